@@ -29,6 +29,7 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_ALGORITHMS_BEE_COLONY_HPP
 #define PAGMO_ALGORITHMS_BEE_COLONY_HPP
 
+#include <algorithm>
 #include <iomanip>
 #include <random>
 #include <stdexcept>
@@ -37,6 +38,8 @@ see https://www.gnu.org/licenses/. */
 #include <vector>
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/bfe.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -80,7 +83,8 @@ public:
      * @throws std::invalid_argument if limit equals 0
      */
     bee_colony(unsigned gen = 1u, unsigned limit = 20u, unsigned seed = pagmo::random_device::next())
-        : m_gen(gen), m_limit(limit), m_e(seed), m_seed(seed), m_verbosity(0u), m_log()
+        : m_gen(gen), m_limit(limit), m_e(seed), m_seed(seed), m_verbosity(0u), m_log(), m_batch_mode(false),
+          m_bfe(1u)
     {
         if (limit == 0u) {
             pagmo_throw(std::invalid_argument, "The limit must be greater than 0.");
@@ -145,7 +149,67 @@ public:
         std::uniform_int_distribution<vector_double::size_type> dvrng(
             0u, NP - 2u); // to generate a random index for the second decision vector
 
+        // Produces in newsol a candidate food source in the neighbourhood of the food source i
+        auto mutate = [&newsol, &X, &comprng, &dvrng, &phirng, &lb, &ub, this](decltype(NP) i) {
+            newsol = X[i];
+            // selects a random component of the decision vector
+            auto comp2change = comprng(m_e);
+            // selects a random decision vector in the population other than the current
+            auto rdv = dvrng(m_e);
+            if (rdv >= i) {
+                ++rdv;
+            }
+            // mutate new solution
+            newsol[comp2change] += phirng(m_e) * (newsol[comp2change] - X[rdv][comp2change]);
+            // if the generated parameter value is out of boundaries, shift it into the boundaries
+            if (newsol[comp2change] < lb[comp2change]) {
+                newsol[comp2change] = lb[comp2change];
+            }
+            if (newsol[comp2change] > ub[comp2change]) {
+                newsol[comp2change] = ub[comp2change];
+            }
+        };
+        // Greedy selection between the food source i and the candidate x, having fitness newfitness
+        auto select = [&X, &fit, &trial, &pop](decltype(NP) i, const vector_double &x,
+                                               const vector_double &newfitness) {
+            // if the new solution is better than the old one replace it and reset its trial counter
+            if (newfitness[0] < fit[i][0]) {
+                fit[i][0] = newfitness[0];
+                X[i] = x;
+                pop.set_xf(i, x, newfitness);
+                trial[i] = 0;
+            } else {
+                ++trial[i];
+            }
+        };
+        // In batch mode the candidates of a phase (and the indices of their food sources) are stored here,
+        // then evaluated together
+        vector_double XB, FB, newfitness(1u);
+        std::vector<decltype(NP)> sources;
+        if (m_batch_mode) {
+            XB.reserve(NP * dim);
+            sources.reserve(NP);
+        }
+        auto add_to_batch = [&XB, &sources, &newsol](decltype(NP) i) {
+            XB.insert(XB.end(), newsol.begin(), newsol.end());
+            sources.push_back(i);
+        };
+        auto evaluate_batch = [&XB, &FB, &sources, &newsol, &newfitness, &select, &prob, dim, this]() {
+            m_bfe.eval(prob, XB, FB);
+            for (decltype(sources.size()) k = 0u; k < sources.size(); ++k) {
+                std::copy(XB.data() + k * dim, XB.data() + (k + 1u) * dim, newsol.begin());
+                newfitness[0] = FB[k];
+                select(sources[k], newsol, newfitness);
+            }
+            XB.clear();
+            sources.clear();
+        };
+
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                return pop;
+            }
             // 1 - Employed bees phase
             std::vector<unsigned>::size_type mi = 0u;
             for (decltype(NP) i = 1u; i < NP; ++i) {
@@ -159,35 +223,17 @@ public:
             }
             for (decltype(NP) i = 0u; i < NP; ++i) {
                 if (trial[i] < m_limit || i != mi) {
-                    newsol = X[i];
-                    // selects a random component of the decision vector
-                    auto comp2change = comprng(m_e);
-                    // selects a random decision vector in the population other than the current
-                    auto rdv = dvrng(m_e);
-                    if (rdv >= i) {
-                        ++rdv;
-                    }
-                    // mutate new solution
-                    newsol[comp2change] += phirng(m_e) * (newsol[comp2change] - X[rdv][comp2change]);
-                    // if the generated parameter value is out of boundaries, shift it into the boundaries
-                    if (newsol[comp2change] < lb[comp2change]) {
-                        newsol[comp2change] = lb[comp2change];
-                    }
-                    if (newsol[comp2change] > ub[comp2change]) {
-                        newsol[comp2change] = ub[comp2change];
-                    }
-                    // if the new solution is better than the old one replace it and reset its trial counter
-                    auto newfitness = prob.fitness(newsol);
-                    if (newfitness[0] < fit[i][0]) {
-                        fit[i][0] = newfitness[0];
-                        X[i][comp2change] = newsol[comp2change];
-                        pop.set_xf(i, newsol, newfitness);
-                        trial[i] = 0;
+                    mutate(i);
+                    if (m_batch_mode) {
+                        add_to_batch(i);
                     } else {
-                        ++trial[i];
+                        select(i, newsol, prob.fitness(newsol));
                     }
                 }
             }
+            if (m_batch_mode) {
+                evaluate_batch();
+            }
             // 2 - Scout bee phase
             if (scout) {
                 for (auto j = 0u; j < dim; ++j) {
@@ -219,36 +265,18 @@ public:
                 auto r = rrng(m_e);
                 if (r < p[s]) {
                     ++t;
-                    newsol = X[s];
-                    // selects a random component of the decision vector
-                    auto comp2change = comprng(m_e);
-                    // selects a random decision vector in the population other than the current
-                    auto rdv = dvrng(m_e);
-                    if (rdv >= s) {
-                        ++rdv;
-                    }
-                    // mutate new solution
-                    newsol[comp2change] += phirng(m_e) * (newsol[comp2change] - X[rdv][comp2change]);
-                    // if the generated parameter value is out of boundaries, shift it into the boundaries
-                    if (newsol[comp2change] < lb[comp2change]) {
-                        newsol[comp2change] = lb[comp2change];
-                    }
-                    if (newsol[comp2change] > ub[comp2change]) {
-                        newsol[comp2change] = ub[comp2change];
-                    }
-                    // if the new solution is better than the old one replace it and reset its trial counter
-                    auto newfitness = prob.fitness(newsol);
-                    if (newfitness[0] < fit[s][0]) {
-                        fit[s][0] = newfitness[0];
-                        X[s][comp2change] = newsol[comp2change];
-                        pop.set_xf(s, newsol, newfitness);
-                        trial[s] = 0;
+                    mutate(s);
+                    if (m_batch_mode) {
+                        add_to_batch(s);
                     } else {
-                        ++trial[s];
+                        select(s, newsol, prob.fitness(newsol));
                     }
                 }
                 s = (s + 1) % NP;
             }
+            if (m_batch_mode) {
+                evaluate_batch();
+            }
             // Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
             if (m_verbosity > 0u) {
                 // Every m_verbosity generations print a log line
@@ -328,6 +356,49 @@ public:
     {
         return m_gen;
     }
+    /// Sets the batch mode
+    /**
+     * By default each candidate food source is evaluated, and compared with the food source it originates from, as
+     * soon as it is produced. In batch mode, instead, the employed and the onlooker phases first produce all their
+     * candidate food sources (from the food sources as they were at the beginning of the phase), then evaluate them
+     * together with the batch fitness evaluator (see bee_colony::set_bfe()) and, finally, apply the greedy
+     * selection and update the trial counters in the order in which the candidates were produced. The scout phase
+     * is not affected. For a given seed, the results do not depend on the number of threads used by the batch
+     * fitness evaluator.
+     *
+     * @param flag \p true to enable the batch mode, \p false to disable it
+     */
+    void set_batch_mode(bool flag)
+    {
+        m_batch_mode = flag;
+    }
+    /// Gets the batch mode
+    /**
+     * @return \p true if the batch mode is enabled
+     */
+    bool get_batch_mode() const
+    {
+        return m_batch_mode;
+    }
+    /// Sets the batch fitness evaluator
+    /**
+     * The batch fitness evaluator \p b (see pagmo::bfe) is used to evaluate the candidate food sources in batch mode
+     * (see bee_colony::set_batch_mode()). By default a sequential evaluator is used.
+     *
+     * @param b the batch fitness evaluator
+     */
+    void set_bfe(const bfe &b)
+    {
+        m_bfe = b;
+    }
+    /// Gets the batch fitness evaluator
+    /**
+     * @return a const reference to the batch fitness evaluator
+     */
+    const bfe &get_bfe() const
+    {
+        return m_bfe;
+    }
     /// Algorithm name
     /**
      * @return a string containing the algorithm name
@@ -347,6 +418,8 @@ public:
         stream(ss, "\n\tLimit: ", m_limit);
         stream(ss, "\n\tVerbosity: ", m_verbosity);
         stream(ss, "\n\tSeed: ", m_seed);
+        stream(ss, "\n\tBatch mode: ", m_batch_mode);
+        stream(ss, "\n\tFitness evaluation: ", m_bfe.get_name());
         return ss.str();
     }
     /// Get log
@@ -373,7 +446,7 @@ public:
     template <typename Archive>
     void serialize(Archive &ar)
     {
-        ar(m_gen, m_limit, m_e, m_seed, m_verbosity, m_log);
+        ar(m_gen, m_limit, m_e, m_seed, m_verbosity, m_log, m_batch_mode, m_bfe);
     }
 
 private:
@@ -383,6 +456,8 @@ private:
     unsigned m_seed;
     unsigned m_verbosity;
     mutable log_type m_log;
+    bool m_batch_mode;
+    bfe m_bfe;
 };
 
 } // namespace pagmo
@@ -41,6 +41,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -312,6 +313,13 @@ public:
         // ----------------------------------------------//
         Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(_(dim));
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                if (m_verbosity > 0u) {
+                    std::cout << "Exit condition -- evolution stopped" << std::endl;
+                }
+                return pop;
+            }
             // 1 - We generate and evaluate lam new individuals
             for (decltype(lam) i = 0u; i < lam; ++i) {
                 // 1a - we create a randomly normal distributed vector
@@ -35,11 +35,11 @@ see https://www.gnu.org/licenses/. */
 #include <random>
 #include <string>
 #include <tuple>
-#include <unordered_map>
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/de.hpp>
 #include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/detail/fitness_cache.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -71,7 +71,7 @@ public:
         assert(false);
     };
     /// Constructs the udp. At construction all member get initialized calling update().
-    penalized_udp(population &pop) : m_fitness_map()
+    penalized_udp(population &pop) : m_cache()
     {
         assert(pop.get_problem().get_nc() != 0u);   // Only constrained problems can use this
         assert(pop.get_problem().get_nobj() == 1u); // Only single objective problems can use this
@@ -79,6 +79,12 @@ public:
 
         // We assign the naked pointer The pointer will be immutable (as in its never changed afterwards)
         m_pop_ptr = &pop;
+        m_c_tol = pop.get_problem().get_c_tol();
+        // The slots of the cache hold at most cache_max_doubles doubles (a slot holds nx + nf doubles, and
+        // there are fewer than 4 slots per entry), but the cache is always able to contain the reference
+        // population.
+        const auto nx = pop.get_problem().get_nx(), nf = pop.get_problem().get_nf();
+        m_cache.reset(nx, nf, std::max(2u * pop.size(), cache_max_doubles / (4u * (nx + nf))));
         // Update all data members and init the cache
         update();
     }
@@ -95,16 +101,15 @@ public:
         double solution_infeasibility;
         vector_double f(1, 0.);
 
-        // 1 - We check if the decision vector is already in the reference population and return that or recompute.
-        auto it_f = m_fitness_map.find(x);
-        if (it_f != m_fitness_map.end()) {
-            f[0] = it_f->second[0];
-            solution_infeasibility = compute_infeasibility(it_f->second);
+        // 1 - We check if the decision vector is already in the cache and return that or recompute.
+        if (auto cached_f = m_cache.find(x)) {
+            f[0] = cached_f[0];
+            solution_infeasibility = compute_infeasibility(cached_f);
         } else { // we have to compute the fitness (this will increase the feval counter in the ref pop problem )
             auto fit = m_pop_ptr->get_problem().fitness(x);
             f[0] = fit[0];
             solution_infeasibility = compute_infeasibility(fit);
-            m_fitness_map[x] = fit;
+            m_cache.insert(x, fit);
         }
         // 2 - Then we apply the penalty
         if (solution_infeasibility > 0.) {
@@ -127,19 +132,26 @@ public:
         return f;
     }
 
+    // The fitness of a penalized_udp reads and writes the cache and the reference population: it cannot
+    // be called concurrently.
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+
     // Call to this method updates all the members that are used to penalize the objective function
     // As the penalization algorithm depends heavily on the ref population this method takes care of
-    // updating the necessary information. It also builds the hash map used to avoid unecessary fitness
-    // evaluations. We exclude this method from the test as all of its corner cases are difficult to trigger
-    // and test for correctness
+    // updating the necessary information. It also resets the cache used to avoid unecessary fitness
+    // evaluations, which thus only spans one call to the inner algorithm. We exclude this method from the
+    // test as all of its corner cases are difficult to trigger and test for correctness
     void update()
     {
         auto pop_size = m_pop_ptr->size();
-        // 1 - We build the hash map to be able (later) to return already computed fitnesses corresponding to
+        // 1 - We fill the cache to be able (later) to return already computed fitnesses corresponding to
         // some decision vector
-        m_fitness_map.clear();
+        m_cache.clear();
         for (decltype(pop_size) i = 0u; i < pop_size; ++i) {
-            m_fitness_map[m_pop_ptr->get_x()[i]] = m_pop_ptr->get_f()[i];
+            m_cache.insert(m_pop_ptr->get_x()[i], m_pop_ptr->get_f()[i]);
         }
 
         // Init some data member values
@@ -336,7 +348,7 @@ public:
         auto pop_size = m_pop_ptr->size();
         auto nc = m_pop_ptr->get_problem().get_nc();
         auto nec = m_pop_ptr->get_problem().get_nec();
-        auto c_tol = m_pop_ptr->get_problem().get_c_tol();
+        const auto &c_tol = m_c_tol;
 
         // We init c_max
         m_c_max = vector_double(nc, 0.);
@@ -359,11 +371,16 @@ public:
     // Assuming the various data member contain useful information, this computes the
     // infeasibility measure of a certain fitness
     double compute_infeasibility(const vector_double &fit) const
+    {
+        return compute_infeasibility(fit.data());
+    }
+    // Same as above, fit pointing to the nf components of a fitness vector.
+    double compute_infeasibility(const double *fit) const
     {
         // 1 - Let's store some useful variables.
         auto nc = m_pop_ptr->get_problem().get_nc();
         auto nec = m_pop_ptr->get_problem().get_nec();
-        auto c_tol = m_pop_ptr->get_problem().get_c_tol();
+        const auto &c_tol = m_c_tol;
         double retval = 0.;
 
         // 2 -  We compute the infeasibility measure
@@ -401,11 +418,13 @@ public:
     // A NAKED pointer to the reference population, allowing to call the fitness function and later recover
     // the counters outside of the class, and avoiding unecessary copies. Use with care.
     population *m_pop_ptr;
-    // The hash map connecting the decision vector to their fitnesses. The use of
-    // custom comparison is needed to take care of nans, while the custom hasher is needed as std::hash does not
-    // work on std::vectors
-    mutable std::unordered_map<vector_double, vector_double, detail::hash_vf<double>, detail::equal_to_vf<double>>
-        m_fitness_map;
+    // The constraints tolerance of the reference problem
+    vector_double m_c_tol;
+    // Upper bound (in number of doubles) for the memory used by the cache, unless the reference population
+    // needs more
+    static const vector_double::size_type cache_max_doubles = 1u << 22;
+    // The cache connecting the decision vectors to their fitnesses (nans are considered equal to each other)
+    mutable fitness_cache m_cache;
 };
 } // namespace detail
 
@@ -460,8 +479,8 @@ public:
  *    Self-adaptive constraints handling implements an internal cache to avoid the re-evaluation of the fitness
  *    for decision vectors already evaluated. This makes the final counter of function evaluations somewhat
  *    unpredictable. The number of function evaluation will be bounded to ``iters`` times the fevals made by one call to
- *    the inner UDA. The internal cache is reset at each iteration, but its size will grow unlimited during each call to
- *    the inner UDA evolve method.
+ *    the inner UDA. The internal cache is reset at each iteration, and its memory footprint is bounded (to about
+ *    32 MB, or to what is needed to store the reference population if larger).
  *
  * .. note::
  *
@@ -634,11 +653,13 @@ public:
             penalized_udp_ptr = new_pop.get_problem().extract<detail::penalized_udp>();
             // We update the original pop avoiding fevals thanks to the cache
             for (decltype(pop.size()) i = 0u; i < pop.size(); ++i) {
-                auto x = new_pop.get_x()[i];
-                auto it_f = penalized_udp_ptr->m_fitness_map.find(x);
-                assert(it_f
-                       != penalized_udp_ptr->m_fitness_map.end()); // We are assasserting here the cache will be hit
-                pop.set_xf(i, x, it_f->second);
+                const auto &x = new_pop.get_x()[i];
+                if (auto cached_f = penalized_udp_ptr->m_cache.find(x)) {
+                    pop.set_xf(i, x, vector_double(cached_f, cached_f + prob.get_nf()));
+                } else {
+                    // The cache was full when x was evaluated: this costs one extra fitness evaluation.
+                    pop.set_x(i, x);
+                }
             }
             pop.set_xf(worst_idx, best_x, best_f);
         }
@@ -29,6 +29,8 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_ALGORITHMS_DE_HPP
 #define PAGMO_ALGORITHMS_DE_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <iomanip>
 #include <numeric> //std::iota
 #include <random>
@@ -36,8 +38,11 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <tuple>
 #include <utility> //std::swap
+#include <vector>
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/detail/async_eval.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -109,7 +114,7 @@ public:
     de(unsigned int gen = 1u, double F = 0.8, double CR = 0.9, unsigned int variant = 2u, double ftol = 1e-6,
        double xtol = 1e-6, unsigned int seed = pagmo::random_device::next())
         : m_gen(gen), m_F(F), m_CR(CR), m_variant(variant), m_Ftol(ftol), m_xtol(xtol), m_e(seed), m_seed(seed),
-          m_verbosity(0u), m_log()
+          m_verbosity(0u), m_log(), m_steady_state(0u)
     {
         if (variant < 1u || variant > 10u) {
             pagmo_throw(std::invalid_argument,
@@ -131,6 +136,7 @@ public:
      * @return evolved population
      * @throws std::invalid_argument if the problem is multi-objective or constrained or stochastic
      * @throws std::invalid_argument if the population size is not at least 5
+     * @throws unspecified any exception thrown by the evaluation of the trial vectors in the steady-state mode
      */
     population evolve(population pop) const
     {
@@ -174,6 +180,10 @@ public:
         // No throws, all valid: we clear the logs
         m_log.clear();
 
+        if (m_steady_state) {
+            return evolve_steady_state(std::move(pop));
+        }
+
         // Some vectors used during evolution are declared.
         vector_double tmp(dim);                              // contains the mutated candidate
         std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
@@ -196,148 +206,17 @@ public:
 
         // Main DE iterations
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                if (m_verbosity > 0u) {
+                    std::cout << "Exit condition -- evolution stopped" << std::endl;
+                }
+                return pop;
+            }
             // Start of the loop through the population
             for (decltype(NP) i = 0u; i < NP; ++i) {
-                /*-----We select at random 5 indexes from the population---------------------------------*/
-                std::vector<vector_double::size_type> idxs(NP);
-                std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
-                for (auto j = 0u; j < 5u; ++j) { // Durstenfeld's algorithm to select 5 indexes at random
-                    auto idx = std::uniform_int_distribution<vector_double::size_type>(0u, NP - 1u - j)(m_e);
-                    r[j] = idxs[idx];
-                    std::swap(idxs[idx], idxs[NP - 1u - j]);
-                }
-
-                /*-------DE/best/1/exp--------------------------------------------------------------------*/
-                /*-------The oldest DE variant but still not bad. However, we have found several---------*/
-                /*-------optimization problems where misconvergence occurs.-------------------------------*/
-                if (m_variant == 1u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-
-                /*-------DE/rand/1/exp-------------------------------------------------------------------*/
-                /*-------This is one of my favourite strategies. It works especially well when the-------*/
-                /*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_F=0.7 and m_CR=0.5---------*/
-                /*-------as a first guess.---------------------------------------------------------------*/
-                else if (m_variant == 2u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    decltype(dim) L = 0u;
-                    do {
-                        tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-                /*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-                /*-------This variant seems to be one of the best strategies. Try m_F=0.85 and m_CR=1.------*/
-                /*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-                /*-------should play around with all three control variables.----------------------------*/
-                else if (m_variant == 3u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-                /*-------DE/best/2/exp is another powerful variant worth trying--------------------------*/
-                else if (m_variant == 4u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n]
-                            = gbIter[n] + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-                /*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-                else if (m_variant == 5u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = popold[r[4]][n]
-                                 + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-
-                /*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-                /*-------DE/best/1/bin--------------------------------------------------------------------*/
-                else if (m_variant == 6u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand/1/bin-------------------------------------------------------------------*/
-                else if (m_variant == 7u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-                else if (m_variant == 8u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/best/2/bin--------------------------------------------------------------------*/
-                else if (m_variant == 9u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = gbIter[n]
-                                     + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand/2/bin--------------------------------------------------------------------*/
-                else if (m_variant == 10u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[4]][n]
-                                     + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-
-                // Trial mutation now in tmp. force feasibility and see how good this choice really was.
-                // a) feasibility
-                // detail::force_bounds_reflection(tmp, lb, ub); // TODO: check if this choice is better
-                detail::force_bounds_random(tmp, lb, ub, m_e);
-                // b) how good?
+                make_trial(tmp, i, popold, gbIter, lb, ub, r, drng, c_idx);
+                // How good?
                 auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
                 if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
                     fit[i] = newfitness;
@@ -473,6 +352,37 @@ public:
     {
         return m_gen;
     }
+    /// Sets the steady-state mode
+    /**
+     * In the steady-state mode the population is not evolved generation by generation. Instead, up to \p n
+     * trial vectors are evaluated concurrently, each in a separate thread using its own copy of the problem.
+     * As soon as the evaluation of a trial vector completes, the trial competes with its target individual
+     * and a new trial vector, built from the current population and the current best, is submitted for evaluation.
+     * The threads are thus kept busy also when the cost of the fitness evaluation varies
+     * from one individual to another.
+     *
+     * The number of fitness evaluations is the same as in the generational mode (i.e., the number of generations
+     * times the population size), and the stopping criteria and the logs are checked every population size
+     * completed evaluations. At most one trial vector per target individual is in flight at any time. If the
+     * problem does not provide at least the pagmo::thread_safety::basic guarantee, or if \p n is 1, the trial
+     * vectors are evaluated one at a time in the calling thread.
+     *
+     * @param n the maximum number of concurrent fitness evaluations (0 selects the generational mode,
+     * which is the default)
+     */
+    void set_steady_state(unsigned n)
+    {
+        m_steady_state = n;
+    }
+    /// Gets the steady-state mode
+    /**
+     * @return the maximum number of concurrent fitness evaluations in the steady-state mode
+     * (0 if the generational mode is selected)
+     */
+    unsigned get_steady_state() const
+    {
+        return m_steady_state;
+    }
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -491,10 +401,15 @@ public:
      */
     std::string get_extra_info() const
     {
-        return "\tGenerations: " + std::to_string(m_gen) + "\n\tParameter F: " + std::to_string(m_F)
-               + "\n\tParameter CR: " + std::to_string(m_CR) + "\n\tVariant: " + std::to_string(m_variant)
-               + "\n\tStopping xtol: " + std::to_string(m_xtol) + "\n\tStopping ftol: " + std::to_string(m_Ftol)
-               + "\n\tVerbosity: " + std::to_string(m_verbosity) + "\n\tSeed: " + std::to_string(m_seed);
+        auto retval = "\tGenerations: " + std::to_string(m_gen) + "\n\tParameter F: " + std::to_string(m_F)
+                      + "\n\tParameter CR: " + std::to_string(m_CR) + "\n\tVariant: " + std::to_string(m_variant)
+                      + "\n\tStopping xtol: " + std::to_string(m_xtol) + "\n\tStopping ftol: "
+                      + std::to_string(m_Ftol) + "\n\tVerbosity: " + std::to_string(m_verbosity)
+                      + "\n\tSeed: " + std::to_string(m_seed);
+        if (m_steady_state) {
+            retval += "\n\tSteady-state evaluations: " + std::to_string(m_steady_state);
+        }
+        return retval;
     }
     /// Get log
     /**
@@ -518,10 +433,271 @@ public:
     template <typename Archive>
     void serialize(Archive &ar)
     {
-        ar(m_gen, m_F, m_CR, m_variant, m_Ftol, m_xtol, m_e, m_seed, m_verbosity, m_log);
+        ar(m_gen, m_F, m_CR, m_variant, m_Ftol, m_xtol, m_e, m_seed, m_verbosity, m_log, m_steady_state);
     }
 
 private:
+    // Compute in tmp the trial vector for the i-th individual, using the mutation variant
+    // and the crossover selected upon construction. The trial vector is made feasible.
+    void make_trial(vector_double &tmp, vector_double::size_type i, const std::vector<vector_double> &popold,
+                    const vector_double &gbIter, const vector_double &lb, const vector_double &ub,
+                    std::vector<vector_double::size_type> &r, std::uniform_real_distribution<double> &drng,
+                    std::uniform_int_distribution<vector_double::size_type> &c_idx) const
+    {
+        auto NP = popold.size();
+        auto dim = lb.size();
+        /*-----We select at random 5 indexes from the population---------------------------------*/
+        std::vector<vector_double::size_type> idxs(NP);
+        std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
+        for (auto j = 0u; j < 5u; ++j) { // Durstenfeld's algorithm to select 5 indexes at random
+            auto idx = std::uniform_int_distribution<vector_double::size_type>(0u, NP - 1u - j)(m_e);
+            r[j] = idxs[idx];
+            std::swap(idxs[idx], idxs[NP - 1u - j]);
+        }
+
+        /*-------DE/best/1/exp--------------------------------------------------------------------*/
+        /*-------The oldest DE variant but still not bad. However, we have found several---------*/
+        /*-------optimization problems where misconvergence occurs.-------------------------------*/
+        if (m_variant == 1u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            auto L = 0u;
+            do {
+                tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
+                n = (n + 1u) % dim;
+                ++L;
+            } while ((drng(m_e) < m_CR) && (L < dim));
+        }
+
+        /*-------DE/rand/1/exp-------------------------------------------------------------------*/
+        /*-------This is one of my favourite strategies. It works especially well when the-------*/
+        /*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_F=0.7 and m_CR=0.5---------*/
+        /*-------as a first guess.---------------------------------------------------------------*/
+        else if (m_variant == 2u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            decltype(dim) L = 0u;
+            do {
+                tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
+                n = (n + 1u) % dim;
+                ++L;
+            } while ((drng(m_e) < m_CR) && (L < dim));
+        }
+        /*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
+        /*-------This variant seems to be one of the best strategies. Try m_F=0.85 and m_CR=1.------*/
+        /*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
+        /*-------should play around with all three control variables.----------------------------*/
+        else if (m_variant == 3u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            auto L = 0u;
+            do {
+                tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
+                n = (n + 1u) % dim;
+                ++L;
+            } while ((drng(m_e) < m_CR) && (L < dim));
+        }
+        /*-------DE/best/2/exp is another powerful variant worth trying--------------------------*/
+        else if (m_variant == 4u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            auto L = 0u;
+            do {
+                tmp[n]
+                    = gbIter[n] + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
+                n = (n + 1u) % dim;
+                ++L;
+            } while ((drng(m_e) < m_CR) && (L < dim));
+        }
+        /*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
+        else if (m_variant == 5u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            auto L = 0u;
+            do {
+                tmp[n] = popold[r[4]][n]
+                         + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
+                n = (n + 1u) % dim;
+                ++L;
+            } while ((drng(m_e) < m_CR) && (L < dim));
+        }
+
+        /*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
+        /*-------DE/best/1/bin--------------------------------------------------------------------*/
+        else if (m_variant == 6u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
+                if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
+                    tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
+                }
+                n = (n + 1u) % dim;
+            }
+        }
+        /*-------DE/rand/1/bin-------------------------------------------------------------------*/
+        else if (m_variant == 7u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
+                if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
+                    tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
+                }
+                n = (n + 1u) % dim;
+            }
+        }
+        /*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
+        else if (m_variant == 8u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
+                if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
+                    tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
+                }
+                n = (n + 1u) % dim;
+            }
+        }
+        /*-------DE/best/2/bin--------------------------------------------------------------------*/
+        else if (m_variant == 9u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
+                if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
+                    tmp[n] = gbIter[n]
+                             + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
+                }
+                n = (n + 1u) % dim;
+            }
+        }
+        /*-------DE/rand/2/bin--------------------------------------------------------------------*/
+        else if (m_variant == 10u) {
+            tmp = popold[i];
+            auto n = c_idx(m_e);
+            for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
+                if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
+                    tmp[n] = popold[r[4]][n]
+                             + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
+                }
+                n = (n + 1u) % dim;
+            }
+        }
+
+        // Trial mutation now in tmp. force feasibility and see how good this choice really was.
+        // a) feasibility
+        // detail::force_bounds_reflection(tmp, lb, ub); // TODO: check if this choice is better
+        detail::force_bounds_random(tmp, lb, ub, m_e);
+    }
+    // The steady-state evolution (see set_steady_state()). Called by evolve() after the preamble.
+    population evolve_steady_state(population pop) const
+    {
+        const auto &prob = pop.get_problem();
+        auto dim = prob.get_nx();
+        const auto bounds = prob.get_bounds();
+        const auto &lb = bounds.first;
+        const auto &ub = bounds.second;
+        auto NP = pop.size();
+        auto fevals0 = prob.get_fevals();
+        unsigned int count = 1u;
+
+        vector_double tmp(dim);
+        std::uniform_real_distribution<double> drng(0., 1.);
+        std::uniform_int_distribution<vector_double::size_type> c_idx(0u, dim - 1u);
+        std::vector<vector_double::size_type> r(5);
+
+        // Here the trial vectors are built from the current population, which is updated in place.
+        auto popx = pop.get_x();
+        auto fit = pop.get_f();
+        auto best_idx = pop.best_idx();
+        auto gbX = popx[best_idx];
+        auto gbfit = fit[best_idx];
+
+        // Total number of trial vectors, and the targets having a trial vector in flight.
+        const auto n_trials = static_cast<unsigned long long>(m_gen) * NP;
+        unsigned long long n_submitted = 0u, n_done = 0u;
+        std::vector<char> busy(NP, 0);
+        vector_double::size_type next_target = 0u;
+
+        detail::async_eval_pool eval_pool(prob, m_steady_state);
+        auto submit_trial = [&]() {
+            while (busy[next_target]) {
+                next_target = (next_target + 1u) % NP;
+            }
+            make_trial(tmp, next_target, popx, gbX, lb, ub, r, drng, c_idx);
+            eval_pool.submit(next_target, tmp);
+            busy[next_target] = 1;
+            next_target = (next_target + 1u) % NP;
+            ++n_submitted;
+        };
+        const auto n_in_flight = std::min(static_cast<unsigned long long>(std::min<decltype(NP)>(m_steady_state, NP)),
+                                          n_trials);
+        for (auto k = 0ull; k < n_in_flight; ++k) {
+            submit_trial();
+        }
+
+        std::size_t i;
+        vector_double newx, newfitness;
+        while (eval_pool.n_pending()) {
+            eval_pool.next(i, newx, newfitness);
+            busy[i] = 0;
+            ++n_done;
+            if (newfitness[0] <= fit[i][0]) {
+                fit[i] = newfitness;
+                popx[i] = newx;
+                pop.set_xf(i, newx, newfitness);
+                if (newfitness[0] <= gbfit[0]) {
+                    gbfit = newfitness;
+                    gbX = newx;
+                }
+            }
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                eval_pool.finish();
+                if (m_verbosity > 0u) {
+                    std::cout << "Exit condition -- evolution stopped" << std::endl;
+                }
+                return pop;
+            }
+            // Every NP completed evaluations we check the exit conditions and log, as
+            // done at the end of each generation in the generational mode.
+            if (n_done % NP == 0u) {
+                const auto gen = static_cast<unsigned int>(n_done / NP);
+                double dx = 0., df = 0.;
+                best_idx = pop.best_idx();
+                const auto worst_idx = pop.worst_idx();
+                for (decltype(dim) j = 0u; j < dim; ++j) {
+                    dx += std::abs(pop.get_x()[worst_idx][j] - pop.get_x()[best_idx][j]);
+                }
+                df = std::abs(pop.get_f()[worst_idx][0] - pop.get_f()[best_idx][0]);
+                if (dx < m_xtol || df < m_Ftol) {
+                    eval_pool.finish();
+                    if (m_verbosity > 0u) {
+                        if (dx < m_xtol) {
+                            std::cout << "Exit condition -- xtol < " << m_xtol << std::endl;
+                        } else {
+                            std::cout << "Exit condition -- ftol < " << m_Ftol << std::endl;
+                        }
+                    }
+                    return pop;
+                }
+                if (m_verbosity > 0u && (gen % m_verbosity == 1u || m_verbosity == 1u)) {
+                    if (count % 50u == 1u) {
+                        print("\n", std::setw(7), "Gen:", std::setw(15), "Fevals:", std::setw(15), "Best:",
+                              std::setw(15), "dx:", std::setw(15), "df:", '\n');
+                    }
+                    print(std::setw(7), gen, std::setw(15), prob.get_fevals() - fevals0, std::setw(15),
+                          pop.get_f()[best_idx][0], std::setw(15), dx, std::setw(15), df, '\n');
+                    ++count;
+                    m_log.emplace_back(gen, prob.get_fevals() - fevals0, pop.get_f()[best_idx][0], dx, df);
+                }
+            }
+            if (n_submitted < n_trials) {
+                submit_trial();
+            }
+        }
+        if (m_verbosity) {
+            std::cout << "Exit condition -- generations = " << m_gen << std::endl;
+        }
+        return pop;
+    }
     unsigned int m_gen;
     double m_F;
     double m_CR;
@@ -532,6 +708,7 @@ private:
     unsigned int m_seed;
     unsigned int m_verbosity;
     mutable log_type m_log;
+    unsigned m_steady_state;
 };
 
 } // namespace pagmo
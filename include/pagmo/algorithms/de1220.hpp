@@ -29,6 +29,7 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_ALGORITHMS_DE1220_HPP
 #define PAGMO_ALGORITHMS_DE1220_HPP
 
+#include <algorithm>
 #include <iomanip>
 #include <numeric> //std::iota
 #include <random>
@@ -38,6 +39,8 @@ see https://www.gnu.org/licenses/. */
 #include <utility> //std::swap
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/bfe.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -162,7 +165,8 @@ public:
            unsigned int variant_adptv = 1u, double ftol = 1e-6, double xtol = 1e-6, bool memory = false,
            unsigned int seed = pagmo::random_device::next())
         : m_gen(gen), m_F(), m_CR(), m_variant(), m_allowed_variants(allowed_variants), m_variant_adptv(variant_adptv),
-          m_ftol(ftol), m_xtol(xtol), m_memory(memory), m_e(seed), m_seed(seed), m_verbosity(0u), m_log()
+          m_ftol(ftol), m_xtol(xtol), m_memory(memory), m_e(seed), m_seed(seed), m_verbosity(0u), m_log(),
+          m_generational(false), m_bfe(1u)
     {
         for (auto variant : allowed_variants) {
             if (variant < 1u || variant > 18u) {
@@ -252,6 +256,16 @@ public:
         // the best decision vector of a generation
         auto gbIter = gbX;
         std::vector<vector_double::size_type> r(7); // indexes of 7 selected population members
+        // In the generational mode the trial vectors of the whole population (and the parameters used to produce
+        // them) are stored and evaluated at the end of each generation
+        vector_double XT, FT, trial_F, trial_CR, trial_fitness(1u);
+        std::vector<unsigned int> trial_variant;
+        if (m_generational) {
+            XT.resize(NP * dim);
+            trial_F.resize(NP);
+            trial_CR.resize(NP);
+            trial_variant.resize(NP);
+        }
 
         // Initialize the F and CR vectors
         if ((m_CR.size() != NP) || (m_F.size() != NP) || (m_variant.size() != NP) || (!m_memory)) {
@@ -280,11 +294,45 @@ public:
         double gbIterF = gbF;
         double gbIterCR = gbCR;
         unsigned int gbIterVariant;
+        // Selection of the trial vector x, having fitness newfitness and produced using F, CR and VARIANT,
+        // against the individual i
+        auto select = [&fit, &popnew, &popold, &pop, &gbfit, &gbX, &gbF, &gbCR, &gbVariant,
+                       this](vector_double::size_type i, const vector_double &x, const vector_double &newfitness,
+                             double F, double CR, unsigned int VARIANT) {
+            if (newfitness[0] <= fit[i][0]) { /* improved objective function value ? */
+                fit[i] = newfitness;
+                popnew[i] = x;
+                // updates the individual in pop (avoiding to recompute the objective function)
+                pop.set_xf(i, popnew[i], newfitness);
+                // Update the adapted parameters
+                m_CR[i] = CR;
+                m_F[i] = F;
+                m_variant[i] = VARIANT;
+
+                if (newfitness[0] <= gbfit[0]) {
+                    /* if so...*/
+                    gbfit = newfitness; /* reset gbfit to new low...*/
+                    gbX = popnew[i];
+                    gbF = F;   /* these were forgotten in PaGMOlegacy */
+                    gbCR = CR; /* these were forgotten in PaGMOlegacy */
+                    gbVariant = VARIANT;
+                }
+            } else {
+                popnew[i] = popold[i];
+            }
+        };
 
         // We initialize the global best for F and CR as the first individual (this will soon be forgotten)
 
         // Main DE iterations
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                if (m_verbosity > 0u) {
+                    std::cout << "Exit condition -- evolution stopped" << std::endl;
+                }
+                return pop;
+            }
             // Start of the loop through the population
             for (decltype(NP) i = 0u; i < NP; ++i) {
                 /*-----We select at random 5 indexes from the population---------------------------------*/
@@ -627,29 +675,25 @@ public:
                     }
                 }
                 // b) how good?
-                auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
-                if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
-                    fit[i] = newfitness;
-                    popnew[i] = tmp;
-                    // updates the individual in pop (avoiding to recompute the objective function)
-                    pop.set_xf(i, popnew[i], newfitness);
-                    // Update the adapted parameters
-                    m_CR[i] = CR;
-                    m_F[i] = F;
-                    m_variant[i] = VARIANT;
-
-                    if (newfitness[0] <= gbfit[0]) {
-                        /* if so...*/
-                        gbfit = newfitness; /* reset gbfit to new low...*/
-                        gbX = popnew[i];
-                        gbF = F;   /* these were forgotten in PaGMOlegacy */
-                        gbCR = CR; /* these were forgotten in PaGMOlegacy */
-                        gbVariant = VARIANT;
-                    }
+                if (m_generational) {
+                    // The evaluation and the selection are deferred to the end of the generation
+                    std::copy(tmp.begin(), tmp.end(), XT.data() + i * dim);
+                    trial_F[i] = F;
+                    trial_CR[i] = CR;
+                    trial_variant[i] = VARIANT;
                 } else {
-                    popnew[i] = popold[i];
+                    select(i, tmp, prob.fitness(tmp), F, CR, VARIANT);
                 }
             } // End of one generation
+            if (m_generational) {
+                // All the trial vectors are evaluated at once, then selected in order
+                m_bfe.eval(prob, XT, FT);
+                for (decltype(NP) i = 0u; i < NP; ++i) {
+                    std::copy(XT.data() + i * dim, XT.data() + (i + 1u) * dim, tmp.begin());
+                    trial_fitness[0] = FT[i];
+                    select(i, tmp, trial_fitness, trial_F[i], trial_CR[i], trial_variant[i]);
+                }
+            }
             /* Save best population member of current iteration */
             gbIter = gbX;
             gbIterF = gbF;
@@ -785,6 +829,50 @@ public:
     {
         return m_gen;
     }
+    /// Sets the generational mode
+    /**
+     * By default each trial vector is evaluated, and selected against its parent, as soon as it is produced, so that
+     * the adapted parameters of the individuals already processed in the current generation are visible to the
+     * following ones (this matters for the iDE adaptation scheme). In the generational mode, instead, the trial
+     * vectors of the whole population are produced first (together with their adapted parameters), they are then
+     * evaluated at once by the batch fitness evaluator (see de1220::set_bfe()) and, finally, selection and
+     * parameter survival are applied in order. For the jDE adaptation scheme the two modes produce the same
+     * results. For a given seed, the results do not depend on the number of threads used by the batch fitness
+     * evaluator.
+     *
+     * @param flag \p true to enable the generational mode, \p false to disable it
+     */
+    void set_generational(bool flag)
+    {
+        m_generational = flag;
+    }
+    /// Gets the generational mode
+    /**
+     * @return \p true if the generational mode is enabled
+     */
+    bool get_generational() const
+    {
+        return m_generational;
+    }
+    /// Sets the batch fitness evaluator
+    /**
+     * The batch fitness evaluator \p b (see pagmo::bfe) is used to evaluate the trial vectors in the
+     * generational mode (see de1220::set_generational()). By default a sequential evaluator is used.
+     *
+     * @param b the batch fitness evaluator
+     */
+    void set_bfe(const bfe &b)
+    {
+        m_bfe = b;
+    }
+    /// Gets the batch fitness evaluator
+    /**
+     * @return a const reference to the batch fitness evaluator
+     */
+    const bfe &get_bfe() const
+    {
+        return m_bfe;
+    }
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -812,6 +900,8 @@ public:
         stream(ss, "\n\tMemory: ", m_memory);
         stream(ss, "\n\tVerbosity: ", m_verbosity);
         stream(ss, "\n\tSeed: ", m_seed);
+        stream(ss, "\n\tGenerational: ", m_generational);
+        stream(ss, "\n\tFitness evaluation: ", m_bfe.get_name());
         return ss.str();
     }
     /// Get log
@@ -839,7 +929,7 @@ public:
     void serialize(Archive &ar)
     {
         ar(m_gen, m_F, m_CR, m_allowed_variants, m_variant_adptv, m_ftol, m_xtol, m_memory, m_e, m_seed, m_verbosity,
-           m_log);
+           m_log, m_generational, m_bfe);
     }
 
 private:
@@ -856,6 +946,8 @@ private:
     unsigned int m_seed;
     unsigned int m_verbosity;
     mutable log_type m_log;
+    bool m_generational;
+    bfe m_bfe;
 };
 
 } // namespace pagmo
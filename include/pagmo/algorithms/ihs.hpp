@@ -32,6 +32,7 @@ see https://www.gnu.org/licenses/. */
 #include <cmath>  // log, etc..
 #include <random> // uniform_int, etc..
 
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
@@ -207,6 +208,10 @@ public:
 
         // Main loop
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                return pop;
+            }
             // 1 - We adjust the algorithm parameters (parameter control)
             const double ppar_cur = m_ppar_min + ((m_ppar_max - m_ppar_min) * gen) / m_gen;
             const double bw_cur = m_bw_max * std::exp(c * gen);
@@ -184,8 +184,16 @@ struct ipopt_nlp final : Ipopt::TNLP {
                 return std::make_pair(boost::numeric_cast<Index>(p.first - 1u), boost::numeric_cast<Index>(p.second));
             });
             if (m_prob.has_gradient_sparsity()) {
-                // Store the objfun gradient sparsity, if user-provided.
-                std::copy(sp.begin(), it, std::back_inserter(m_obj_g_sp));
+                // Store the columns of the objfun gradient sparsity, if user-provided.
+                std::transform(sp.begin(), it, std::back_inserter(m_obj_g_cols),
+                               [](const sparsity_pattern::value_type &p) {
+                                   assert(p.first == 0u);
+                                   return boost::numeric_cast<Index>(p.second);
+                               });
+                m_jac_offset = m_obj_g_cols.size();
+            } else {
+                // Dense gradient: the objfun part is made of the first nx elements.
+                m_jac_offset = m_prob.get_nx();
             }
         }
 
@@ -219,6 +227,18 @@ struct ipopt_nlp final : Ipopt::TNLP {
                                return std::make_pair(boost::numeric_cast<Index>(p.first),
                                                      boost::numeric_cast<Index>(p.second));
                            });
+            // Map each element of the original hessians onto its position in the merged pattern. As the
+            // original patterns are sorted and contained in the merged one, we just need a joint scan.
+            for (const auto &sp : m_h_sp) {
+                m_h_idx.emplace_back();
+                m_h_idx.back().reserve(sp.size());
+                auto it = merged_sp.begin();
+                for (const auto &p : sp) {
+                    it = std::lower_bound(it, merged_sp.end(), p);
+                    assert(it != merged_sp.end() && *it == p);
+                    m_h_idx.back().push_back(static_cast<decltype(m_lag_sp.size())>(it - merged_sp.begin()));
+                }
+            }
         }
     }
 
@@ -342,12 +362,9 @@ struct ipopt_nlp final : Ipopt::TNLP {
     {
         try {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
-            // NOTE: the new_x boolean flag will be false if the last call to any of the eval_* function
-            // used the same x value. Probably we can ignore this in favour of the upcoming caches work.
-            (void)new_x;
 
-            std::copy(x, x + n, m_dv.begin());
-            const auto fitness = m_prob.fitness(m_dv);
+            update_dv(n, x, new_x);
+            const auto &fitness = cur_fitness();
             obj_value = fitness[0];
 
             // Update the log if requested.
@@ -393,24 +410,20 @@ struct ipopt_nlp final : Ipopt::TNLP {
     {
         try {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
-            (void)new_x;
 
-            std::copy(x, x + n, m_dv.begin());
+            update_dv(n, x, new_x);
             // Compute the full gradient (this includes the cosntraints as well).
-            const auto gradient = m_prob.gradient(m_dv);
+            const auto &gradient = cur_gradient();
 
             if (m_prob.has_gradient_sparsity()) {
                 // Sparse gradient case.
-                auto g_it = gradient.begin();
+                assert(gradient.size() >= m_obj_g_cols.size());
 
                 // First we fill the dense output gradient with zeroes.
                 std::fill(grad_f, grad_f + n, 0.);
-                // Then we iterate over the sparsity pattern of the objfun, and fill in the
-                // nonzero bits in grad_f.
-                for (auto it = m_obj_g_sp.begin(); it != m_obj_g_sp.end(); ++it, ++g_it) {
-                    assert(it->first == 0u);
-                    assert(g_it != gradient.end());
-                    grad_f[it->second] = *g_it;
+                // Then we scatter the nonzero bits of the objfun gradient into grad_f.
+                for (decltype(m_obj_g_cols.size()) k = 0; k < m_obj_g_cols.size(); ++k) {
+                    grad_f[m_obj_g_cols[k]] = gradient[k];
                 }
             } else {
                 // Dense gradient.
@@ -430,10 +443,9 @@ struct ipopt_nlp final : Ipopt::TNLP {
         try {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
             assert(m == boost::numeric_cast<Index>(m_prob.get_nc()));
-            (void)new_x;
 
-            std::copy(x, x + n, m_dv.begin());
-            const auto fitness = m_prob.fitness(m_dv);
+            update_dv(n, x, new_x);
+            const auto &fitness = cur_fitness();
 
             // Eq. constraints.
             std::copy(fitness.data() + 1, fitness.data() + 1 + m_prob.get_nec(), g);
@@ -458,16 +470,14 @@ struct ipopt_nlp final : Ipopt::TNLP {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
             assert(m == boost::numeric_cast<Index>(m_prob.get_nc()));
             assert(nele_jac == boost::numeric_cast<Index>(m_jac_sp.size()));
-            (void)new_x;
 
             if (values) {
-                std::copy(x, x + n, m_dv.begin());
-                const auto gradient = m_prob.gradient(m_dv);
+                update_dv(n, x, new_x);
+                const auto &gradient = cur_gradient();
                 // NOTE: here we need the gradients of the constraints only, so we need to discard the gradient of the
-                // objfun. If the gradient sparsity is user-provided, then the size of the objfun sparse gradient is
-                // m_obj_g_sp.size(), otherwise the gradient is dense and its size is nx.
-                std::copy(gradient.data() + (m_prob.has_gradient_sparsity() ? m_obj_g_sp.size() : m_prob.get_nx()),
-                          gradient.data() + gradient.size(), values);
+                // objfun, whose size (m_jac_offset) has been determined upon construction.
+                assert(gradient.size() == m_jac_offset + m_jac_sp.size());
+                std::copy(gradient.data() + m_jac_offset, gradient.data() + gradient.size(), values);
             } else {
                 for (decltype(m_jac_sp.size()) k = 0; k < m_jac_sp.size(); ++k) {
                     iRow[k] = m_jac_sp[k].first;
@@ -492,7 +502,6 @@ struct ipopt_nlp final : Ipopt::TNLP {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
             assert(m == boost::numeric_cast<Index>(m_prob.get_nc()));
             assert(nele_hess == boost::numeric_cast<Index>(m_lag_sp.size()));
-            (void)new_x;
             (void)new_lambda;
 
             if (!m_prob.has_hessians()) {
@@ -505,54 +514,28 @@ struct ipopt_nlp final : Ipopt::TNLP {
             }
 
             if (values) {
-                std::copy(x, x + n, m_dv.begin());
+                update_dv(n, x, new_x);
                 const auto hessians = m_prob.hessians(m_dv);
                 if (m_prob.has_hessians_sparsity()) {
                     // Sparse case.
-                    // Objfun first.
-                    assert(hessians[0].size() <= m_lag_sp.size());
-                    auto it_h_sp = m_h_sp[0].begin();
-                    auto it = hessians[0].begin();
-                    assert(hessians[0].size() == m_h_sp[0].size());
                     // NOTE: the idea here is that we need to fill up values with m_lag_sp.size()
                     // numbers. Some of these numbers will be zero because, in general, our hessians
-                    // may contain fewer elements. In order to establish which elements to take
-                    // from our hessians and which elements to set to zero, we need to iterate at the
-                    // same time on the original sparsity pattern and compare the indices pairs.
-                    for (decltype(m_lag_sp.size()) i = 0; i < m_lag_sp.size(); ++i) {
-                        // NOTE: static_cast is ok as we already converted via numeric_cast
-                        // earlier.
-                        if (it_h_sp != m_h_sp[0].end() && static_cast<Index>(it_h_sp->first) == m_lag_sp[i].first
-                            && static_cast<Index>(it_h_sp->second) == m_lag_sp[i].second) {
-                            // This means that we are at a sparsity entry which is both in our original sparsity
-                            // pattern and in the merged one.
-                            assert(it != hessians[0].end());
-                            values[i] = (*it) * obj_factor;
-                            ++it;
-                            ++it_h_sp;
-                        } else {
-                            // This means we are at a sparsity entry which is in the merged patterns but not in our
-                            // original sparsity pattern. Thus, set the value to zero.
-                            values[i] = 0.;
-                        }
+                    // may contain fewer elements. The position of each element of our hessians
+                    // in the merged pattern has been computed upon construction.
+                    std::fill(values, values + m_lag_sp.size(), 0.);
+                    // Objfun first.
+                    assert(hessians[0].size() == m_h_idx[0].size());
+                    for (decltype(hessians[0].size()) k = 0; k < hessians[0].size(); ++k) {
+                        values[m_h_idx[0][k]] = hessians[0][k] * obj_factor;
                     }
                     // Constraints.
                     for (decltype(hessians.size()) j = 1; j < hessians.size(); ++j) {
-                        assert(hessians[j].size() <= m_lag_sp.size());
-                        it_h_sp = m_h_sp[j].begin();
-                        it = hessians[j].begin();
-                        assert(hessians[j].size() == m_h_sp[j].size());
+                        assert(hessians[j].size() == m_h_idx[j].size());
                         // NOTE: the lambda factors refer to the constraints only, hence we need
-                        // to decrease i by 1.
+                        // to decrease j by 1.
                         const auto lam = lambda[j - 1u];
-                        for (decltype(m_lag_sp.size()) i = 0; i < m_lag_sp.size(); ++i) {
-                            if (it_h_sp != m_h_sp[j].end() && static_cast<Index>(it_h_sp->first) == m_lag_sp[i].first
-                                && static_cast<Index>(it_h_sp->second) == m_lag_sp[i].second) {
-                                assert(it != hessians[j].end());
-                                values[i] += (*it) * lam;
-                                ++it;
-                                ++it_h_sp;
-                            }
+                        for (decltype(hessians[j].size()) k = 0; k < hessians[j].size(); ++k) {
+                            values[m_h_idx[j][k]] += hessians[j][k] * lam;
                         }
                     }
                 } else {
@@ -586,6 +569,37 @@ struct ipopt_nlp final : Ipopt::TNLP {
         }
     }
 
+    // Set the current dv to x. The cached fitness and gradient are invalidated if Ipopt signals that
+    // x is new, or if x differs from the current dv.
+    void update_dv(Index n, const Number *x, bool new_x)
+    {
+        if (new_x || !std::equal(x, x + n, m_dv.begin())) {
+            std::copy(x, x + n, m_dv.begin());
+            m_fit_ok = false;
+            m_grad_ok = false;
+        }
+    }
+
+    // Fitness and gradient at the current dv, computed at most once per point. Ipopt typically
+    // asks for the objfun and the constraints (and for their gradients) at the same point in separate
+    // callbacks.
+    const vector_double &cur_fitness()
+    {
+        if (!m_fit_ok) {
+            m_fit = m_prob.fitness(m_dv);
+            m_fit_ok = true;
+        }
+        return m_fit;
+    }
+    const vector_double &cur_gradient()
+    {
+        if (!m_grad_ok) {
+            m_grad = m_prob.gradient(m_dv);
+            m_grad_ok = true;
+        }
+        return m_grad;
+    }
+
     // Solution Methods.
     // This method is called when the algorithm is complete so the TNLP can store/write the solution.
     // NOTE: no need for try/catch here, nothing can throw.
@@ -626,14 +640,24 @@ struct ipopt_nlp final : Ipopt::TNLP {
     double m_final_objfun;
     // Status at the end of the optimisation.
     SolverReturn m_status;
-    // Sparsity pattern of the gradient of the objfun. We need this for the evaluation
+    // Cached fitness and gradient at m_dv, and their validity flags.
+    vector_double m_fit;
+    vector_double m_grad;
+    bool m_fit_ok = false;
+    bool m_grad_ok = false;
+    // Columns of the sparsity pattern of the gradient of the objfun. We need this for the evaluation
     // of the gradient in eval_grad_f(). If the gradient sparsity is not user-provided,
     // it will be empty.
-    sparsity_pattern m_obj_g_sp;
+    std::vector<Index> m_obj_g_cols;
+    // Position, in the full gradient, of the first element of the constraints' gradients.
+    vector_double::size_type m_jac_offset;
     // The original hessians sp from pagmo. We need this if the hessians sparsity
     // is user-provided, as we must rebuild the hessian of the lagrangian in Ipopt format.
     // If the hessians sparsity is not user-provided, it will be empty.
     std::vector<sparsity_pattern> m_h_sp;
+    // Positions of the elements of the original hessians in the hessian of the lagrangian
+    // (empty if the hessians sparsity is not user-provided).
+    std::vector<std::vector<vector_double::size_type>> m_h_idx;
     // Jacobian sparsity pattern as required by Ipopt: sparse
     // rectangular matrix represented as a list of (Row,Col)
     // pairs.
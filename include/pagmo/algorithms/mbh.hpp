@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_ALGORITHMS_MBH_HPP
 
 #include <algorithm> //std::if_all
+#include <cstddef>
 #include <iomanip>
 #include <random>
 #include <string>
@@ -38,10 +39,12 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/detail/parallel_for.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/type_traits.hpp>
 #include <pagmo/utils/constrained.hpp>
 #include <pagmo/utils/generic.hpp> // pagmo::uniform_real_from_range
@@ -79,6 +82,10 @@ namespace pagmo
  *
  * pagmo::mbh is a user-defined algorithm (UDA) that can be used to construct pagmo::algorithm objects.
  *
+ * Optionally (see mbh::set_n_trials()), several perturbations can be generated and evolved concurrently at each
+ * iteration, the best one being the only candidate for acceptance. This allows to exploit parallel hardware
+ * when the inner algorithm is an expensive local optimizer.
+ *
  * See: https://arxiv.org/pdf/cond-mat/9803344.pdf for the paper introducing the basin hopping idea for a Lennard-Jones
  * cluster optimization.
  */
@@ -99,11 +106,12 @@ public:
      * - inner algorithm: pagmo::compass_search;
      * - consecutive runs of the inner algorithm that need to result in no improvement for pagmo::mbh to stop: 5;
      * - scalar perturbation: 1E-2;
+     * - number of trials per iteration: 1;
      * - seed: random.
      *
      * @throws unspecified any exception thrown by the constructor of pagmo::algorithm.
      */
-    mbh() : m_algorithm(compass_search{}), m_stop(5u), m_perturb(1, 1e-2), m_verbosity(0u)
+    mbh() : m_algorithm(compass_search{}), m_stop(5u), m_perturb(1, 1e-2), m_verbosity(0u), m_n_trials(1u)
     {
         const auto rnd = pagmo::random_device::next();
         m_seed = rnd;
@@ -133,7 +141,8 @@ public:
      */
     template <typename T, ctor_enabler<T> = 0>
     explicit mbh(T &&a, unsigned stop, double perturb, unsigned seed = pagmo::random_device::next())
-        : m_algorithm(std::forward<T>(a)), m_stop(stop), m_perturb(1, perturb), m_e(seed), m_seed(seed), m_verbosity(0u)
+        : m_algorithm(std::forward<T>(a)), m_stop(stop), m_perturb(1, perturb), m_e(seed), m_seed(seed),
+          m_verbosity(0u), m_n_trials(1u)
     {
         if (perturb > 1. || perturb <= 0. || std::isnan(perturb)) {
             pagmo_throw(std::invalid_argument, "The scalar perturbation must be in (0, 1], while a value of "
@@ -165,7 +174,8 @@ public:
      */
     template <typename T, ctor_enabler<T> = 0>
     explicit mbh(T &&a, unsigned stop, vector_double perturb, unsigned seed = pagmo::random_device::next())
-        : m_algorithm(std::forward<T>(a)), m_stop(stop), m_perturb(perturb), m_e(seed), m_seed(seed), m_verbosity(0u)
+        : m_algorithm(std::forward<T>(a)), m_stop(stop), m_perturb(perturb), m_e(seed), m_seed(seed), m_verbosity(0u),
+          m_n_trials(1u)
     {
         if (!std::all_of(perturb.begin(), perturb.end(),
                          [](double item) { return (item > 0. && item <= 1. && !std::isnan(item)); })) {
@@ -230,31 +240,85 @@ public:
 
         // No throws, all valid: we clear the logs
         m_log.clear();
+        // The trials run concurrently only if both the inner algorithm and the problem are thread safe.
+        const bool parallel
+            = static_cast<int>(m_algorithm.get_thread_safety()) >= static_cast<int>(thread_safety::basic)
+              && static_cast<int>(prob.get_thread_safety()) >= static_cast<int>(thread_safety::basic);
+        const auto n_threads = parallel ? detail::parallel_n_threads(0u, m_n_trials) : 1u;
         // mbh main loop
         unsigned i = 0u;
         while (i < m_stop) {
-            // 1 - We make a copy of the current population
-            population pop_old(pop);
-            // 2 - We perturb the current population (NP funevals are made here)
-            for (decltype(NP) j = 0u; j < NP; ++j) {
-                vector_double tmp_x(dim);
-                for (decltype(dim) k = 0u; k < dim; ++k) {
-                    tmp_x[k] = uniform_real_from_range(
-                        std::max(pop.get_x()[j][k] - m_perturb[k] * (ub[k] - lb[k]), lb[k]),
-                        std::min(pop.get_x()[j][k] + m_perturb[k] * (ub[k] - lb[k]), ub[k]), m_e);
+            if (m_n_trials == 1u) {
+                // 1 - We make a copy of the current population
+                population pop_old(pop);
+                // 2 - We perturb the current population (NP funevals are made here)
+                perturb_population(pop, lb, ub, m_e);
+                // 3 - We evolve the current population with the selected algorithm
+                pop = m_algorithm.evolve(pop);
+                i++;
+                // 4 - We reset the counter if we have improved, otherwise we reset the population
+                if (compare_fc(pop.get_f()[pop.best_idx()], pop_old.get_f()[pop_old.best_idx()], nec,
+                               prob.get_c_tol())) {
+                    i = 0u;
+                } else {
+                    for (decltype(NP) j = 0u; j < NP; ++j) {
+                        pop.set_xf(j, pop_old.get_x()[j], pop_old.get_f()[j]);
+                    }
                 }
-                pop.set_x(j, tmp_x); // fitness is evaluated here
-            }
-            // 3 - We evolve the current population with the selected algorithm
-            pop = m_algorithm.evolve(pop);
-            i++;
-            // 4 - We reset the counter if we have improved, otherwise we reset the population
-            if (compare_fc(pop.get_f()[pop.best_idx()], pop_old.get_f()[pop_old.best_idx()], nec, prob.get_c_tol())) {
-                i = 0u;
             } else {
-                for (decltype(NP) j = 0u; j < NP; ++j) {
-                    pop.set_xf(j, pop_old.get_x()[j], pop_old.get_f()[j]);
+                // 1 - We prepare the trials: each one gets its own copy of the population and of the inner
+                // algorithm, and its own seed. Copies and seeds are generated here, sequentially, so that the
+                // outcome does not depend on the number of threads.
+                std::vector<population> trial_pops(m_n_trials, pop);
+                std::vector<algorithm> trial_algos(m_n_trials, m_algorithm);
+                std::vector<unsigned> trial_seeds(m_n_trials);
+                for (auto &s : trial_seeds) {
+                    s = static_cast<unsigned>(m_e());
+                }
+                // 2 - Each trial perturbs its population and evolves it with its inner algorithm
+                detail::parallel_for(m_n_trials, n_threads, [&](std::size_t begin, std::size_t end, unsigned) {
+                    for (auto t = begin; t < end; ++t) {
+                        detail::random_engine_type r_engine(trial_seeds[t]);
+                        if (trial_algos[t].has_set_seed()) {
+                            trial_algos[t].set_seed(static_cast<unsigned>(r_engine()));
+                        }
+                        perturb_population(trial_pops[t], lb, ub, r_engine);
+                        trial_pops[t] = trial_algos[t].evolve(trial_pops[t]);
+                    }
+                });
+                // 3 - We select the best trial (the first one in case of ties) and count the evaluations made
+                const auto fevals_before = prob.get_fevals(), gevals_before = prob.get_gevals(),
+                           hevals_before = prob.get_hevals();
+                unsigned long long fevals = 0u, gevals = 0u, hevals = 0u;
+                decltype(trial_pops.size()) best_trial = 0u;
+                for (decltype(trial_pops.size()) t = 0u; t < trial_pops.size(); ++t) {
+                    const auto &tp = trial_pops[t].get_problem();
+                    fevals += tp.get_fevals() - fevals_before;
+                    gevals += tp.get_gevals() - gevals_before;
+                    hevals += tp.get_hevals() - hevals_before;
+                    if (t > 0u
+                        && compare_fc(trial_pops[t].get_f()[trial_pops[t].best_idx()],
+                                      trial_pops[best_trial].get_f()[trial_pops[best_trial].best_idx()], nec,
+                                      prob.get_c_tol())) {
+                        best_trial = t;
+                    }
                 }
+                i++;
+                // 4 - We accept the best trial and reset the counter if we have improved, otherwise
+                // the current population is left untouched
+                const auto &best_pop = trial_pops[best_trial];
+                if (compare_fc(best_pop.get_f()[best_pop.best_idx()], pop.get_f()[pop.best_idx()], nec,
+                               prob.get_c_tol())) {
+                    i = 0u;
+                    const auto &bp = best_pop.get_problem();
+                    fevals -= bp.get_fevals() - fevals_before;
+                    gevals -= bp.get_gevals() - gevals_before;
+                    hevals -= bp.get_hevals() - hevals_before;
+                    pop = std::move(trial_pops[best_trial]);
+                }
+                pop.get_problem().increment_fevals(fevals);
+                pop.get_problem().increment_gevals(gevals);
+                pop.get_problem().increment_hevals(hevals);
             }
             // 5 - We log to screen
             if (m_verbosity > 0u) {
@@ -368,6 +432,37 @@ public:
         }
         m_perturb = perturb;
     }
+    /// Set the number of concurrent trials.
+    /**
+     * When \p n is larger than one, each iteration of mbh::evolve() generates \p n perturbations of the current
+     * population and evolves each of them with its own copy of the inner algorithm (reseeded, if possible, with
+     * a seed drawn from the internal random number generator). The best of the trials is then accepted if it
+     * improves on the current population. If both the inner algorithm and the problem provide at least
+     * the pagmo::thread_safety::basic guarantee, the trials are run in parallel. The outcome for a given
+     * seed does not depend on the number of threads actually used.
+     *
+     * A value of 1 (the default) recovers the original, sequential, basin hopping.
+     *
+     * @param n the number of trials per iteration.
+     *
+     * @throws std::invalid_argument if \p n is zero.
+     */
+    void set_n_trials(unsigned n)
+    {
+        if (n == 0u) {
+            pagmo_throw(std::invalid_argument, "The number of trials in MBH must be at least 1, while a value of 0 "
+                                               "was detected.");
+        }
+        m_n_trials = n;
+    }
+    /// Get the number of concurrent trials.
+    /**
+     * @return the number of trials generated at each iteration of mbh::evolve().
+     */
+    unsigned get_n_trials() const
+    {
+        return m_n_trials;
+    }
     /// Algorithm's thread safety level.
     /**
      * The thread safety of a meta-algorithm is defined by the thread safety of the interal pagmo::algorithm.
@@ -439,6 +534,7 @@ public:
         stream(ss, "\n\tPerturbation vector: ", m_perturb);
         stream(ss, "\n\tSeed: ", m_seed);
         stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\tTrials: ", m_n_trials);
         stream(ss, "\n\n\tInner algorithm: ", m_algorithm.get_name());
         stream(ss, "\n\tInner algorithm extra info: ");
         stream(ss, "\n", m_algorithm.get_extra_info());
@@ -455,10 +551,26 @@ public:
     template <typename Archive>
     void serialize(Archive &ar)
     {
-        ar(m_algorithm, m_stop, m_perturb, m_e, m_seed, m_verbosity, m_log);
+        ar(m_algorithm, m_stop, m_perturb, m_e, m_seed, m_verbosity, m_log, m_n_trials);
     }
 
 private:
+    // Perturbs all the individuals of pop within m_perturb (relative to the bounds) using the engine r_engine.
+    template <typename Engine>
+    void perturb_population(population &pop, const vector_double &lb, const vector_double &ub, Engine &r_engine) const
+    {
+        const auto dim = lb.size();
+        for (decltype(pop.size()) j = 0u; j < pop.size(); ++j) {
+            vector_double tmp_x(dim);
+            for (decltype(lb.size()) k = 0u; k < dim; ++k) {
+                tmp_x[k] = uniform_real_from_range(std::max(pop.get_x()[j][k] - m_perturb[k] * (ub[k] - lb[k]), lb[k]),
+                                                   std::min(pop.get_x()[j][k] + m_perturb[k] * (ub[k] - lb[k]), ub[k]),
+                                                   r_engine);
+            }
+            pop.set_x(j, tmp_x); // fitness is evaluated here
+        }
+    }
+
     algorithm m_algorithm;
     unsigned m_stop;
     // The member m_perturb is mutable as to allow to construct mbh also using a perturbation defined as a scalar
@@ -472,6 +584,7 @@ private:
     unsigned m_seed;
     unsigned m_verbosity;
     mutable log_type m_log;
+    unsigned m_n_trials;
 };
 }
 
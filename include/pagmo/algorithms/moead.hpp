@@ -37,6 +37,8 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 
 #include <pagmo/algorithm.hpp> // needed for the cereal macro
+#include <pagmo/bfe.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -113,7 +115,7 @@ public:
           unsigned int seed = pagmo::random_device::next())
         : m_gen(gen), m_weight_generation(weight_generation), m_decomposition(decomposition), m_neighbours(neighbours),
           m_CR(CR), m_F(F), m_eta_m(eta_m), m_realb(realb), m_limit(limit), m_preserve_diversity(preserve_diversity),
-          m_e(seed), m_seed(seed), m_verbosity(0u), m_log()
+          m_e(seed), m_seed(seed), m_verbosity(0u), m_log(), m_batch_size(1u), m_bfe(1u), m_knn_threads(1u)
     {
         // Sanity checks
         if (m_weight_generation != "random" && m_weight_generation != "grid"
@@ -217,15 +219,25 @@ public:
                           // Declaring the candidate chromosome
         vector_double candidate(dim);
         // We compute, for each vector of weights, the k = m_neighbours neighbours
-        auto neigh_idxs = kNN(weights, m_neighbours);
+        auto neigh_idxs = kNN(weights, m_neighbours, m_knn_threads);
         // We compute the initial ideal point (will be adapted along the course of the algorithm)
         vector_double ideal_point = ideal(pop.get_f());
         // We create the container that will represent a pseudo-random permutation of the population indexes 1..NP
         std::vector<population::size_type> shuffle(NP);
         std::iota(shuffle.begin(), shuffle.end(), std::vector<population::size_type>::size_type(0u));
+        // The candidates of a block of subproblems (and their fitnesses) are stored contiguously in XB (FB),
+        // together with the choice of the mating pool made for each of them
+        const auto batch_size = std::min(m_batch_size, NP);
+        const auto nf = prob.get_nf();
+        vector_double XB(batch_size * dim), FB(batch_size * nf), new_f(nf);
+        std::vector<bool> whole_population(batch_size);
 
         // Main MOEA/D loop --------------------------------------------------------------------------------------------
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                return pop;
+            }
             // 0 - Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
             if (m_verbosity > 0u) {
                 // Every m_verbosity generations print a log line
@@ -262,82 +274,93 @@ public:
             }
             // 1 - Shuffle the population indexes
             std::shuffle(shuffle.begin(), shuffle.end(), m_e);
-            // 2 - Loop over the shuffled NP decomposed problems
-            for (auto n : shuffle) {
-                // 3 - if the diversity preservation mechanism is active we select at random whether to consider the
-                // whole
-                // population or just a neighbourhood to select two parents
-                bool whole_population;
-                if (drng(m_e) < m_realb || !m_preserve_diversity) {
-                    whole_population = false; // neighborhood
-                } else {
-                    whole_population = true; // whole population
-                }
-                // 4 - We select two parents in the neighbourhood
-                std::vector<population::size_type> parents_idx(2);
-                parents_idx = select_parents(n, neigh_idxs, whole_population);
-                // 5 - Crossover using the Differential Evolution operator (binomial crossover)
-                for (decltype(dim) kk = 0u; kk < dim; ++kk) {
-                    if (drng(m_e) < m_CR) {
-                        /*Selected Two Parents*/
-                        candidate[kk] = pop.get_x()[n][kk]
-                                        + m_F * (pop.get_x()[parents_idx[0]][kk] - pop.get_x()[parents_idx[1]][kk]);
-                        // Fix the bounds
-                        if (candidate[kk] < lb[kk]) {
-                            candidate[kk] = lb[kk] + drng(m_e) * (pop.get_x()[n][kk] - lb[kk]);
-                        }
-                        if (candidate[kk] > ub[kk]) {
-                            candidate[kk] = ub[kk] - drng(m_e) * (ub[kk] - pop.get_x()[n][kk]);
-                        }
+            // 2 - Loop over the shuffled NP decomposed problems, in blocks of batch_size subproblems
+            for (decltype(NP) b_begin = 0u; b_begin < NP; b_begin += batch_size) {
+                const auto b_end = std::min(b_begin + batch_size, NP);
+                // The candidates of all the subproblems in the block are generated first, from the
+                // current population.
+                XB.resize((b_end - b_begin) * dim);
+                for (auto i = b_begin; i < b_end; ++i) {
+                    const auto n = shuffle[i];
+                    // 3 - if the diversity preservation mechanism is active we select at random whether to consider
+                    // the whole population or just a neighbourhood to select two parents
+                    if (drng(m_e) < m_realb || !m_preserve_diversity) {
+                        whole_population[i - b_begin] = false; // neighborhood
                     } else {
-                        candidate[kk] = pop.get_x()[n][kk];
+                        whole_population[i - b_begin] = true; // whole population
                     }
+                    // 4 - We select two parents in the neighbourhood
+                    std::vector<population::size_type> parents_idx(2);
+                    parents_idx = select_parents(n, neigh_idxs, whole_population[i - b_begin]);
+                    // 5 - Crossover using the Differential Evolution operator (binomial crossover)
+                    for (decltype(dim) kk = 0u; kk < dim; ++kk) {
+                        if (drng(m_e) < m_CR) {
+                            /*Selected Two Parents*/
+                            candidate[kk]
+                                = pop.get_x()[n][kk]
+                                  + m_F * (pop.get_x()[parents_idx[0]][kk] - pop.get_x()[parents_idx[1]][kk]);
+                            // Fix the bounds
+                            if (candidate[kk] < lb[kk]) {
+                                candidate[kk] = lb[kk] + drng(m_e) * (pop.get_x()[n][kk] - lb[kk]);
+                            }
+                            if (candidate[kk] > ub[kk]) {
+                                candidate[kk] = ub[kk] - drng(m_e) * (ub[kk] - pop.get_x()[n][kk]);
+                            }
+                        } else {
+                            candidate[kk] = pop.get_x()[n][kk];
+                        }
+                    }
+                    // 6 - We apply a further mutation using polynomial mutation
+                    polynomial_mutation(candidate, pop, 1.0 / static_cast<double>(dim));
+                    std::copy(candidate.begin(), candidate.end(), XB.data() + (i - b_begin) * dim);
                 }
-                // 6 - We apply a further mutation using polynomial mutation
-                polynomial_mutation(candidate, pop, 1.0 / static_cast<double>(dim));
-                // 7- We evaluate the fitness function.
-                auto new_f = prob.fitness(candidate);
-                // 8 - We update the ideal point
-                for (decltype(prob.get_nf()) j = 0u; j < prob.get_nf(); ++j) {
-                    ideal_point[j] = std::min(new_f[j], ideal_point[j]);
-                }
-                std::transform(ideal_point.begin(), ideal_point.end(), new_f.begin(), ideal_point.begin(),
-                               [](double a, double b) { return std::min(a, b); });
-                // 9 - We insert the newly found solution into the population
-                decltype(NP) size, time = 0;
-                // First try on problem n
-                auto f1 = decompose_objectives(pop.get_f()[n], weights[n], ideal_point, m_decomposition);
-                auto f2 = decompose_objectives(new_f, weights[n], ideal_point, m_decomposition);
-                if (f2[0] < f1[0]) {
-                    pop.set_xf(n, candidate, new_f);
-                    time++;
-                }
-                // Then, on neighbouring problems up to m_limit (to preserve diversity)
-                if (whole_population) {
-                    size = NP;
-                } else {
-                    size = neigh_idxs[n].size();
-                }
-                std::vector<population::size_type> shuffle2(size);
-                std::iota(shuffle2.begin(), shuffle2.end(), std::vector<population::size_type>::size_type(0u));
-                std::shuffle(shuffle2.begin(), shuffle2.end(), m_e);
-                for (decltype(size) k = 0u; k < size; ++k) {
-                    population::size_type pick;
-                    if (whole_population) {
-                        pick = shuffle2[k];
-                    } else {
-                        pick = neigh_idxs[n][shuffle2[k]];
+                // 7- We evaluate the fitness function of all the candidates of the block (as a single batch).
+                m_bfe.eval(prob, XB, FB);
+                // The subproblems in the block are then updated, in order
+                for (auto i = b_begin; i < b_end; ++i) {
+                    const auto n = shuffle[i];
+                    candidate.assign(XB.data() + (i - b_begin) * dim, XB.data() + (i - b_begin + 1u) * dim);
+                    new_f.assign(FB.data() + (i - b_begin) * nf, FB.data() + (i - b_begin + 1u) * nf);
+                    // 8 - We update the ideal point
+                    for (decltype(prob.get_nf()) j = 0u; j < prob.get_nf(); ++j) {
+                        ideal_point[j] = std::min(new_f[j], ideal_point[j]);
                     }
-                    f1 = decompose_objectives(pop.get_f()[pick], weights[pick], ideal_point, m_decomposition);
-                    f2 = decompose_objectives(new_f, weights[pick], ideal_point, m_decomposition);
+                    // 9 - We insert the newly found solution into the population
+                    decltype(NP) size, time = 0;
+                    // First try on problem n
+                    auto f1 = decompose_objectives(pop.get_f()[n], weights[n], ideal_point, m_decomposition);
+                    auto f2 = decompose_objectives(new_f, weights[n], ideal_point, m_decomposition);
                     if (f2[0] < f1[0]) {
-                        pop.set_xf(pick, candidate, new_f);
+                        pop.set_xf(n, candidate, new_f);
                         time++;
                     }
-                    // the maximal number of solutions updated is not allowed to exceed 'limit' if diversity is to be
-                    // preserved
-                    if (time >= m_limit && m_preserve_diversity) {
-                        break;
+                    // Then, on neighbouring problems up to m_limit (to preserve diversity)
+                    if (whole_population[i - b_begin]) {
+                        size = NP;
+                    } else {
+                        size = neigh_idxs[n].size();
+                    }
+                    std::vector<population::size_type> shuffle2(size);
+                    std::iota(shuffle2.begin(), shuffle2.end(), std::vector<population::size_type>::size_type(0u));
+                    std::shuffle(shuffle2.begin(), shuffle2.end(), m_e);
+                    for (decltype(size) k = 0u; k < size; ++k) {
+                        population::size_type pick;
+                        if (whole_population[i - b_begin]) {
+                            pick = shuffle2[k];
+                        } else {
+                            pick = neigh_idxs[n][shuffle2[k]];
+                        }
+                        f1 = decompose_objectives(pop.get_f()[pick], weights[pick], ideal_point, m_decomposition);
+                        f2 = decompose_objectives(new_f, weights[pick], ideal_point, m_decomposition);
+                        if (f2[0] < f1[0]) {
+                            pop.set_xf(pick, candidate, new_f);
+                            time++;
+                        }
+                        // the maximal number of solutions updated is not allowed to exceed 'limit' if diversity is to
+                        // be preserved
+                        if (time >= m_limit && m_preserve_diversity) {
+                            break;
+                        }
                     }
                 }
             }
@@ -409,6 +432,76 @@ public:
     {
         return m_gen;
     }
+    /// Sets the batch size
+    /**
+     * By default (batch size 1) each subproblem is updated as soon as its candidate has been evaluated, which makes
+     * the algorithm strictly sequential. With a batch size \p n larger than one, the algorithm runs synchronously on
+     * blocks of \p n subproblems (taken in the shuffled order of each generation): the candidates for all the
+     * subproblems in a block are generated first from the current population, they are then evaluated together by
+     * the batch fitness evaluator (see moead::set_bfe()) and, finally, the neighbourhood updates are applied one
+     * candidate at a time, in the order of generation. Batch sizes larger than the population size
+     * are equivalent to the population size. For a given seed, the evolution depends on the batch size,
+     * but not on the number of threads used by the batch fitness evaluator.
+     *
+     * @param n the number of subproblems in a block
+     *
+     * @throws std::invalid_argument if \p n is zero
+     */
+    void set_batch_size(population::size_type n)
+    {
+        if (n == 0u) {
+            pagmo_throw(std::invalid_argument, "The batch size for MOEA/D must be at least 1, while a value of 0 was "
+                                               "detected");
+        }
+        m_batch_size = n;
+    }
+    /// Gets the batch size
+    /**
+     * @return the number of subproblems whose candidates are evaluated together
+     */
+    population::size_type get_batch_size() const
+    {
+        return m_batch_size;
+    }
+    /// Sets the batch fitness evaluator
+    /**
+     * The batch fitness evaluator \p b (see pagmo::bfe) is used to evaluate the candidates of a block of
+     * subproblems (see moead::set_batch_size()). By default a sequential evaluator is used.
+     *
+     * @param b the batch fitness evaluator
+     */
+    void set_bfe(const bfe &b)
+    {
+        m_bfe = b;
+    }
+    /// Gets the batch fitness evaluator
+    /**
+     * @return a const reference to the batch fitness evaluator
+     */
+    const bfe &get_bfe() const
+    {
+        return m_bfe;
+    }
+    /// Sets the number of threads used to compute the neighbourhoods
+    /**
+     * The neighbourhoods of the subproblems are computed once per call to moead::evolve() via pagmo::kNN(),
+     * which can split the work among \p n threads (0 selects the number of hardware threads). This is
+     * worthwhile only for large populations, and the neighbourhoods do not depend on the number of threads.
+     *
+     * @param n the number of threads
+     */
+    void set_knn_threads(unsigned n)
+    {
+        m_knn_threads = n;
+    }
+    /// Gets the number of threads used to compute the neighbourhoods
+    /**
+     * @return the number of threads passed to pagmo::kNN()
+     */
+    unsigned get_knn_threads() const
+    {
+        return m_knn_threads;
+    }
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -438,6 +531,9 @@ public:
         stream(ss, "\n\tChance for diversity preservation: ", m_realb);
         stream(ss, "\n\tSeed: ", m_seed);
         stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\tBatch size: ", m_batch_size);
+        stream(ss, "\n\tFitness evaluation: ", m_bfe.get_name());
+        stream(ss, "\n\tNeighbourhood threads: ", m_knn_threads);
         return ss.str();
     }
     /// Get log
@@ -464,7 +560,7 @@ public:
     void serialize(Archive &ar)
     {
         ar(m_gen, m_weight_generation, m_decomposition, m_neighbours, m_CR, m_F, m_eta_m, m_realb, m_limit,
-           m_preserve_diversity, m_e, m_seed, m_verbosity, m_log);
+           m_preserve_diversity, m_e, m_seed, m_verbosity, m_log, m_batch_size, m_bfe, m_knn_threads);
     }
 
 private:
@@ -551,6 +647,9 @@ private:
     unsigned int m_seed;
     unsigned int m_verbosity;
     mutable log_type m_log;
+    population::size_type m_batch_size;
+    bfe m_bfe;
+    unsigned m_knn_threads;
 };
 
 } // namespace pagmo
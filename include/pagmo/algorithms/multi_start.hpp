@@ -0,0 +1,410 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ALGORITHMS_MULTI_START_HPP
+#define PAGMO_ALGORITHMS_MULTI_START_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/detail/parallel_for.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/rng.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/constrained.hpp>
+
+namespace pagmo
+{
+
+/// Parallel multi-start local refinement.
+/**
+ * Local solvers such as pagmo::nlopt, pagmo::ipopt or pagmo::compass_search optimise, at each call
+ * of their <tt>evolve()</tt> method, a single individual selected from the input population. Polishing
+ * the best \f$K\f$ individuals of a population thus requires \f$K\f$ sequential calls.
+ *
+ * pagmo::multi_start is a meta-algorithm that, given any inner (local) algorithm, refines the best \f$K\f$
+ * individuals of the input population (ranked via pagmo::sort_population_con(), thus taking constraints into
+ * account) independently of each other. Each start is a population containing only the selected individual,
+ * evolved by its own copy of the inner algorithm on its own copy of the problem. The result of each start
+ * replaces, in the original population, the individual it originated from if it is better according to
+ * pagmo::compare_fc(). The pseudo code is:
+ * @code{.unparsed}
+ * > Rank the population and select the best K individuals
+ * > for each selected individual (concurrently)
+ * > > Create a population containing only the individual
+ * > > Evolve it using a copy of the inner algorithm
+ * > for each selected individual (in rank order)
+ * > > if the refined individual is better, replace the original one
+ * @endcode
+ *
+ * If both the inner algorithm and the problem provide at least the pagmo::thread_safety::basic guarantee,
+ * the starts are run in parallel. Each copy of the inner algorithm is reseeded (if possible) with a seed drawn
+ * from the internal random number generator before the starts are run, so that, for a given seed, the outcome
+ * does not depend on the number of threads actually used. All the fitness, gradient and hessians evaluations
+ * performed by the starts are accounted for in the problem of the returned population.
+ *
+ * pagmo::multi_start is a user-defined algorithm (UDA) that can be used to construct pagmo::algorithm objects.
+ */
+class multi_start
+{
+    // Enabler for the ctor from UDA or algorithm. In this case we allow construction from type algorithm.
+    template <typename T>
+    using ctor_enabler = enable_if_t<std::is_constructible<algorithm, T &&>::value, int>;
+
+public:
+    /// Single entry of the log (start, index, initial objective, final objective, fevals).
+    typedef std::tuple<unsigned, population::size_type, double, double, unsigned long long> log_line_type;
+    /// The log.
+    typedef std::vector<log_line_type> log_type;
+    /// Default constructor.
+    /**
+     * The default constructor will initialize the algorithm with the following parameters:
+     * - inner algorithm: pagmo::compass_search;
+     * - number of starts: 1;
+     * - seed: random.
+     *
+     * @throws unspecified any exception thrown by the constructor of pagmo::algorithm.
+     */
+    multi_start() : m_algorithm(compass_search{}), m_n_starts(1u), m_verbosity(0u)
+    {
+        const auto rnd = pagmo::random_device::next();
+        m_seed = rnd;
+        m_e.seed(rnd);
+    }
+    /// Constructor.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    This constructor is enabled only if ``T`` can be used to construct a :cpp:class:`pagmo::algorithm`.
+     *
+     * \endverbatim
+     *
+     * @param a a user-defined algorithm (UDA) or a pagmo::algorithm that will be used to construct the inner algorithm.
+     * @param n_starts the number of individuals refined at each call of multi_start::evolve().
+     * @param seed seed used by the internal random number generator (default is random).
+     *
+     * @throws unspecified any exception thrown by the constructor of pagmo::algorithm.
+     * @throws std::invalid_argument if \p n_starts is zero.
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit multi_start(T &&a, unsigned n_starts, unsigned seed = pagmo::random_device::next())
+        : m_algorithm(std::forward<T>(a)), m_n_starts(n_starts), m_e(seed), m_seed(seed), m_verbosity(0u)
+    {
+        if (n_starts == 0u) {
+            pagmo_throw(std::invalid_argument, "The number of starts in " + get_name()
+                                                   + " must be at least 1, while a value of 0 was detected.");
+        }
+    }
+    /// Evolve method.
+    /**
+     * This method will refine the best multi_start::get_n_starts() individuals of \p pop (or all of them, if the
+     * population is smaller) using copies of the inner algorithm.
+     *
+     * @param pop population to be evolved.
+     *
+     * @return evolved population.
+     *
+     * @throws std::invalid_argument if the problem is multi-objective or stochastic.
+     * @throws unspecified any exception thrown by the inner algorithm, by the copy of pagmo::population and
+     * pagmo::algorithm, or by threading primitives.
+     */
+    population evolve(population pop) const
+    {
+        const auto &prob = pop.get_problem();
+        const auto nec = prob.get_nec();
+        const auto c_tol = prob.get_c_tol();
+        const auto fevals0 = prob.get_fevals(), gevals0 = prob.get_gevals(), hevals0 = prob.get_hevals();
+
+        // PREAMBLE-------------------------------------------------------------------------------------------------
+        if (prob.get_nobj() != 1u) {
+            pagmo_throw(std::invalid_argument, "Multiple objectives detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.is_stochastic()) {
+            pagmo_throw(std::invalid_argument, "The input problem " + prob.get_name() + " appears to be stochastic, "
+                                                   + get_name() + " cannot deal with it");
+        }
+        // ---------------------------------------------------------------------------------------------------------
+
+        // No throws, all valid: we clear the logs
+        m_log.clear();
+        // Get out if there is nothing to do.
+        const auto K = static_cast<population::size_type>(std::min<unsigned long long>(m_n_starts, pop.size()));
+        if (K == 0u) {
+            return pop;
+        }
+        // 1 - We select the best K individuals and prepare the starts: each one gets its own single-individual
+        // population (thus its own copy of the problem), its own copy of the inner algorithm and its own seed.
+        // Everything is done here, sequentially, so that the outcome does not depend on the number of threads.
+        auto idx = sort_population_con(pop.get_f(), nec, c_tol);
+        idx.resize(static_cast<decltype(idx.size())>(K));
+        std::vector<population> start_pops;
+        start_pops.reserve(static_cast<decltype(start_pops.size())>(K));
+        std::vector<algorithm> start_algos(static_cast<decltype(start_pops.size())>(K), m_algorithm);
+        for (decltype(idx.size()) s = 0u; s < idx.size(); ++s) {
+            start_pops.emplace_back(prob, 0u, static_cast<unsigned>(m_e()));
+            start_pops.back().push_back(pop.get_x()[idx[s]], pop.get_f()[idx[s]]);
+            if (start_algos[s].has_set_seed()) {
+                start_algos[s].set_seed(static_cast<unsigned>(m_e()));
+            }
+        }
+        // 2 - The starts are run concurrently only if both the inner algorithm and the problem are thread safe.
+        const bool parallel
+            = static_cast<int>(m_algorithm.get_thread_safety()) >= static_cast<int>(thread_safety::basic)
+              && static_cast<int>(prob.get_thread_safety()) >= static_cast<int>(thread_safety::basic);
+        const auto n_threads = parallel ? detail::parallel_n_threads(0u, idx.size()) : 1u;
+        detail::parallel_for(idx.size(), n_threads, [&](std::size_t begin, std::size_t end, unsigned) {
+            for (auto s = begin; s < end; ++s) {
+                start_pops[s] = start_algos[s].evolve(start_pops[s]);
+            }
+        });
+        // 3 - We merge back the improvements (in rank order) and account for the evaluations made
+        unsigned long long fevals = 0u, gevals = 0u, hevals = 0u;
+        for (decltype(idx.size()) s = 0u; s < idx.size(); ++s) {
+            const auto &sp = start_pops[s];
+            const auto &sprob = sp.get_problem();
+            const auto s_fevals = sprob.get_fevals() - fevals0;
+            fevals += s_fevals;
+            gevals += sprob.get_gevals() - gevals0;
+            hevals += sprob.get_hevals() - hevals0;
+            const double f_initial = pop.get_f()[idx[s]][0];
+            if (sp.size() > 0u) {
+                const auto best = sp.best_idx();
+                if (compare_fc(sp.get_f()[best], pop.get_f()[idx[s]], nec, c_tol)) {
+                    pop.set_xf(idx[s], sp.get_x()[best], sp.get_f()[best]);
+                }
+            }
+            if (m_verbosity > 0u) {
+                m_log.emplace_back(static_cast<unsigned>(s), idx[s], f_initial, pop.get_f()[idx[s]][0], s_fevals);
+            }
+        }
+        pop.get_problem().increment_fevals(fevals);
+        pop.get_problem().increment_gevals(gevals);
+        pop.get_problem().increment_hevals(hevals);
+        // 4 - We log to screen
+        if (m_verbosity > 0u) {
+            print("\n", std::setw(7), "Start:", std::setw(15), "Index:", std::setw(15), "Initial:", std::setw(15),
+                  "Final:", std::setw(15), "Fevals:", '\n');
+            for (const auto &l : m_log) {
+                print(std::setw(7), std::get<0>(l), std::setw(15), std::get<1>(l), std::setw(15), std::get<2>(l),
+                      std::setw(15), std::get<3>(l), std::setw(15), std::get<4>(l), '\n');
+            }
+            std::cout << std::flush;
+        }
+        return pop;
+    }
+    /// Set the seed.
+    /**
+     * @param seed the seed controlling the algorithm's stochastic behaviour.
+     */
+    void set_seed(unsigned seed)
+    {
+        m_e.seed(seed);
+        m_seed = seed;
+    }
+    /// Get the seed.
+    /**
+     * @return the seed controlling the algorithm's stochastic behaviour.
+     */
+    unsigned get_seed() const
+    {
+        return m_seed;
+    }
+    /// Set the algorithm verbosity.
+    /**
+     * This method will sets the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity,
+     * - >0: will print and log one line per start at the end of each call to multi_start::evolve().
+     *
+     * Example (verbosity 1):
+     * @code
+     * Start:         Index:       Initial:         Final:        Fevals:
+     *      0              3        1094.35     0.00145062            912
+     *      1              7        1571.13    0.000402583           1033
+     *      2              0        3382.51     0.00391846            866
+     * @endcode
+     * \p Start is the start number, \p Index is the index in the population of the refined individual,
+     * \p Initial and \p Final are its objective function before and after the refinement, and \p Fevals
+     * is the number of fitness evaluations made by the start.
+     *
+     * @param level verbosity level.
+     */
+    void set_verbosity(unsigned level)
+    {
+        m_verbosity = level;
+    }
+    /// Get the verbosity level.
+    /**
+     * @return the verbosity level.
+     */
+    unsigned get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Set the number of starts.
+    /**
+     * @param n the number of individuals refined at each call of multi_start::evolve().
+     *
+     * @throws std::invalid_argument if \p n is zero.
+     */
+    void set_n_starts(unsigned n)
+    {
+        if (n == 0u) {
+            pagmo_throw(std::invalid_argument, "The number of starts in " + get_name()
+                                                   + " must be at least 1, while a value of 0 was detected.");
+        }
+        m_n_starts = n;
+    }
+    /// Get the number of starts.
+    /**
+     * @return the number of individuals refined at each call of multi_start::evolve().
+     */
+    unsigned get_n_starts() const
+    {
+        return m_n_starts;
+    }
+    /// Algorithm's thread safety level.
+    /**
+     * The thread safety of a meta-algorithm is defined by the thread safety of the interal pagmo::algorithm.
+     *
+     * @return the thread safety level of the interal pagmo::algorithm.
+     */
+    thread_safety get_thread_safety() const
+    {
+        return m_algorithm.get_thread_safety();
+    }
+    /// Getter for the inner algorithm.
+    /**
+     * Returns a const reference to the inner pagmo::algorithm.
+     *
+     * @return a const reference to the inner pagmo::algorithm.
+     */
+    const algorithm &get_inner_algorithm() const
+    {
+        return m_algorithm;
+    }
+    /// Getter for the inner algorithm.
+    /**
+     * Returns a reference to the inner pagmo::algorithm.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     * .. warning::
+     *
+     *    The ability to extract a non const reference is provided only in order to allow to call
+     *    non-const methods on the internal :cpp:class:`pagmo::algorithm` instance. Assigning a new
+     *    :cpp:class:`pagmo::algorithm` via this reference is undefined behaviour.
+     *
+     * \endverbatim
+     *
+     * @return a reference to the inner pagmo::algorithm.
+     */
+    algorithm &get_inner_algorithm()
+    {
+        return m_algorithm;
+    }
+    /// Get log.
+    /**
+     * A log containing relevant quantities monitoring the last call to multi_start::evolve(). Each element of the
+     * returned <tt>std::vector</tt> is a multi_start::log_line_type containing: \p Start, \p Index, \p Initial,
+     * \p Final and \p Fevals as described in multi_start::set_verbosity().
+     *
+     * @return an <tt>std::vector</tt> of multi_start::log_line_type containing the logged values Start, Index,
+     * Initial, Final and Fevals.
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+    /// Algorithm name.
+    /**
+     * @return a string containing the algorithm name.
+     */
+    std::string get_name() const
+    {
+        return "Multi-start: parallel local refinement";
+    }
+    /// Extra informations.
+    /**
+     * @return a string containing extra informations on the algorithm.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream ss;
+        stream(ss, "\tStarts: ", m_n_starts);
+        stream(ss, "\n\tSeed: ", m_seed);
+        stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\n\tInner algorithm: ", m_algorithm.get_name());
+        stream(ss, "\n\tInner algorithm extra info: ");
+        stream(ss, "\n", m_algorithm.get_extra_info());
+        return ss.str();
+    }
+    /// Object serialization.
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the inner algorithm and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_algorithm, m_n_starts, m_e, m_seed, m_verbosity, m_log);
+    }
+
+private:
+    algorithm m_algorithm;
+    unsigned m_n_starts;
+    mutable detail::random_engine_type m_e;
+    unsigned m_seed;
+    unsigned m_verbosity;
+    mutable log_type m_log;
+};
+}
+
+PAGMO_REGISTER_ALGORITHM(pagmo::multi_start)
+
+#endif
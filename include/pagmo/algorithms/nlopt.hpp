@@ -357,6 +357,39 @@ struct nlopt_obj {
         }
     }
 
+    // Set the current decision vector to the dim values starting at x. If the decision
+    // vector changes, the cached fitness and gradient are invalidated.
+    void update_dv(unsigned dim, const double *x)
+    {
+        if (!std::equal(x, x + dim, m_dv.begin())) {
+            std::copy(x, x + dim, m_dv.begin());
+            m_has_fitness = false;
+            m_has_gradient = false;
+        }
+    }
+    // Fitness and gradient at the current decision vector. They are computed on first request
+    // and then served from the cache, until the decision vector changes.
+    const vector_double &cur_fitness()
+    {
+        if (m_has_fitness) {
+            ++m_saved_fevals;
+        } else {
+            m_fitness = m_prob.fitness(m_dv);
+            m_has_fitness = true;
+        }
+        return m_fitness;
+    }
+    const vector_double &cur_gradient()
+    {
+        if (m_has_gradient) {
+            ++m_saved_gevals;
+        } else {
+            m_gradient = m_prob.gradient(m_dv);
+            m_has_gradient = true;
+        }
+        return m_gradient;
+    }
+
     // Delete all other ctors/assignment ops.
     nlopt_obj(const nlopt_obj &) = delete;
     nlopt_obj(nlopt_obj &&) = delete;
@@ -372,6 +405,16 @@ struct nlopt_obj {
     unsigned m_verbosity;
     unsigned long m_objfun_counter = 0;
     log_type m_log;
+    // Cache of the fitness and of the gradient at m_dv. NLopt calls the objective function and
+    // the constraints separately, usually at the same point, while in pagmo a single fitness (gradient)
+    // evaluation yields them all.
+    vector_double m_fitness;
+    vector_double m_gradient;
+    bool m_has_fitness = false;
+    bool m_has_gradient = false;
+    // Number of fitness/gradient evaluations avoided thanks to the cache.
+    unsigned long long m_saved_fevals = 0;
+    unsigned long long m_saved_gevals = 0;
     // This exception pointer will be null, unless
     // an error is raised during the computation of the objfun
     // or constraints. If not null, it will be re-thrown
@@ -392,14 +435,13 @@ inline double nlopt_objfun_wrapper(unsigned dim, const double *x, double *grad,
     try {
         // A few shortcuts.
         auto &p = nlo.m_prob;
-        auto &dv = nlo.m_dv;
         const auto verb = nlo.m_verbosity;
         auto &f_count = nlo.m_objfun_counter;
         auto &log = nlo.m_log;
 
         // A couple of sanity checks.
         assert(dim == p.get_nx());
-        assert(dv.size() == dim);
+        assert(nlo.m_dv.size() == dim);
 
         if (grad && !p.has_gradient()) {
             // If grad is not null, it means we are in an algorithm
@@ -413,15 +455,15 @@ inline double nlopt_objfun_wrapper(unsigned dim, const double *x, double *grad,
         }
 
         // Copy the decision vector in our temporary dv vector_double,
-        // for use in the pagmo API.
-        std::copy(x, x + dim, dv.begin());
+        // for use in the pagmo API (this invalidates the cache if x changed).
+        nlo.update_dv(dim, x);
 
-        // Compute fitness.
-        const auto fitness = p.fitness(dv);
+        // Compute fitness (or fetch it from the cache).
+        const auto &fitness = nlo.cur_fitness();
 
         // Compute gradient, if needed.
         if (grad) {
-            const auto gradient = p.gradient(dv);
+            const auto &gradient = nlo.cur_gradient();
 
             if (p.has_gradient_sparsity()) {
                 // Sparse gradient case.
@@ -500,11 +542,10 @@ inline void nlopt_ineq_c_wrapper(unsigned m, double *result, unsigned dim, const
     try {
         // A few shortcuts.
         auto &p = nlo.m_prob;
-        auto &dv = nlo.m_dv;
 
         // A couple of sanity checks.
         assert(dim == p.get_nx());
-        assert(dv.size() == dim);
+        assert(nlo.m_dv.size() == dim);
         assert(m == p.get_nic());
 
         if (grad && !p.has_gradient()) {
@@ -520,17 +561,17 @@ inline void nlopt_ineq_c_wrapper(unsigned m, double *result, unsigned dim, const
         }
 
         // Copy the decision vector in our temporary dv vector_double,
-        // for use in the pagmo API.
-        std::copy(x, x + dim, dv.begin());
+        // for use in the pagmo API (this invalidates the cache if x changed).
+        nlo.update_dv(dim, x);
 
-        // Compute fitness and write IC to the output.
+        // Compute fitness (or fetch it from the cache) and write IC to the output.
         // NOTE: fitness is nobj + nec + nic.
-        const auto fitness = p.fitness(dv);
+        const auto &fitness = nlo.cur_fitness();
         nlopt_obj::unchecked_copy(p.get_nic(), fitness.data() + 1 + p.get_nec(), result);
 
         if (grad) {
             // Handle gradient, if requested.
-            const auto gradient = p.gradient(dv);
+            const auto &gradient = nlo.cur_gradient();
 
             if (p.has_gradient_sparsity()) {
                 // Sparse gradient.
@@ -588,11 +629,10 @@ inline void nlopt_eq_c_wrapper(unsigned m, double *result, unsigned dim, const d
     try {
         // A few shortcuts.
         auto &p = nlo.m_prob;
-        auto &dv = nlo.m_dv;
 
         // A couple of sanity checks.
         assert(dim == p.get_nx());
-        assert(dv.size() == dim);
+        assert(nlo.m_dv.size() == dim);
         assert(m == p.get_nec());
 
         if (grad && !p.has_gradient()) {
@@ -607,17 +647,17 @@ inline void nlopt_eq_c_wrapper(unsigned m, double *result, unsigned dim, const d
         }
 
         // Copy the decision vector in our temporary dv vector_double,
-        // for use in the pagmo API.
-        std::copy(x, x + dim, dv.begin());
+        // for use in the pagmo API (this invalidates the cache if x changed).
+        nlo.update_dv(dim, x);
 
-        // Compute fitness and write EC to the output.
+        // Compute fitness (or fetch it from the cache) and write EC to the output.
         // NOTE: fitness is nobj + nec + nic.
-        const auto fitness = p.fitness(dv);
+        const auto &fitness = nlo.cur_fitness();
         nlopt_obj::unchecked_copy(p.get_nec(), fitness.data() + 1, result);
 
         if (grad) {
             // Handle gradient, if requested.
-            const auto gradient = p.gradient(dv);
+            const auto &gradient = nlo.cur_gradient();
 
             if (p.has_gradient_sparsity()) {
                 // Sparse gradient case.
@@ -848,7 +888,8 @@ public:
           m_sc_stopval(other.m_sc_stopval), m_sc_ftol_rel(other.m_sc_ftol_rel), m_sc_ftol_abs(other.m_sc_ftol_abs),
           m_sc_xtol_rel(other.m_sc_xtol_rel), m_sc_xtol_abs(other.m_sc_xtol_abs), m_sc_maxeval(other.m_sc_maxeval),
           m_sc_maxtime(other.m_sc_maxtime), m_verbosity(other.m_verbosity), m_log(other.m_log),
-          m_loc_opt(other.m_loc_opt ? detail::make_unique<nlopt>(*other.m_loc_opt) : nullptr)
+          m_loc_opt(other.m_loc_opt ? detail::make_unique<nlopt>(*other.m_loc_opt) : nullptr),
+          m_last_saved_fevals(other.m_last_saved_fevals), m_last_saved_gevals(other.m_last_saved_gevals)
     {
     }
     /// Move constructor.
@@ -941,11 +982,17 @@ public:
 
         // Handle any exception that might've been thrown.
         if (no.m_eptr) {
+            m_last_saved_fevals = no.m_saved_fevals;
+            m_last_saved_gevals = no.m_saved_gevals;
             std::rethrow_exception(no.m_eptr);
         }
 
-        // Compute the new fitness vector.
-        const auto new_f = prob.fitness(initial_guess);
+        // Compute the new fitness vector. If the final point is the last one that was
+        // evaluated, the fitness comes from the cache.
+        no.update_dv(static_cast<unsigned>(initial_guess.size()), initial_guess.data());
+        const auto new_f = no.cur_fitness();
+        m_last_saved_fevals = no.m_saved_fevals;
+        m_last_saved_gevals = no.m_saved_gevals;
 
         // Store the new individual into the population, but only if better.
         if (compare_fc(new_f, old_f, prob.get_nec(), prob.get_c_tol())) {
@@ -1059,6 +1106,30 @@ public:
     {
         return m_last_opt_result;
     }
+    /// Get the number of fitness evaluations saved in the last optimisation.
+    /**
+     * During an optimisation, the fitness and the gradient of the problem at the last point requested by the
+     * NLopt solver are cached, so that the objective function and the equality and inequality constraints
+     * (which NLopt queries separately, usually at the same point) are all computed from a single evaluation.
+     * This method returns the number of fitness evaluations that were avoided thanks to this cache in the last
+     * evolve() call.
+     *
+     * @return the number of fitness evaluations avoided in the last optimisation.
+     */
+    unsigned long long get_last_saved_fevals() const
+    {
+        return m_last_saved_fevals;
+    }
+    /// Get the number of gradient evaluations saved in the last optimisation.
+    /**
+     * See get_last_saved_fevals().
+     *
+     * @return the number of gradient evaluations avoided in the last optimisation.
+     */
+    unsigned long long get_last_saved_gevals() const
+    {
+        return m_last_saved_gevals;
+    }
     /// Get the ``stopval`` stopping criterion.
     /**
      * The ``stopval`` stopping criterion instructs the solver to stop when an objective value less than
@@ -1306,7 +1377,8 @@ public:
     void save(Archive &ar) const
     {
         ar(cereal::base_class<not_population_based>(this), m_algo, m_last_opt_result, m_sc_stopval, m_sc_ftol_rel,
-           m_sc_ftol_abs, m_sc_xtol_rel, m_sc_xtol_abs, m_sc_maxeval, m_sc_maxtime, m_verbosity, m_log, m_loc_opt);
+           m_sc_ftol_abs, m_sc_xtol_rel, m_sc_xtol_abs, m_sc_maxeval, m_sc_maxtime, m_verbosity, m_log, m_loc_opt,
+           m_last_saved_fevals, m_last_saved_gevals);
     }
     /// Load from archive.
     /**
@@ -1322,7 +1394,8 @@ public:
     {
         try {
             ar(cereal::base_class<not_population_based>(this), m_algo, m_last_opt_result, m_sc_stopval, m_sc_ftol_rel,
-               m_sc_ftol_abs, m_sc_xtol_rel, m_sc_xtol_abs, m_sc_maxeval, m_sc_maxtime, m_verbosity, m_log, m_loc_opt);
+               m_sc_ftol_abs, m_sc_xtol_rel, m_sc_xtol_abs, m_sc_maxeval, m_sc_maxtime, m_verbosity, m_log, m_loc_opt,
+               m_last_saved_fevals, m_last_saved_gevals);
         } catch (...) {
             *this = nlopt{};
             throw;
@@ -1345,6 +1418,9 @@ private:
     mutable log_type m_log;
     // Local/subsidiary optimizer.
     std::unique_ptr<nlopt> m_loc_opt;
+    // Evaluations avoided by the cache in the last optimisation.
+    mutable unsigned long long m_last_saved_fevals = 0;
+    mutable unsigned long long m_last_saved_gevals = 0;
 };
 }
 
@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_ALGORITHMS_NSGA2_HPP
 
 #include <algorithm> // std::shuffle, std::transform
+#include <cstddef>
 #include <iomanip>
 #include <numeric> // std::iota, std::inner_product
 #include <random>
@@ -37,6 +38,8 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 
 #include <pagmo/algorithm.hpp> // needed for the cereal macro
+#include <pagmo/bfe.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -88,7 +91,7 @@ public:
     nsga2(unsigned gen = 1u, double cr = 0.95, double eta_c = 10., double m = 0.01, double eta_m = 50.,
           unsigned seed = pagmo::random_device::next())
         : m_gen(gen), m_cr(cr), m_eta_c(eta_c), m_m(m), m_eta_m(eta_m), m_e(seed), m_seed(seed), m_verbosity(0u),
-          m_log()
+          m_log(), m_bfe(1u)
     {
         if (cr >= 1. || cr < 0.) {
             pagmo_throw(std::invalid_argument, "The crossover probability must be in the [0,1[ range, while a value of "
@@ -163,12 +166,26 @@ public:
         std::vector<vector_double::size_type> best_idx(NP), shuffle1(NP), shuffle2(NP);
         vector_double::size_type parent1_idx, parent2_idx;
         vector_double child1(dim), child2(dim);
+        // The offspring of a generation are stored contiguously in XOFF and evaluated in a single batch into FOFF.
+        // The merged parents + offspring set (parents first) is kept in XALL and FALL. All these buffers
+        // are reused across generations.
+        const auto nf = prob.get_nf();
+        vector_double XOFF(NP * dim), FOFF(NP * nf), XALL(2u * NP * dim), tmp_x(dim);
+        std::vector<vector_double> FALL(2u * NP, vector_double(nf));
+        // Workspace of the non dominated sorting and of the crowding distances, and crowding distances
+        // of the whole population, also reused across generations.
+        mo_workspace ws;
+        vector_double pop_cd(NP);
 
         std::iota(shuffle1.begin(), shuffle1.end(), 0u);
         std::iota(shuffle2.begin(), shuffle2.end(), 0u);
 
         // Main NSGA-II loop
         for (decltype(m_gen) gen = 1u; gen <= m_gen; gen++) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                return pop;
+            }
             // 0 - Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
             if (m_verbosity > 0u) {
                 // Every m_verbosity generations print a log line
@@ -201,35 +218,23 @@ public:
                 }
             }
 
-            // At each generation we make a copy of the population into popnew
-            population popnew(pop);
-
             // We create some pseudo-random permutation of the poulation indexes
             std::shuffle(shuffle1.begin(), shuffle1.end(), m_e);
             std::shuffle(shuffle2.begin(), shuffle2.end(), m_e);
 
             // 1 - We compute crowding distance and non dominated rank for the current population
-            auto fnds_res = fast_non_dominated_sorting(pop.get_f());
-            auto ndf = std::get<0>(fnds_res); // non dominated fronts [[0,3,2],[1,5,6],[4],...]
-            vector_double pop_cd(NP);         // crowding distances of the whole population
-            auto ndr = std::get<3>(fnds_res); // non domination rank [0,1,0,0,2,1,1, ... ]
-            for (const auto &front_idxs : ndf) {
-                if (front_idxs.size() == 1u) { // handles the case where the front has collapsed to one point
-                    pop_cd[front_idxs[0]] = std::numeric_limits<double>::infinity();
-                } else {
-                    if (front_idxs.size() == 2u) { // handles the case where the front has collapsed to one point
-                        pop_cd[front_idxs[0]] = std::numeric_limits<double>::infinity();
-                        pop_cd[front_idxs[1]] = std::numeric_limits<double>::infinity();
-                    } else {
-                        std::vector<vector_double> front;
-                        for (auto idx : front_idxs) {
-                            front.push_back(pop.get_f()[idx]);
-                        }
-                        auto cd = crowding_distance(front);
-                        for (decltype(cd.size()) i = 0u; i < cd.size(); ++i) {
-                            pop_cd[front_idxs[i]] = cd[i];
-                        }
+            fast_non_dominated_sorting(pop.get_f(), ws);
+            const auto &ndr = ws.non_dom_rank; // non domination rank [0,1,0,0,2,1,1, ... ]
+            for (decltype(ws.n_fronts()) f = 0u; f < ws.n_fronts(); ++f) {
+                // The f-th non dominated front is a span of ws.fronts.
+                const auto b = ws.fronts.cbegin() + static_cast<std::ptrdiff_t>(ws.front_begin[f]),
+                           e = ws.fronts.cbegin() + static_cast<std::ptrdiff_t>(ws.front_begin[f + 1u]);
+                if (e - b <= 2) { // handles the case where the front has collapsed to one or two points
+                    for (auto it = b; it != e; ++it) {
+                        pop_cd[*it] = std::numeric_limits<double>::infinity();
                     }
+                } else {
+                    crowding_distance(pop.get_f(), b, e, pop_cd, ws.tmp);
                 }
             }
 
@@ -242,12 +247,8 @@ public:
                 crossover(child1, child2, parent1_idx, parent2_idx, pop);
                 mutate(child1, pop);
                 mutate(child2, pop);
-                // we use prob to evaluate the fitness so
-                // that its feval counter is correctly updated
-                auto f1 = prob.fitness(child1);
-                auto f2 = prob.fitness(child2);
-                popnew.push_back(child1, f1);
-                popnew.push_back(child2, f2);
+                std::copy(child1.begin(), child1.end(), XOFF.data() + i * dim);
+                std::copy(child2.begin(), child2.end(), XOFF.data() + (i + 1u) * dim);
 
                 // We repeat with the shuffled list 2
                 parent1_idx = tournament_selection(shuffle2[i], shuffle2[i + 1], ndr, pop_cd);
@@ -255,20 +256,29 @@ public:
                 crossover(child1, child2, parent1_idx, parent2_idx, pop);
                 mutate(child1, pop);
                 mutate(child2, pop);
-                // we use prob to evaluate the fitness so
-                // that its feval counter is correctly updated
-                f1 = prob.fitness(child1);
-                f2 = prob.fitness(child2);
-                popnew.push_back(child1, f1);
-                popnew.push_back(child2, f2);
-            } // popnew now contains 2NP individuals
+                std::copy(child1.begin(), child1.end(), XOFF.data() + (i + 2u) * dim);
+                std::copy(child2.begin(), child2.end(), XOFF.data() + (i + 3u) * dim);
+            } // XOFF now contains NP offspring
+
+            // 4 - We evaluate all the offspring in a single batch. We use prob to evaluate the fitness so
+            // that its feval counter is correctly updated
+            m_bfe.eval(prob, XOFF, FOFF);
+
+            // 5 - We assemble the 2NP individuals made of parents and offspring
+            for (decltype(NP) i = 0u; i < NP; ++i) {
+                std::copy(pop.get_x()[i].begin(), pop.get_x()[i].end(), XALL.data() + i * dim);
+                std::copy(XOFF.data() + i * dim, XOFF.data() + (i + 1u) * dim, XALL.data() + (NP + i) * dim);
+                std::copy(pop.get_f()[i].begin(), pop.get_f()[i].end(), FALL[i].begin());
+                std::copy(FOFF.data() + i * nf, FOFF.data() + (i + 1u) * nf, FALL[NP + i].begin());
+            }
 
             // This method returns the sorted N best individuals in the population according to the crowded comparison
             // operator
-            best_idx = select_best_N_mo(popnew.get_f(), NP);
+            select_best_N_mo(FALL, NP, ws, best_idx);
             // We insert into the population
             for (population::size_type i = 0; i < NP; ++i) {
-                pop.set_xf(i, popnew.get_x()[best_idx[i]], popnew.get_f()[best_idx[i]]);
+                tmp_x.assign(XALL.data() + best_idx[i] * dim, XALL.data() + (best_idx[i] + 1u) * dim);
+                pop.set_xf(i, tmp_x, FALL[best_idx[i]]);
             }
         } // end of main NSGAII loop
         return pop;
@@ -328,6 +338,26 @@ public:
     {
         return m_verbosity;
     }
+    /// Sets the batch fitness evaluator
+    /**
+     * The offspring of each generation are evaluated with a single call to the batch fitness evaluator \p b,
+     * which can distribute the evaluations over multiple threads (see pagmo::bfe). By default
+     * a sequential evaluator is used. The evolution does not depend on the evaluator used.
+     *
+     * @param b the batch fitness evaluator
+     */
+    void set_bfe(const bfe &b)
+    {
+        m_bfe = b;
+    }
+    /// Gets the batch fitness evaluator
+    /**
+     * @return a const reference to the batch fitness evaluator
+     */
+    const bfe &get_bfe() const
+    {
+        return m_bfe;
+    }
     /// Algorithm name
     /**
      * Returns the name of the algorithm.
@@ -354,6 +384,7 @@ public:
         stream(ss, "\n\tDistribution index for mutation: ", m_eta_m);
         stream(ss, "\n\tSeed: ", m_seed);
         stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\tFitness evaluation: ", m_bfe.get_name());
         return ss.str();
     }
     /// Get log
@@ -379,7 +410,7 @@ public:
     template <typename Archive>
     void serialize(Archive &ar)
     {
-        ar(m_gen, m_cr, m_eta_c, m_m, m_eta_m, m_e, m_seed, m_verbosity, m_log);
+        ar(m_gen, m_cr, m_eta_c, m_m, m_eta_m, m_e, m_seed, m_verbosity, m_log, m_bfe);
     }
 
 private:
@@ -406,8 +437,8 @@ private:
         const auto &lb = bounds.first;
         const auto &ub = bounds.second;
         // Parents decision vectors
-        vector_double parent1 = pop.get_x()[parent1_idx];
-        vector_double parent2 = pop.get_x()[parent2_idx];
+        const auto &parent1 = pop.get_x()[parent1_idx];
+        const auto &parent2 = pop.get_x()[parent2_idx];
         // declarations
         double y1, y2, yl, yu, rand01, beta, alpha, betaq, c1, c2;
         vector_double::size_type site1, site2;
@@ -554,6 +585,7 @@ private:
     unsigned int m_seed;
     unsigned int m_verbosity;
     mutable log_type m_log;
+    bfe m_bfe;
 };
 
 } // namespace pagmo
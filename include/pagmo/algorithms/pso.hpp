@@ -38,6 +38,7 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -327,6 +328,16 @@ public:
          */
         // For each generation
         for (decltype(m_max_gen) gen = 1u; gen <= m_max_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                if (m_verbosity) {
+                    std::cout << "Exit condition -- evolution stopped" << std::endl;
+                }
+                for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
+                    pop.set_xf(i, lbX[i], lbfit[i]);
+                }
+                return pop;
+            }
             best_fit_improved = false;
             // For each particle in the swarm
             for (decltype(swarm_size) p = 0u; p < swarm_size; ++p) {
@@ -29,15 +29,22 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_ALGORITHMS_PSO_GEN_HPP
 #define PAGMO_ALGORITHMS_PSO_GEN_HPP
 
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
+#include <deque>
 #include <iomanip>
+#include <numeric>
 #include <random>
 #include <string>
 #include <tuple>
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/bfe.hpp>
+#include <pagmo/detail/async_eval.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -137,7 +144,7 @@ public:
             bool memory = false, unsigned int seed = pagmo::random_device::next())
         : m_max_gen(gen), m_omega(omega), m_eta1(eta1), m_eta2(eta2), m_max_vel(max_vel), m_variant(variant),
           m_neighb_type(neighb_type), m_neighb_param(neighb_param), m_memory(memory), m_V(), m_e(seed), m_seed(seed),
-          m_verbosity(0u), m_log()
+          m_verbosity(0u), m_log(), m_bfe(1u), m_steady_state(0u)
     {
         if (m_omega < 0. || m_omega > 1.) {
             // variants using Inertia weight
@@ -175,6 +182,8 @@ public:
      * @param pop population to be evolved
      * @return evolved population
      * @throws std::invalid_argument if the problem is multi-objective or constrained
+     * @throws std::invalid_argument if the problem is stochastic and the steady-state mode is selected
+     * @throws unspecified any exception thrown by the evaluation of the particles in the steady-state mode
      */
     population evolve(population pop) const
     {
@@ -201,23 +210,26 @@ public:
         if (!pop.size()) {
             pagmo_throw(std::invalid_argument, get_name() + " does not work on an empty population");
         }
+        if (m_steady_state && prob.is_stochastic()) {
+            pagmo_throw(std::invalid_argument, "The problem appears to be stochastic, the steady-state mode of "
+                                                   + get_name() + " cannot deal with it");
+        }
         // ---------------------------------------------------------------------------------------------------------
         // No throws, all valid: we clear the logs
         m_log.clear();
 
         auto swarm_size = pop.size();
         // Some vectors used are allocated here.
-        vector_double dummy(dim, 0.); // used for initialisation purposes
-
-        std::vector<vector_double> X(swarm_size, dummy); // particles' current positions
-        std::vector<vector_double> fit(swarm_size);      // particles' current fitness values
+        // NOTE: positions and velocities are stored contiguously, one particle after the other.
+        vector_double X(swarm_size * dim); // particles' current positions
+        vector_double fit(swarm_size);     // particles' current fitness values
 
-        std::vector<vector_double> lbX(swarm_size, dummy); // particles' previous best positions
-        std::vector<vector_double> lbfit(swarm_size);      // particles' fitness values at their previous best positions
+        vector_double lbX(swarm_size * dim); // particles' previous best positions
+        vector_double lbfit(swarm_size);     // particles' fitness values at their previous best positions
 
         // swarm topology (iterators over indexes of each particle's neighbors in the swarm)
         std::vector<std::vector<decltype(swarm_size)>> neighb(swarm_size);
-        // search space position of particles' best neighbor
+        // search space position of particles' best neighbor (tracked only when using topologies 1 or 4)
         vector_double best_neighb(dim, 0.);
         // fitness at the best found search space position (tracked only when using topologies 1 or 4)
         vector_double best_fit;
@@ -227,7 +239,6 @@ public:
         vector_double minv(dim), maxv(dim); // Maximum and minimum velocity allowed
 
         double vwidth; // Temporary variable
-        double new_x;  // Temporary variable
 
         std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
         std::uniform_int_distribution<unsigned int> urng;
@@ -241,19 +252,18 @@ public:
 
         // Copy the particle positions and their fitness
         for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
-            X[i] = pop.get_x()[i];
-            lbX[i] = pop.get_x()[i];
-
-            fit[i] = pop.get_f()[i];
-            lbfit[i] = pop.get_f()[i];
+            std::copy(pop.get_x()[i].begin(), pop.get_x()[i].end(), X.data() + i * dim);
+            fit[i] = pop.get_f()[i][0];
         }
+        lbX = X;
+        lbfit = fit;
 
         // Initialize the particle velocities if necessary
-        if ((m_V.size() != swarm_size) || (!m_memory)) {
-            m_V = std::vector<vector_double>(swarm_size, dummy);
+        if ((m_V.size() != swarm_size * dim) || (!m_memory)) {
+            m_V.resize(swarm_size * dim);
             for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
                 for (decltype(dim) j = 0u; j < dim; ++j) {
-                    m_V[i][j] = uniform_real_from_range(minv[j], maxv[j], m_e);
+                    m_V[i * dim + j] = uniform_real_from_range(minv[j], maxv[j], m_e);
                 }
             }
         }
@@ -275,177 +285,125 @@ public:
             default:
                 initialize_topology__lbest(neighb);
         }
-        // auxiliary variables specific to the Fully Informed Particle Swarm variant
-        double acceleration_coefficient = m_eta1 + m_eta2;
-        double sum_forces;
-
-        double r1 = 0.;
-        double r2 = 0.;
 
-        /* --- Main PSO loop ---
-         */
-        // For each generation
-        for (decltype(m_max_gen) gen = 1u; gen <= m_max_gen; ++gen) {
-
-            // 1st iteration: velocity update
-            for (decltype(swarm_size) p = 0u; p < swarm_size; ++p) {
+        // Steady-state mode (see set_steady_state()): each particle is moved, using the information available
+        // at that time, as soon as the evaluation of its previous position completes.
+        if (m_steady_state) {
+            const auto n_moves = static_cast<unsigned long long>(m_max_gen) * swarm_size;
+            unsigned long long n_submitted = 0u, n_done = 0u;
+            // The particles waiting to be moved, in order.
+            std::deque<decltype(swarm_size)> idle(swarm_size);
+            std::iota(idle.begin(), idle.end(), decltype(swarm_size)(0u));
+            detail::async_eval_pool eval_pool(prob, m_steady_state);
+            auto move_particle = [&]() {
+                const auto p = idle.front();
+                idle.pop_front();
+                particle__update_velocity(p, X, lbX, lbfit, neighb, best_neighb, drng);
+                particle__update_position(p, X, minv, maxv, lb, ub);
+                eval_pool.submit(p, vector_double(X.data() + p * dim, X.data() + (p + 1u) * dim));
+                ++n_submitted;
+            };
+            const auto n_in_flight = std::min(
+                static_cast<unsigned long long>(std::min<decltype(swarm_size)>(m_steady_state, swarm_size)), n_moves);
+            for (auto k = 0ull; k < n_in_flight; ++k) {
+                move_particle();
+            }
 
-                // identify the current particle's best neighbour
-                // . not needed if m_neighb_type == 1 (gbest): best_neighb directly tracked in this function
-                // . not needed if m_variant == 6 (FIPS): all neighbours are considered, no need to identify the best
-                // one
-                if (m_neighb_type != 1u && m_variant != 6u)
-                    best_neighb = particle__get_best_neighbor(p, neighb, lbX, lbfit);
-
-                /*-------PSO canonical (with inertia weight) ---------------------------------------------*/
-                /*-------Original algorithm used in the first PaGMO paper (~2007) ------------------------*/
-                if (m_variant == 1u) {
-                    for (decltype(dim) d = 0u; d < dim; ++d) {
-                        r1 = drng(m_e);
-                        r2 = drng(m_e);
-                        m_V[p][d] = m_omega * m_V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d])
-                                    + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
+            best_fit_improved = false;
+            std::size_t p;
+            vector_double new_x, new_f;
+            while (eval_pool.n_pending()) {
+                eval_pool.next(p, new_x, new_f);
+                ++n_done;
+                fit[p] = new_f[0];
+                // We update the particle memory if a better point has been reached
+                if (fit[p] <= lbfit[p]) {
+                    lbfit[p] = fit[p];
+                    std::copy(new_x.begin(), new_x.end(), lbX.data() + p * dim);
+                    if ((m_neighb_type == 1u || m_neighb_type == 4u) && (fit[p] <= best_fit[0])) {
+                        best_neighb = new_x;
+                        best_fit[0] = fit[p];
+                        best_fit_improved = true;
                     }
                 }
-
-                /*-------PSO canonical (with inertia weight) ---------------------------------------------*/
-                /*-------and with equal random weights of social and cognitive components-----------------*/
-                /*-------Check with Rastrigin-------------------------------------------------------------*/
-                else if (m_variant == 2u) {
-                    for (decltype(dim) d = 0u; d < dim; ++d) {
-                        r1 = drng(m_e);
-                        m_V[p][d] = m_omega * m_V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d])
-                                    + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
+                idle.push_back(p);
+                // Stop if requested by the island running the evolution.
+                if (evolve_stop_requested(prob)) {
+                    eval_pool.finish();
+                    if (m_verbosity) {
+                        std::cout << "Exit condition -- evolution stopped" << std::endl;
                     }
+                    break;
                 }
-
-                /*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
-                /*-------Same random number for all components------------------------------------------*/
-                else if (m_variant == 3u) {
-                    r1 = drng(m_e);
-                    r2 = drng(m_e);
-                    for (decltype(dim) d = 0u; d < dim; ++d) {
-                        m_V[p][d] = m_omega * m_V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d])
-                                    + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
+                // Every swarm_size completed evaluations we rewire the topology and log, as
+                // done at the end of each generation in the generational mode.
+                if (n_done % swarm_size == 0u) {
+                    const auto gen = static_cast<decltype(m_max_gen)>(n_done / swarm_size);
+                    if (m_neighb_type == 4u && !best_fit_improved) initialize_topology__adaptive_random(neighb);
+                    best_fit_improved = false;
+                    if (m_verbosity > 0u && (gen % m_verbosity == 1u || m_verbosity == 1u)) {
+                        log_swarm(gen, prob.get_fevals() - fevals0, X, lbfit, lb, ub, count);
                     }
                 }
-
-                /*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
-                /*-------Same random number for all components------------------------------------------*/
-                /*-------and with equal random weights of social and cognitive components---------------*/
-                else if (m_variant == 4u) {
-                    r1 = drng(m_e);
-                    for (decltype(dim) d = 0u; d < dim; ++d) {
-                        m_V[p][d] = m_omega * m_V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d])
-                                    + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
-                    }
+                if (n_submitted < n_moves) {
+                    move_particle();
                 }
+            }
+            if (m_verbosity && n_done == n_moves) {
+                std::cout << "Exit condition -- generations = " << m_max_gen << std::endl;
+            }
+            for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
+                pop.set_xf(i, vector_double(lbX.data() + i * dim, lbX.data() + (i + 1u) * dim), {lbfit[i]});
+            }
+            return pop;
+        }
 
-                /*-------PSO variant with constriction coefficients------------------------------------*/
-                /*  ''Clerc's analysis of the iterative system led him to propose a strategy for the
-                 *  placement of "constriction coefficients" on the terms of the formulas; these
-                 *  coefficients controlled the convergence of the particle and allowed an elegant and
-                 *  well-explained method for preventing explosion, ensuring convergence, and
-                 *  eliminating the arbitrary Vmax parameter. The analysis also takes the guesswork
-                 *  out of setting the values of phi_1 and phi_2.''
-                 *  ''this is the canonical particle swarm algorithm of today.''
-                 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
-                 *  [Clerc and Kennedy, 2002] http://dx.doi.org/10.1109/4235.985692
-                 *
-                 *  This being the canonical PSO of today, this variant is set as the default in PaGMO.
-                 *-------------------------------------------------------------------------------------*/
-                else if (m_variant == 5u) {
-                    for (decltype(dim) d = 0u; d < dim; ++d) {
-                        r1 = drng(m_e);
-                        r2 = drng(m_e);
-                        m_V[p][d] = m_omega
-                                    * (m_V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d])
-                                       + m_eta2 * r2 * (best_neighb[d] - X[p][d]));
-                    }
+        /* --- Main PSO loop ---
+         */
+        // For each generation
+        for (decltype(m_max_gen) gen = 1u; gen <= m_max_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                if (m_verbosity) {
+                    std::cout << "Exit condition -- evolution stopped" << std::endl;
                 }
-
-                /*-------Fully Informed Particle Swarm-------------------------------------------------*/
-                /*  ''Whereas in the traditional algorithm each particle is affected by its own
-                 *  previous performance and the single best success found in its neighborhood, in
-                 *  Mendes' fully informed particle swarm (FIPS), the particle is affected by all its
-                 *  neighbors, sometimes with no influence from its own previous success.''
-                 *  ''With good parameters, FIPS appears to find better solutions in fewer iterations
-                 *  than the canonical algorithm, but it is much more dependent on the population topology.''
-                 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
-                 *  [Mendes et al., 2004] http://dx.doi.org/10.1109/TEVC.2004.826074
-                 *-------------------------------------------------------------------------------------*/
-                else if (m_variant == 6u) {
-                    for (decltype(dim) d = 0u; d < dim; ++d) {
-                        sum_forces = 0.;
-                        for (decltype(neighb[p].size()) n = 0u; n < neighb[p].size(); ++n) {
-                            sum_forces += drng(m_e) * acceleration_coefficient * (lbX[neighb[p][n]][d] - X[p][d]);
-                        }
-                        m_V[p][d] = m_omega * (m_V[p][d] + sum_forces / static_cast<double>(neighb[p].size()));
-                    }
+                for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
+                    pop.set_xf(i, vector_double(lbX.data() + i * dim, lbX.data() + (i + 1u) * dim), {lbfit[i]});
                 }
+                return pop;
             }
 
-            // 2nd iteration: position update
+            // 1st iteration: velocity update
             for (decltype(swarm_size) p = 0u; p < swarm_size; ++p) {
+                particle__update_velocity(p, X, lbX, lbfit, neighb, best_neighb, drng);
+            }
 
-                // We now check that the velocity does not exceed the maximum allowed per component
-                // and we perform the position update and the feasibility correction
-                for (decltype(dim) d = 0u; d < dim; ++d) {
-
-                    if (m_V[p][d] > maxv[d]) {
-                        m_V[p][d] = maxv[d];
-                    }
-
-                    else if (m_V[p][d] < minv[d]) {
-                        m_V[p][d] = minv[d];
-                    }
-
-                    // update position
-                    new_x = X[p][d] + m_V[p][d];
-
-                    // feasibility correction
-                    // (velocity updated to that which would have taken the previous position
-                    // to the newly corrected feasible position)
-                    if (new_x < lb[d]) {
-                        new_x = lb[d];
-                        m_V[p][d] = 0.;
-                        //					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-                        //					V[p][d] = new_x - X[p][d];
-                    } else if (new_x > ub[d]) {
-                        new_x = ub[d];
-                        m_V[p][d] = 0.;
-                        //					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-                        //					V[p][d] = new_x - X[p][d];
-                    }
-                    X[p][d] = new_x;
-                }
-            } // End of 2nd iteration
+            // 2nd iteration: position update
+            for (decltype(swarm_size) p = 0u; p < swarm_size; ++p) {
+                particle__update_position(p, X, minv, maxv, lb, ub);
+            }
 
             if (prob.is_stochastic()) {
                 pop.get_problem().set_seed(urng(m_e));
                 // re-evaluate the whole population w.r.t. the new seed
 
-                for (decltype(swarm_size) p = 0u; p < swarm_size; ++p) {
-                    // We evaluate here the new individual fitness
-                    fit[p] = prob.fitness(X[p]);
-                    // We re-evaluate the fitness of the particle memory
-                    lbfit[p] = prob.fitness(lbX[p]);
-                }
+                // We evaluate here the new individual fitness
+                m_bfe.eval(prob, X, fit);
+                // We re-evaluate the fitness of the particle memory
+                m_bfe.eval(prob, lbX, lbfit);
 
-                best_fit = fit[0];
-                best_neighb = X[0];
+                best_fit.assign(1u, fit[0]);
+                best_neighb.assign(X.begin(), X.begin() + static_cast<std::ptrdiff_t>(dim));
 
                 for (decltype(swarm_size) p = 1; p < swarm_size; p++) {
-                    if (fit[p] < best_fit) {
-                        best_fit = fit[p];
-                        best_neighb = X[p];
+                    if (fit[p] < best_fit[0]) {
+                        best_fit[0] = fit[p];
+                        std::copy(X.data() + p * dim, X.data() + (p + 1u) * dim, best_neighb.begin());
                     }
                 }
             } else {
-                for (decltype(swarm_size) p = 0; p < swarm_size; p++) {
-                    // We evaluate here the new individual fitness
-                    fit[p] = prob.fitness(X[p]);
-                }
+                // We evaluate here the new individual fitness
+                m_bfe.eval(prob, X, fit);
             }
 
             // We update the particles memory if a better point has been reached
@@ -455,12 +413,12 @@ public:
                 if (fit[p] <= lbfit[p]) {
                     // update the particle's previous best position
                     lbfit[p] = fit[p];
-                    lbX[p] = X[p];
+                    std::copy(X.data() + p * dim, X.data() + (p + 1u) * dim, lbX.data() + p * dim);
                     // update the best position observed so far by any particle in the swarm
                     // (only performed if swarm topology is gbest)
-                    if ((m_neighb_type == 1u || m_neighb_type == 4u) && (fit[p] <= best_fit)) {
-                        best_neighb = X[p];
-                        best_fit = fit[p];
+                    if ((m_neighb_type == 1u || m_neighb_type == 4u) && (fit[p] <= best_fit[0])) {
+                        std::copy(X.data() + p * dim, X.data() + (p + 1u) * dim, best_neighb.begin());
+                        best_fit[0] = fit[p];
                         best_fit_improved = true;
                     }
                 }
@@ -472,58 +430,7 @@ public:
             if (m_verbosity > 0u) {
                 // Every m_verbosity generations print a log line
                 if (gen % m_verbosity == 1u || m_verbosity == 1u) {
-                    // We compute the number of fitness evaluations made
-                    auto feval_count = prob.get_fevals() - fevals0;
-                    // We compute the average across the swarm of the best fitness encountered
-                    vector_double local_fits(swarm_size);
-                    for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
-                        local_fits[i] = lbfit[i][0];
-                    }
-                    auto lb_avg = std::accumulate(local_fits.begin(), local_fits.end(), 0.)
-                                  / static_cast<double>(local_fits.size());
-                    // We compute the best fitness encounterd so far across generations and across the swarm
-                    // TODO: distance returns a signed type that can be overflown by the local_fits::size_type
-                    auto idx_best = std::distance(std::begin(local_fits),
-                                                  std::min_element(std::begin(local_fits), std::end(local_fits)));
-                    auto best = local_fits[static_cast<vector_double::size_type>(idx_best)];
-                    // We compute a measure for the average particle velocity across the swarm
-                    auto mean_velocity = 0.;
-                    for (decltype(m_V.size()) i = 0u; i < m_V.size(); ++i) {
-                        for (decltype(m_V[i].size()) j = 0u; j < m_V[i].size(); ++j) {
-                            if (ub[j] > lb[j]) {
-                                mean_velocity += std::abs(m_V[i][j] / (ub[j] - lb[j]));
-                            } // else 0
-                        }
-                        mean_velocity /= static_cast<double>(m_V[i].size());
-                    }
-                    // We compute the average distance across particles (NOTE: N^2 complexity)
-                    auto avg_dist = 0.;
-                    for (decltype(X.size()) i = 0u; i < X.size(); ++i) {
-                        for (decltype(X.size()) j = i + 1u; j < X.size(); ++j) {
-                            auto x1 = X[i];
-                            auto x2 = X[j];
-                            double acc = 0.;
-                            for (decltype(x1.size()) k = 0u; k < x1.size(); ++k) {
-                                if (ub[j] > lb[j]) {
-                                    acc += (x1[k] - x2[k]) * (x1[k] - x2[k]) / (ub[k] - lb[k]) / (ub[k] - lb[k]);
-                                } // else 0
-                            }
-                            avg_dist += std::sqrt(acc);
-                        }
-                    }
-                    avg_dist /= ((static_cast<double>(X.size()) - 1u) * static_cast<double>(X.size())) / 2.;
-                    // We start printing
-                    // Every 50 lines print the column names
-                    if (count % 50u == 1u) {
-                        print("\n", std::setw(7), "Gen:", std::setw(15), "Fevals:", std::setw(15),
-                              "gbest:", std::setw(15), "Mean Vel.:", std::setw(15), "Mean lbest:", std::setw(15),
-                              "Avg. Dist.:", '\n');
-                    }
-                    print(std::setw(7), gen, std::setw(15), feval_count, std::setw(15), best, std::setw(15),
-                          mean_velocity, std::setw(15), lb_avg, std::setw(15), avg_dist, '\n');
-                    ++count;
-                    // Logs
-                    m_log.emplace_back(gen, feval_count, best, mean_velocity, lb_avg, avg_dist);
+                    log_swarm(gen, prob.get_fevals() - fevals0, X, lbfit, lb, ub, count);
                 }
             }
         } // end of main PSO loop
@@ -533,7 +440,7 @@ public:
 
         // copy particles' positions & velocities back to the main population
         for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
-            pop.set_xf(i, lbX[i], lbfit[i]);
+            pop.set_xf(i, vector_double(lbX.data() + i * dim, lbX.data() + (i + 1u) * dim), {lbfit[i]});
         }
         return pop;
     };
@@ -595,6 +502,57 @@ public:
     {
         return m_seed;
     }
+    /// Sets the batch fitness evaluator
+    /**
+     * The batch fitness evaluator \p b (see pagmo::bfe) is used to evaluate the whole swarm at each generation.
+     * By default a sequential evaluator is used. For a given seed the results do not depend on the
+     * number of threads used by \p b.
+     *
+     * @param b the batch fitness evaluator
+     */
+    void set_bfe(const bfe &b)
+    {
+        m_bfe = b;
+    }
+    /// Gets the batch fitness evaluator
+    /**
+     * @return a const reference to the batch fitness evaluator
+     */
+    const bfe &get_bfe() const
+    {
+        return m_bfe;
+    }
+    /// Sets the steady-state mode
+    /**
+     * In the steady-state mode the swarm is not moved generation by generation. Instead, up to \p n particles
+     * are evaluated concurrently, each in a separate thread using its own copy of the problem. As soon as the
+     * evaluation of a particle completes, its memory (and the best position of the swarm, for topologies 1 and 4)
+     * is updated, and the next particle waiting to be moved is moved, using the information available at that
+     * time, and submitted for evaluation. The threads are thus kept busy also when the cost of the fitness
+     * evaluation varies from one particle to another.
+     *
+     * The number of fitness evaluations is the same as in the generational mode (i.e., the number of generations
+     * times the swarm size), and the adaptive random topology is rewired and the logs are produced every swarm
+     * size completed evaluations. The batch fitness evaluator is not used in this mode, and stochastic problems
+     * are not supported. If the problem does not provide at least the pagmo::thread_safety::basic guarantee,
+     * or if \p n is 1, the particles are evaluated one at a time in the calling thread.
+     *
+     * @param n the maximum number of concurrent fitness evaluations (0 selects the generational mode,
+     * which is the default)
+     */
+    void set_steady_state(unsigned n)
+    {
+        m_steady_state = n;
+    }
+    /// Gets the steady-state mode
+    /**
+     * @return the maximum number of concurrent fitness evaluations in the steady-state mode
+     * (0 if the generational mode is selected)
+     */
+    unsigned get_steady_state() const
+    {
+        return m_steady_state;
+    }
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -627,6 +585,10 @@ public:
         stream(ss, "\n\tMemory: ", m_memory);
         stream(ss, "\n\tSeed: ", m_seed);
         stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\tFitness evaluation: ", m_bfe.get_name());
+        if (m_steady_state) {
+            stream(ss, "\n\tSteady-state evaluations: ", m_steady_state);
+        }
         return ss.str();
     }
     /// Get log
@@ -652,7 +614,7 @@ public:
     void serialize(Archive &ar)
     {
         ar(m_max_gen, m_omega, m_eta1, m_eta2, m_max_vel, m_variant, m_neighb_type, m_neighb_param, m_e, m_seed,
-           m_verbosity, m_log);
+           m_verbosity, m_log, m_bfe, m_steady_state);
     }
 
 private:
@@ -661,14 +623,13 @@ private:
      *
      *  @param pidx index to the particle under consideration
      *  @param neighb definition of the swarm's topology
-     *  @param lbX particles' previous best positions
      *  @param lbfit particles' fitness values at their previous best positions
-     *  @return best position already visited by any of the considered particle's neighbours
+     *  @return index of the neighbour whose previous best position is the best among those of the considered
+     *  particle's neighbours
      */
-    vector_double particle__get_best_neighbor(population::size_type pidx,
-                                              std::vector<std::vector<vector_double::size_type>> &neighb,
-                                              const std::vector<vector_double> &lbX,
-                                              const std::vector<vector_double> &lbfit) const
+    population::size_type particle__get_best_neighbor(population::size_type pidx,
+                                                      std::vector<std::vector<vector_double::size_type>> &neighb,
+                                                      const vector_double &lbfit) const
     {
         population::size_type bnidx; // neighbour index; best neighbour index
 
@@ -687,11 +648,11 @@ private:
                 // iterate over indexes of the particle's neighbours, and identify the best
                 bnidx = neighb[pidx][0];
                 for (decltype(neighb[pidx].size()) nidx = 1u; nidx < neighb[pidx].size(); ++nidx) {
-                    if (lbfit[neighb[pidx][nidx]][0] <= lbfit[bnidx][0]) {
+                    if (lbfit[neighb[pidx][nidx]] <= lbfit[bnidx]) {
                         bnidx = neighb[pidx][nidx];
                     }
                 }
-                return lbX[bnidx];
+                return bnidx;
         }
     }
 
@@ -864,6 +825,231 @@ private:
             }
         }
     }
+    /**
+     *  @brief Update the velocity of a particle
+     *
+     *  @param p index of the particle
+     *  @param X particles' current positions
+     *  @param lbX particles' previous best positions
+     *  @param lbfit particles' fitness values at their previous best positions
+     *  @param neighb definition of the swarm's topology
+     *  @param best_neighb best position found by the swarm (tracked only when using topologies 1 or 4)
+     *  @param drng distribution generating numbers in [0, 1)
+     */
+    void particle__update_velocity(population::size_type p, const vector_double &X, const vector_double &lbX,
+                                   const vector_double &lbfit,
+                                   std::vector<std::vector<vector_double::size_type>> &neighb,
+                                   const vector_double &best_neighb, std::uniform_real_distribution<double> &drng) const
+    {
+        auto dim = X.size() / lbfit.size();
+        // pointer to the search space position of the best neighbor of the particle
+        const double *bn;
+        // auxiliary variables specific to the Fully Informed Particle Swarm variant
+        double acceleration_coefficient = m_eta1 + m_eta2;
+        double sum_forces;
+
+        double r1 = 0.;
+        double r2 = 0.;
+
+        // identify the current particle's best neighbour
+        // . not needed if m_neighb_type == 1 (gbest): best_neighb directly tracked in this function
+        // . not needed if m_variant == 6 (FIPS): all neighbours are considered, no need to identify the best
+        // one
+        if (m_neighb_type != 1u && m_variant != 6u) {
+            bn = lbX.data() + particle__get_best_neighbor(p, neighb, lbfit) * dim;
+        } else {
+            bn = best_neighb.data();
+        }
+        // the particle's velocity, position and previous best position
+        double *v = m_V.data() + p * dim;
+        const double *x = X.data() + p * dim;
+        const double *lbx = lbX.data() + p * dim;
+
+        /*-------PSO canonical (with inertia weight) ---------------------------------------------*/
+        /*-------Original algorithm used in the first PaGMO paper (~2007) ------------------------*/
+        if (m_variant == 1u) {
+            for (decltype(dim) d = 0u; d < dim; ++d) {
+                r1 = drng(m_e);
+                r2 = drng(m_e);
+                v[d] = m_omega * v[d] + m_eta1 * r1 * (lbx[d] - x[d]) + m_eta2 * r2 * (bn[d] - x[d]);
+            }
+        }
+
+        /*-------PSO canonical (with inertia weight) ---------------------------------------------*/
+        /*-------and with equal random weights of social and cognitive components-----------------*/
+        /*-------Check with Rastrigin-------------------------------------------------------------*/
+        else if (m_variant == 2u) {
+            for (decltype(dim) d = 0u; d < dim; ++d) {
+                r1 = drng(m_e);
+                v[d] = m_omega * v[d] + m_eta1 * r1 * (lbx[d] - x[d]) + m_eta2 * r1 * (bn[d] - x[d]);
+            }
+        }
+
+        /*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
+        /*-------Same random number for all components------------------------------------------*/
+        else if (m_variant == 3u) {
+            r1 = drng(m_e);
+            r2 = drng(m_e);
+            for (decltype(dim) d = 0u; d < dim; ++d) {
+                v[d] = m_omega * v[d] + m_eta1 * r1 * (lbx[d] - x[d]) + m_eta2 * r2 * (bn[d] - x[d]);
+            }
+        }
+
+        /*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
+        /*-------Same random number for all components------------------------------------------*/
+        /*-------and with equal random weights of social and cognitive components---------------*/
+        else if (m_variant == 4u) {
+            r1 = drng(m_e);
+            for (decltype(dim) d = 0u; d < dim; ++d) {
+                v[d] = m_omega * v[d] + m_eta1 * r1 * (lbx[d] - x[d]) + m_eta2 * r1 * (bn[d] - x[d]);
+            }
+        }
+
+        /*-------PSO variant with constriction coefficients------------------------------------*/
+        /*  ''Clerc's analysis of the iterative system led him to propose a strategy for the
+         *  placement of "constriction coefficients" on the terms of the formulas; these
+         *  coefficients controlled the convergence of the particle and allowed an elegant and
+         *  well-explained method for preventing explosion, ensuring convergence, and
+         *  eliminating the arbitrary Vmax parameter. The analysis also takes the guesswork
+         *  out of setting the values of phi_1 and phi_2.''
+         *  ''this is the canonical particle swarm algorithm of today.''
+         *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
+         *  [Clerc and Kennedy, 2002] http://dx.doi.org/10.1109/4235.985692
+         *
+         *  This being the canonical PSO of today, this variant is set as the default in PaGMO.
+         *-------------------------------------------------------------------------------------*/
+        else if (m_variant == 5u) {
+            for (decltype(dim) d = 0u; d < dim; ++d) {
+                r1 = drng(m_e);
+                r2 = drng(m_e);
+                v[d] = m_omega * (v[d] + m_eta1 * r1 * (lbx[d] - x[d]) + m_eta2 * r2 * (bn[d] - x[d]));
+            }
+        }
+
+        /*-------Fully Informed Particle Swarm-------------------------------------------------*/
+        /*  ''Whereas in the traditional algorithm each particle is affected by its own
+         *  previous performance and the single best success found in its neighborhood, in
+         *  Mendes' fully informed particle swarm (FIPS), the particle is affected by all its
+         *  neighbors, sometimes with no influence from its own previous success.''
+         *  ''With good parameters, FIPS appears to find better solutions in fewer iterations
+         *  than the canonical algorithm, but it is much more dependent on the population topology.''
+         *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
+         *  [Mendes et al., 2004] http://dx.doi.org/10.1109/TEVC.2004.826074
+         *-------------------------------------------------------------------------------------*/
+        else if (m_variant == 6u) {
+            for (decltype(dim) d = 0u; d < dim; ++d) {
+                sum_forces = 0.;
+                for (decltype(neighb[p].size()) n = 0u; n < neighb[p].size(); ++n) {
+                    sum_forces += drng(m_e) * acceleration_coefficient * (lbX[neighb[p][n] * dim + d] - x[d]);
+                }
+                v[d] = m_omega * (v[d] + sum_forces / static_cast<double>(neighb[p].size()));
+            }
+        }
+    }
+    /**
+     *  @brief Update the position of a particle, limiting its velocity and enforcing the bounds
+     *
+     *  @param p index of the particle
+     *  @param X particles' current positions
+     *  @param minv minimum velocity allowed
+     *  @param maxv maximum velocity allowed
+     *  @param lb lower bounds
+     *  @param ub upper bounds
+     */
+    void particle__update_position(population::size_type p, vector_double &X, const vector_double &minv,
+                                   const vector_double &maxv, const vector_double &lb, const vector_double &ub) const
+    {
+        auto dim = lb.size();
+        double new_x; // Temporary variable
+
+        double *v = m_V.data() + p * dim;
+        double *x = X.data() + p * dim;
+
+        // We now check that the velocity does not exceed the maximum allowed per component
+        // and we perform the position update and the feasibility correction
+        for (decltype(dim) d = 0u; d < dim; ++d) {
+
+            if (v[d] > maxv[d]) {
+                v[d] = maxv[d];
+            }
+
+            else if (v[d] < minv[d]) {
+                v[d] = minv[d];
+            }
+
+            // update position
+            new_x = x[d] + v[d];
+
+            // feasibility correction
+            // (velocity updated to that which would have taken the previous position
+            // to the newly corrected feasible position)
+            if (new_x < lb[d]) {
+                new_x = lb[d];
+                v[d] = 0.;
+                //					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
+                //					v[d] = new_x - x[d];
+            } else if (new_x > ub[d]) {
+                new_x = ub[d];
+                v[d] = 0.;
+                //					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
+                //					v[d] = new_x - x[d];
+            }
+            x[d] = new_x;
+        }
+    }
+    // Print and log a line describing the state of the swarm (see set_verbosity()).
+    void log_swarm(unsigned int gen, unsigned long long feval_count, const vector_double &X, const vector_double &lbfit,
+                   const vector_double &lb, const vector_double &ub, unsigned int &count) const
+    {
+        auto swarm_size = lbfit.size();
+        auto dim = lb.size();
+        // We compute the average across the swarm of the best fitness encountered
+        const auto &local_fits = lbfit;
+        auto lb_avg = std::accumulate(local_fits.begin(), local_fits.end(), 0.)
+                      / static_cast<double>(local_fits.size());
+        // We compute the best fitness encounterd so far across generations and across the swarm
+        // TODO: distance returns a signed type that can be overflown by the local_fits::size_type
+        auto idx_best = std::distance(std::begin(local_fits),
+                                      std::min_element(std::begin(local_fits), std::end(local_fits)));
+        auto best = local_fits[static_cast<vector_double::size_type>(idx_best)];
+        // We compute a measure for the average particle velocity across the swarm
+        auto mean_velocity = 0.;
+        for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
+            for (decltype(dim) j = 0u; j < dim; ++j) {
+                if (ub[j] > lb[j]) {
+                    mean_velocity += std::abs(m_V[i * dim + j] / (ub[j] - lb[j]));
+                } // else 0
+            }
+            mean_velocity /= static_cast<double>(dim);
+        }
+        // We compute the average distance across particles (NOTE: N^2 complexity)
+        auto avg_dist = 0.;
+        for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
+            for (decltype(swarm_size) j = i + 1u; j < swarm_size; ++j) {
+                const double *x1 = X.data() + i * dim;
+                const double *x2 = X.data() + j * dim;
+                double acc = 0.;
+                for (decltype(dim) k = 0u; k < dim; ++k) {
+                    if (ub[k] > lb[k]) {
+                        acc += (x1[k] - x2[k]) * (x1[k] - x2[k]) / (ub[k] - lb[k]) / (ub[k] - lb[k]);
+                    } // else 0
+                }
+                avg_dist += std::sqrt(acc);
+            }
+        }
+        avg_dist /= ((static_cast<double>(swarm_size) - 1u) * static_cast<double>(swarm_size)) / 2.;
+        // We start printing
+        // Every 50 lines print the column names
+        if (count % 50u == 1u) {
+            print("\n", std::setw(7), "Gen:", std::setw(15), "Fevals:", std::setw(15), "gbest:", std::setw(15),
+                  "Mean Vel.:", std::setw(15), "Mean lbest:", std::setw(15), "Avg. Dist.:", '\n');
+        }
+        print(std::setw(7), gen, std::setw(15), feval_count, std::setw(15), best, std::setw(15), mean_velocity,
+              std::setw(15), lb_avg, std::setw(15), avg_dist, '\n');
+        ++count;
+        // Logs
+        m_log.emplace_back(gen, feval_count, best, mean_velocity, lb_avg, avg_dist);
+    }
     // Generations
     unsigned int m_max_gen;
     // Inertia (or constriction) coefficient
@@ -880,13 +1066,15 @@ private:
     unsigned int m_neighb_param;
     // memory
     bool m_memory;
-    // paricles' velocities
-    mutable std::vector<vector_double> m_V;
+    // paricles' velocities (stored contiguously, one particle after the other)
+    mutable vector_double m_V;
 
     mutable detail::random_engine_type m_e;
     unsigned int m_seed;
     unsigned int m_verbosity;
     mutable log_type m_log;
+    bfe m_bfe;
+    unsigned m_steady_state;
 };
 
 } // namespace pagmo
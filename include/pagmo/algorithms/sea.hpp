@@ -35,6 +35,7 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -150,6 +151,10 @@ public:
         std::uniform_real_distribution<double> drng(0., 1.); // [0,1]
 
         for (unsigned int i = 1u; i <= m_gen; ++i) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                return pop;
+            }
             if (prob.is_stochastic()) {
                 pop.get_problem().set_seed(std::uniform_int_distribution<unsigned int>()(m_e));
                 // re-evaluate the whole population w.r.t. the new seed
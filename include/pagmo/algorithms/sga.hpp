@@ -33,6 +33,7 @@ see https://www.gnu.org/licenses/. */
 #include <boost/bimap.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/test/floating_point_comparison.hpp>
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
 #include <numeric> // std::iota
@@ -43,7 +44,10 @@ see https://www.gnu.org/licenses/. */
 #include <vector>
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/bfe.hpp>
+#include <pagmo/detail/async_eval.hpp>
 #include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -220,7 +224,7 @@ public:
         unsigned param_s = 2u, std::string crossover = "exponential", std::string mutation = "polynomial",
         std::string selection = "tournament", unsigned seed = pagmo::random_device::next())
         : m_gen(gen), m_cr(cr), m_eta_c(eta_c), m_m(m), m_param_m(param_m), m_param_s(param_s), m_e(seed), m_seed(seed),
-          m_verbosity(0u), m_log()
+          m_verbosity(0u), m_log(), m_bfe(1u), m_steady_state(0u)
     {
         if (cr > 1. || cr < 0.) {
             pagmo_throw(std::invalid_argument,
@@ -289,6 +293,8 @@ public:
      * @throws std::invalid_argument if the problem is multi-objective or constrained, if the population size is smaller
      * than 2, if \p param_s is larger than the population size, if the size of \p pop is odd and a "sbx" crossover has
      * been selected upon construction.
+     * @throws std::invalid_argument if the problem is stochastic and the steady-state mode is selected.
+     * @throws unspecified any exception thrown by the evaluation of the offspring in the steady-state mode.
      */
     population evolve(population pop) const
     {
@@ -326,6 +332,10 @@ public:
                         "Population size must be even if sbx crossover is selected. Detected pop size is: "
                             + std::to_string(pop.size()));
         }
+        if (m_steady_state && prob.is_stochastic()) {
+            pagmo_throw(std::invalid_argument, "The problem appears to be stochastic, the steady-state mode of "
+                                                   + get_name() + " cannot deal with it");
+        }
         // Get out if there is nothing to do.
         if (m_gen == 0u) {
             return pop;
@@ -335,37 +345,53 @@ public:
         // No throws, all valid: we clear the logs
         m_log.clear();
 
+        if (m_steady_state) {
+            return evolve_steady_state(std::move(pop));
+        }
+
         double improvement; // stores the difference in fitness between parents and offsprings
         std::uniform_int_distribution<unsigned int> urng;
+        // The chromosomes and fitnesses of the offspring are stored in contiguous buffers (one chromosome
+        // after the other) which are reused across generations, together with the scratch buffers needed
+        // by the genetic operators and by the reinsertion.
+        const auto dim = prob.get_nx();
+        vector_double XNEW(NP * dim), FNEW(NP), XTMP(NP * dim), XPAR(NP * dim), FPAR(NP), tmp_x(dim), tmp_f(1u);
+        std::vector<vector_double::size_type> best_idxs(2u * NP);
         for (decltype(m_gen) i = 1u; i <= m_gen; ++i) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                return pop;
+            }
             // 1 - if the problem is stochastic we change seed and re-evaluate the entire population
             if (prob.is_stochastic()) {
                 pop.get_problem().set_seed(urng(m_e));
                 // re-evaluate the whole population w.r.t. the new seed
-                for (decltype(pop.size()) j = 0u; j < pop.size(); ++j) {
-                    pop.set_xf(j, pop.get_x()[j], prob.fitness(pop.get_x()[j]));
+                for (decltype(NP) j = 0u; j < NP; ++j) {
+                    std::copy(pop.get_x()[j].begin(), pop.get_x()[j].end(), XNEW.data() + j * dim);
+                }
+                m_bfe.eval(prob, XNEW, FNEW);
+                for (decltype(NP) j = 0u; j < NP; ++j) {
+                    tmp_f[0] = FNEW[j];
+                    pop.set_xf(j, pop.get_x()[j], tmp_f);
                 }
             }
-            auto XNEW = pop.get_x();
-            auto FNEW = pop.get_f();
             // 2 - Selection.
-            auto selected_idx = perform_selection(FNEW);
+            auto selected_idx = perform_selection(pop.get_f());
             for (decltype(NP) j = 0u; j < NP; ++j) {
-                XNEW[j] = pop.get_x()[selected_idx[j]];
+                const auto &x = pop.get_x()[selected_idx[j]];
+                std::copy(x.begin(), x.end(), XNEW.data() + j * dim);
             }
             // 3 - Crossover
-            perform_crossover(XNEW, prob.get_bounds(), dim_i);
+            perform_crossover(XNEW, XTMP, prob.get_bounds(), dim_i);
             // 4 - Mutation
             perform_mutation(XNEW, prob.get_bounds(), dim_i);
-            // 5 - Evaluate the new population
-            for (decltype(NP) j = 0u; j < NP; ++j) {
-                FNEW[j] = prob.fitness(XNEW[j]);
-            }
+            // 5 - Evaluate the new population (as a single batch)
+            m_bfe.eval(prob, XNEW, FNEW);
             // 6 - Logs and prints
             if (m_verbosity > 0u) {
                 double bestf = std::numeric_limits<double>::max();
                 for (decltype(NP) j = 0u; j < NP; ++j) {
-                    if (FNEW[j][0] < bestf) bestf = FNEW[j][0];
+                    if (FNEW[j] < bestf) bestf = FNEW[j];
                 }
                 improvement = pop.get_f()[pop.best_idx()][0] - bestf;
                 // (verbosity modes = 1: a line is added at each improvement
@@ -385,20 +411,27 @@ public:
                 }
             }
             // 7 - And insert the best into pop
-            // We add all the parents to the new population
+            // The pool is made of the offspring (indices [0, NP)) and of the parents (indices [NP, 2NP)),
+            // which we copy as the population is overwritten below
             for (decltype(NP) j = 0u; j < NP; ++j) {
-                XNEW.push_back(pop.get_x()[j]);
-                FNEW.push_back(pop.get_f()[j]);
+                std::copy(pop.get_x()[j].begin(), pop.get_x()[j].end(), XPAR.data() + j * dim);
+                FPAR[j] = pop.get_f()[j][0];
             }
             // sort the entire pool
-            std::vector<vector_double::size_type> best_idxs(FNEW.size());
+            auto pool_f = [&FNEW, &FPAR, NP](vector_double::size_type idx) {
+                return idx < NP ? FNEW[idx] : FPAR[idx - NP];
+            };
             std::iota(best_idxs.begin(), best_idxs.end(), vector_double::size_type(0u));
             std::sort(best_idxs.begin(), best_idxs.end(),
-                      [&FNEW](vector_double::size_type a, vector_double::size_type b) {
-                          return detail::less_than_f(FNEW[a][0], FNEW[b][0]);
+                      [&pool_f](vector_double::size_type a, vector_double::size_type b) {
+                          return detail::less_than_f(pool_f(a), pool_f(b));
                       });
             for (decltype(NP) j = 0u; j < NP; ++j) {
-                pop.set_xf(j, XNEW[best_idxs[j]], FNEW[best_idxs[j]]);
+                const auto idx = best_idxs[j];
+                const auto x_ptr = idx < NP ? XNEW.data() + idx * dim : XPAR.data() + (idx - NP) * dim;
+                tmp_x.assign(x_ptr, x_ptr + dim);
+                tmp_f[0] = pool_f(idx);
+                pop.set_xf(j, tmp_x, tmp_f);
             }
         }
         return pop;
@@ -467,6 +500,58 @@ public:
     {
         return m_verbosity;
     }
+    /// Sets the batch fitness evaluator
+    /**
+    * The offspring of each generation are evaluated with a single call to the batch fitness evaluator \p b,
+    * which can distribute the evaluations over multiple threads (see pagmo::bfe). By default
+    * a sequential evaluator is used. The evolution does not depend on the evaluator used.
+    *
+    * @param b the batch fitness evaluator
+    */
+    void set_bfe(const bfe &b)
+    {
+        m_bfe = b;
+    }
+    /// Gets the batch fitness evaluator
+    /**
+    * @return a const reference to the batch fitness evaluator
+    */
+    const bfe &get_bfe() const
+    {
+        return m_bfe;
+    }
+    /// Sets the steady-state mode
+    /**
+    * In the steady-state mode the offspring are not evaluated generation by generation. Instead, up to \p n
+    * offspring are evaluated concurrently, each in a separate thread using its own copy of the problem.
+    * As soon as the evaluation of an offspring completes, the offspring replaces the worst individual
+    * of the population (if it is better) and a new offspring is submitted for evaluation. The threads
+    * are thus kept busy also when the cost of the fitness evaluation varies from one individual to another.
+    * The offspring are generated a population size at a time from the current population, using the
+    * selection, crossover and mutation selected upon construction.
+    *
+    * The number of fitness evaluations is the same as in the generational mode (i.e., the number of generations
+    * times the population size), and the logs are produced every population size completed evaluations.
+    * The batch fitness evaluator is not used in this mode, and stochastic problems are not supported. If the
+    * problem does not provide at least the pagmo::thread_safety::basic guarantee, or if \p n is 1, the offspring
+    * are evaluated one at a time in the calling thread.
+    *
+    * @param n the maximum number of concurrent fitness evaluations (0 selects the generational mode,
+    * which is the default)
+    */
+    void set_steady_state(unsigned n)
+    {
+        m_steady_state = n;
+    }
+    /// Gets the steady-state mode
+    /**
+    * @return the maximum number of concurrent fitness evaluations in the steady-state mode
+    * (0 if the generational mode is selected)
+    */
+    unsigned get_steady_state() const
+    {
+        return m_steady_state;
+    }
     /// Algorithm name
     /**
     * @return a string containing the algorithm name
@@ -501,6 +586,10 @@ public:
         if (m_selection == selection::TOURNAMENT) stream(ss, "\n\t\tTournament size: ", m_param_s);
         stream(ss, "\n\tSeed: ", m_seed);
         stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\tFitness evaluation: ", m_bfe.get_name());
+        if (m_steady_state) {
+            stream(ss, "\n\tSteady-state evaluations: ", m_steady_state);
+        }
         return ss.str();
     }
 
@@ -529,10 +618,87 @@ public:
     void serialize(Archive &ar)
     {
         ar(m_gen, m_cr, m_eta_c, m_m, m_param_m, m_param_s, m_mutation, m_selection, m_crossover, m_e, m_seed,
-           m_verbosity, m_log);
+           m_verbosity, m_log, m_bfe, m_steady_state);
     }
 
 private:
+    // The steady-state evolution (see set_steady_state()). Called by evolve() after the preamble.
+    population evolve_steady_state(population pop) const
+    {
+        const auto &prob = pop.get_problem();
+        auto dim = prob.get_nx();
+        auto dim_i = prob.get_nix();
+        const auto bounds = prob.get_bounds();
+        auto NP = pop.size();
+        auto fevals0 = prob.get_fevals();
+        auto count = 1u;
+
+        // The offspring are generated NP at a time in XNEW, and submitted one at a time.
+        vector_double XNEW(NP * dim), XTMP(NP * dim), tmp_x(dim);
+        decltype(NP) n_ready = 0u;
+        const auto n_offspring = static_cast<unsigned long long>(m_gen) * NP;
+        unsigned long long n_submitted = 0u, n_done = 0u;
+        auto best_f = pop.get_f()[pop.best_idx()][0];
+
+        detail::async_eval_pool eval_pool(prob, m_steady_state);
+        auto submit_offspring = [&]() {
+            if (n_ready == 0u) {
+                auto selected_idx = perform_selection(pop.get_f());
+                for (decltype(NP) j = 0u; j < NP; ++j) {
+                    const auto &x = pop.get_x()[selected_idx[j]];
+                    std::copy(x.begin(), x.end(), XNEW.data() + j * dim);
+                }
+                perform_crossover(XNEW, XTMP, bounds, dim_i);
+                perform_mutation(XNEW, bounds, dim_i);
+                n_ready = NP;
+            }
+            --n_ready;
+            tmp_x.assign(XNEW.data() + n_ready * dim, XNEW.data() + (n_ready + 1u) * dim);
+            eval_pool.submit(0u, tmp_x);
+            ++n_submitted;
+        };
+        for (auto k = 0ull; k < std::min(static_cast<unsigned long long>(m_steady_state), n_offspring); ++k) {
+            submit_offspring();
+        }
+
+        std::size_t id;
+        vector_double newx, newf;
+        while (eval_pool.n_pending()) {
+            eval_pool.next(id, newx, newf);
+            ++n_done;
+            // The offspring replaces the worst individual, if better.
+            const auto worst_idx = pop.worst_idx();
+            if (detail::less_than_f(newf[0], pop.get_f()[worst_idx][0])) {
+                pop.set_xf(worst_idx, newx, newf);
+            }
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                eval_pool.finish();
+                return pop;
+            }
+            // Logs and prints, every NP completed evaluations (see the generational mode).
+            if (n_done % NP == 0u && m_verbosity > 0u) {
+                const auto gen = static_cast<unsigned>(n_done / NP);
+                const auto cur_best_f = pop.get_f()[pop.best_idx()][0];
+                const double improvement = best_f - cur_best_f;
+                best_f = cur_best_f;
+                if (((gen % m_verbosity == 1u) && (m_verbosity > 1u)) || ((improvement > 0) && (m_verbosity == 1u))) {
+                    if (count % 50u == 1u) {
+                        print("\n", std::setw(7), "Gen:", std::setw(15), "Fevals:", std::setw(15), "Best:",
+                              std::setw(15), "Improvement:", '\n');
+                    }
+                    print(std::setw(7), gen, std::setw(15), prob.get_fevals() - fevals0, std::setw(15), cur_best_f,
+                          std::setw(15), improvement, '\n');
+                    ++count;
+                    m_log.emplace_back(gen, prob.get_fevals() - fevals0, cur_best_f, improvement);
+                }
+            }
+            if (n_submitted < n_offspring) {
+                submit_offspring();
+            }
+        }
+        return pop;
+    }
     std::vector<vector_double::size_type> perform_selection(const std::vector<vector_double> &F) const
     {
         assert(m_param_s <= F.size());
@@ -577,38 +743,48 @@ private:
         }
         return retval;
     }
-    void perform_crossover(std::vector<vector_double> &X, const std::pair<vector_double, vector_double> &bounds,
+    // NOTE: the genetic operators work on chromosomes stored contiguously in X, one after the other.
+    void perform_crossover(vector_double &X, vector_double &XCOPY,
+                           const std::pair<vector_double, vector_double> &bounds,
                            vector_double::size_type dim_i) const
     {
-        auto dim = X[0].size();
-        assert(X.size() > 1u);
-        assert(std::all_of(X.begin(), X.end(), [dim](const vector_double &item) { return item.size() == dim; }));
-        std::vector<vector_double::size_type> all_idx(X.size()); // stores indexes to then select one at random
+        auto dim = bounds.first.size();
+        auto NP = X.size() / dim;
+        assert(NP > 1u);
+        assert(X.size() == NP * dim);
+        std::vector<vector_double::size_type> all_idx(NP); // stores indexes to then select one at random
         std::iota(all_idx.begin(), all_idx.end(), vector_double::size_type(0u));
         std::uniform_real_distribution<> drng(0., 1.);
+        // The crossover reads the parents from a copy of the chromosomes (the assignment does not
+        // allocate after the first generation).
+        XCOPY = X;
         // We need different loops if the crossover type is "sbx"" as this method creates two offsprings per
         // selected couple.
         if (m_crossover == crossover::SBX) {
-            assert(X.size() % 2u == 0u);
-            std::shuffle(X.begin(), X.end(), m_e);
-            for (decltype(X.size()) i = 0u; i < X.size(); i += 2) {
-                auto children = sbx_crossover_impl(X[i], X[i + 1], bounds, dim_i);
-                X[i] = children.first;
-                X[i + 1] = children.second;
+            assert(NP % 2u == 0u);
+            // We shuffle the chromosomes by shuffling their indexes (the random engine
+            // is used exactly as it would be shuffling the chromosomes themselves).
+            std::shuffle(all_idx.begin(), all_idx.end(), m_e);
+            for (decltype(NP) i = 0u; i < NP; ++i) {
+                std::copy(XCOPY.data() + all_idx[i] * dim, XCOPY.data() + (all_idx[i] + 1u) * dim,
+                          X.data() + i * dim);
+            }
+            for (decltype(NP) i = 0u; i < NP; i += 2) {
+                sbx_crossover_impl(XCOPY.data() + all_idx[i] * dim, XCOPY.data() + all_idx[i + 1] * dim,
+                                   X.data() + i * dim, X.data() + (i + 1) * dim, bounds, dim_i);
             }
         } else {
-            auto XCOPY = X;
             std::uniform_int_distribution<std::vector<vector_double::size_type>::size_type> rnd_gene_idx(0, dim - 1u);
             std::uniform_int_distribution<std::vector<vector_double::size_type>::size_type> rnd_skip_first_idx(
                 1, all_idx.size() - 1);
             // Start of main loop through the X
-            for (decltype(X.size()) i = 0u; i < X.size(); ++i) {
+            for (decltype(NP) i = 0u; i < NP; ++i) {
                 // 1 - we select a mating partner
                 std::swap(all_idx[0], all_idx[i]);
                 auto partner_idx = rnd_skip_first_idx(m_e);
                 // 2 - We rename these chromosomes for code clarity
-                auto &child = X[i];
-                const auto &parent2 = XCOPY[all_idx[partner_idx]];
+                auto child = X.data() + i * dim;
+                const auto parent2 = XCOPY.data() + all_idx[partner_idx] * dim;
                 // 3 - We perform crossover according to the selected method
                 switch (m_crossover) {
                     case (crossover::EXPONENTIAL): {
@@ -650,15 +826,15 @@ private:
             }
         }
     }
-    void perform_mutation(std::vector<vector_double> &X, const std::pair<vector_double, vector_double> &bounds,
+    void perform_mutation(vector_double &X, const std::pair<vector_double, vector_double> &bounds,
                           vector_double::size_type dimi) const
     {
         // Asserting the correct behaviour of input parameters
-        assert(X.size() > 1u);
-        auto dim = X[0].size();
-        assert(std::all_of(X.begin(), X.end(), [dim](const vector_double &item) { return item.size() == dim; }));
         assert(bounds.first.size() == bounds.second.size());
-        assert(bounds.first.size() == X[0].size());
+        auto dim = bounds.first.size();
+        auto NP = X.size() / dim;
+        assert(NP > 1u);
+        assert(X.size() == NP * dim);
 
         // Renaming some dimensions
         auto dimc = dim - dimi;
@@ -674,7 +850,8 @@ private:
         std::vector<vector_double::size_type> to_be_mutated(dim);
         std::iota(to_be_mutated.begin(), to_be_mutated.end(), vector_double::size_type(0u));
         // Then we start tha main loop through the population
-        for (decltype(X.size()) i = 0u; i < X.size(); ++i) {
+        for (decltype(NP) i = 0u; i < NP; ++i) {
+            auto xi = X.data() + i * dim;
             // We select the indexes to be mutated (the first N of to_be_mutated)
             std::shuffle(to_be_mutated.begin(), to_be_mutated.end(), m_e);
             auto N = std::binomial_distribution<vector_double::size_type>(dim, m_m)(m_e);
@@ -687,11 +864,11 @@ private:
                     for (decltype(N) j = 0u; j < N; ++j) {
                         auto gene_idx = to_be_mutated[j];
                         if (gene_idx < dimc) {
-                            X[i][gene_idx] = uniform_real_from_range(lb[gene_idx], ub[gene_idx], m_e);
+                            xi[gene_idx] = uniform_real_from_range(lb[gene_idx], ub[gene_idx], m_e);
                         } else {
                             rnd_lb_ub.param(std::uniform_int_distribution<int>::param_type(
                                 static_cast<int>(lb[gene_idx]), static_cast<int>(ub[gene_idx])));
-                            X[i][gene_idx] = static_cast<double>(rnd_lb_ub(m_e));
+                            xi[gene_idx] = static_cast<double>(rnd_lb_ub(m_e));
                         }
                     }
                     break;
@@ -702,9 +879,9 @@ private:
                         auto gene_idx = to_be_mutated[j];
                         auto std = (ub[gene_idx] - lb[gene_idx]) * m_param_m;
                         if (gene_idx < dimc) {
-                            X[i][gene_idx] += normal(m_e) * std;
+                            xi[gene_idx] += normal(m_e) * std;
                         } else {
-                            X[i][gene_idx] += std::round(normal(m_e) * std);
+                            xi[gene_idx] += std::round(normal(m_e) * std);
                         }
                     }
                     break;
@@ -717,31 +894,31 @@ private:
                             double u = drng(m_e);
                             if (u <= 0.5) {
                                 auto delta_l = std::pow(2. * u, 1. / (1. + m_param_m)) - 1.;
-                                X[i][gene_idx] += delta_l * (X[i][gene_idx] - lb[gene_idx]);
+                                xi[gene_idx] += delta_l * (xi[gene_idx] - lb[gene_idx]);
                             } else {
                                 auto delta_r = 1 - std::pow(2. * (1. - u), 1. / (1. + m_param_m));
-                                X[i][gene_idx] += delta_r * (ub[gene_idx] - X[i][gene_idx]);
+                                xi[gene_idx] += delta_r * (ub[gene_idx] - xi[gene_idx]);
                             }
                         } else {
                             rnd_lb_ub.param(std::uniform_int_distribution<int>::param_type(
                                 static_cast<int>(lb[gene_idx]), static_cast<int>(ub[gene_idx])));
-                            X[i][gene_idx] = static_cast<double>(rnd_lb_ub(m_e));
+                            xi[gene_idx] = static_cast<double>(rnd_lb_ub(m_e));
                         }
                     }
                     break;
                 }
             }
             // We fix chromosomes possibly created outside the bounds to stick to the bounds
-            detail::force_bounds_stick(X[i], lb, ub);
+            detail::force_bounds_stick(xi, lb, ub);
         }
     }
-    std::pair<vector_double, vector_double> sbx_crossover_impl(const vector_double &parent1,
-                                                               const vector_double &parent2,
-                                                               const std::pair<vector_double, vector_double> &bounds,
-                                                               vector_double::size_type Di) const
+    // Writes into child1 and child2 (which must not overlap the parents and must be initialised
+    // as copies of the parents) the result of the crossover between parent1 and parent2.
+    void sbx_crossover_impl(const double *parent1, const double *parent2, double *child1, double *child2,
+                            const std::pair<vector_double, vector_double> &bounds, vector_double::size_type Di) const
     {
         // Decision vector dimensions
-        auto D = parent1.size();
+        auto D = bounds.first.size();
         auto Dc = D - Di;
         // Problem bounds
         const auto &lb = bounds.first;
@@ -749,9 +926,6 @@ private:
         // declarations
         double y1, y2, yl, yu, rand01, beta, alpha, betaq, c1, c2;
         vector_double::size_type site1, site2;
-        // Initialize the child decision vectors
-        auto child1 = parent1;
-        auto child2 = parent2;
         // Random distributions
         std::uniform_real_distribution<> drng(0., 1.); // to generate a number in [0, 1)
 
@@ -827,7 +1001,6 @@ private:
                 child2[i] = parent2[i];
             }
         }
-        return std::make_pair(std::move(child1), std::move(child2));
     }
     unsigned m_gen;
     double m_cr;
@@ -842,6 +1015,8 @@ private:
     unsigned int m_seed;
     unsigned int m_verbosity;
     mutable log_type m_log;
+    bfe m_bfe;
+    unsigned m_steady_state;
 };
 
 } // namespace pagmo
@@ -43,6 +43,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -301,6 +302,13 @@ public:
         // HERE WE START THE JUICE OF THE ALGORITHM      //
         // ----------------------------------------------//
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Stop if requested by the island running the evolution.
+            if (evolve_stop_requested(prob)) {
+                if (m_verbosity > 0u) {
+                    std::cout << "Exit condition -- evolution stopped" << std::endl;
+                }
+                return pop;
+            }
             // 0 -If the problem is stochastic change seed first
             if (prob.is_stochastic()) {
                 // change the problem seed. This is done via the population_set_seed method as prob.set_seed
@@ -0,0 +1,188 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_BFE_HPP
+#define PAGMO_BFE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pagmo/detail/parallel_for.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// Batch fitness evaluator.
+/**
+ * This class computes the fitnesses of a batch of decision vectors. The decision vectors are passed in
+ * a single contiguous buffer (one decision vector after the other) and the fitness vectors are returned
+ * in the same layout, so that algorithms generating a whole set of candidates at once (e.g., the offspring
+ * of a generation) can evaluate them in a single call and without per-candidate allocations.
+ *
+ * The evaluations are distributed over multiple threads, each working on its own copy of the problem. This
+ * is possible only if the problem provides at least the pagmo::thread_safety::basic guarantee: otherwise
+ * the batch is evaluated sequentially in the calling thread. In all cases the fitness evaluations
+ * performed are accounted for in the fitness evaluation counter of the input problem, and the output
+ * does not depend on the number of threads used.
+ *
+ * Algorithms supporting batch evaluation store an instance of this class (see, e.g., pagmo::sga::set_bfe()).
+ * A default-constructed evaluator uses all the available hardware threads, while an evaluator constructed
+ * with one thread reproduces exactly the sequential behaviour.
+ */
+class bfe
+{
+public:
+    /// Constructor.
+    /**
+     * @param n_threads the maximum number of threads that will be used to evaluate a batch. A value of zero means
+     * that the number of threads will be determined by <tt>std::thread::hardware_concurrency()</tt>.
+     */
+    explicit bfe(unsigned n_threads = 0u) : m_n_threads(n_threads)
+    {
+    }
+    /// Call operator.
+    /**
+     * The decision vectors in \p dvs are expected to be stored contiguously, i.e., the \f$i\f$-th decision vector
+     * occupies the range \f$\left[ i n_x, \left( i + 1 \right) n_x \right)\f$ of \p dvs, where \f$n_x\f$ is the
+     * problem dimension. The \f$i\f$-th fitness vector will be stored in the range
+     * \f$\left[ i n_f, \left( i + 1 \right) n_f \right)\f$ of the return value, where \f$n_f\f$ is the fitness
+     * dimension.
+     *
+     * @param p the problem that will be used for the evaluations.
+     * @param dvs the decision vectors to be evaluated.
+     *
+     * @return the fitness vectors of \p dvs.
+     *
+     * @throws std::invalid_argument if the size of \p dvs is not a multiple of the problem dimension.
+     * @throws unspecified any exception thrown by problem::fitness() or by the copy constructor of
+     * pagmo::problem, or any exception raised by threading primitives.
+     */
+    vector_double operator()(const problem &p, const vector_double &dvs) const
+    {
+        vector_double retval;
+        eval(p, dvs, retval);
+        return retval;
+    }
+    /// Batch evaluation into an existing buffer.
+    /**
+     * This method is equivalent to bfe::operator()(), but the fitness vectors are written into \p fvs
+     * (which is resized as needed), so that its storage can be reused across calls.
+     *
+     * @param p the problem that will be used for the evaluations.
+     * @param dvs the decision vectors to be evaluated.
+     * @param fvs the buffer that will contain the fitness vectors of \p dvs.
+     *
+     * @throws unspecified any exception thrown by bfe::operator()().
+     */
+    void eval(const problem &p, const vector_double &dvs, vector_double &fvs) const
+    {
+        const auto nx = p.get_nx(), nf = p.get_nf();
+        if (dvs.size() % nx) {
+            pagmo_throw(std::invalid_argument, "Invalid argument for a batch fitness evaluation: the length of the "
+                                               "decision vectors buffer ("
+                                                   + std::to_string(dvs.size())
+                                                   + ") is not a multiple of the problem dimension ("
+                                                   + std::to_string(nx) + ")");
+        }
+        const auto n_dvs = dvs.size() / nx;
+        fvs.resize(n_dvs * nf);
+        const auto n_threads
+            = static_cast<int>(p.get_thread_safety()) >= static_cast<int>(thread_safety::basic)
+                  ? detail::parallel_n_threads(m_n_threads, n_dvs)
+                  : 1u;
+        // The last block is evaluated directly with p, the others with copies made here, in the calling
+        // thread, as concurrent copies of the same problem are not guaranteed to be safe.
+        std::vector<problem> copies(n_threads - 1u, p);
+        const auto fevals0 = p.get_fevals();
+        detail::parallel_for(n_dvs, n_threads, [&](std::size_t begin, std::size_t end, unsigned block) {
+            const problem &pb = block < copies.size() ? copies[block] : p;
+            vector_double x(nx);
+            for (auto i = begin; i < end; ++i) {
+                std::copy(dvs.data() + i * nx, dvs.data() + (i + 1u) * nx, x.data());
+                const auto f = pb.fitness(x);
+                std::copy(f.begin(), f.end(), fvs.data() + i * nf);
+            }
+        });
+        for (const auto &c : copies) {
+            p.increment_fevals(c.get_fevals() - fevals0);
+        }
+    }
+    /// Get the number of threads.
+    /**
+     * @return the maximum number of threads used for the evaluation of a batch (zero meaning that
+     * the number of threads is determined by the hardware).
+     */
+    unsigned get_n_threads() const
+    {
+        return m_n_threads;
+    }
+    /// Evaluator name.
+    /**
+     * @return a string containing the evaluator name.
+     */
+    std::string get_name() const
+    {
+        std::ostringstream ss;
+        stream(ss, "Batch fitness evaluator (threads: ");
+        if (m_n_threads) {
+            stream(ss, m_n_threads);
+        } else {
+            stream(ss, "auto");
+        }
+        stream(ss, ")");
+        return ss.str();
+    }
+    /// Object serialization.
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_n_threads);
+    }
+
+private:
+    unsigned m_n_threads;
+};
+}
+
+#endif
@@ -0,0 +1,222 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_DETAIL_AFFINITY_HPP
+#define PAGMO_DETAIL_AFFINITY_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+
+#include <sched.h>
+
+#endif
+
+#include <pagmo/exceptions.hpp>
+
+// Thread placement utilities. The placement is implemented only on Linux, where
+// the NUMA topology is read from sysfs (no dependency on libnuma). Elsewhere, the
+// topology is empty and the placement functions do nothing.
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Parse a Linux CPU list (e.g., "0-3,8,10-11"). Returns a sorted list.
+inline std::vector<unsigned> parse_cpu_list(const std::string &str)
+{
+    std::vector<unsigned> retval;
+    std::istringstream iss(str);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        item.erase(std::remove_if(item.begin(), item.end(), [](char c) { return c == ' ' || c == '\n'; }),
+                   item.end());
+        if (item.empty()) {
+            continue;
+        }
+        const auto dash = item.find('-');
+        try {
+            const auto first = static_cast<unsigned>(std::stoul(item.substr(0, dash)));
+            const auto last
+                = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(item.substr(dash + 1u)));
+            for (auto i = first; i <= last; ++i) {
+                retval.push_back(i);
+            }
+        } catch (const std::logic_error &) {
+            // Ignore malformed entries.
+        }
+    }
+    std::sort(retval.begin(), retval.end());
+    retval.erase(std::unique(retval.begin(), retval.end()), retval.end());
+    return retval;
+}
+
+// Affinity mask of the calling thread.
+inline std::vector<unsigned> get_thread_affinity()
+{
+    std::vector<unsigned> retval;
+#if defined(__linux__)
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &set)) {
+                retval.push_back(i);
+            }
+        }
+    }
+#endif
+    return retval;
+}
+
+// The CPUs available to the process, i.e., the affinity mask of the first
+// thread calling this function (normally, the unpinned main thread).
+template <typename = void>
+struct process_cpus {
+    static const std::vector<unsigned> &get()
+    {
+        static const std::vector<unsigned> retval = get_thread_affinity();
+        return retval;
+    }
+};
+
+// The CPUs of each NUMA node, restricted to the CPUs available to the process.
+// Nodes without available CPUs are omitted. If the topology cannot be read,
+// all the available CPUs are assigned to a single node.
+struct numa_node_cpus {
+    int node;
+    std::vector<unsigned> cpus;
+};
+
+inline std::vector<numa_node_cpus> numa_topology()
+{
+    std::vector<numa_node_cpus> retval;
+    const auto &avail = process_cpus<>::get();
+    if (avail.empty()) {
+        return retval;
+    }
+#if defined(__linux__)
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string line;
+    if (online && std::getline(online, line)) {
+        for (auto n : parse_cpu_list(line)) {
+            std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(n) + "/cpulist");
+            std::string cl;
+            if (!cpulist || !std::getline(cpulist, cl)) {
+                continue;
+            }
+            numa_node_cpus nc{static_cast<int>(n), {}};
+            for (auto c : parse_cpu_list(cl)) {
+                if (std::binary_search(avail.begin(), avail.end(), c)) {
+                    nc.cpus.push_back(c);
+                }
+            }
+            if (!nc.cpus.empty()) {
+                retval.push_back(std::move(nc));
+            }
+        }
+    }
+#endif
+    if (retval.empty()) {
+        retval.push_back(numa_node_cpus{0, avail});
+    }
+    return retval;
+}
+
+// Check that the CPUs are available to the process.
+inline void check_cpus(const std::vector<unsigned> &cpus)
+{
+    const auto &avail = process_cpus<>::get();
+    if (avail.empty()) {
+        // No affinity support.
+        return;
+    }
+    for (auto c : cpus) {
+        if (!std::binary_search(avail.begin(), avail.end(), c)) {
+            pagmo_throw(std::invalid_argument, "cannot pin a thread to the CPU " + std::to_string(c)
+                                                   + ", which is not available to the process");
+        }
+    }
+}
+
+// Pin the calling thread to the input CPUs. An empty list means all
+// the CPUs available to the process. Returns the resulting affinity mask
+// (empty if not supported).
+inline std::vector<unsigned> set_thread_affinity(const std::vector<unsigned> &cpus)
+{
+#if defined(__linux__)
+    const auto &target = cpus.empty() ? process_cpus<>::get() : cpus;
+    if (target.empty()) {
+        return {};
+    }
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto c : target) {
+        if (c < CPU_SETSIZE) {
+            CPU_SET(c, &set);
+        }
+    }
+    if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+        pagmo_throw(std::runtime_error,
+                    std::string("could not set the CPU affinity of the thread: ") + std::strerror(errno));
+    }
+    return get_thread_affinity();
+#else
+    (void)cpus;
+    return {};
+#endif
+}
+
+// The NUMA node containing all the input CPUs, or -1.
+inline int numa_node_of(const std::vector<unsigned> &cpus)
+{
+    if (cpus.empty()) {
+        return -1;
+    }
+    for (const auto &nc : numa_topology()) {
+        if (std::all_of(cpus.begin(), cpus.end(),
+                        [&nc](unsigned c) { return std::binary_search(nc.cpus.begin(), nc.cpus.end(), c); })) {
+            return nc.node;
+        }
+    }
+    return -1;
+}
+}
+}
+
+#endif
@@ -0,0 +1,214 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_DETAIL_ASYNC_EVAL_HPP
+#define PAGMO_DETAIL_ASYNC_EVAL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/evolve_stop.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Asynchronous evaluation of decision vectors, used by the steady-state modes of the algorithms.
+// Up to n_workers evaluations are run concurrently, each worker thread using its own copy of the
+// problem, and the results are retrieved in completion order, so that the caller can submit
+// a new candidate as soon as any evaluation completes. If the problem does not provide at least
+// the basic thread safety guarantee, the evaluations are performed in the calling thread at submission.
+// The fevals counter of the input problem is updated when the results are retrieved, so that
+// the fevals budgets of the islands keep working. The worker threads inherit the evolution stop
+// state of the calling thread (see evolve_stop.hpp).
+class async_eval_pool
+{
+    struct result {
+        std::size_t id;
+        vector_double x;
+        vector_double f;
+        std::exception_ptr error;
+    };
+
+public:
+    async_eval_pool(const problem &p, unsigned n_workers) : m_prob(p)
+    {
+        if (n_workers <= 1u || static_cast<int>(p.get_thread_safety()) < static_cast<int>(thread_safety::basic)) {
+            return;
+        }
+        // NOTE: the copies are made here, in the calling thread, as concurrent
+        // copies of the same problem are not guaranteed to be safe.
+        m_copies.assign(n_workers, p);
+        m_threads.reserve(n_workers);
+        const auto stop_state = evolve_stop_tls<>::s_ptr;
+        try {
+            for (unsigned i = 0; i < n_workers; ++i) {
+                m_threads.emplace_back([this, i, stop_state]() {
+                    evolve_stop_guard esg(stop_state);
+                    this->worker(this->m_copies[i]);
+                });
+            }
+            // LCOV_EXCL_START
+        } catch (...) {
+            finish();
+            throw;
+            // LCOV_EXCL_STOP
+        }
+    }
+    ~async_eval_pool()
+    {
+        try {
+            finish();
+            // LCOV_EXCL_START
+        } catch (...) {
+            std::terminate();
+            // LCOV_EXCL_STOP
+        }
+    }
+    async_eval_pool(const async_eval_pool &) = delete;
+    async_eval_pool &operator=(const async_eval_pool &) = delete;
+    // Submit x for evaluation. id is returned together with the result.
+    void submit(std::size_t id, vector_double x)
+    {
+        if (m_threads.empty()) {
+            result r{id, std::move(x), {}, nullptr};
+            try {
+                r.f = m_prob.fitness(r.x);
+            } catch (...) {
+                r.error = std::current_exception();
+            }
+            m_results.push_back(std::move(r));
+            ++m_pending;
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.push_back(result{id, std::move(x), {}, nullptr});
+            ++m_pending;
+        }
+        m_job_cond.notify_one();
+    }
+    // Number of submitted evaluations whose result has not been retrieved yet.
+    std::size_t n_pending() const
+    {
+        return m_pending;
+    }
+    // Wait for the next completed evaluation. Re-throws the exception raised by the evaluation, if any.
+    // Must be called only if n_pending() is not zero.
+    void next(std::size_t &id, vector_double &x, vector_double &f)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_res_cond.wait(lock, [this]() { return !this->m_results.empty(); });
+        auto r = std::move(m_results.front());
+        m_results.pop_front();
+        --m_pending;
+        lock.unlock();
+        if (!m_threads.empty()) {
+            m_prob.increment_fevals(1u);
+        }
+        if (r.error) {
+            std::rethrow_exception(r.error);
+        }
+        id = r.id;
+        x = std::move(r.x);
+        f = std::move(r.f);
+    }
+    // Discard the queued evaluations, wait for the running ones and join the threads.
+    // The evaluations completed but not retrieved are accounted for in the fevals counter.
+    void finish()
+    {
+        if (m_threads.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_pending -= m_jobs.size();
+            m_jobs.clear();
+        }
+        m_job_cond.notify_all();
+        for (auto &t : m_threads) {
+            t.join();
+        }
+        m_threads.clear();
+        m_prob.increment_fevals(m_results.size());
+        m_pending = 0;
+        m_results.clear();
+    }
+
+private:
+    void worker(const problem &p)
+    {
+        while (true) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_cond.wait(lock, [this]() { return this->m_stop || !this->m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                // Stopping.
+                return;
+            }
+            auto r = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            lock.unlock();
+            try {
+                r.f = p.fitness(r.x);
+            } catch (...) {
+                r.error = std::current_exception();
+            }
+            lock.lock();
+            m_results.push_back(std::move(r));
+            lock.unlock();
+            m_res_cond.notify_one();
+        }
+    }
+    const problem &m_prob;
+    std::vector<problem> m_copies;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_job_cond;
+    std::condition_variable m_res_cond;
+    std::deque<result> m_jobs;
+    std::deque<result> m_results;
+    std::size_t m_pending = 0;
+    bool m_stop = false;
+};
+}
+}
+
+#endif
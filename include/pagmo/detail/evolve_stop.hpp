@@ -0,0 +1,104 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_DETAIL_EVOLVE_STOP_HPP
+#define PAGMO_DETAIL_EVOLVE_STOP_HPP
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// The conditions under which an ongoing evolution should stop. An instance of this
+// class is created by pagmo::island for each evolution task, and it is made visible to the
+// code running the evolution via the thread-local pointer in evolve_stop_tls.
+struct evolve_stop_state {
+    using clock_t = std::chrono::steady_clock;
+    explicit evolve_stop_state(std::shared_ptr<std::atomic<bool>> c) : cancelled(std::move(c))
+    {
+    }
+    // Cancellation or deadline.
+    bool stop_requested() const
+    {
+        return cancelled->load(std::memory_order_relaxed) || (has_deadline && clock_t::now() >= deadline);
+    }
+    // As above, plus the fevals budget, given the current value of the fevals counter.
+    bool stop_requested(unsigned long long fevals) const
+    {
+        // NOTE: the fevals counter might go backwards if the population is replaced
+        // during the evolution. In such case, we don't consider the budget exhausted.
+        return stop_requested() || (fevals >= fevals_start && fevals - fevals_start >= max_fevals);
+    }
+    bool has_fevals_limit() const
+    {
+        return max_fevals != std::numeric_limits<unsigned long long>::max();
+    }
+    // The cancellation flag, shared by all the evolutions of an island.
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    bool has_deadline = false;
+    clock_t::time_point deadline;
+    unsigned long long max_fevals = std::numeric_limits<unsigned long long>::max();
+    unsigned long long fevals_start = 0;
+};
+
+// The stop state of the evolution running in the current thread (null if no
+// evolution managed by an island is running).
+template <typename = void>
+struct evolve_stop_tls {
+    static thread_local const evolve_stop_state *s_ptr;
+};
+
+template <typename T>
+thread_local const evolve_stop_state *evolve_stop_tls<T>::s_ptr = nullptr;
+
+// RAII helper to install a stop state in the current thread.
+struct evolve_stop_guard {
+    explicit evolve_stop_guard(const evolve_stop_state *st) : m_prev(evolve_stop_tls<>::s_ptr)
+    {
+        evolve_stop_tls<>::s_ptr = st;
+    }
+    ~evolve_stop_guard()
+    {
+        evolve_stop_tls<>::s_ptr = m_prev;
+    }
+    evolve_stop_guard(const evolve_stop_guard &) = delete;
+    evolve_stop_guard &operator=(const evolve_stop_guard &) = delete;
+    const evolve_stop_state *m_prev;
+};
+}
+}
+
+#endif
@@ -0,0 +1,221 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_FITNESS_CACHE_HPP
+#define PAGMO_FITNESS_CACHE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// A bounded cache mapping decision vectors to fitness vectors, implemented as an open-addressing hash table
+// with linear probing. Decision vectors and fitness vectors are stored contiguously in flat arrays, so that
+// lookups do not allocate. Keys are compared with equal_to_f (i.e., nan == nan).
+// Every slot is tagged with the epoch in which it was written: clear() just starts a new epoch, thus
+// invalidating all the entries in O(1). Once max_size entries are stored in the current epoch, further
+// insertions are ignored.
+// The load factor is kept not larger than 1/2 with a power of two number of slots, so the table has at most
+// n_slots(max_size) slots (fewer than 4 * max_size), each storing nx + nf doubles, a hash and an epoch tag.
+class fitness_cache
+{
+public:
+    using size_type = vector_double::size_type;
+
+    fitness_cache() : m_nx(0u), m_nf(0u), m_max_size(0u), m_size(0u), m_epoch(1u) {}
+    // Empties the cache and prepares it to store up to max_size pairs of decision vectors of size nx
+    // and fitness vectors of size nf.
+    void reset(size_type nx, size_type nf, size_type max_size)
+    {
+        m_nx = nx;
+        m_nf = nf;
+        m_max_size = max_size;
+        m_size = 0u;
+        m_epoch = 1u;
+        m_keys.clear();
+        m_values.clear();
+        m_hashes.clear();
+        m_epochs.clear();
+    }
+    // Invalidates all the entries, keeping the allocated memory.
+    void clear()
+    {
+        m_size = 0u;
+        if (++m_epoch == 0u) {
+            // The epoch counter wrapped around: reset the tags by hand.
+            std::fill(m_epochs.begin(), m_epochs.end(), 0u);
+            m_epoch = 1u;
+        }
+    }
+    size_type size() const
+    {
+        return m_size;
+    }
+    size_type max_size() const
+    {
+        return m_max_size;
+    }
+    // Maximum number of slots of a cache storing up to max_size entries: the smallest power of two
+    // (not smaller than 16) which is at least 2 * max_size.
+    static size_type n_slots(size_type max_size)
+    {
+        size_type retval = 16u;
+        while (retval < 2u * max_size) {
+            retval *= 2u;
+        }
+        return retval;
+    }
+    // Returns a pointer to the nf values of the fitness associated to x, or nullptr if x is not in the cache.
+    const double *find(const vector_double &x) const
+    {
+        assert(x.size() == m_nx);
+        if (!m_size) {
+            return nullptr;
+        }
+        const auto i = locate(x.data(), hash(x.data()));
+        return m_epochs[i] == m_epoch ? m_values.data() + i * m_nf : nullptr;
+    }
+    // Stores the pair (x, f), overwriting the fitness if x is already present. Returns false if the
+    // pair could not be stored because the cache is full.
+    bool insert(const vector_double &x, const vector_double &f)
+    {
+        assert(x.size() == m_nx);
+        assert(f.size() == m_nf);
+        const auto h = hash(x.data());
+        if (m_size) {
+            const auto i = locate(x.data(), h);
+            if (m_epochs[i] == m_epoch) {
+                std::copy(f.begin(), f.end(), m_values.data() + i * m_nf);
+                return true;
+            }
+        }
+        if (m_size == m_max_size) {
+            return false;
+        }
+        if (m_hashes.size() < 2u * (m_size + 1u)) {
+            // Keep the load factor not larger than 1/2.
+            grow();
+        }
+        write(locate(x.data(), h), h, x.data(), f.data());
+        ++m_size;
+        return true;
+    }
+
+private:
+    // Hash of a decision vector. Zeroes of any sign and all nans have the same hash, consistently with equal_to_f.
+    std::uint64_t hash(const double *x) const
+    {
+        std::uint64_t retval = 0xcbf29ce484222325ULL;
+        for (size_type i = 0u; i < m_nx; ++i) {
+            double el = x[i];
+            if (el == 0.) {
+                el = 0.;
+            } else if (std::isnan(el)) {
+                el = std::numeric_limits<double>::quiet_NaN();
+            }
+            std::uint64_t bits;
+            std::memcpy(&bits, &el, sizeof(double));
+            retval = (retval ^ bits) * 0x100000001b3ULL;
+            retval ^= retval >> 29u;
+        }
+        // Final avalanche (from splitmix64), as the low bits are used to select the slot.
+        retval = (retval ^ (retval >> 30u)) * 0xbf58476d1ce4e5b9ULL;
+        retval = (retval ^ (retval >> 27u)) * 0x94d049bb133111ebULL;
+        return retval ^ (retval >> 31u);
+    }
+    // Index of the slot containing x (if present) or of the free slot where x would be stored.
+    size_type locate(const double *x, std::uint64_t h) const
+    {
+        const auto mask = m_hashes.size() - 1u;
+        auto i = static_cast<size_type>(h) & mask;
+        while (m_epochs[i] == m_epoch && !(m_hashes[i] == h && equal(m_keys.data() + i * m_nx, x))) {
+            i = (i + 1u) & mask;
+        }
+        return i;
+    }
+    bool equal(const double *a, const double *b) const
+    {
+        return std::equal(a, a + m_nx, b, equal_to_f<double>);
+    }
+    void write(size_type i, std::uint64_t h, const double *x, const double *f)
+    {
+        std::copy(x, x + m_nx, m_keys.data() + i * m_nx);
+        std::copy(f, f + m_nf, m_values.data() + i * m_nf);
+        m_hashes[i] = h;
+        m_epochs[i] = m_epoch;
+    }
+    // Doubles the number of slots (starting from 16), re-inserting the valid entries.
+    void grow()
+    {
+        const auto new_n_slots = std::max(size_type(16u), 2u * m_hashes.size());
+        std::vector<double> old_keys(new_n_slots * m_nx), old_values(new_n_slots * m_nf);
+        std::vector<std::uint64_t> old_hashes(new_n_slots);
+        std::vector<unsigned> old_epochs(new_n_slots, 0u);
+        old_keys.swap(m_keys);
+        old_values.swap(m_values);
+        old_hashes.swap(m_hashes);
+        old_epochs.swap(m_epochs);
+        const auto mask = new_n_slots - 1u;
+        for (size_type j = 0u; j < old_hashes.size(); ++j) {
+            if (old_epochs[j] == m_epoch) {
+                auto i = static_cast<size_type>(old_hashes[j]) & mask;
+                while (m_epochs[i] == m_epoch) {
+                    i = (i + 1u) & mask;
+                }
+                write(i, old_hashes[j], old_keys.data() + j * m_nx, old_values.data() + j * m_nf);
+            }
+        }
+    }
+
+    size_type m_nx;
+    size_type m_nf;
+    size_type m_max_size;
+    size_type m_size;
+    unsigned m_epoch;
+    std::vector<double> m_keys;
+    std::vector<double> m_values;
+    std::vector<std::uint64_t> m_hashes;
+    std::vector<unsigned> m_epochs;
+};
+}
+}
+
+#endif
@@ -0,0 +1,207 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_KD_TREE_HPP
+#define PAGMO_KD_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/parallel_for.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Squared euclidean distance between two points of dimension M stored contiguously.
+inline double knn_distance2(const double *a, const double *b, vector_double::size_type M)
+{
+    double retval = 0.;
+    for (decltype(M) l = 0u; l < M; ++l) {
+        retval += (a[l] - b[l]) * (a[l] - b[l]);
+    }
+    return retval;
+}
+
+// A static kd-tree over a set of (finite) points having all the same dimension, used for the k-nearest
+// neighbours queries of kNN().
+// The tree is implicit: the points are referenced by a permutation of their indices in which every node
+// is identified by the median position of its range [b, e). The subranges [b, mid) and [mid + 1, e) are the
+// children of the node and ranges not larger than leaf_size are leaves. As the nodes of disjoint ranges never
+// overlap, subtrees can be built concurrently and the result does not depend on the number of threads.
+class kd_tree
+{
+public:
+    using size_type = vector_double::size_type;
+    // A neighbour candidate: squared distance and index. Candidates are ordered lexicographically,
+    // so that ties in the distance are broken by the index.
+    using candidate = std::pair<double, size_type>;
+
+    kd_tree(const std::vector<vector_double> &points, unsigned n_threads)
+        : m_N(points.size()), m_M(m_N ? points[0].size() : 0u), m_pts(m_N * m_M), m_idx(m_N), m_split(m_N, 0u)
+    {
+        for (decltype(m_N) i = 0u; i < m_N; ++i) {
+            std::copy(points[i].begin(), points[i].end(), m_pts.data() + i * m_M);
+            m_idx[i] = i;
+        }
+        // Split sequentially the top levels of the tree until there are enough independent
+        // subtrees to keep all threads busy, then build the subtrees in parallel.
+        std::vector<std::pair<size_type, size_type>> ranges{{0u, m_N}}, next;
+        while (ranges.size() < n_threads) {
+            next.clear();
+            for (const auto &r : ranges) {
+                const auto mid = split(r.first, r.second);
+                if (mid != r.second) {
+                    next.emplace_back(r.first, mid);
+                    next.emplace_back(mid + 1u, r.second);
+                }
+            }
+            if (next.empty()) {
+                return;
+            }
+            ranges.swap(next);
+        }
+        parallel_for(ranges.size(), n_threads, [this, &ranges](std::size_t b, std::size_t e, unsigned) {
+            for (auto i = b; i < e; ++i) {
+                this->build(ranges[i].first, ranges[i].second);
+            }
+        });
+    }
+    // Writes in out the indices of the k nearest neighbours of the point of index i (the point itself
+    // excluded), sorted by distance. heap is a workspace.
+    void query(size_type i, size_type k, std::vector<size_type> &out, std::vector<candidate> &heap) const
+    {
+        heap.clear();
+        if (k) {
+            query_impl(m_pts.data() + i * m_M, i, k, 0u, m_N, heap);
+        }
+        std::sort_heap(heap.begin(), heap.end());
+        out.resize(heap.size());
+        std::transform(heap.begin(), heap.end(), out.begin(), [](const candidate &c) { return c.second; });
+    }
+
+private:
+    static const size_type leaf_size = 8u;
+    // Splits the range [b, e) on the median along the dimension of maximum spread, returning the median
+    // position, or e if the range is a leaf.
+    size_type split(size_type b, size_type e)
+    {
+        if (e - b <= leaf_size) {
+            return e;
+        }
+        size_type dim = 0u;
+        double max_spread = -1.;
+        for (decltype(m_M) l = 0u; l < m_M; ++l) {
+            auto lo = std::numeric_limits<double>::max(), hi = std::numeric_limits<double>::lowest();
+            for (auto j = b; j < e; ++j) {
+                const auto x = m_pts[m_idx[j] * m_M + l];
+                lo = std::min(lo, x);
+                hi = std::max(hi, x);
+            }
+            if (hi - lo > max_spread) {
+                max_spread = hi - lo;
+                dim = l;
+            }
+        }
+        const auto mid = b + (e - b) / 2u;
+        const double *pts = m_pts.data();
+        const auto M = m_M;
+        const auto first = m_idx.begin();
+        std::nth_element(first + static_cast<std::ptrdiff_t>(b), first + static_cast<std::ptrdiff_t>(mid),
+                         first + static_cast<std::ptrdiff_t>(e), [pts, M, dim](size_type a, size_type c) {
+                             return candidate{pts[a * M + dim], a} < candidate{pts[c * M + dim], c};
+                         });
+        m_split[mid] = dim;
+        return mid;
+    }
+    void build(size_type b, size_type e)
+    {
+        const auto mid = split(b, e);
+        if (mid != e) {
+            build(b, mid);
+            build(mid + 1u, e);
+        }
+    }
+    void consider(const double *q, size_type i, size_type j, size_type k, std::vector<candidate> &heap) const
+    {
+        if (j == i) {
+            return;
+        }
+        const candidate c{knn_distance2(q, m_pts.data() + j * m_M, m_M), j};
+        if (heap.size() < k) {
+            heap.push_back(c);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (c < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = c;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+    void query_impl(const double *q, size_type i, size_type k, size_type b, size_type e,
+                    std::vector<candidate> &heap) const
+    {
+        if (e - b <= leaf_size) {
+            for (auto j = b; j < e; ++j) {
+                consider(q, i, m_idx[j], k, heap);
+            }
+            return;
+        }
+        const auto mid = b + (e - b) / 2u;
+        const auto p = m_idx[mid];
+        const auto dim = m_split[mid];
+        consider(q, i, p, k, heap);
+        const auto diff = q[dim] - m_pts[p * m_M + dim];
+        if (diff < 0.) {
+            query_impl(q, i, k, b, mid, heap);
+            if (heap.size() < k || !(heap.front().first < diff * diff)) {
+                query_impl(q, i, k, mid + 1u, e, heap);
+            }
+        } else {
+            query_impl(q, i, k, mid + 1u, e, heap);
+            if (heap.size() < k || !(heap.front().first < diff * diff)) {
+                query_impl(q, i, k, b, mid, heap);
+            }
+        }
+    }
+    size_type m_N;
+    size_type m_M;
+    vector_double m_pts;
+    std::vector<size_type> m_idx;
+    std::vector<size_type> m_split;
+};
+}
+}
+
+#endif
@@ -0,0 +1,119 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PARALLEL_FOR_HPP
+#define PAGMO_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <pagmo/detail/evolve_stop.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Number of threads to be used for processing n items in parallel. A requested
+// value of zero means "as many threads as the hardware supports". The result is
+// never larger than n and never smaller than 1.
+inline unsigned parallel_n_threads(unsigned requested, std::size_t n)
+{
+    if (requested == 0u) {
+        // NOTE: hardware_concurrency() is allowed to return zero if the
+        // value is not computable.
+        requested = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    if (n < requested) {
+        requested = static_cast<unsigned>(std::max(n, std::size_t(1)));
+    }
+    return requested;
+}
+
+// Invoke f(begin, end, block) on n_threads contiguous blocks partitioning the [0, n) range, block being
+// the index of the block.
+// The last block is processed in the calling thread, the others in freshly-spawned threads.
+// The block boundaries depend only on n and n_threads, so that f can rely on them in order to set up
+// per-block state. All the threads are joined before returning and, if any block threw, the exception
+// thrown by the block with the lowest index is re-thrown in the calling thread.
+// The spawned threads inherit the evolution stop state of the calling thread (see evolve_stop.hpp).
+template <typename F>
+inline void parallel_for(std::size_t n, unsigned n_threads, const F &f)
+{
+    if (n_threads <= 1u || n <= 1u) {
+        f(std::size_t(0), n, 0u);
+        return;
+    }
+    n_threads = parallel_n_threads(n_threads, n);
+    const auto block_size = n / n_threads, remainder = n % n_threads;
+    // The first 'remainder' blocks get one extra item.
+    auto block_begin
+        = [block_size, remainder](std::size_t i) { return i * block_size + std::min(i, std::size_t(remainder)); };
+    std::vector<std::exception_ptr> errors(n_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1u);
+    const auto stop_state = evolve_stop_tls<>::s_ptr;
+    auto run_block = [&f, &errors, &block_begin, stop_state](std::size_t i) {
+        try {
+            evolve_stop_guard esg(stop_state);
+            f(block_begin(i), block_begin(i + 1u), static_cast<unsigned>(i));
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    try {
+        for (std::size_t i = 0u; i < n_threads - 1u; ++i) {
+            threads.emplace_back(run_block, i);
+        }
+        // LCOV_EXCL_START
+    } catch (...) {
+        // Thread creation failed: join what we started before bailing out.
+        for (auto &t : threads) {
+            t.join();
+        }
+        throw;
+        // LCOV_EXCL_STOP
+    }
+    run_block(n_threads - 1u);
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (const auto &e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+}
+}
+
+#endif
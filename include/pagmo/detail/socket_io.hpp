@@ -0,0 +1,288 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_DETAIL_SOCKET_IO_HPP
+#define PAGMO_DETAIL_SOCKET_IO_HPP
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+
+#define PAGMO_DETAIL_POSIX_SOCKETS
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Message tags. A request consists of a serialised algorithm and population,
+// the reply of either the evolved population or an error message.
+enum : char { socket_msg_evolve = 0, socket_msg_population = 0, socket_msg_error = 1 };
+
+// Error message from errno.
+inline std::string socket_errno_str(const std::string &what)
+{
+    return what + " failed with error: " + std::strerror(errno);
+}
+
+// The maximum duration (in milliseconds) of the poll() calls of the functions below.
+// The stop predicates are checked between successive calls.
+constexpr int socket_poll_interval = 100;
+
+// Stop predicate which never requests to stop: the I/O functions
+// invoked with it just block.
+struct socket_no_stop {
+    bool operator()() const
+    {
+        return false;
+    }
+};
+
+// Wait until fd is ready for events (POLLIN or POLLOUT). Returns false if
+// stop() returned true before fd became ready. Errors and hangups count as readiness,
+// so that they are reported by the subsequent I/O call.
+template <typename F>
+inline bool socket_wait(int fd, short events, const F &stop)
+{
+    while (!stop()) {
+        ::pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = events;
+        pfd.revents = 0;
+        const auto ret = ::poll(&pfd, 1, socket_poll_interval);
+        if (ret > 0 || (ret == -1 && errno != EINTR)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool socket_wait(int, short, const socket_no_stop &)
+{
+    return true;
+}
+
+// Write the whole buffer to fd. Returns false if stop() returned true before
+// the buffer was written.
+template <typename F = socket_no_stop>
+inline bool socket_write_all(int fd, const char *buf, std::size_t size, const F &stop = F{})
+{
+#if defined(MSG_NOSIGNAL)
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    while (size) {
+        if (!socket_wait(fd, POLLOUT, stop)) {
+            return false;
+        }
+        const auto ret = ::send(fd, buf, size, flags);
+        if (ret == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            pagmo_throw(std::runtime_error, socket_errno_str("send()"));
+        }
+        buf += ret;
+        size -= static_cast<std::size_t>(ret);
+    }
+    return true;
+}
+
+// Read exactly size bytes from fd. Returns false on EOF or error, or if stop()
+// returned true before the bytes were read.
+template <typename F = socket_no_stop>
+inline bool socket_read_all(int fd, char *buf, std::size_t size, const F &stop = F{})
+{
+    while (size) {
+        if (!socket_wait(fd, POLLIN, stop)) {
+            return false;
+        }
+        const auto ret = ::recv(fd, buf, size, 0);
+        if (ret == -1 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            return false;
+        }
+        buf += ret;
+        size -= static_cast<std::size_t>(ret);
+    }
+    return true;
+}
+
+// The messages consist of a tag byte, followed by the payload size
+// (64-bit little-endian integer) and by the payload.
+
+// Maximum accepted payload size (512 MiB). The size is read from the wire
+// before the payload, so it must be validated before allocating the buffer.
+constexpr std::uint64_t socket_max_msg_size = 512ull * 1024ull * 1024ull;
+
+// Returns false if stop() returned true before the message was sent.
+template <typename F = socket_no_stop>
+inline bool socket_send_msg(int fd, char tag, const std::string &payload, const F &stop = F{})
+{
+    char header[9];
+    header[0] = tag;
+    auto size = static_cast<std::uint64_t>(payload.size());
+    for (std::size_t i = 1; i < sizeof(header); ++i) {
+        header[i] = static_cast<char>(static_cast<unsigned char>(size & 0xFFu));
+        size >>= 8;
+    }
+    return socket_write_all(fd, header, sizeof(header), stop)
+           && socket_write_all(fd, payload.data(), payload.size(), stop);
+}
+
+// Returns false on EOF or error (or if stop() returned true before the message was
+// received), throws if the announced payload size exceeds socket_max_msg_size.
+template <typename F = socket_no_stop>
+inline bool socket_recv_msg(int fd, char &tag, std::string &payload, const F &stop = F{})
+{
+    char header[9];
+    if (!socket_read_all(fd, header, sizeof(header), stop)) {
+        return false;
+    }
+    tag = header[0];
+    std::uint64_t size = 0;
+    for (std::size_t i = sizeof(header) - 1u; i > 0u; --i) {
+        size = (size << 8) | static_cast<unsigned char>(header[i]);
+    }
+    if (size > socket_max_msg_size) {
+        pagmo_throw(std::runtime_error, "a message of " + std::to_string(size)
+                                            + " bytes was received over a socket, but the maximum size is "
+                                            + std::to_string(socket_max_msg_size) + " bytes");
+    }
+    payload.resize(static_cast<std::string::size_type>(size));
+    return size == 0u || socket_read_all(fd, &payload[0], payload.size(), stop);
+}
+
+// Serialise the evolution request for the input algorithm and population.
+template <typename OArchive>
+inline std::string socket_evolve_request(const algorithm &algo, const population &pop)
+{
+    std::ostringstream oss;
+    {
+        OArchive oarchive(oss);
+        oarchive(algo, pop);
+    }
+    return oss.str();
+}
+
+// Serve an evolution request: the reply will contain either the evolved population
+// or the error message. The return value is the tag of the reply. If unsafe_mutex is
+// not null, it will be locked during the evolution if the algorithm or the problem
+// do not provide the basic thread safety guarantee.
+template <typename IArchive, typename OArchive>
+inline char socket_serve_evolve(const std::string &request, std::string &reply, std::mutex *unsafe_mutex = nullptr)
+{
+    try {
+        algorithm algo;
+        population pop;
+        {
+            std::istringstream iss(request);
+            IArchive iarchive(iss);
+            iarchive(algo, pop);
+        }
+        std::unique_lock<std::mutex> lock;
+        if (unsafe_mutex
+            && (static_cast<int>(algo.get_thread_safety()) < static_cast<int>(thread_safety::basic)
+                || static_cast<int>(pop.get_problem().get_thread_safety())
+                       < static_cast<int>(thread_safety::basic))) {
+            lock = std::unique_lock<std::mutex>(*unsafe_mutex);
+        }
+        pop = algo.evolve(pop);
+        std::ostringstream oss;
+        {
+            OArchive oarchive(oss);
+            oarchive(pop);
+        }
+        reply = oss.str();
+        return socket_msg_population;
+    } catch (const std::exception &e) {
+        reply = e.what();
+    } catch (...) {
+        reply = "unknown exception";
+    }
+    return socket_msg_error;
+}
+
+// Serve the evolution requests received over the connected socket fd until the
+// peer closes the connection. See socket_serve_evolve() for unsafe_mutex.
+inline void socket_serve(int fd, std::mutex *unsafe_mutex = nullptr)
+{
+    char tag;
+    std::string request, reply;
+    while (socket_recv_msg(fd, tag, request)) {
+        char rtag = socket_msg_error;
+        if (tag == socket_msg_evolve) {
+            rtag = socket_serve_evolve<cereal::PortableBinaryInputArchive, cereal::PortableBinaryOutputArchive>(
+                request, reply, unsafe_mutex);
+        } else {
+            reply = "unknown request";
+        }
+        socket_send_msg(fd, rtag, reply);
+    }
+}
+
+// Deserialise the population from a reply.
+template <typename IArchive>
+inline population socket_evolve_reply(const std::string &reply)
+{
+    population pop;
+    std::istringstream iss(reply);
+    {
+        IArchive iarchive(iss);
+        iarchive(pop);
+    }
+    return pop;
+}
+}
+}
+
+#endif
+
+#endif
@@ -29,17 +29,19 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_TASK_QUEUE_HPP
 #define PAGMO_TASK_QUEUE_HPP
 
+#include <condition_variable>
+#include <cstddef>
 #include <cstdlib>
-#include <functional>
-#include <future>
-#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <pagmo/exceptions.hpp>
+#include <pagmo/type_traits.hpp>
 
 namespace pagmo
 {
@@ -47,37 +49,192 @@ namespace pagmo
 namespace detail
 {
 
+// A type-erased nullary callable. Callables which are small enough (and nothrow-movable)
+// are stored inline, the others on the heap. The inline storage is large enough for all
+// the tasks enqueued by pagmo::island, so that enqueueing them does not allocate.
+class small_task
+{
+    enum class op { move, destroy };
+    static const std::size_t storage_size = 64;
+    using storage_t = typename std::aligned_storage<storage_size, alignof(std::max_align_t)>::type;
+    template <typename F>
+    using fits_inline = std::integral_constant<bool, sizeof(F) <= storage_size
+                                                         && alignof(F) <= alignof(std::max_align_t)
+                                                         && std::is_nothrow_move_constructible<F>::value>;
+
+public:
+    small_task() noexcept : m_invoke(nullptr), m_manage(nullptr), m_inline(false) {}
+    template <typename F, enable_if_t<!std::is_same<uncvref_t<F>, small_task>::value, int> = 0>
+    explicit small_task(F &&f) : small_task()
+    {
+        construct<uncvref_t<F>>(std::forward<F>(f), fits_inline<uncvref_t<F>>{});
+    }
+    small_task(small_task &&other) noexcept : small_task()
+    {
+        steal(other);
+    }
+    small_task &operator=(small_task &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            steal(other);
+        }
+        return *this;
+    }
+    small_task(const small_task &) = delete;
+    small_task &operator=(const small_task &) = delete;
+    ~small_task()
+    {
+        reset();
+    }
+    // Destroy the stored callable, if any.
+    void reset() noexcept
+    {
+        if (m_manage) {
+            m_manage(op::destroy, *this, *this);
+            m_invoke = nullptr;
+            m_manage = nullptr;
+            m_inline = false;
+        }
+    }
+    explicit operator bool() const noexcept
+    {
+        return m_invoke != nullptr;
+    }
+    // Whether the callable is stored inline.
+    bool is_inline() const noexcept
+    {
+        return m_inline;
+    }
+    void operator()()
+    {
+        m_invoke(*this);
+    }
+
+private:
+    void steal(small_task &other) noexcept
+    {
+        if (other.m_manage) {
+            other.m_manage(op::move, *this, other);
+            m_invoke = other.m_invoke;
+            m_manage = other.m_manage;
+            m_inline = other.m_inline;
+            other.m_invoke = nullptr;
+            other.m_manage = nullptr;
+            other.m_inline = false;
+        }
+    }
+    template <typename D, typename F>
+    void construct(F &&f, std::true_type)
+    {
+        ::new (static_cast<void *>(&m_storage)) D(std::forward<F>(f));
+        m_invoke = &invoke_inline<D>;
+        m_manage = &manage_inline<D>;
+        m_inline = true;
+    }
+    template <typename D, typename F>
+    void construct(F &&f, std::false_type)
+    {
+        ::new (static_cast<void *>(&m_storage)) D *(new D(std::forward<F>(f)));
+        m_invoke = &invoke_heap<D>;
+        m_manage = &manage_heap<D>;
+    }
+    template <typename D>
+    static D *inline_ptr(small_task &t) noexcept
+    {
+        return reinterpret_cast<D *>(&t.m_storage);
+    }
+    template <typename D>
+    static D *&heap_ptr(small_task &t) noexcept
+    {
+        return *reinterpret_cast<D **>(&t.m_storage);
+    }
+    template <typename D>
+    static void invoke_inline(small_task &t)
+    {
+        (*inline_ptr<D>(t))();
+    }
+    template <typename D>
+    static void manage_inline(op o, small_task &dst, small_task &src) noexcept
+    {
+        if (o == op::move) {
+            ::new (static_cast<void *>(&dst.m_storage)) D(std::move(*inline_ptr<D>(src)));
+        }
+        inline_ptr<D>(src)->~D();
+    }
+    template <typename D>
+    static void invoke_heap(small_task &t)
+    {
+        (*heap_ptr<D>(t))();
+    }
+    template <typename D>
+    static void manage_heap(op o, small_task &dst, small_task &src) noexcept
+    {
+        if (o == op::move) {
+            ::new (static_cast<void *>(&dst.m_storage)) D *(heap_ptr<D>(src));
+        } else {
+            delete heap_ptr<D>(src);
+        }
+    }
+    storage_t m_storage;
+    void (*m_invoke)(small_task &);
+    void (*m_manage)(op, small_task &, small_task &);
+    bool m_inline;
+};
+
+// A bounded FIFO queue of tasks, consumed by a separate thread of execution.
+// The tasks are stored in a ring buffer of small_task allocated upon construction:
+// if the buffer is full, enqueueing blocks until the consumer has made room.
+// Each enqueued task is identified by a ticket (a counter starting from 1), which
+// can be used to wait for the completion of the task and of all the tasks enqueued
+// before it. The tasks must not throw: an exception escaping from a task
+// terminates the program, so errors must be stored by the tasks themselves
+// (this is what pagmo::island does to implement wait_check()).
 struct task_queue {
-    task_queue() : m_stop(false)
+    using ticket = unsigned long long;
+    explicit task_queue(std::size_t capacity = 256u)
+        : m_slots(capacity ? capacity : 1u), m_head(0), m_size(0), m_n_pushed(0), m_n_done(0), m_stop(false),
+          m_idle(false), m_n_full_waiters(0), m_n_done_waiters(0)
     {
         m_thread = std::thread([this]() {
             try {
+                std::unique_lock<std::mutex> lock(this->m_mutex);
                 while (true) {
-                    std::unique_lock<std::mutex> lock(this->m_mutex);
-                    while (!this->m_stop && this->m_tasks.empty()) {
+                    while (!this->m_stop && !this->m_size) {
                         // Need to wait for something to happen only if the task
-                        // list is empty and we are not stopping.
-                        // NOTE: wait will be noexcept in C++14.
+                        // list is empty and we are not stopping. The flag tells the
+                        // producers that a notification is needed.
+                        this->m_idle = true;
                         this->m_cond.wait(lock);
                     }
-                    if (this->m_stop && this->m_tasks.empty()) {
+                    this->m_idle = false;
+                    if (!this->m_size) {
                         // If the stop flag was set, and we do not have more tasks,
                         // just exit.
                         break;
                     }
-                    // NOTE: move constructor of std::function could throw, unfortunately.
-                    std::function<void()> task(std::move(this->m_tasks.front()));
-                    this->m_tasks.pop();
+                    small_task task(std::move(this->m_slots[this->m_head]));
+                    this->m_head = (this->m_head + 1u) % this->m_slots.size();
+                    --this->m_size;
+                    if (this->m_n_full_waiters) {
+                        this->m_not_full.notify_all();
+                    }
                     lock.unlock();
                     task();
+                    // NOTE: destroy the task (and whatever it captured) before
+                    // signalling its completion.
+                    task.reset();
+                    lock.lock();
+                    ++this->m_n_done;
+                    if (this->m_n_done_waiters) {
+                        this->m_done_cond.notify_all();
+                    }
                 }
                 // LCOV_EXCL_START
             } catch (...) {
                 // The errors we could get here are:
                 // - threading primitives,
-                // - move-construction of std::function,
-                // - queue popping (I guess unlikely, as the destructor of std::function
-                //   is noexcept).
+                // - exceptions thrown by the tasks.
                 // In any case, not much that can be done to recover from this, better to abort.
                 // NOTE: logging candidate.
                 std::abort();
@@ -97,27 +254,87 @@ struct task_queue {
             // LCOV_EXCL_STOP
         }
     }
-    // Main enqueue function.
+    // Main enqueue function. Returns the ticket of the task. If an exception is thrown,
+    // the task is not enqueued.
     template <typename F>
-    std::future<void> enqueue(F &&f)
-    {
-        using p_task_type = std::packaged_task<void()>;
-        // NOTE: here we have a 2-stage construction of the task:
-        // - std::packaged_task gives us the std::future machinery,
-        // - std::function (in m_tasks) gives the uniform type interface via type erasure.
-        auto task = std::make_shared<p_task_type>(std::forward<F>(f));
-        std::future<void> res = task->get_future();
+    ticket enqueue(F &&f)
+    {
+        return enqueue(std::forward<F>(f), []() { return 0; });
+    }
+    // Like enqueue(), but if the queue is full on_block() is invoked before blocking, and the object
+    // it returns is kept alive (with the queue's lock released) until enqueue() returns. This is used
+    // by pagmo::island to release the GIL in Python while waiting for room (see wait_raii).
+    template <typename F, typename W>
+    ticket enqueue(F &&f, const W &on_block)
+    {
         {
             std::unique_lock<std::mutex> lock(m_mutex);
-            if (m_stop) {
-                // Enqueueing is not allowed if the queue is stopped.
-                pagmo_throw(std::runtime_error, "cannot enqueue task while the task queue is stopping");
+            if (m_stop || m_size < m_slots.size()) {
+                wait_for_room(lock);
+                const auto retval = push(std::forward<F>(f));
+                notify_consumer();
+                return retval;
             }
-            m_tasks.push([task]() { (*task)(); });
         }
-        // NOTE: notify_one is noexcept.
-        m_cond.notify_one();
-        return res;
+        // NOTE: the object returned by on_block() is created and destroyed
+        // without holding the queue's lock, as its ctor/dtor might block (e.g.,
+        // acquiring the GIL) while a task is waiting for the lock.
+        auto blk = on_block();
+        (void)blk;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        wait_for_room(lock);
+        const auto retval = push(std::forward<F>(f));
+        notify_consumer();
+        return retval;
+    }
+    // Enqueue the tasks in the range [first, last) (which are copied), locking and waking up the
+    // consumer once per batch. Returns the ticket of the last task (or the ticket of the last
+    // task enqueued before the call if the range is empty). Batches larger than the capacity
+    // of the queue are enqueued in chunks. If an exception is thrown, the tasks
+    // preceding the one that failed remain enqueued.
+    template <typename It>
+    ticket enqueue_batch(It first, It last)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto retval = m_n_pushed;
+        while (first != last) {
+            wait_for_room(lock);
+            try {
+                for (; first != last && m_size < m_slots.size(); ++first) {
+                    retval = push(*first);
+                }
+                // LCOV_EXCL_START
+            } catch (...) {
+                notify_consumer();
+                throw;
+                // LCOV_EXCL_STOP
+            }
+            notify_consumer();
+        }
+        return retval;
+    }
+    // Block until the task with ticket t (and all the tasks enqueued before it) has been completed.
+    // NOTE: this must not be invoked from a task, as it would deadlock.
+    void wait(ticket t)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_n_done >= t) {
+            return;
+        }
+        ++m_n_done_waiters;
+        m_done_cond.wait(lock, [this, t]() { return this->m_n_done >= t; });
+        --m_n_done_waiters;
+    }
+    // Check if the task with ticket t has been completed.
+    bool done(ticket t)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_n_done >= t;
+    }
+    // Number of tasks that can be queued.
+    std::size_t capacity() const
+    {
+        return m_slots.size();
     }
     // NOTE: we call this only from dtor, it is here in order to be able to test it.
     // So the exception handling in dtor will suffice, keep it in mind if things change.
@@ -134,13 +351,56 @@ struct task_queue {
         // Notify the thread that queue has been stopped, wait for it
         // to consume the remaining tasks and exit.
         m_cond.notify_one();
+        m_not_full.notify_all();
         m_thread.join();
     }
+
+private:
+    // Wait until there is room for at least one task. To be called with the lock held.
+    void wait_for_room(std::unique_lock<std::mutex> &lock)
+    {
+        while (true) {
+            if (m_stop) {
+                // Enqueueing is not allowed if the queue is stopped.
+                pagmo_throw(std::runtime_error, "cannot enqueue task while the task queue is stopping");
+            }
+            if (m_size < m_slots.size()) {
+                return;
+            }
+            ++m_n_full_waiters;
+            m_not_full.wait(lock);
+            --m_n_full_waiters;
+        }
+    }
+    // Store a task in the first free slot. To be called with the lock held, when there is room.
+    template <typename F>
+    ticket push(F &&f)
+    {
+        m_slots[(m_head + m_size) % m_slots.size()] = small_task(std::forward<F>(f));
+        ++m_size;
+        return ++m_n_pushed;
+    }
+    // Wake up the consumer, if it is waiting for tasks. To be called with the lock held.
+    void notify_consumer()
+    {
+        if (m_idle) {
+            m_cond.notify_one();
+        }
+    }
     // Data members.
+    std::vector<small_task> m_slots;
+    std::size_t m_head;
+    std::size_t m_size;
+    ticket m_n_pushed;
+    ticket m_n_done;
     bool m_stop;
+    bool m_idle;
+    unsigned m_n_full_waiters;
+    unsigned m_n_done_waiters;
     std::condition_variable m_cond;
+    std::condition_variable m_not_full;
+    std::condition_variable m_done_cond;
     std::mutex m_mutex;
-    std::queue<std::function<void()>> m_tasks;
     std::thread m_thread;
 };
 }
@@ -0,0 +1,137 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_EVOLVE_LIMITS_HPP
+#define PAGMO_EVOLVE_LIMITS_HPP
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <pagmo/detail/evolve_stop.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+
+namespace pagmo
+{
+
+/// Limits for an evolution.
+/**
+ * This class groups the limits that can be imposed on an evolution launched via
+ * pagmo::island::evolve() or pagmo::archipelago::evolve():
+ *
+ * - a wall-clock timeout, measured from the moment the evolution is launched (that is, the time spent
+ *   by the evolution waiting in the island's queue is included),
+ * - a budget of fitness evaluations, measured on the problem of the island's population.
+ *
+ * When a limit is reached, the island will not start further invocations of the <tt>run_evolve()</tt> method
+ * of the UDI, and the algorithms polling pagmo::evolve_stop_requested() will stop at the end of the current
+ * generation, returning their current population. Hitting a limit is not an error, and no exception is raised.
+ */
+class evolve_limits
+{
+public:
+    /// Constructor.
+    /**
+     * The default constructor imposes no limits.
+     *
+     * @param max_seconds the maximum wall-clock duration of the evolution, in seconds.
+     * @param max_fevals the maximum number of fitness evaluations.
+     *
+     * @throws std::invalid_argument if \p max_seconds is negative or NaN.
+     */
+    explicit evolve_limits(double max_seconds = std::numeric_limits<double>::infinity(),
+                           unsigned long long max_fevals = std::numeric_limits<unsigned long long>::max())
+        : m_max_seconds(max_seconds), m_max_fevals(max_fevals)
+    {
+        if (std::isnan(max_seconds) || max_seconds < 0.) {
+            pagmo_throw(std::invalid_argument, "The maximum duration of an evolution must be non-negative, but a "
+                                               "value of "
+                                                   + std::to_string(max_seconds) + " was provided instead");
+        }
+    }
+    /// Get the timeout.
+    /**
+     * @return the maximum wall-clock duration of the evolution, in seconds.
+     */
+    double get_max_seconds() const
+    {
+        return m_max_seconds;
+    }
+    /// Get the fitness evaluations budget.
+    /**
+     * @return the maximum number of fitness evaluations.
+     */
+    unsigned long long get_max_fevals() const
+    {
+        return m_max_fevals;
+    }
+
+private:
+    double m_max_seconds;
+    unsigned long long m_max_fevals;
+};
+
+/// Check if the current evolution should stop.
+/**
+ * This function is meant to be polled by algorithms between generations. It returns \p true if the
+ * evolution running in the current thread was launched by a pagmo::island, and either the evolution
+ * was cancelled (see pagmo::island::cancel()) or one of the pagmo::evolve_limits of the evolution
+ * was reached. In all the other cases (e.g., when algorithm::evolve() is called directly by the user),
+ * \p false is returned.
+ *
+ * The state of the evolution is propagated to the threads used by pagmo::bfe, so that user-defined problems
+ * can also poll this function (e.g., between the chunks of an expensive batch evaluation).
+ *
+ * @param p the problem being optimised, used to check the budget of fitness evaluations.
+ *
+ * @return \p true if the current evolution should stop, \p false otherwise.
+ */
+inline bool evolve_stop_requested(const problem &p)
+{
+    const auto st = detail::evolve_stop_tls<>::s_ptr;
+    return st && st->stop_requested(p.get_fevals());
+}
+
+/// Check if the current evolution should stop (without budget of fitness evaluations).
+/**
+ * This function is equivalent to evolve_stop_requested(const problem &), but the budget of fitness
+ * evaluations is not checked.
+ *
+ * @return \p true if the current evolution was cancelled or if its deadline expired, \p false otherwise.
+ */
+inline bool evolve_stop_requested()
+{
+    const auto st = detail::evolve_stop_tls<>::s_ptr;
+    return st && st->stop_requested();
+}
+}
+
+#endif
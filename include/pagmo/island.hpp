@@ -31,13 +31,14 @@ see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/any.hpp>
 #include <boost/iterator/indirect_iterator.hpp>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <exception>
 #include <functional>
-#include <future>
 #include <initializer_list>
 #include <iostream>
 #include <memory>
@@ -52,10 +53,14 @@ see https://www.gnu.org/licenses/. */
 #include <vector>
 
 #include <pagmo/algorithm.hpp>
+#include <pagmo/detail/affinity.hpp>
+#include <pagmo/detail/evolve_stop.hpp>
 #include <pagmo/detail/make_unique.hpp>
 #include <pagmo/detail/task_queue.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
+#include <pagmo/pareto_archive.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
 #include <pagmo/serialization.hpp>
@@ -230,47 +235,6 @@ struct isl_inner final : isl_inner_base {
     T m_value;
 };
 
-// NOTE: this is just a simple wrapper to force noexcept behaviour on std::future::wait().
-// If f.wait() throws something, the program will terminate. A valid std::future should not
-// throw, but technically the standard does not guarantee that. Having this noexcept wrapper
-// simplifies reasoning about exception behaviour in wait(), wait_check(), etc.
-inline void wait_f(const std::future<void> &f) noexcept
-{
-    assert(f.valid());
-    f.wait();
-}
-
-// Small helper to determine if a future holds an exception.
-// The noexcept reasoning is the same as above. Here we could fail
-// because of memory errors, but there's not much we can do in such
-// a case.
-inline bool future_has_exception(std::future<void> &f) noexcept
-{
-    assert(f.valid());
-    // Try to get the error.
-    try {
-        f.get();
-    } catch (...) {
-        // An error was generated. Re-store the exception into the future
-        // and return true.
-        // http://en.cppreference.com/w/cpp/experimental/make_exceptional_future
-        std::promise<void> p;
-        p.set_exception(std::current_exception());
-        f = p.get_future();
-        return true;
-    }
-    // No error was raised. Need to reconstruct f to a valid state.
-    std::promise<void> p;
-    p.set_value();
-    f = p.get_future();
-    return false;
-}
-
-// Small helper to check if a future is still running.
-inline bool future_running(const std::future<void> &f)
-{
-    return f.wait_for(std::chrono::duration<int>::zero()) != std::future_status::ready;
-}
 }
 
 /// Thread island.
@@ -300,6 +264,113 @@ public:
     }
 };
 
+/// Evolution status.
+/**
+ * This enumeration contains status flags used to represent the current
+ * status of asynchronous evolution/optimisation in pagmo::island and pagmo::archipelago.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. seealso::
+ *
+ *    :cpp:func:`pagmo::island::status()` and :cpp:func:`pagmo::archipelago::status()`.
+ *
+ * \endverbatim
+ */
+enum class evolve_status {
+    idle = 0,       ///< No asynchronous operations are ongoing, and no error was generated
+                    /// by an asynchronous operation in the past
+    busy = 1,       ///< Asynchronous operations are ongoing, and no error was generated
+                    /// by an asynchronous operation in the past
+    idle_error = 2, ///< Idle with error: no asynchronous operations are ongoing, but an error
+                    /// was generated by an asynchronous operation in the past
+    busy_error = 3  ///< Busy with error: asynchronous operations are ongoing, and an error
+                    /// was generated by an asynchronous operation in the past
+};
+
+/// Island snapshot.
+/**
+ * This structure contains a summary of the state of a pagmo::island. The islands publish a new immutable
+ * snapshot each time their state changes, and the latest snapshot can be fetched via island::get_snapshot()
+ * without locking the island's population and without interfering with ongoing evolutions.
+ */
+struct island_snapshot {
+    /// Version.
+    /**
+     * The version is incremented at each publication of a new snapshot by the island.
+     */
+    unsigned long long version = 0;
+    /// Champion decision vector.
+    /**
+     * The decision vector of the champion of the island's population, as returned by
+     * population::champion_x(). It will be empty if the champion is not available (e.g., if the
+     * population is empty, or if the problem is multi-objective or stochastic).
+     */
+    vector_double champion_x;
+    /// Champion fitness vector.
+    /**
+     * The fitness vector of the champion of the island's population, with the same availability
+     * as island_snapshot::champion_x.
+     */
+    vector_double champion_f;
+    /// Number of fitness evaluations.
+    /**
+     * The number of fitness evaluations of the problem of the island's population.
+     */
+    unsigned long long fevals = 0;
+    /// Number of evolutions.
+    /**
+     * The number of invocations of the <tt>run_evolve()</tt> method of the UDI completed by the island.
+     */
+    unsigned long long n_evolve = 0;
+    /// Status.
+    /**
+     * The status of the asynchronous operations in the island. This flag mirrors the value returned by
+     * island::status(), but it is updated only when an evolution task starts or finishes, and when
+     * island::wait_check() is called.
+     */
+    evolve_status status = evolve_status::idle;
+};
+
+/// Island placement.
+/**
+ * This structure describes the placement of the thread of execution of a pagmo::island on the
+ * CPUs of the machine, as set by island::set_placement() or archipelago::set_placement().
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    Thread placement is supported only on Linux. On the other platforms, the placement
+ *    of an island is always empty.
+ *
+ * \endverbatim
+ */
+struct island_placement {
+    /// CPUs.
+    /**
+     * The CPUs the island's thread is pinned to. It will be empty if the thread is not pinned.
+     */
+    std::vector<unsigned> cpus;
+    /// NUMA node.
+    /**
+     * The NUMA node containing all the CPUs in island_placement::cpus, or -1 if the thread is
+     * not pinned or if its CPUs span multiple NUMA nodes.
+     */
+    int numa_node = -1;
+};
+
+/// Placement policies.
+/**
+ * This enumeration lists the policies that can be used by archipelago::set_placement()
+ * to place the threads of execution of the islands on the CPUs of the machine.
+ */
+enum class placement_policy {
+    none = 0, ///< The threads are not pinned, and they are free to run on any CPU
+    numa = 1, ///< Each thread is pinned to all the CPUs of a NUMA node, with the islands
+              /// distributed round-robin over the NUMA nodes
+    core = 2  ///< Each thread is pinned to a single CPU, with the islands distributed round-robin
+              /// over the CPUs, alternating between NUMA nodes
+};
+
 class archipelago;
 
 namespace detail
@@ -340,6 +411,28 @@ inline void default_island_factory(const algorithm &, const population &, std::u
 template <typename T>
 typename island_factory<T>::func_t island_factory<T>::s_func = default_island_factory;
 
+// Set the population-dependent members of the snapshot s from pop.
+inline void snapshot_population(island_snapshot &s, const population &pop)
+{
+    const auto &prob = pop.get_problem();
+    if (prob.get_nobj() == 1u && !prob.is_stochastic()) {
+        s.champion_x = pop.champion_x();
+        s.champion_f = pop.champion_f();
+    } else {
+        s.champion_x.clear();
+        s.champion_f.clear();
+    }
+    s.fevals = prob.get_fevals();
+}
+
+// Create the initial snapshot of an island with population pop.
+inline std::shared_ptr<const island_snapshot> make_island_snapshot(const population &pop)
+{
+    auto retval = std::make_shared<island_snapshot>();
+    snapshot_population(*retval, pop);
+    return retval;
+}
+
 // NOTE: the idea with this class is that we use it to store the data members of pagmo::island, and,
 // within pagmo::island, we store a pointer to an instance of this struct. The reason for this approach
 // is that, like this, we can provide sensible move semantics: just move the internal pointer of pagmo::island.
@@ -348,7 +441,7 @@ struct island_data {
     // are both thread safe.
     island_data()
         : isl_ptr(make_unique<isl_inner<thread_island>>()), algo(std::make_shared<algorithm>()),
-          pop(std::make_shared<population>())
+          pop(std::make_shared<population>()), snapshot(make_island_snapshot(*pop))
     {
     }
     // This is the main ctor, from an algo and a population. The UDI type will be selected
@@ -356,7 +449,7 @@ struct island_data {
     template <typename Algo, typename Pop>
     explicit island_data(Algo &&a, Pop &&p)
         : algo(std::make_shared<algorithm>(std::forward<Algo>(a))),
-          pop(std::make_shared<population>(std::forward<Pop>(p)))
+          pop(std::make_shared<population>(std::forward<Pop>(p))), snapshot(make_island_snapshot(*pop))
     {
         island_factory<>::s_func(*algo, *pop, isl_ptr);
     }
@@ -365,7 +458,7 @@ struct island_data {
     explicit island_data(Isl &&isl, Algo &&a, Pop &&p)
         : isl_ptr(make_unique<isl_inner<uncvref_t<Isl>>>(std::forward<Isl>(isl))),
           algo(std::make_shared<algorithm>(std::forward<Algo>(a))),
-          pop(std::make_shared<population>(std::forward<Pop>(p)))
+          pop(std::make_shared<population>(std::forward<Pop>(p))), snapshot(make_island_snapshot(*pop))
     {
     }
     // This is used only in the copy ctor of island. It's equivalent to the ctor from Algo + pop,
@@ -373,7 +466,7 @@ struct island_data {
     template <typename Algo, typename Pop>
     explicit island_data(std::unique_ptr<isl_inner_base> &&ptr, Algo &&a, Pop &&p)
         : isl_ptr(std::move(ptr)), algo(std::make_shared<algorithm>(std::forward<Algo>(a))),
-          pop(std::make_shared<population>(std::forward<Pop>(p)))
+          pop(std::make_shared<population>(std::forward<Pop>(p))), snapshot(make_island_snapshot(*pop))
     {
     }
     // Delete all the rest, make sure we don't implicitly rely on any of this.
@@ -393,37 +486,34 @@ struct island_data {
     std::shared_ptr<algorithm> algo;
     std::mutex pop_mutex;
     std::shared_ptr<population> pop;
-    std::vector<std::future<void>> futures;
+    // The latest snapshot. It is read via std::atomic_load(), without locking.
+    // Publishers are serialised by snapshot_mutex, which also protects
+    // the number of queued evolution tasks and the first exception thrown
+    // by an evolution task since the last wait_check(), used
+    // to compute the status in the snapshot.
+    std::mutex snapshot_mutex;
+    std::shared_ptr<const island_snapshot> snapshot;
+    unsigned long long n_tasks = 0;
+    std::exception_ptr task_error;
+    // The ticket of the last evolution task pushed to the queue.
+    task_queue::ticket last_task = 0;
     // This will be explicitly set only during archipelago::push_back().
     // In all other situations, it will be null.
     archipelago *archi_ptr = nullptr;
+    // The Pareto archive of the hosting archipelago, if any. It is set by the
+    // archipelago, and read via std::atomic_load() at the end of each evolution.
+    std::shared_ptr<pareto_archive> archive;
+    // The cancellation flag shared by the evolutions launched since
+    // the last call to island::cancel().
+    std::mutex cancel_mutex;
+    std::shared_ptr<std::atomic<bool>> cancel_flag = std::make_shared<std::atomic<bool>>(false);
+    // The placement of the thread of execution of the queue.
+    std::mutex placement_mutex;
+    island_placement placement;
     task_queue queue;
 };
 }
 
-/// Evolution status.
-/**
- * This enumeration contains status flags used to represent the current
- * status of asynchronous evolution/optimisation in pagmo::island and pagmo::archipelago.
- *
- * \verbatim embed:rst:leading-asterisk
- * .. seealso::
- *
- *    :cpp:func:`pagmo::island::status()` and :cpp:func:`pagmo::archipelago::status()`.
- *
- * \endverbatim
- */
-enum class evolve_status {
-    idle = 0,       ///< No asynchronous operations are ongoing, and no error was generated
-                    /// by an asynchronous operation in the past
-    busy = 1,       ///< Asynchronous operations are ongoing, and no error was generated
-                    /// by an asynchronous operation in the past
-    idle_error = 2, ///< Idle with error: no asynchronous operations are ongoing, but an error
-                    /// was generated by an asynchronous operation in the past
-    busy_error = 3  ///< Busy with error: asynchronous operations are ongoing, and an error
-                    /// was generated by an asynchronous operation in the past
-};
-
 namespace detail
 {
 
@@ -528,6 +618,167 @@ class island
         }
         // LCOV_EXCL_STOP
     }
+    // Push the evolution task f to the island's queue, recording its ticket
+    // so that it can be waited upon by wait()/wait_check().
+    template <typename F>
+    void enqueue_evolution(F &&f)
+    {
+        // Account for the new task in the snapshot.
+        publish_snapshot([this](island_snapshot &) { ++this->m_ptr->n_tasks; });
+        try {
+            // NOTE: enqueue either enqueues the task, or throws without having enqueued it.
+            // The tasks of the queue must not throw: the exception raised by f is stored
+            // by task_finished(), to be re-raised by wait_check().
+            // NOTE: if the queue is full, enqueue blocks until the island's thread has made room:
+            // use wait_raii in order not to hold the GIL while waiting in Python.
+            m_ptr->last_task = m_ptr->queue.enqueue(
+                [this, f]() {
+                    try {
+                        f();
+                    } catch (...) {
+                        this->task_finished(std::current_exception());
+                        return;
+                    }
+                    this->task_finished(nullptr);
+                },
+                []() { return detail::wait_raii<>::getter(); });
+            // LCOV_EXCL_START
+        } catch (...) {
+            // We end up here only if enqueue threw. In such a case, we need to cleanup
+            // the task counter before re-throwing and exiting.
+            publish_snapshot([this](island_snapshot &) { --this->m_ptr->n_tasks; });
+            throw;
+            // LCOV_EXCL_STOP
+        }
+    }
+    // Publish a new snapshot, obtained by applying mod to a copy of the current one.
+    // mod can also modify the task counter and the error flag in m_ptr, as it is
+    // invoked with the snapshot lock held.
+    template <typename F>
+    void publish_snapshot(const F &mod) const
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->snapshot_mutex);
+        auto new_snapshot = std::make_shared<island_snapshot>(*m_ptr->snapshot);
+        mod(*new_snapshot);
+        ++new_snapshot->version;
+        if (m_ptr->n_tasks) {
+            new_snapshot->status = m_ptr->task_error ? evolve_status::busy_error : evolve_status::busy;
+        } else {
+            new_snapshot->status = m_ptr->task_error ? evolve_status::idle_error : evolve_status::idle;
+        }
+        std::atomic_store(&m_ptr->snapshot, std::shared_ptr<const island_snapshot>(std::move(new_snapshot)));
+    }
+    // Record the end of an evolution task in the snapshot, together with the
+    // exception it raised (only the first one is kept).
+    void task_finished(std::exception_ptr error) const
+    {
+        publish_snapshot([this, &error](island_snapshot &) {
+            assert(this->m_ptr->n_tasks);
+            --this->m_ptr->n_tasks;
+            if (!this->m_ptr->task_error) {
+                this->m_ptr->task_error = std::move(error);
+            }
+        });
+    }
+    // Invoke the run_evolve() method of the UDI, and record it in the snapshot.
+    void run_evolve_once()
+    {
+        m_ptr->isl_ptr->run_evolve(*this);
+        if (const auto archive = std::atomic_load(&m_ptr->archive)) {
+            // NOTE: the stored populations are never modified, so we can
+            // insert the evolved population without copying it.
+            std::unique_lock<std::mutex> lock(m_ptr->pop_mutex);
+            const auto pop_ptr = m_ptr->pop;
+            lock.unlock();
+            archive->insert(*pop_ptr);
+        }
+        publish_snapshot([](island_snapshot &s) { ++s.n_evolve; });
+    }
+    // Pin the island's thread to cpus. The pinning is done by a task running in the
+    // island's queue, which also moves the population to memory local to the new CPUs.
+    // The ticket of the task is returned, and the exception raised by the task (if any)
+    // is stored in error, which must stay alive until the task has been completed.
+    detail::task_queue::ticket enqueue_placement(std::vector<unsigned> cpus, std::exception_ptr &error)
+    {
+        detail::check_cpus(cpus);
+        auto ptr = m_ptr.get();
+        auto eptr = &error;
+        return ptr->queue.enqueue(
+            [ptr, cpus, eptr]() {
+                try {
+                    place(ptr, cpus);
+                } catch (...) {
+                    *eptr = std::current_exception();
+                }
+            },
+            []() { return detail::wait_raii<>::getter(); });
+    }
+    // Body of the placement task (see enqueue_placement()).
+    static void place(detail::island_data *ptr, const std::vector<unsigned> &cpus)
+    {
+        island_placement pl;
+        const auto mask = detail::set_thread_affinity(cpus);
+        if (!cpus.empty()) {
+            pl.cpus = mask;
+            pl.numa_node = detail::numa_node_of(mask);
+        }
+        // NOTE: with the first-touch policy of Linux, the copy of the population
+        // made here is allocated on the NUMA node of the new CPUs. The following
+        // evolutions will allocate their populations from this thread as well.
+        std::unique_lock<std::mutex> lock(ptr->pop_mutex);
+        const auto old_pop_ptr = ptr->pop;
+        lock.unlock();
+        auto new_pop_ptr = std::make_shared<population>(*old_pop_ptr);
+        lock.lock();
+        // Don't overwrite a population set concurrently via set_population().
+        if (ptr->pop == old_pop_ptr) {
+            ptr->pop = std::move(new_pop_ptr);
+        }
+        lock.unlock();
+        std::lock_guard<std::mutex> pl_lock(ptr->placement_mutex);
+        ptr->placement = std::move(pl);
+    }
+    // Extract the stored exception and reset the error flag in the snapshot, used by wait_check().
+    std::exception_ptr take_task_error()
+    {
+        std::exception_ptr retval;
+        publish_snapshot([this, &retval](island_snapshot &) { std::swap(retval, this->m_ptr->task_error); });
+        return retval;
+    }
+    // Create the stop state for a new evolution subject to the limits lim.
+    std::shared_ptr<detail::evolve_stop_state> make_stop_state(const evolve_limits &lim) const
+    {
+        std::shared_ptr<std::atomic<bool>> flag;
+        {
+            std::lock_guard<std::mutex> lock(m_ptr->cancel_mutex);
+            flag = m_ptr->cancel_flag;
+        }
+        auto st = std::make_shared<detail::evolve_stop_state>(std::move(flag));
+        using clock_t = detail::evolve_stop_state::clock_t;
+        const auto now = clock_t::now();
+        // NOTE: timeouts too large to be represented by the clock are considered infinite.
+        if (lim.get_max_seconds() < std::chrono::duration<double>(clock_t::time_point::max() - now).count() / 2.) {
+            st->has_deadline = true;
+            st->deadline = now
+                           + std::chrono::duration_cast<clock_t::duration>(
+                                 std::chrono::duration<double>(lim.get_max_seconds()));
+        }
+        st->max_fevals = lim.get_max_fevals();
+        return st;
+    }
+    // Check, from within an evolution task, if the evolution with stop state st should stop.
+    bool evolve_stopped(const detail::evolve_stop_state &st) const
+    {
+        return st.has_fevals_limit() ? st.stop_requested(get_population().get_problem().get_fevals())
+                                     : st.stop_requested();
+    }
+    // Set up st at the beginning of an evolution task.
+    void start_stop_state(detail::evolve_stop_state &st) const
+    {
+        if (st.has_fevals_limit()) {
+            st.fevals_start = get_population().get_problem().get_fevals();
+        }
+    }
 
 public:
     /// Default constructor.
@@ -718,13 +969,16 @@ public:
     }
     /// Destructor.
     /**
-     * If the island has not been moved-from, the destructor will call island::wait_check(),
-     * ignoring any exception that might be thrown.
+     * If the island has not been moved-from, the destructor will cancel the ongoing evolutions (as
+     * in island::cancel()) and it will then call island::wait_check(), ignoring any exception that might be thrown.
      */
     ~island()
     {
         // If the island has been moved from, don't do anything.
         if (m_ptr) {
+            // NOTE: no need to lock here, nobody else can be accessing the flag
+            // pointer while the island is being destroyed.
+            m_ptr->cancel_flag->store(true);
             wait_check_ignore();
         }
     }
@@ -770,7 +1024,9 @@ public:
      * This method will evolve the island's pagmo::population using the
      * island's pagmo::algorithm. The evolution happens asynchronously:
      * a call to island::evolve() will create an evolution task that will be pushed
-     * to a queue, and then return immediately.
+     * to a queue, and then return.
+     * The queue can hold up to 256 pending tasks: if it is full, this method will block until
+     * the island's thread has started one of the queued tasks (in Python, the GIL is released while waiting).
      * The tasks in the queue are consumed
      * by a separate thread of execution managed by the pagmo::island object.
      * Each task will invoke the <tt>run_evolve()</tt>
@@ -789,32 +1045,55 @@ public:
      *
      * @throws unspecified any exception thrown by:
      * - threading primitives,
-     * - memory allocation errors,
-     * - the public interface of \p std::future.
+     * - memory allocation errors.
      */
     void evolve(unsigned n = 1)
     {
-        // First add an empty future, so that if an exception is thrown
-        // we will not have modified m_futures, nor we will have a future
-        // in flight which we cannot wait upon.
-        m_ptr->futures.emplace_back();
-        try {
-            // Move assign a new future provided by the enqueue() method.
-            // NOTE: enqueue either returns a valid future, or throws without
-            // having enqueued any task.
-            m_ptr->futures.back() = m_ptr->queue.enqueue([this, n]() {
-                for (auto i = 0u; i < n; ++i) {
-                    this->m_ptr->isl_ptr->run_evolve(*this);
-                }
-            });
-            // LCOV_EXCL_START
-        } catch (...) {
-            // We end up here only if enqueue threw. In such a case, we need to cleanup
-            // the empty future we added above before re-throwing and exiting.
-            m_ptr->futures.pop_back();
-            throw;
-            // LCOV_EXCL_STOP
-        }
+        evolve(n, evolve_limits{});
+    }
+    /// Launch evolution with limits.
+    /**
+     * This method is equivalent to island::evolve(unsigned), but the evolution task will be subject to the limits
+     * \p lim (see pagmo::evolve_limits). The limits are checked before each invocation of the <tt>run_evolve()</tt>
+     * method of the UDI and, within the algorithms polling pagmo::evolve_stop_requested(), after each generation.
+     * The timeout is measured from the call to this method, and the budget of fitness evaluations from the
+     * beginning of the execution of the evolution task.
+     *
+     * @param n the maximum number of times the <tt>run_evolve()</tt> method of the UDI will be called
+     * within the evolution task.
+     * @param lim the limits of the evolution.
+     *
+     * @throws unspecified any exception thrown by island::evolve(unsigned).
+     */
+    void evolve(unsigned n, const evolve_limits &lim)
+    {
+        auto st = make_stop_state(lim);
+        enqueue_evolution([this, n, st]() {
+            this->start_stop_state(*st);
+            detail::evolve_stop_guard esg(st.get());
+            for (auto i = 0u; i < n && !this->evolve_stopped(*st); ++i) {
+                this->run_evolve_once();
+            }
+        });
+    }
+    /// Cancel evolution.
+    /**
+     * This method will request the cancellation of all the evolution tasks that are currently running or queued in
+     * the island, and it will return immediately. The cancelled tasks will not start further invocations of the
+     * <tt>run_evolve()</tt> method of the UDI, and the algorithms polling pagmo::evolve_stop_requested() will
+     * stop at the end of the current generation. Evolution tasks launched after the call to this method are not
+     * affected. Cancellation is not an error: island::wait_check() will not raise because of it.
+     *
+     * It is safe to call this method while the island is evolving.
+     *
+     * @throws unspecified any exception thrown by threading primitives or memory allocation errors.
+     */
+    void cancel()
+    {
+        auto new_flag = std::make_shared<std::atomic<bool>>(false);
+        std::lock_guard<std::mutex> lock(m_ptr->cancel_mutex);
+        m_ptr->cancel_flag->store(true);
+        m_ptr->cancel_flag = std::move(new_flag);
     }
     /// Block until evolution ends and re-raise the first stored exception.
     /**
@@ -833,23 +1112,13 @@ public:
     {
         auto iwr = detail::wait_raii<>::getter();
         (void)iwr;
-        for (auto it = m_ptr->futures.begin(); it != m_ptr->futures.end(); ++it) {
-            assert(it->valid());
-            try {
-                it->get();
-            } catch (...) {
-                // If any of the futures stores an exception, we will re-raise it.
-                // But first, we need to get all the other futures and erase the futures
-                // vector.
-                // NOTE: everything is this block is noexcept.
-                for (it = it + 1; it != m_ptr->futures.end(); ++it) {
-                    detail::wait_f(*it);
-                }
-                m_ptr->futures.clear();
-                throw;
-            }
+        // NOTE: the tasks are consumed in FIFO order by a single thread, so the stored
+        // exception is the one raised by the first enqueued task that threw.
+        m_ptr->queue.wait(m_ptr->last_task);
+        const auto eptr = take_task_error();
+        if (eptr) {
+            std::rethrow_exception(eptr);
         }
-        m_ptr->futures.clear();
     }
     /// Block until evolution ends.
     /**
@@ -861,33 +1130,13 @@ public:
     void wait()
     {
         // NOTE: we use this function in move ops and in the dtor, which are all noexcept. In theory we could
-        // end up aborting in case the wait_raii mechanism throws in such cases. We could also end up aborting
-        // due to memory failures in future_has_exception().
-        // NOTE: the idea here is that, after a wait() call, all the futures of successful tasks have been erased,
-        // with at most 1 surviving future from the first throwing task. This way, wait() does some cleaning up
-        // behind the scenes, without changing the behaviour of successive wait_check() and status() calls: wait_check()
+        // end up aborting in case the wait_raii mechanism or the threading primitives throw in such cases.
+        // NOTE: the exception raised by the first throwing task (if any) stays stored in the island,
+        // so that successive wait_check() and status() calls are not affected: wait_check()
         // will still re-throw the first exception, and status() will still return idle_error.
         auto iwr = detail::wait_raii<>::getter();
         (void)iwr;
-        const auto it_f = m_ptr->futures.end();
-        auto it_first_exc = it_f;
-        for (auto it = m_ptr->futures.begin(); it != it_f; ++it) {
-            // Wait on the task.
-            detail::wait_f(*it);
-            if (it_first_exc == it_f && detail::future_has_exception(*it)) {
-                // Store an iterator to the throwing future.
-                it_first_exc = it;
-            }
-        }
-        if (it_first_exc == it_f) {
-            // No exceptions were raised, just clear everything.
-            m_ptr->futures.clear();
-        } else {
-            // We had a throwing future: preserve it and erase all the other futures.
-            auto tmp_f(std::move(*it_first_exc));
-            m_ptr->futures.clear();
-            m_ptr->futures.emplace_back(std::move(tmp_f));
-        }
+        m_ptr->queue.wait(m_ptr->last_task);
     }
     /// Status of the island.
     /**
@@ -911,29 +1160,8 @@ public:
      */
     evolve_status status() const
     {
-        // Error flag. It will be set to true if at least one completed task raised an exception.
-        bool error = false;
-        // Iterate over all current evolve() tasks.
-        for (auto &f : m_ptr->futures) {
-            if (detail::future_running(f)) {
-                // We have at least one busy task. The return status will be either "busy"
-                // or "busy_error", depending on whether at least one completed task raised an
-                // exception.
-                if (error) {
-                    return evolve_status::busy_error;
-                }
-                return evolve_status::busy;
-            }
-            // The current task is not running. Check if it generated an error.
-            // NOTE: the '||' is because this flag, once set to true, needs to stay true.
-            error = error || detail::future_has_exception(f);
-        }
-        if (error) {
-            // All tasks have finished and at least one generated an error.
-            return evolve_status::idle_error;
-        }
-        // All tasks have finished, no errors generated.
-        return evolve_status::idle;
+        // NOTE: the status is kept up to date in the snapshot by the evolution tasks.
+        return std::atomic_load(&m_ptr->snapshot)->status;
     }
     /// Get the algorithm.
     /**
@@ -1005,8 +1233,69 @@ public:
     void set_population(population pop)
     {
         auto new_pop_ptr = std::make_shared<population>(std::move(pop));
+        // NOTE: the snapshot is published while holding the population lock, so that concurrent
+        // calls to set_population() publish their snapshots in the same order in which
+        // they replace the population. The lock order is thus pop_mutex -> snapshot_mutex.
         std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
-        m_ptr->pop = new_pop_ptr;
+        publish_snapshot([&new_pop_ptr](island_snapshot &s) { detail::snapshot_population(s, *new_pop_ptr); });
+        m_ptr->pop = std::move(new_pop_ptr);
+    }
+    /// Get the latest snapshot.
+    /**
+     * This method will return the latest pagmo::island_snapshot published by the island. The snapshot
+     * is fetched without locking the island's population, and it is thus suitable for frequent polling
+     * (e.g., for monitoring purposes). The returned snapshot is immutable and it will not be updated
+     * by the island: newer snapshots can be fetched by calling this method again, and they
+     * can be distinguished via the island_snapshot::version member.
+     *
+     * It is safe to call this method while the island is evolving.
+     *
+     * @return a pointer to the latest snapshot of the island.
+     */
+    std::shared_ptr<const island_snapshot> get_snapshot() const
+    {
+        return std::atomic_load(&m_ptr->snapshot);
+    }
+    /// Set the placement of the island's thread.
+    /**
+     * This method will pin the thread of execution of the island to the input CPUs (identified by the
+     * indices used by the operating system). If \p cpus is empty, the thread will be unpinned,
+     * and it will be free to run on any CPU available to the process.
+     *
+     * The pinning is performed by a task enqueued in the island after the evolutions that are currently queued,
+     * and this method will block until the pinning has taken place. After the pinning, the island's population
+     * is copied in the island's thread, so that, with the first-touch allocation policy of Linux, it is stored
+     * on the NUMA node of the new CPUs (the evolutions allocate their populations from the island's thread as well).
+     *
+     * The placement is a property of the island's thread of execution: it is neither copied nor serialised.
+     * On platforms other than Linux, this method does nothing.
+     *
+     * @param cpus the CPUs the island's thread will be pinned to.
+     *
+     * @throws std::invalid_argument if any CPU in \p cpus is not available to the process.
+     * @throws std::runtime_error if the affinity of the thread cannot be set.
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    void set_placement(const std::vector<unsigned> &cpus)
+    {
+        std::exception_ptr error;
+        m_ptr->queue.wait(enqueue_placement(cpus, error));
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    /// Get the placement of the island's thread.
+    /**
+     * It is safe to call this method while the island is evolving.
+     *
+     * @return the current placement of the island's thread.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    island_placement get_placement() const
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->placement_mutex);
+        return m_ptr->placement;
     }
     /// Get the thread safety of the island's members.
     /**
@@ -1127,6 +1416,7 @@ public:
         ar(tmp_island.m_ptr->isl_ptr);
         ar(*tmp_island.m_ptr->algo);
         ar(*tmp_island.m_ptr->pop);
+        tmp_island.m_ptr->snapshot = detail::make_island_snapshot(*tmp_island.m_ptr->pop);
         *this = std::move(tmp_island);
     }
 
@@ -1163,6 +1453,60 @@ inline void thread_island::run_evolve(island &isl) const
     isl.set_population(isl.get_algorithm().evolve(isl.get_population()));
 }
 
+namespace detail
+{
+
+// Queue of the islands whose evolutions, submitted via archipelago::submit() and
+// archipelago::submit_fevals(), have completed. The islands are identified by their
+// index in the archipelago, and they are pushed in the order in which their evolutions finish.
+struct archi_completion_queue {
+    using size_type = std::vector<std::unique_ptr<island>>::size_type;
+    // Register a new evolution in flight. We make sure here that the vector of completed
+    // islands has enough capacity to absorb all the evolutions in flight, so that
+    // complete() never needs to allocate while running in the island's thread.
+    void submit()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done.reserve(m_done.size() + m_in_flight + 1u);
+        ++m_in_flight;
+    }
+    // Undo submit(), used if the enqueueing of the evolution task failed.
+    void cancel()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        assert(m_in_flight);
+        --m_in_flight;
+    }
+    // Signal that the evolution of the island at index idx has finished.
+    void complete(size_type idx)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            assert(m_in_flight);
+            assert(m_done.size() < m_done.capacity());
+            --m_in_flight;
+            m_done.push_back(idx);
+        }
+        m_cond.notify_all();
+    }
+    // Pop the first completed island. Must be called with the lock held,
+    // and with a non-empty m_done.
+    size_type pop()
+    {
+        assert(!m_done.empty());
+        // NOTE: the number of completed islands is bounded by the number of
+        // submissions, which is normally small: erasing from the front is fine.
+        const auto retval = m_done.front();
+        m_done.erase(m_done.begin());
+        return retval;
+    }
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    size_type m_in_flight = 0;
+    std::vector<size_type> m_done;
+};
+}
+
 /// Archipelago.
 /**
  * \image html archi_no_text.png
@@ -1233,6 +1577,7 @@ public:
      * @throws unspecified any exception thrown by archipelago::push_back().
      */
     archipelago(const archipelago &other)
+        : m_archive(other.m_archive ? std::make_shared<pareto_archive>(*other.m_archive) : nullptr)
     {
         for (const auto &iptr : other.m_islands) {
             // This will end up copying the island members,
@@ -1248,18 +1593,23 @@ public:
      *
      * @param other the archipelago that will be moved.
      */
-    archipelago(archipelago &&other) noexcept
+    archipelago(archipelago &&other) noexcept : m_cq(std::move(other.m_cq))
     {
         // NOTE: in move operations we have to wait, because the ongoing
         // island evolutions are interacting with their hosting archi 'other'.
         // We cannot just move in the vector of islands.
         other.wait_check_ignore();
-        // Move in the islands.
+        // Move in the islands and the Pareto archive they share.
         m_islands = std::move(other.m_islands);
+        m_archive = std::move(other.m_archive);
         // Re-direct the archi pointers to point to this.
         for (const auto &iptr : m_islands) {
             iptr->m_ptr->archi_ptr = this;
         }
+        // NOTE: the completion queue was taken over in the init list, without
+        // allocating. The evolution tasks still in flight refer to the queue
+        // object, not to other, and other is left without a queue (which
+        // behaves as an empty one, see the m_cq member).
     }
 
 private:
@@ -1371,22 +1721,37 @@ public:
             // This mirrors the island's behaviour.
             wait_check_ignore();
             other.wait_check_ignore();
-            // Move in the islands.
+            // Move in the islands and the Pareto archive they share.
             m_islands = std::move(other.m_islands);
+            m_archive = std::move(other.m_archive);
             // Re-direct the archi pointers to point to this.
             for (const auto &iptr : m_islands) {
                 iptr->m_ptr->archi_ptr = this;
             }
+            // Take over the completion queue. The queue that other gets
+            // in exchange refers to our old islands, thus we clear it.
+            // NOTE: no evolution is in flight at this point, and clearing
+            // a vector does not throw.
+            m_cq.swap(other.m_cq);
+            if (other.m_cq) {
+                other.m_cq->m_done.clear();
+                assert(other.m_cq->m_in_flight == 0u);
+            }
         }
         return *this;
     }
     /// Destructor.
     /**
-     * The destructor will call archipelago::wait_check() internally, ignoring any exception that might be thrown,
-     * and run checks in debug mode.
+     * The destructor will cancel the ongoing evolutions and call archipelago::wait_check() internally,
+     * ignoring any exception that might be thrown, and run checks in debug mode.
      */
     ~archipelago()
     {
+        // NOTE: cancel all the islands first, so that we don't have to wait
+        // for each island in turn to complete its queued evolutions.
+        for (const auto &iptr : m_islands) {
+            iptr->m_ptr->cancel_flag->store(true);
+        }
         // NOTE: this is not strictly necessary, but it will not hurt. And, if we add further
         // sanity checks, we know the archi is stopped.
         wait_check_ignore();
@@ -1485,13 +1850,15 @@ public:
         m_islands.emplace_back(detail::make_unique<island>(std::forward<Args>(args)...));
         // NOTE: this is noexcept.
         m_islands.back()->m_ptr->archi_ptr = this;
+        std::atomic_store(&m_islands.back()->m_ptr->archive, m_archive);
     }
     /// Evolve archipelago.
     /**
      * This method will call island::evolve() on all the islands of the archipelago.
      * The input parameter \p n will be passed to the invocations of island::evolve() for each island.
      * archipelago::status() can be used to query the status of the asynchronous operations in the
-     * archipelago.
+     * archipelago. Like island::evolve(), this method will block if the queue of pending tasks
+     * of an island is full.
      *
      * @param n the parameter that will be passed to island::evolve().
      *
@@ -1503,6 +1870,175 @@ public:
             iptr->evolve(n);
         }
     }
+    /// Evolve archipelago with limits.
+    /**
+     * This method will call island::evolve(unsigned, const evolve_limits &) on all the islands of the archipelago.
+     * The limits apply separately to each island. Like archipelago::evolve(unsigned), this method will block
+     * if the queue of pending tasks of an island is full.
+     *
+     * @param n the parameter that will be passed to island::evolve().
+     * @param lim the limits of the evolution.
+     *
+     * @throws unspecified any exception thrown by island::evolve().
+     */
+    void evolve(unsigned n, const evolve_limits &lim)
+    {
+        for (auto &iptr : m_islands) {
+            iptr->evolve(n, lim);
+        }
+    }
+    /// Cancel evolution.
+    /**
+     * This method will call island::cancel() on all the islands of the archipelago.
+     *
+     * @throws unspecified any exception thrown by island::cancel().
+     */
+    void cancel()
+    {
+        for (auto &iptr : m_islands) {
+            iptr->cancel();
+        }
+    }
+    /// Submit an evolution to a single island.
+    /**
+     * This method will enqueue in the <tt>i</tt>-th island of the archipelago an evolution task that will invoke
+     * \p n times the <tt>run_evolve()</tt> method of the UDI, similarly to island::evolve(). Contrary to
+     * island::evolve(), when the task finishes the index \p i will be pushed to the archipelago's completion
+     * queue, from which it can be retrieved via wait_any() or try_wait_any(). This allows to assign a different
+     * budget to each island and to react to each island finishing its evolution (e.g., by resubmitting it
+     * or by changing its algorithm) without waiting for the slowest island of the archipelago.
+     *
+     * The index \p i is pushed to the completion queue also if the evolution task throws. The exception
+     * can then be re-raised via island::wait_check() or archipelago::wait_check(). Submitted evolutions can be
+     * cancelled via island::cancel() or archipelago::cancel(), in which case the completion is signalled as well.
+     * Like island::evolve(), this method will block if the queue of pending tasks of the island is full.
+     *
+     * @param i the index of the island that will be evolved.
+     * @param n the number of times the <tt>run_evolve()</tt> method of the UDI will be called.
+     *
+     * @throws std::out_of_range if \p i is not less than the size of the archipelago.
+     * @throws unspecified any exception thrown by threading primitives or memory allocation errors.
+     */
+    void submit(size_type i, unsigned n = 1)
+    {
+        auto &isl = (*this)[i];
+        auto st = isl.make_stop_state(evolve_limits{});
+        submit_impl(i, [&isl, n, st]() {
+            detail::evolve_stop_guard esg(st.get());
+            for (auto j = 0u; j < n && !isl.evolve_stopped(*st); ++j) {
+                isl.run_evolve_once();
+            }
+        });
+    }
+    /// Submit an evolution with a budget of fitness evaluations to a single island.
+    /**
+     * This method is equivalent to submit(), but the <tt>run_evolve()</tt> method of the UDI will be invoked
+     * repeatedly until the number of fitness evaluations recorded by the problem of the <tt>i</tt>-th island
+     * has increased by at least \p max_fevals. Since the budget is checked only between <tt>run_evolve()</tt>
+     * invocations, the actual number of fitness evaluations may exceed \p max_fevals. The evolution will also
+     * stop if a <tt>run_evolve()</tt> invocation does not increase the number of fitness evaluations.
+     * Like island::evolve(), this method will block if the queue of pending tasks of the island is full.
+     *
+     * @param i the index of the island that will be evolved.
+     * @param max_fevals the budget of fitness evaluations.
+     *
+     * @throws std::out_of_range if \p i is not less than the size of the archipelago.
+     * @throws unspecified any exception thrown by threading primitives or memory allocation errors.
+     */
+    void submit_fevals(size_type i, unsigned long long max_fevals)
+    {
+        auto &isl = (*this)[i];
+        auto st = isl.make_stop_state(evolve_limits{});
+        submit_impl(i, [&isl, max_fevals, st]() {
+            detail::evolve_stop_guard esg(st.get());
+            const auto start = isl.get_population().get_problem().get_fevals();
+            auto cur = start;
+            while (cur - start < max_fevals && !isl.evolve_stopped(*st)) {
+                isl.run_evolve_once();
+                const auto new_fevals = isl.get_population().get_problem().get_fevals();
+                if (new_fevals <= cur) {
+                    // No progress (or the population was replaced), avoid
+                    // looping forever.
+                    break;
+                }
+                cur = new_fevals;
+            }
+        });
+    }
+    /// Wait for the completion of a submitted evolution.
+    /**
+     * This method will block until an evolution submitted via submit() or submit_fevals() has finished,
+     * and it will return the index of the island that completed it. Islands are returned in the order in which
+     * their evolutions finished, and each submission is returned exactly once.
+     *
+     * When this method returns, the population of the returned island has been updated by the
+     * evolution. Exceptions thrown by the evolution are **not** re-raised by this method: they can be re-raised via
+     * island::wait_check() on the returned island. Note that, since the completion is signalled from within
+     * the evolution task, island::status() might report the returned island as busy for a brief moment after this
+     * method has returned.
+     *
+     * @return the index of the island whose evolution has finished.
+     *
+     * @throws std::runtime_error if there are no submitted evolutions left to wait for.
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    size_type wait_any()
+    {
+        auto iwr = detail::wait_raii<>::getter();
+        (void)iwr;
+        std::unique_lock<std::mutex> lock;
+        if (m_cq) {
+            lock = std::unique_lock<std::mutex>(m_cq->m_mutex);
+        }
+        if (!m_cq || (m_cq->m_done.empty() && !m_cq->m_in_flight)) {
+            pagmo_throw(std::runtime_error, "cannot wait for the completion of an evolution in an archipelago: no "
+                                            "evolution was submitted via archipelago::submit() or "
+                                            "archipelago::submit_fevals()");
+        }
+        auto cq = m_cq.get();
+        m_cq->m_cond.wait(lock, [cq]() { return !cq->m_done.empty(); });
+        return m_cq->pop();
+    }
+    /// Check for the completion of a submitted evolution without blocking.
+    /**
+     * If an evolution submitted via submit() or submit_fevals() has finished, this method will write into
+     * \p i the index of the corresponding island, as wait_any() would, and return \p true. Otherwise,
+     * \p i is left untouched and \p false is returned.
+     *
+     * @param i the output index.
+     *
+     * @return \p true if a completed evolution was found, \p false otherwise.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    bool try_wait_any(size_type &i)
+    {
+        if (!m_cq) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_cq->m_mutex);
+        if (m_cq->m_done.empty()) {
+            return false;
+        }
+        i = m_cq->pop();
+        return true;
+    }
+    /// Number of pending submissions.
+    /**
+     * @return the number of evolutions submitted via submit() or submit_fevals() which have not been
+     * retrieved yet via wait_any() or try_wait_any(), either because they are still running
+     * or because they have finished but were not consumed yet.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    size_type get_n_pending() const
+    {
+        if (!m_cq) {
+            return 0u;
+        }
+        std::lock_guard<std::mutex> lock(m_cq->m_mutex);
+        return m_cq->m_in_flight + m_cq->m_done.size();
+    }
     /// Block until all evolutions have finished.
     /**
      * This method will call island::wait() on all the islands of the archipelago. Exceptions thrown by island
@@ -1701,6 +2237,9 @@ public:
     }
     /// Get the fitness vectors of the islands' champions.
     /**
+     * The champions are read from the islands' snapshots (see island::get_snapshot()) whenever
+     * they are available there, without copying the islands' populations.
+     *
      * @return a collection of the fitness vectors of the islands' champions.
      *
      * @throws unspecified any exception thrown by population::champion_f() or
@@ -1710,12 +2249,22 @@ public:
     {
         std::vector<vector_double> retval;
         for (const auto &isl_ptr : m_islands) {
-            retval.emplace_back(isl_ptr->get_population().champion_f());
+            const auto s = isl_ptr->get_snapshot();
+            if (s->champion_f.empty()) {
+                // Champion not available in the snapshot, go through the population
+                // (which will throw if the champion is not defined).
+                retval.emplace_back(isl_ptr->get_population().champion_f());
+            } else {
+                retval.emplace_back(s->champion_f);
+            }
         }
         return retval;
     }
     /// Get the decision vectors of the islands' champions.
     /**
+     * The champions are read from the islands' snapshots (see island::get_snapshot()) whenever
+     * they are available there, without copying the islands' populations.
+     *
      * @return a collection of the decision vectors of the islands' champions.
      *
      * @throws unspecified any exception thrown by population::champion_x() or
@@ -1725,22 +2274,193 @@ public:
     {
         std::vector<vector_double> retval;
         for (const auto &isl_ptr : m_islands) {
-            retval.emplace_back(isl_ptr->get_population().champion_x());
+            const auto s = isl_ptr->get_snapshot();
+            if (s->champion_x.empty()) {
+                retval.emplace_back(isl_ptr->get_population().champion_x());
+            } else {
+                retval.emplace_back(s->champion_x);
+            }
+        }
+        return retval;
+    }
+    /// Get the islands' snapshots.
+    /**
+     * This method will call island::get_snapshot() on all the islands of the archipelago. It is meant
+     * for the frequent monitoring of running archipelagos, as the snapshots are fetched without locking
+     * the islands' populations.
+     *
+     * @return the latest snapshots of the islands.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    std::vector<std::shared_ptr<const island_snapshot>> get_snapshots() const
+    {
+        std::vector<std::shared_ptr<const island_snapshot>> retval;
+        retval.reserve(m_islands.size());
+        for (const auto &isl_ptr : m_islands) {
+            retval.emplace_back(isl_ptr->get_snapshot());
         }
         return retval;
     }
+    /// Set the placement of the islands' threads.
+    /**
+     * This method will pin the threads of execution of the islands according to the policy \p p, using
+     * the NUMA topology of the machine (on Linux, it is read from <tt>/sys/devices/system/node</tt>; if it is not
+     * available, all the CPUs are considered to belong to a single NUMA node). The islands are pinned as explained
+     * in island::set_placement(), and this method will block until all the islands have been pinned.
+     *
+     * The islands added to the archipelago after the invocation of this method are not pinned.
+     * On platforms other than Linux, this method does nothing.
+     *
+     * @param p the placement policy.
+     *
+     * @throws std::invalid_argument if \p p is not one of the values of pagmo::placement_policy.
+     * @throws unspecified any exception thrown by island::set_placement().
+     */
+    void set_placement(placement_policy p)
+    {
+        std::vector<std::vector<unsigned>> cpus;
+        const auto topo = detail::numa_topology();
+        switch (p) {
+            case placement_policy::none:
+                cpus.emplace_back();
+                break;
+            case placement_policy::numa:
+                for (const auto &nc : topo) {
+                    cpus.push_back(nc.cpus);
+                }
+                break;
+            case placement_policy::core:
+                // Alternate between the nodes: node 0 cpu 0, node 1 cpu 0, ..., node 0 cpu 1, etc.
+                for (decltype(topo.size()) j = 0;; ++j) {
+                    bool added = false;
+                    for (const auto &nc : topo) {
+                        if (j < nc.cpus.size()) {
+                            cpus.push_back({nc.cpus[j]});
+                            added = true;
+                        }
+                    }
+                    if (!added) {
+                        break;
+                    }
+                }
+                break;
+            default:
+                pagmo_throw(std::invalid_argument, "invalid placement policy: " + std::to_string(static_cast<int>(p)));
+        }
+        if (cpus.empty()) {
+            // No affinity support.
+            return;
+        }
+        // Enqueue all the placements first, then wait for them, so that
+        // busy islands do not delay the placement of the others.
+        // NOTE: the errors vector is never resized after this point, as the
+        // placement tasks store their exceptions into it.
+        std::vector<std::exception_ptr> errors(m_islands.size());
+        std::vector<detail::task_queue::ticket> tickets;
+        tickets.reserve(m_islands.size());
+        std::exception_ptr eptr;
+        for (size_type i = 0; i < m_islands.size(); ++i) {
+            try {
+                tickets.push_back(m_islands[i]->enqueue_placement(cpus[i % cpus.size()], errors[i]));
+            } catch (...) {
+                eptr = std::current_exception();
+                break;
+            }
+        }
+        for (decltype(tickets.size()) i = 0; i < tickets.size(); ++i) {
+            m_islands[i]->m_ptr->queue.wait(tickets[i]);
+            if (!eptr) {
+                eptr = errors[i];
+            }
+        }
+        if (eptr) {
+            std::rethrow_exception(eptr);
+        }
+    }
+    /// Get the placement of the islands' threads.
+    /**
+     * This method will call island::get_placement() on all the islands of the archipelago.
+     *
+     * @return the placements of the islands' threads.
+     *
+     * @throws unspecified any exception thrown by island::get_placement().
+     */
+    std::vector<island_placement> get_placements() const
+    {
+        std::vector<island_placement> retval;
+        retval.reserve(m_islands.size());
+        for (const auto &isl_ptr : m_islands) {
+            retval.emplace_back(isl_ptr->get_placement());
+        }
+        return retval;
+    }
+    /// Set the Pareto archive.
+    /**
+     * This method will install a copy of \p archive as the Pareto archive of the archipelago: from now on,
+     * at the end of each evolution (that is, after each invocation of the <tt>run_evolve()</tt> method of
+     * the UDI), every island of the archipelago will insert its population into the archive via
+     * pareto_archive::insert(const population &). The islands added later via push_back() will share the
+     * same archive. The content of the archive can be read at any time via get_pareto_archive(), also
+     * while the archipelago is evolving.
+     *
+     * The evolutions which are running while this method is invoked might insert their populations into
+     * the previous archive. An error raised by the insertion (e.g., if the islands' problems have different
+     * numbers of objectives) is reported by wait_check() as any other error raised by the evolution.
+     *
+     * @param archive the Pareto archive.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    void set_pareto_archive(pareto_archive archive)
+    {
+        auto ptr = std::make_shared<pareto_archive>(std::move(archive));
+        for (const auto &iptr : m_islands) {
+            std::atomic_store(&iptr->m_ptr->archive, ptr);
+        }
+        m_archive = std::move(ptr);
+    }
+    /// Remove the Pareto archive.
+    /**
+     * After the invocation of this method the islands will stop inserting their populations
+     * into the Pareto archive set by set_pareto_archive(). The archive is kept alive
+     * by the pointers previously returned by get_pareto_archive().
+     */
+    void unset_pareto_archive()
+    {
+        for (const auto &iptr : m_islands) {
+            std::atomic_store(&iptr->m_ptr->archive, std::shared_ptr<pareto_archive>{});
+        }
+        m_archive.reset();
+    }
+    /// Get the Pareto archive.
+    /**
+     * The returned pointer can be used to read the content of the archive at any time,
+     * also while the archipelago is evolving (see pagmo::pareto_archive).
+     *
+     * @return a pointer to the Pareto archive set by set_pareto_archive(), or null if no archive was set.
+     */
+    std::shared_ptr<const pareto_archive> get_pareto_archive() const
+    {
+        return m_archive;
+    }
     /// Save to archive.
     /**
-     * This method will save to \p ar the islands of the archipelago.
+     * This method will save to \p ar the islands and the Pareto archive of the archipelago.
      *
      * @param ar the output archive.
      *
-     * @throws unspecified any exception thrown by the serialization of pagmo::island.
+     * @throws unspecified any exception thrown by the serialization of pagmo::island and pagmo::pareto_archive.
      */
     template <typename Archive>
     void save(Archive &ar) const
     {
         ar(m_islands);
+        const bool has_archive = static_cast<bool>(m_archive);
+        ar(has_archive);
+        if (has_archive) {
+            ar(*m_archive);
+        }
     }
     /// Load from archive.
     /**
@@ -1749,17 +2469,67 @@ public:
      *
      * @param ar the input archive.
      *
-     * @throws unspecified any exception thrown by the deserialization of pagmo::island.
+     * @throws unspecified any exception thrown by the deserialization of pagmo::island and pagmo::pareto_archive.
      */
     template <typename Archive>
     void load(Archive &ar)
     {
         archipelago tmp;
         ar(tmp.m_islands);
+        bool has_archive;
+        ar(has_archive);
+        if (has_archive) {
+            pareto_archive archive;
+            ar(archive);
+            tmp.set_pareto_archive(std::move(archive));
+        }
         *this = std::move(tmp);
     }
 
 private:
+    // Enqueue f as an evolution task in the island at index i, and make sure
+    // that i is pushed to the completion queue when the task finishes.
+    // NOTE: i must have been checked by the caller.
+    template <typename F>
+    void submit_impl(size_type i, F &&f)
+    {
+        assert(i < m_islands.size());
+        if (!m_cq) {
+            // A moved-from archipelago has no completion queue.
+            m_cq = detail::make_unique<detail::archi_completion_queue>();
+        }
+        auto cq = m_cq.get();
+        cq->submit();
+        try {
+            // NOTE: the completion is signalled from within the evolution task, so that
+            // it is visible as soon as island::wait() returns.
+            m_islands[i]->enqueue_evolution([cq, i, f]() {
+                try {
+                    f();
+                } catch (...) {
+                    // The island is signalled as completed anyway, the exception
+                    // will be stored in the island's future.
+                    cq->complete(i);
+                    throw;
+                }
+                cq->complete(i);
+            });
+            // LCOV_EXCL_START
+        } catch (...) {
+            cq->cancel();
+            throw;
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    // NOTE: the completion queue is stored via a pointer so that
+    // its address stays valid when the archipelago is moved. It is declared
+    // before the islands so that it is destroyed after the islands' threads
+    // have been joined. The pointer is null in a moved-from archipelago,
+    // in which case it behaves as an empty queue.
+    std::unique_ptr<detail::archi_completion_queue> m_cq = detail::make_unique<detail::archi_completion_queue>();
+    // The Pareto archive shared by the islands (null if not set).
+    std::shared_ptr<pareto_archive> m_archive;
     container_t m_islands;
 };
 }
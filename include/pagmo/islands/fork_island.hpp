@@ -0,0 +1,530 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_ISLANDS_FORK_ISLAND_HPP
+#define PAGMO_ISLANDS_FORK_ISLAND_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pagmo/detail/socket_io.hpp>
+
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#endif
+
+#include <pagmo/evolve_limits.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/island.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/serialization.hpp>
+
+namespace pagmo
+{
+
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+
+namespace detail
+{
+
+// The prefix of the command line argument through which the worker
+// processes receive the file descriptor of their socket.
+inline const char *fork_fd_prefix()
+{
+    return "fd://";
+}
+
+// Locate the worker executable: names without slashes are looked up in PATH.
+inline std::string fork_resolve_executable(const std::string &name)
+{
+    if (name.find('/') != std::string::npos) {
+        if (::access(name.c_str(), X_OK) == -1) {
+            pagmo_throw(std::runtime_error, socket_errno_str("accessing the worker executable '" + name + "'"));
+        }
+        return name;
+    }
+    const auto path = std::getenv("PATH");
+    std::istringstream iss(path ? path : "");
+    std::string dir;
+    while (std::getline(iss, dir, ':')) {
+        const auto candidate = (dir.empty() ? std::string(".") : dir) + "/" + name;
+        if (::access(candidate.c_str(), X_OK) == 0) {
+            return candidate;
+        }
+    }
+    pagmo_throw(std::runtime_error, "the worker executable '" + name + "' could not be found in the PATH");
+}
+
+struct fork_worker {
+    ::pid_t pid;
+    int fd;
+    unsigned long long generation;
+};
+
+// The pool of worker processes shared by all the fork islands.
+template <typename = void>
+struct fork_pool {
+    // Terminate a worker: closing the socket makes the worker exit its main loop. A busy
+    // worker would first complete its evolution, so it is killed if force is true.
+    static void terminate(const fork_worker &w, bool force)
+    {
+        if (force) {
+            ::kill(w.pid, SIGKILL);
+        }
+        ::close(w.fd);
+        while (::waitpid(w.pid, nullptr, 0) == -1 && errno == EINTR) {
+        }
+    }
+    // Get a worker, spawning a new one if needed and allowed by the pool size.
+    static fork_worker acquire()
+    {
+        std::unique_lock<std::mutex> lock(s_mutex);
+        s_cond.wait(lock, []() { return !s_idle.empty() || s_workers.size() < s_size; });
+        if (!s_idle.empty()) {
+            const auto w = s_idle.back();
+            s_idle.pop_back();
+            return w;
+        }
+        // Prepare everything the child needs before forking: the parent is multithreaded,
+        // so the child can only invoke async-signal-safe functions until exec.
+        const auto exe = fork_resolve_executable(s_executable);
+        int sv[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == -1) {
+            pagmo_throw(std::runtime_error, socket_errno_str("socketpair()"));
+        }
+        // NOTE: the parent's end must not be inherited by the workers spawned later.
+        ::fcntl(sv[0], F_SETFD, FD_CLOEXEC);
+#if defined(SO_NOSIGPIPE)
+        int one = 1;
+        ::setsockopt(sv[0], SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        const auto arg = fork_fd_prefix() + std::to_string(sv[1]);
+        std::vector<char> exe_buf(exe.begin(), exe.end()), arg_buf(arg.begin(), arg.end());
+        exe_buf.push_back('\0');
+        arg_buf.push_back('\0');
+        char *argv[] = {exe_buf.data(), arg_buf.data(), nullptr};
+        s_workers.reserve(s_workers.size() + 1u);
+        const auto pid = ::fork();
+        if (pid == -1) {
+            ::close(sv[0]);
+            ::close(sv[1]);
+            pagmo_throw(std::runtime_error, socket_errno_str("fork()"));
+        }
+        if (pid == 0) {
+            // Child: replace the process image. The parent's ends of the sockets of
+            // all the workers are closed by exec (FD_CLOEXEC), so that the workers see the EOF
+            // when the parent closes them.
+            ::execv(argv[0], argv);
+            ::_exit(127);
+        }
+        ::close(sv[1]);
+        const fork_worker w{pid, sv[0], s_generation};
+        s_workers.push_back(w);
+        return w;
+    }
+    // Give back a worker acquired via acquire(). If ok is false, the worker is
+    // considered broken and it is killed.
+    static void release(const fork_worker &w, bool ok)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            if (ok && w.generation == s_generation && s_workers.size() <= s_size) {
+                s_idle.push_back(w);
+            } else {
+                remove(w);
+                terminate(w, !ok);
+            }
+        }
+        s_cond.notify_one();
+    }
+    // Remove w from the list of workers. Must be called with the lock held.
+    static void remove(const fork_worker &w)
+    {
+        s_workers.erase(std::remove_if(s_workers.begin(), s_workers.end(),
+                                       [&w](const fork_worker &other) { return other.pid == w.pid; }),
+                        s_workers.end());
+    }
+    // Terminate the idle workers. The busy ones will be terminated when released
+    // if they belong to an old generation or if they exceed the pool size.
+    static void shrink(bool new_generation)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (new_generation) {
+            ++s_generation;
+        }
+        while (!s_idle.empty() && (new_generation || s_workers.size() > s_size)) {
+            const auto w = s_idle.back();
+            s_idle.pop_back();
+            remove(w);
+            terminate(w, false);
+        }
+    }
+    static std::mutex s_mutex;
+    static std::condition_variable s_cond;
+    // All the live workers, and the idle ones.
+    static std::vector<fork_worker> s_workers;
+    static std::vector<fork_worker> s_idle;
+    static std::vector<fork_worker>::size_type s_size;
+    static unsigned long long s_generation;
+    static std::string s_executable;
+};
+
+template <typename T>
+std::mutex fork_pool<T>::s_mutex;
+
+template <typename T>
+std::condition_variable fork_pool<T>::s_cond;
+
+template <typename T>
+std::vector<fork_worker> fork_pool<T>::s_workers;
+
+template <typename T>
+std::vector<fork_worker> fork_pool<T>::s_idle;
+
+template <typename T>
+std::vector<fork_worker>::size_type fork_pool<T>::s_size = std::max(std::thread::hardware_concurrency(), 1u);
+
+template <typename T>
+unsigned long long fork_pool<T>::s_generation = 0;
+
+template <typename T>
+std::string fork_pool<T>::s_executable = "pagmo_socket_worker";
+}
+
+#endif
+
+/// Fork island.
+/**
+ * This user-defined island (UDI) will evolve its population in a separate process, using a pool of worker processes
+ * created via the POSIX <tt>fork()</tt> and <tt>exec()</tt> primitives. The island's algorithm and population are
+ * serialised and sent to a worker process over a Unix-domain socket, using the same protocol as
+ * pagmo::socket_island. The worker performs the evolution and sends back the evolved population. Since the evolution
+ * takes place in a separate process, this UDI can be used to parallelise problems and algorithms which do
+ * not provide any thread safety guarantee (see pagmo::thread_safety).
+ *
+ * The worker processes are created on demand, and they are kept alive and reused for successive
+ * evolutions, so that the cost of process creation is paid only once. The pool is shared by all the fork islands,
+ * and its maximum size can be set via fork_island::resize_pool() (the default being the number of hardware
+ * threads). The pool of worker processes can be shut down via fork_island::shutdown_pool().
+ *
+ * The worker processes run a separate executable (<tt>pagmo_socket_worker</tt> by default, looked up in the
+ * <tt>PATH</tt>), which is started with a single command line argument of the form <tt>"fd://N"</tt>, \p N
+ * being the file descriptor of the socket connected to the parent process. Starting a fresh process image,
+ * rather than running the evolution in a copy of the (multithreaded) parent process, ensures that the worker
+ * does not inherit locks held by other threads at the time of the fork. Any executable
+ * serving the requests via fork_island::worker_main() can be used (see fork_island::set_worker_executable()).
+ *
+ * All the user-defined types involved in the evolution (e.g., UDAs and UDPs) must be registered with pagmo's
+ * serialization machinery (e.g., via PAGMO_REGISTER_PROBLEM()) both in the process using the island and in
+ * the worker executable. <tt>pagmo_socket_worker</tt> can serve all the algorithms and problems implemented in
+ * pagmo. Programs using their own UDPs or UDAs can act as their own worker executable:
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. code-block:: c++
+ *
+ *    int main(int argc, char **argv)
+ *    {
+ *        if (pagmo::fork_island::worker_main(argc, argv)) {
+ *            // We are a worker process.
+ *            return 0;
+ *        }
+ *        pagmo::fork_island::set_worker_executable(argv[0]);
+ *        // ...
+ *    }
+ *
+ * .. note::
+ *
+ *    This UDI is available only on POSIX systems. On the other platforms, :cpp:func:`run_evolve()` will throw.
+ *
+ * \endverbatim
+ */
+class fork_island
+{
+public:
+    /// Island's name.
+    /**
+     * @return <tt>"Fork island"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Fork island";
+    }
+    /// Island's extra info.
+    /**
+     * @return a string containing information about the pool of worker processes.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream oss;
+        oss << "\tPool size: " << get_pool_size() << "\n\tWorker processes: " << get_worker_pids().size() << '\n';
+        oss << "\tWorker executable: " << get_worker_executable() << '\n';
+        return oss.str();
+    }
+    /// Run evolve.
+    /**
+     * This method will use copies of <tt>isl</tt>'s algorithm and population, obtained via island::get_algorithm()
+     * and island::get_population(), to evolve the input island's population in a worker process. The evolved
+     * population will be assigned to \p isl using island::set_population().
+     *
+     * If all the worker processes are busy and the pool has reached its maximum size, this method will
+     * wait until a worker becomes available.
+     *
+     * While waiting for the reply of the worker, the state of the evolution is checked between polling intervals
+     * of 100 ms: if the evolution is cancelled (see island::cancel()) or if its pagmo::evolve_limits timeout
+     * expires, the worker process is killed and this method returns without updating the population of \p isl.
+     *
+     * @param isl the pagmo::island that will undergo evolution.
+     *
+     * @throws std::runtime_error if the worker executable cannot be found, if the evolution in the worker process
+     * throws (the error message of the original exception will be included in the message of the exception), if the
+     * worker process terminates unexpectedly, or if this UDI is not supported on the current platform.
+     * @throws unspecified any exception thrown by island::get_algorithm(), island::get_population(),
+     * island::set_population(), by the serialization of the algorithm and of the population, or
+     * by system and threading primitives.
+     */
+    void run_evolve(island &isl) const
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        const auto request = detail::socket_evolve_request<cereal::PortableBinaryOutputArchive>(isl.get_algorithm(),
+                                                                                                isl.get_population());
+        const auto stop = []() { return evolve_stop_requested(); };
+        const auto w = detail::fork_pool<>::acquire();
+        char tag = 0;
+        std::string reply;
+        bool ok = false;
+        try {
+            ok = detail::socket_send_msg(w.fd, detail::socket_msg_evolve, request, stop)
+                 && detail::socket_recv_msg(w.fd, tag, reply, stop);
+        } catch (...) {
+        }
+        detail::fork_pool<>::release(w, ok);
+        if (!ok) {
+            if (stop()) {
+                // Interrupted evolution.
+                return;
+            }
+            pagmo_throw(std::runtime_error, "the worker process of a fork island terminated unexpectedly (worker "
+                                            "executable: '"
+                                                + get_worker_executable() + "')");
+        }
+        if (tag == detail::socket_msg_error) {
+            pagmo_throw(std::runtime_error,
+                        "the evolution in the worker process of a fork island raised an exception:\n" + reply);
+        }
+        isl.set_population(detail::socket_evolve_reply<cereal::PortableBinaryInputArchive>(reply));
+#else
+        (void)isl;
+        pagmo_throw(std::runtime_error, "the fork island is available only on POSIX systems");
+#endif
+    }
+    /// Get the pool size.
+    /**
+     * @return the maximum number of worker processes in the pool.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    static unsigned get_pool_size()
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        std::lock_guard<std::mutex> lock(detail::fork_pool<>::s_mutex);
+        return static_cast<unsigned>(detail::fork_pool<>::s_size);
+#else
+        return 0u;
+#endif
+    }
+    /// Resize the pool.
+    /**
+     * This method will set the maximum number of worker processes in the pool. If the new size is smaller than
+     * the current number of worker processes, the idle workers in excess will be terminated immediately, and the
+     * busy ones when they finish their current evolution.
+     *
+     * @param size the new maximum number of worker processes.
+     *
+     * @throws std::invalid_argument if \p size is zero.
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    static void resize_pool(unsigned size)
+    {
+        if (!size) {
+            pagmo_throw(std::invalid_argument, "the size of the process pool of the fork island must be nonzero");
+        }
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        {
+            std::lock_guard<std::mutex> lock(detail::fork_pool<>::s_mutex);
+            detail::fork_pool<>::s_size = size;
+        }
+        detail::fork_pool<>::shrink(false);
+        detail::fork_pool<>::s_cond.notify_all();
+#endif
+    }
+    /// Shut down the pool.
+    /**
+     * This method will terminate all the idle worker processes. The busy ones will be terminated as soon as
+     * they finish their current evolution. New worker processes will be created as needed by successive
+     * evolutions.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    static void shutdown_pool()
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        detail::fork_pool<>::shrink(true);
+#endif
+    }
+    /// Get the worker executable.
+    /**
+     * @return the name (or the path) of the executable run by the worker processes.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    static std::string get_worker_executable()
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        std::lock_guard<std::mutex> lock(detail::fork_pool<>::s_mutex);
+        return detail::fork_pool<>::s_executable;
+#else
+        return "";
+#endif
+    }
+    /// Set the worker executable.
+    /**
+     * This method will set the executable run by the worker processes. Names without slashes are looked up
+     * in the <tt>PATH</tt> when a worker process is started. The executable must serve the requests via
+     * fork_island::worker_main() (like <tt>pagmo_socket_worker</tt> does). The idle worker processes
+     * are terminated, as if by fork_island::shutdown_pool(), so that successive evolutions will use
+     * the new executable.
+     *
+     * @param exe the name or the path of the worker executable.
+     *
+     * @throws std::invalid_argument if \p exe is empty.
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    static void set_worker_executable(const std::string &exe)
+    {
+        if (exe.empty()) {
+            pagmo_throw(std::invalid_argument, "the worker executable of the fork island cannot be empty");
+        }
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        {
+            std::lock_guard<std::mutex> lock(detail::fork_pool<>::s_mutex);
+            detail::fork_pool<>::s_executable = exe;
+        }
+        detail::fork_pool<>::shrink(true);
+#endif
+    }
+    /// Entry point of the worker processes.
+    /**
+     * This function is meant to be called at the beginning of the <tt>main()</tt> function of a worker executable.
+     * If the command line arguments are those with which the fork islands start the worker processes, this
+     * function will serve the evolution requests of the parent process until the parent closes the connection,
+     * and then return \p true. Otherwise, \p false is returned immediately, and the executable can go on with its
+     * normal operations.
+     *
+     * @param argc the number of command line arguments.
+     * @param argv the command line arguments.
+     *
+     * @return \p true if the calling process is a worker process (whose work is done),
+     * \p false otherwise.
+     */
+    static bool worker_main(int argc, const char *const *argv)
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        const auto prefix = detail::fork_fd_prefix();
+        const auto prefix_len = std::strlen(prefix);
+        if (argc != 2 || std::strncmp(argv[1], prefix, prefix_len) != 0) {
+            return false;
+        }
+        const std::string fd_str(argv[1] + prefix_len);
+        if (fd_str.empty() || fd_str.size() > 9u || fd_str.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        const auto fd = std::stoi(fd_str);
+        try {
+            detail::socket_serve(fd);
+        } catch (...) {
+            // NOTE: the parent will see the connection closing,
+            // and it will report the failure.
+        }
+        ::close(fd);
+        return true;
+#else
+        (void)argc;
+        (void)argv;
+        return false;
+#endif
+    }
+    /// Get the worker processes' IDs.
+    /**
+     * @return the process IDs of the live worker processes.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    static std::vector<long> get_worker_pids()
+    {
+        std::vector<long> retval;
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        std::lock_guard<std::mutex> lock(detail::fork_pool<>::s_mutex);
+        for (const auto &w : detail::fork_pool<>::s_workers) {
+            retval.push_back(static_cast<long>(w.pid));
+        }
+#endif
+        return retval;
+    }
+    /// Serialization support.
+    /**
+     * This class is stateless, no data will be saved to or loaded from the archive.
+     */
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+}
+
+PAGMO_REGISTER_ISLAND(pagmo::fork_island)
+
+#endif
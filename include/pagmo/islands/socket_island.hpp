@@ -0,0 +1,902 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_ISLANDS_SOCKET_ISLAND_HPP
+#define PAGMO_ISLANDS_SOCKET_ISLAND_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/socket_io.hpp>
+
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#endif
+
+#include <pagmo/evolve_limits.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/island.hpp>
+#include <pagmo/serialization.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// A parsed socket address, either "tcp://host:port" or "unix://path".
+struct socket_address {
+    bool is_unix;
+    std::string host;
+    std::string port;
+    std::string path;
+};
+
+inline socket_address parse_socket_address(const std::string &address)
+{
+    const std::string tcp_prefix = "tcp://", unix_prefix = "unix://";
+    socket_address retval{false, "", "", ""};
+    if (address.compare(0, unix_prefix.size(), unix_prefix) == 0) {
+        retval.is_unix = true;
+        retval.path = address.substr(unix_prefix.size());
+        if (retval.path.empty()) {
+            pagmo_throw(std::invalid_argument, "the path in the socket address '" + address + "' is empty");
+        }
+        return retval;
+    }
+    if (address.compare(0, tcp_prefix.size(), tcp_prefix) != 0) {
+        pagmo_throw(std::invalid_argument, "the socket address '" + address
+                                               + "' is invalid: the address must be either in the form "
+                                                 "'tcp://host:port' or 'unix://path'");
+    }
+    const auto rest = address.substr(tcp_prefix.size());
+    std::string::size_type colon;
+    if (!rest.empty() && rest[0] == '[') {
+        // IPv6 address literal in brackets.
+        const auto bracket = rest.find(']');
+        if (bracket == std::string::npos || bracket + 1u >= rest.size() || rest[bracket + 1u] != ':') {
+            pagmo_throw(std::invalid_argument, "the socket address '" + address + "' is invalid");
+        }
+        retval.host = rest.substr(1u, bracket - 1u);
+        colon = bracket + 1u;
+    } else {
+        colon = rest.rfind(':');
+        if (colon == std::string::npos) {
+            pagmo_throw(std::invalid_argument, "the socket address '" + address + "' does not contain a port");
+        }
+        retval.host = rest.substr(0, colon);
+    }
+    retval.port = rest.substr(colon + 1u);
+    if (retval.host.empty()) {
+        pagmo_throw(std::invalid_argument, "the host in the socket address '" + address + "' is empty");
+    }
+    if (retval.port.empty() || retval.port.size() > 5u
+        || retval.port.find_first_not_of("0123456789") != std::string::npos || std::stoul(retval.port) > 65535ul) {
+        pagmo_throw(std::invalid_argument, "the port in the socket address '" + address + "' is invalid");
+    }
+    return retval;
+}
+
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+
+// Close a file descriptor, ignoring errors.
+inline void socket_close(int fd)
+{
+    while (::close(fd) == -1 && errno == EINTR) {
+    }
+}
+
+// Socket options common to all the connections.
+inline void socket_setup(int fd, bool is_unix)
+{
+    int one = 1;
+    if (!is_unix) {
+        // The messages are sent as a whole, avoid delays on small replies.
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        // An evolution can keep a connection silent for a long time: use keepalive
+        // probes to detect peers which disappeared without closing the connection
+        // (e.g., after a crash of their machine). Where possible, we start probing
+        // after one minute of inactivity rather than after the default two hours.
+        ::setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+        int idle = 60, intvl = 10, cnt = 6;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+        ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &intvl, sizeof(intvl));
+        ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt));
+#endif
+    }
+#if defined(SO_NOSIGPIPE)
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    (void)one;
+}
+
+// Fill in a Unix-domain socket address.
+inline ::sockaddr_un socket_unix_sockaddr(const std::string &path)
+{
+    ::sockaddr_un retval;
+    std::memset(&retval, 0, sizeof(retval));
+    if (path.size() >= sizeof(retval.sun_path)) {
+        pagmo_throw(std::invalid_argument, "the Unix-domain socket path '" + path + "' is too long");
+    }
+    retval.sun_family = AF_UNIX;
+    std::memcpy(retval.sun_path, path.c_str(), path.size());
+    return retval;
+}
+
+// Remove the file at path if it is a Unix-domain socket on which nobody is listening,
+// e.g., one left behind by a worker that crashed.
+inline void socket_unlink_stale(const std::string &path, const ::sockaddr_un &sa)
+{
+    struct ::stat st;
+    if (::lstat(path.c_str(), &st) == -1 || !S_ISSOCK(st.st_mode)) {
+        return;
+    }
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        return;
+    }
+    if (::connect(fd, reinterpret_cast<const ::sockaddr *>(&sa), sizeof(sa)) == -1 && errno == ECONNREFUSED) {
+        ::unlink(path.c_str());
+    }
+    socket_close(fd);
+}
+
+// RAII wrapper for the result of getaddrinfo().
+struct socket_addrinfo {
+    socket_addrinfo(const socket_address &addr, bool passive) : m_res(nullptr)
+    {
+        ::addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = passive ? AI_PASSIVE : 0;
+        const auto ret = ::getaddrinfo(addr.host.c_str(), addr.port.c_str(), &hints, &m_res);
+        if (ret) {
+            pagmo_throw(std::runtime_error,
+                        "could not resolve the host '" + addr.host + "': " + std::string(::gai_strerror(ret)));
+        }
+    }
+    ~socket_addrinfo()
+    {
+        ::freeaddrinfo(m_res);
+    }
+    socket_addrinfo(const socket_addrinfo &) = delete;
+    socket_addrinfo &operator=(const socket_addrinfo &) = delete;
+    ::addrinfo *m_res;
+};
+
+// Connect fd to the input address, waiting at most timeout seconds (an infinite timeout
+// means no limit). The connection is established in non-blocking mode, so that stop() can be
+// checked while waiting. Returns 0 on success, -1 if stop() returned true, and the errno value
+// describing the failure otherwise (ETIMEDOUT if the timeout expired).
+template <typename F>
+inline int socket_connect_fd(int fd, const ::sockaddr *sa, ::socklen_t len, double timeout, const F &stop)
+{
+    using clock_t = std::chrono::steady_clock;
+    const auto flags = ::fcntl(fd, F_GETFL);
+    if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+        return errno;
+    }
+    if (::connect(fd, sa, len) == -1) {
+        if (errno != EINPROGRESS && errno != EINTR) {
+            return errno;
+        }
+        const auto has_deadline = std::isfinite(timeout);
+        const auto deadline
+            = has_deadline ? clock_t::now()
+                                 + std::chrono::duration_cast<clock_t::duration>(std::chrono::duration<double>(timeout))
+                           : clock_t::time_point{};
+        while (true) {
+            if (stop()) {
+                return -1;
+            }
+            auto ms = socket_poll_interval;
+            if (has_deadline) {
+                const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock_t::now());
+                if (left.count() <= 0) {
+                    return ETIMEDOUT;
+                }
+                ms = static_cast<int>(std::min<decltype(left.count())>(left.count(), ms));
+            }
+            ::pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            const auto ret = ::poll(&pfd, 1, ms);
+            if (ret == -1 && errno != EINTR) {
+                return errno;
+            }
+            if (ret > 0) {
+                break;
+            }
+        }
+        int err = 0;
+        ::socklen_t err_len = sizeof(err);
+        if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &err_len) == -1) {
+            return errno;
+        }
+        if (err) {
+            return err;
+        }
+    }
+    // Back to blocking mode: the I/O functions wait via poll() on their own.
+    return ::fcntl(fd, F_SETFL, flags) == -1 ? errno : 0;
+}
+
+// Open a connection to a socket worker, waiting at most timeout seconds for each of the
+// addresses the host resolves to. Returns -1 if stop() returned true while connecting.
+template <typename F = socket_no_stop>
+inline int socket_connect(const std::string &address, double timeout = std::numeric_limits<double>::infinity(),
+                          const F &stop = F{})
+{
+    const auto addr = parse_socket_address(address);
+    if (addr.is_unix) {
+        const auto sa = socket_unix_sockaddr(addr.path);
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd == -1) {
+            pagmo_throw(std::runtime_error, socket_errno_str("socket()"));
+        }
+        const auto ret = socket_connect_fd(fd, reinterpret_cast<const ::sockaddr *>(&sa), sizeof(sa), timeout, stop);
+        if (ret) {
+            socket_close(fd);
+            if (ret == -1) {
+                return -1;
+            }
+            errno = ret;
+            pagmo_throw(std::runtime_error, socket_errno_str("connecting to '" + address + "'"));
+        }
+        socket_setup(fd, true);
+        return fd;
+    }
+    socket_addrinfo ai(addr, false);
+    std::string err = "could not connect to '" + address + "'";
+    for (auto p = ai.m_res; p; p = p->ai_next) {
+        const int fd = ::socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+        if (fd == -1) {
+            err = socket_errno_str("socket()");
+            continue;
+        }
+        const auto ret = socket_connect_fd(fd, p->ai_addr, p->ai_addrlen, timeout, stop);
+        if (!ret) {
+            socket_setup(fd, false);
+            return fd;
+        }
+        socket_close(fd);
+        if (ret == -1) {
+            return -1;
+        }
+        errno = ret;
+        err = socket_errno_str("connecting to '" + address + "'");
+    }
+    pagmo_throw(std::runtime_error, err);
+}
+
+// The pool of idle connections to the socket workers, shared by all the socket islands
+// and indexed by address.
+template <typename = void>
+struct socket_conn_pool {
+    // Get a connection to address, reusing an idle one if possible. A new connection
+    // is opened via socket_connect(), and -1 is returned if it was interrupted by stop().
+    template <typename F>
+    static int acquire(const std::string &address, double timeout, const F &stop, bool &reused)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            auto it = s_idle.find(address);
+            if (it != s_idle.end() && !it->second.empty()) {
+                const auto fd = it->second.back();
+                it->second.pop_back();
+                reused = true;
+                return fd;
+            }
+        }
+        reused = false;
+        return socket_connect(address, timeout, stop);
+    }
+    static void release(const std::string &address, int fd)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        try {
+            s_idle[address].push_back(fd);
+        } catch (...) {
+            socket_close(fd);
+        }
+    }
+    // Close the idle connections to address, after one of them turned out to be stale.
+    static void discard(const std::string &address)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto it = s_idle.find(address);
+        if (it != s_idle.end()) {
+            for (auto fd : it->second) {
+                socket_close(fd);
+            }
+            s_idle.erase(it);
+        }
+    }
+    static void clear()
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (const auto &p : s_idle) {
+            for (auto fd : p.second) {
+                socket_close(fd);
+            }
+        }
+        s_idle.clear();
+    }
+    static std::mutex s_mutex;
+    static std::unordered_map<std::string, std::vector<int>> s_idle;
+};
+
+template <typename T>
+std::mutex socket_conn_pool<T>::s_mutex;
+
+template <typename T>
+std::unordered_map<std::string, std::vector<int>> socket_conn_pool<T>::s_idle;
+
+#endif
+}
+
+/// Socket island.
+/**
+ * This user-defined island (UDI) will evolve its population in a remote worker process, represented by
+ * a pagmo::socket_worker, which can run on the same machine or on another machine. The island's
+ * algorithm and population are serialised (using a portable binary format) and sent to the worker
+ * over a TCP or Unix-domain socket. The worker evolves the population and sends it back.
+ *
+ * The address of the worker is specified as a string in one of the following forms:
+ *
+ * - <tt>"tcp://host:port"</tt> (e.g., <tt>"tcp://192.168.1.10:2424"</tt> or <tt>"tcp://[::1]:2424"</tt>),
+ * - <tt>"unix://path"</tt> (e.g., <tt>"unix:///tmp/pagmo_worker.sock"</tt>).
+ *
+ * The connections to the workers are kept open and reused by successive evolutions (from any socket island
+ * in the process), so that the connection latency is paid only once. If a reused connection turns out to
+ * have been closed (e.g., because the worker was restarted), all the idle connections to that worker are closed
+ * and the evolution is retried once on a new connection.
+ *
+ * Establishing a new connection fails if the worker does not accept it within a configurable timeout
+ * (10 seconds by default). TCP connections use keepalive probes, so that a worker which disappears
+ * without closing the connection (e.g., because its machine crashed) is eventually detected. While waiting
+ * for the worker, the island checks the state of the evolution between polling intervals of 100 ms: if the
+ * evolution is cancelled (see island::cancel()) or if its pagmo::evolve_limits timeout expires,
+ * the connection is closed and <tt>run_evolve()</tt> returns without updating the island's population
+ * (the worker will discard the result of the interrupted evolution).
+ *
+ * The protocol is a simple request/reply scheme over a stream socket. Each message is made of a tag
+ * byte, a 64-bit little-endian payload size and the payload. The payload of a request is the serialised
+ * algorithm and population, the payload of a reply is either the serialised evolved population
+ * (tag 0) or an error message (tag 1). Messages whose payload exceeds 512 MiB are rejected.
+ *
+ * All the user-defined types involved in the evolution (e.g., UDAs and UDPs) must be registered with pagmo's
+ * serialization machinery (e.g., via PAGMO_REGISTER_PROBLEM()) both in the process using the island and in
+ * the worker process.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    This UDI is available only on POSIX systems. On the other platforms, :cpp:func:`run_evolve()` will throw.
+ *
+ * .. warning::
+ *
+ *    The protocol provides neither authentication nor encryption, and the workers deserialise whatever they
+ *    receive. The workers must be reachable only from trusted networks.
+ *
+ * \endverbatim
+ */
+class socket_island
+{
+public:
+    /// Default constructor.
+    /**
+     * The default constructor will set the worker's address to socket_island::default_address().
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    socket_island() : m_address(default_address()), m_connect_timeout(10.)
+    {
+    }
+    /// Constructor from address.
+    /**
+     * @param address the address of the socket worker.
+     * @param connect_timeout the maximum time, in seconds, to wait for the establishment of a new connection
+     * to the worker (an infinite value disables the timeout).
+     *
+     * @throws std::invalid_argument if \p address is not in one of the formats described above, or if
+     * \p connect_timeout is not positive.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    explicit socket_island(const std::string &address, double connect_timeout = 10.)
+        : m_address(address), m_connect_timeout(connect_timeout)
+    {
+        detail::parse_socket_address(m_address);
+        if (!(connect_timeout > 0.)) {
+            pagmo_throw(std::invalid_argument, "the connection timeout of a socket island must be positive, but a "
+                                               "value of "
+                                                   + std::to_string(connect_timeout) + " was provided instead");
+        }
+    }
+    /// Default address.
+    /**
+     * @return <tt>"tcp://127.0.0.1:2424"</tt>.
+     */
+    static std::string default_address()
+    {
+        return "tcp://127.0.0.1:2424";
+    }
+    /// Get the address.
+    /**
+     * @return the address of the socket worker.
+     */
+    const std::string &get_address() const
+    {
+        return m_address;
+    }
+    /// Get the connection timeout.
+    /**
+     * @return the maximum time, in seconds, to wait for the establishment of a new connection to the worker.
+     */
+    double get_connect_timeout() const
+    {
+        return m_connect_timeout;
+    }
+    /// Island's name.
+    /**
+     * @return <tt>"Socket island"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Socket island";
+    }
+    /// Island's extra info.
+    /**
+     * @return a string containing the address of the socket worker and the connection timeout.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream oss;
+        oss << "\tWorker address: " << m_address << "\n";
+        oss << "\tConnection timeout: " << m_connect_timeout << " s\n";
+        return oss.str();
+    }
+    /// Run evolve.
+    /**
+     * This method will use copies of <tt>isl</tt>'s algorithm and population, obtained via island::get_algorithm()
+     * and island::get_population(), to evolve the input island's population in the socket worker. The evolved
+     * population will be assigned to \p isl using island::set_population(). If the evolution is cancelled or
+     * its timeout expires before the reply of the worker is received, the population of \p isl is not modified.
+     *
+     * @param isl the pagmo::island that will undergo evolution.
+     *
+     * @throws std::runtime_error if the connection to the worker cannot be established (within the
+     * connection timeout) or is lost, if the
+     * evolution in the worker throws (the error message of the original exception will be included in the
+     * message of the exception), or if this UDI is not supported on the current platform.
+     * @throws unspecified any exception thrown by island::get_algorithm(), island::get_population(),
+     * island::set_population() or by the serialization of the algorithm and of the population.
+     */
+    void run_evolve(island &isl) const
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        using pool = detail::socket_conn_pool<>;
+        const auto request = detail::socket_evolve_request<cereal::PortableBinaryOutputArchive>(
+            isl.get_algorithm(), isl.get_population());
+        // NOTE: the stop state of the evolution is checked between the poll() calls, so that
+        // cancellation and timeouts are honoured while waiting for the worker.
+        const auto stop = []() { return evolve_stop_requested(); };
+        for (auto attempt = 0;; ++attempt) {
+            bool reused = false;
+            // The retry always uses a new connection.
+            const auto fd = attempt ? detail::socket_connect(m_address, m_connect_timeout, stop)
+                                    : pool::acquire(m_address, m_connect_timeout, stop, reused);
+            if (fd == -1) {
+                // Interrupted while connecting.
+                return;
+            }
+            char tag = 0;
+            std::string reply;
+            bool ok = false;
+            try {
+                ok = detail::socket_send_msg(fd, detail::socket_msg_evolve, request, stop)
+                     && detail::socket_recv_msg(fd, tag, reply, stop);
+            } catch (...) {
+            }
+            if (!ok) {
+                // NOTE: the connection is in an unknown state (the reply might
+                // still be on its way), so it cannot be reused.
+                detail::socket_close(fd);
+                if (stop()) {
+                    return;
+                }
+                if (reused) {
+                    // Stale connection: the worker was probably restarted, so all the other
+                    // idle connections to it are stale as well. Try again with a new one.
+                    pool::discard(m_address);
+                    continue;
+                }
+                pagmo_throw(std::runtime_error,
+                            "the connection to the socket worker at '" + m_address + "' was lost");
+            }
+            pool::release(m_address, fd);
+            if (tag == detail::socket_msg_error) {
+                pagmo_throw(std::runtime_error, "the evolution in the socket worker at '" + m_address
+                                                    + "' raised an exception:\n" + reply);
+            }
+            isl.set_population(detail::socket_evolve_reply<cereal::PortableBinaryInputArchive>(reply));
+            return;
+        }
+#else
+        (void)isl;
+        pagmo_throw(std::runtime_error, "the socket island is available only on POSIX systems");
+#endif
+    }
+    /// Close the idle connections.
+    /**
+     * This method will close all the idle connections to the socket workers. New connections will be opened
+     * as needed by successive evolutions.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    static void close_connections()
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        detail::socket_conn_pool<>::clear();
+#endif
+    }
+    /// Serialization support.
+    /**
+     * @param ar the target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the address and of the timeout.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_address, m_connect_timeout);
+    }
+
+private:
+    std::string m_address;
+    double m_connect_timeout;
+};
+
+/// Socket worker.
+/**
+ * This class implements the worker daemon used by pagmo::socket_island. A socket worker listens on a TCP
+ * or Unix-domain socket, and serves the evolution requests of the socket islands. Each connection is served
+ * by a separate thread, so that a single worker can serve many islands concurrently. Evolutions involving an
+ * algorithm or a problem which do not provide at least the pagmo::thread_safety::basic guarantee are serialised.
+ *
+ * The worker can deserialise only the user-defined types which are registered in its process. pagmo ships a
+ * small executable, <tt>pagmo_socket_worker</tt>, which can serve all the algorithms and problems implemented
+ * in pagmo. Users needing to evolve their own UDPs or UDAs will need to build their own executable, e.g.:
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. code-block:: c++
+ *
+ *    #include <pagmo/pagmo.hpp>
+ *
+ *    #include "my_udp.hpp" // Defines and registers my_udp.
+ *
+ *    int main()
+ *    {
+ *        pagmo::socket_worker w("tcp://0.0.0.0:2424");
+ *        w.run();
+ *    }
+ *
+ * .. note::
+ *
+ *    This class is available only on POSIX systems. On the other platforms, the constructor will throw.
+ *
+ * \endverbatim
+ */
+class socket_worker
+{
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+    // A connection and the thread serving it.
+    struct connection {
+        int fd;
+        std::atomic<bool> done;
+        std::thread thread;
+    };
+#endif
+
+public:
+    /// Constructor.
+    /**
+     * The constructor will bind the worker to the input address and start listening for connections.
+     * If the port of a TCP address is zero, a free port will be chosen by the operating system
+     * (the actual address can be retrieved via get_address()). The connections will be served
+     * only after run() is invoked.
+     *
+     * @param address the address the worker will be listening on.
+     *
+     * @throws std::invalid_argument if \p address is not valid.
+     * @throws std::runtime_error if the socket cannot be created or bound, or if this class
+     * is not supported on the current platform.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    explicit socket_worker(const std::string &address = socket_island::default_address())
+        : m_stop(false), m_n_connections(0)
+    {
+        const auto addr = detail::parse_socket_address(address);
+        (void)addr;
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        if (::pipe(m_pipe) == -1) {
+            pagmo_throw(std::runtime_error, detail::socket_errno_str("pipe()"));
+        }
+        try {
+            if (addr.is_unix) {
+                listen_unix(addr);
+            } else {
+                listen_tcp(addr);
+            }
+        } catch (...) {
+            detail::socket_close(m_pipe[0]);
+            detail::socket_close(m_pipe[1]);
+            throw;
+        }
+#else
+        pagmo_throw(std::runtime_error, "the socket worker is available only on POSIX systems");
+#endif
+    }
+    /// Deleted copy constructor.
+    socket_worker(const socket_worker &) = delete;
+    /// Deleted copy assignment.
+    socket_worker &operator=(const socket_worker &) = delete;
+    /// Destructor.
+    /**
+     * The destructor will stop listening and, for Unix-domain sockets, remove the socket file.
+     * run() must not be running when the destructor is invoked.
+     */
+    ~socket_worker()
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        detail::socket_close(m_fd);
+        detail::socket_close(m_pipe[0]);
+        detail::socket_close(m_pipe[1]);
+        if (!m_unix_path.empty()) {
+            ::unlink(m_unix_path.c_str());
+        }
+#endif
+    }
+    /// Get the address.
+    /**
+     * @return the address the worker is listening on.
+     */
+    const std::string &get_address() const
+    {
+        return m_address;
+    }
+    /// Number of accepted connections.
+    /**
+     * @return the total number of connections accepted by the worker.
+     */
+    unsigned long long get_n_connections() const
+    {
+        return m_n_connections.load();
+    }
+    /// Serve connections.
+    /**
+     * This method will accept and serve connections until stop() is invoked. Before returning,
+     * the open connections will be closed and their threads joined (ongoing evolutions will be
+     * allowed to finish, but their results will be discarded). This method must not be called
+     * concurrently from multiple threads.
+     *
+     * @throws std::runtime_error in case of errors while accepting connections.
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    void run()
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        std::vector<std::unique_ptr<connection>> conns;
+        // Close all the connections and join their threads.
+        auto closer = [&conns]() {
+            for (auto &c : conns) {
+                ::shutdown(c->fd, SHUT_RDWR);
+            }
+            for (auto &c : conns) {
+                c->thread.join();
+                detail::socket_close(c->fd);
+            }
+        };
+        try {
+            while (!m_stop.load()) {
+                ::pollfd fds[2];
+                fds[0].fd = m_fd;
+                fds[0].events = POLLIN;
+                fds[1].fd = m_pipe[0];
+                fds[1].events = POLLIN;
+                if (::poll(fds, 2, -1) == -1) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    pagmo_throw(std::runtime_error, detail::socket_errno_str("poll()"));
+                }
+                if (fds[1].revents || m_stop.load()) {
+                    break;
+                }
+                const int fd = ::accept(m_fd, nullptr, nullptr);
+                if (fd == -1) {
+                    if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK) {
+                        continue;
+                    }
+                    pagmo_throw(std::runtime_error, detail::socket_errno_str("accept()"));
+                }
+                ++m_n_connections;
+                // Remove the connections which were closed by the clients.
+                for (auto it = conns.begin(); it != conns.end();) {
+                    if ((*it)->done.load()) {
+                        (*it)->thread.join();
+                        detail::socket_close((*it)->fd);
+                        it = conns.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                std::unique_ptr<connection> c(new connection);
+                c->fd = fd;
+                c->done.store(false);
+                try {
+                    detail::socket_setup(fd, m_unix_path.empty());
+                    conns.reserve(conns.size() + 1u);
+                    auto *cptr = c.get();
+                    c->thread = std::thread([this, cptr]() { serve(*cptr); });
+                } catch (...) {
+                    detail::socket_close(fd);
+                    throw;
+                }
+                conns.push_back(std::move(c));
+            }
+        } catch (...) {
+            closer();
+            throw;
+        }
+        closer();
+#endif
+    }
+    /// Stop serving connections.
+    /**
+     * This method will make run() return. If run() is not running, the next invocation of run()
+     * will return immediately. This method is async-signal-safe, and thus it can be invoked
+     * from a signal handler.
+     */
+    void stop()
+    {
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+        m_stop.store(true);
+        const char c = 0;
+        // NOTE: a failed write is not an issue, the flag will be seen
+        // at the next iteration of the accept loop.
+        const auto ret = ::write(m_pipe[1], &c, 1);
+        (void)ret;
+#endif
+    }
+
+private:
+#if defined(PAGMO_DETAIL_POSIX_SOCKETS)
+    void listen_unix(const detail::socket_address &addr)
+    {
+        const auto sa = detail::socket_unix_sockaddr(addr.path);
+        detail::socket_unlink_stale(addr.path, sa);
+        m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (m_fd == -1) {
+            pagmo_throw(std::runtime_error, detail::socket_errno_str("socket()"));
+        }
+        if (::bind(m_fd, reinterpret_cast<const ::sockaddr *>(&sa), sizeof(sa)) == -1
+            || ::listen(m_fd, SOMAXCONN) == -1) {
+            const auto err = detail::socket_errno_str("listening on 'unix://" + addr.path + "'");
+            detail::socket_close(m_fd);
+            pagmo_throw(std::runtime_error, err);
+        }
+        m_unix_path = addr.path;
+        m_address = "unix://" + addr.path;
+    }
+    void listen_tcp(const detail::socket_address &addr)
+    {
+        detail::socket_addrinfo ai(addr, true);
+        std::string err = "could not listen on 'tcp://" + addr.host + ":" + addr.port + "'";
+        for (auto p = ai.m_res; p; p = p->ai_next) {
+            m_fd = ::socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+            if (m_fd == -1) {
+                err = detail::socket_errno_str("socket()");
+                continue;
+            }
+            int one = 1;
+            ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            ::sockaddr_storage ss;
+            ::socklen_t len = sizeof(ss);
+            if (::bind(m_fd, p->ai_addr, p->ai_addrlen) == 0 && ::listen(m_fd, SOMAXCONN) == 0
+                && ::getsockname(m_fd, reinterpret_cast<::sockaddr *>(&ss), &len) == 0) {
+                // Fetch the actual port, in case the requested one was zero.
+                const auto port = ss.ss_family == AF_INET6
+                                      ? ntohs(reinterpret_cast<const ::sockaddr_in6 *>(&ss)->sin6_port)
+                                      : ntohs(reinterpret_cast<const ::sockaddr_in *>(&ss)->sin_port);
+                const auto host = addr.host.find(':') == std::string::npos ? addr.host : "[" + addr.host + "]";
+                m_address = "tcp://" + host + ":" + std::to_string(port);
+                return;
+            }
+            err = detail::socket_errno_str("listening on 'tcp://" + addr.host + ":" + addr.port + "'");
+            detail::socket_close(m_fd);
+        }
+        pagmo_throw(std::runtime_error, err);
+    }
+    // Serve the requests on a connection until the client closes it.
+    void serve(connection &c)
+    {
+        try {
+            detail::socket_serve(c.fd, &m_unsafe_mutex);
+        } catch (...) {
+            // NOTE: the connection will be closed by the accept loop, there is
+            // not much else that can be done here.
+        }
+        c.done.store(true);
+    }
+    int m_fd;
+    int m_pipe[2];
+    std::string m_unix_path;
+    std::mutex m_unsafe_mutex;
+#endif
+    std::string m_address;
+    std::atomic<bool> m_stop;
+    std::atomic<unsigned long long> m_n_connections;
+};
+}
+
+PAGMO_REGISTER_ISLAND(pagmo::socket_island)
+
+#endif
@@ -45,6 +45,7 @@ see https://www.gnu.org/licenses/. */
 #endif
 #include <pagmo/algorithms/mbh.hpp>
 #include <pagmo/algorithms/moead.hpp>
+#include <pagmo/algorithms/multi_start.hpp>
 #if defined(PAGMO_WITH_NLOPT)
 #include <pagmo/algorithms/nlopt.hpp>
 #endif
@@ -55,9 +56,14 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/algorithms/sga.hpp>
 #include <pagmo/algorithms/simulated_annealing.hpp>
 #include <pagmo/archipelago.hpp>
+#include <pagmo/bfe.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/island.hpp>
+#include <pagmo/islands/fork_island.hpp>
+#include <pagmo/islands/socket_island.hpp>
+#include <pagmo/pareto_archive.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/ackley.hpp>
@@ -68,6 +74,7 @@ see https://www.gnu.org/licenses/. */
 #endif
 #include <pagmo/problems/decompose.hpp>
 #include <pagmo/problems/dtlz.hpp>
+#include <pagmo/problems/fd_gradient.hpp>
 #include <pagmo/problems/griewank.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
 #include <pagmo/problems/inventory.hpp>
@@ -91,6 +98,8 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/utils/hv_algos/hv_hv2d.hpp>
 #include <pagmo/utils/hv_algos/hv_hv3d.hpp>
 #include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hv_algos/hv_mc_approx.hpp>
+#include <pagmo/utils/hv_contributions.hpp>
 #include <pagmo/utils/hypervolume.hpp>
 #include <pagmo/utils/multi_objective.hpp>
 
@@ -0,0 +1,506 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PARETO_ARCHIVE_HPP
+#define PAGMO_PARETO_ARCHIVE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/exceptions.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hv_algos/hv_hv2d.hpp>
+#include <pagmo/utils/hv_algos/hv_hv3d.hpp>
+#include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hv_contributions.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+namespace pagmo
+{
+
+/// Pruning policies for pagmo::pareto_archive.
+/**
+ * This enumeration lists the criteria used by pagmo::pareto_archive to select the points
+ * to be discarded when the archive exceeds its capacity.
+ */
+enum class archive_pruning {
+    /// Discard the point with the smallest crowding distance (see pagmo::crowding_distance()).
+    crowding_distance,
+    /// Discard the point with the smallest exclusive contribution to the hypervolume of the archive. The reference
+    /// point is the nadir of the archive before the pruning, shifted by 10% of the extent of the archive in each
+    /// objective (or by 1, if the extent is zero), so that the extreme points have a nonzero contribution.
+    hv_contribution
+};
+
+/// Bounded archive of non-dominated points.
+/**
+ * This class stores a set of mutually non-dominated decision vectors, together with their objective vectors.
+ * Inserting a point in the archive is a no-op if the point is dominated by (or has the same objective vector as)
+ * a point already in the archive. Otherwise, the new point is added and the points it dominates are removed.
+ * When the number of points exceeds the capacity of the archive, the points are discarded one at a time according
+ * to the selected pagmo::archive_pruning policy until the capacity is respected again.
+ *
+ * The archive can be shared among several threads: the getters read, without locking, an immutable version of the
+ * content which is replaced at the end of each insertion. Thus, the archive can be read at any time (e.g., while
+ * the islands of a pagmo::archipelago are inserting their populations into it, see
+ * archipelago::set_pareto_archive()), and the readers never block the writers. An insertion, including the
+ * pruning, is computed on a copy of the content without holding any lock, and the result is published only if no
+ * other insertion was published in the meantime: otherwise, the insertion is repeated on the new content (after a
+ * few attempts, it is repeated while holding a mutex which keeps the other writers from publishing).
+ * Copy, move, assignment and deserialization are not thread-safe.
+ *
+ * With the pagmo::archive_pruning::hv_contribution policy and 2 or 3 objectives, the contributions are updated
+ * with pagmo::hv_contributions after each discarded point. Otherwise, they are recomputed from scratch.
+ *
+ * All the objectives are minimised. The objective vectors of a pagmo::population are the first
+ * <tt>problem::get_nobj()</tt> components of the fitness vectors, and only feasible individuals are
+ * considered (see problem::feasibility_f()).
+ */
+class pareto_archive
+{
+    // The content of the archive. Once published, it is never modified.
+    struct content {
+        std::vector<vector_double> x;
+        std::vector<vector_double> f;
+    };
+
+public:
+    /// The size type of the archive.
+    using size_type = std::vector<vector_double>::size_type;
+    /// Constructor.
+    /**
+     * The constructor will initialise an empty archive.
+     *
+     * @param capacity the maximum number of points in the archive.
+     * @param pruning the policy used to discard points when the archive is full.
+     *
+     * @throws std::invalid_argument if \p capacity is zero or if \p pruning is not one of
+     * the values of pagmo::archive_pruning.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    explicit pareto_archive(size_type capacity = 100u, archive_pruning pruning = archive_pruning::crowding_distance)
+        : m_capacity(capacity), m_pruning(pruning), m_version(0u), m_content(std::make_shared<const content>())
+    {
+        if (!capacity) {
+            pagmo_throw(std::invalid_argument, "The capacity of a Pareto archive must be at least 1");
+        }
+        if (pruning != archive_pruning::crowding_distance && pruning != archive_pruning::hv_contribution) {
+            pagmo_throw(std::invalid_argument,
+                        "Invalid pruning policy for a Pareto archive: " + std::to_string(static_cast<int>(pruning)));
+        }
+    }
+    /// Copy constructor.
+    /**
+     * @param other the archive that will be copied.
+     */
+    pareto_archive(const pareto_archive &other)
+        : m_capacity(other.m_capacity), m_pruning(other.m_pruning), m_version(0u), m_content(other.load_content())
+    {
+    }
+    /// Move constructor.
+    /**
+     * After the move, \p other is left in an unspecified but valid state.
+     *
+     * @param other the archive that will be moved.
+     */
+    pareto_archive(pareto_archive &&other) noexcept
+        : m_capacity(other.m_capacity), m_pruning(other.m_pruning), m_version(0u), m_content(other.load_content())
+    {
+    }
+    /// Copy assignment.
+    /**
+     * @param other the assignment argument.
+     *
+     * @return a reference to \p this.
+     */
+    pareto_archive &operator=(const pareto_archive &other)
+    {
+        if (this != &other) {
+            m_capacity = other.m_capacity;
+            m_pruning = other.m_pruning;
+            ++m_version;
+            std::atomic_store(&m_content, other.load_content());
+        }
+        return *this;
+    }
+    /// Move assignment.
+    /**
+     * @param other the assignment argument.
+     *
+     * @return a reference to \p this.
+     */
+    pareto_archive &operator=(pareto_archive &&other) noexcept
+    {
+        return *this = static_cast<const pareto_archive &>(other);
+    }
+    /// Insert a point.
+    /**
+     * This method will insert into the archive the point with decision vector \p x and objective vector \p f,
+     * as explained in the class documentation.
+     *
+     * @param x the decision vector.
+     * @param f the objective vector.
+     *
+     * @return \p true if the point is in the archive after the insertion, \p false otherwise.
+     *
+     * @throws std::invalid_argument if \p f is empty or contains NaNs, or if the sizes of \p x and \p f
+     * differ from the ones of the points already in the archive.
+     * @throws unspecified any exception thrown by memory errors in standard containers or by the
+     * hypervolume computations.
+     */
+    bool insert(const vector_double &x, const vector_double &f)
+    {
+        return insert_impl({&x}, {&f}) != 0u;
+    }
+    /// Insert a population.
+    /**
+     * This method will insert into the archive the feasible individuals of \p pop, as if by calling
+     * insert(const vector_double &, const vector_double &) on each of them. The content of the archive is
+     * published once, after all the individuals have been inserted: readers never observe a partial insertion.
+     *
+     * @param pop the input population.
+     *
+     * @return the number of individuals of \p pop which are in the archive after the insertion.
+     *
+     * @throws unspecified any exception thrown by insert(const vector_double &, const vector_double &),
+     * by problem::feasibility_f(), or by memory errors in standard containers.
+     */
+    size_type insert(const population &pop)
+    {
+        const auto &prob = pop.get_problem();
+        const auto nobj = prob.get_nobj();
+        std::vector<const vector_double *> xs, fs;
+        std::vector<vector_double> objs;
+        objs.reserve(pop.size());
+        for (decltype(pop.size()) i = 0; i < pop.size(); ++i) {
+            if (prob.feasibility_f(pop.get_f()[i])) {
+                xs.push_back(&pop.get_x()[i]);
+                objs.emplace_back(pop.get_f()[i].data(), pop.get_f()[i].data() + nobj);
+            }
+        }
+        for (const auto &f : objs) {
+            fs.push_back(&f);
+        }
+        return insert_impl(xs, fs);
+    }
+    /// Get the decision vectors.
+    /**
+     * @return the decision vectors of the points in the archive.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    std::vector<vector_double> get_x() const
+    {
+        return load_content()->x;
+    }
+    /// Get the objective vectors.
+    /**
+     * The <tt>i</tt>-th objective vector corresponds to the <tt>i</tt>-th decision vector
+     * returned by get_x() only if the archive was not modified in between: use get_xf() in order
+     * to read both at once.
+     *
+     * @return the objective vectors of the points in the archive.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    std::vector<vector_double> get_f() const
+    {
+        return load_content()->f;
+    }
+    /// Get the decision and objective vectors.
+    /**
+     * @return a pair containing the decision vectors and the objective vectors of the points in the archive.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    std::pair<std::vector<vector_double>, std::vector<vector_double>> get_xf() const
+    {
+        const auto c = load_content();
+        return std::make_pair(c->x, c->f);
+    }
+    /// Size.
+    /**
+     * @return the number of points in the archive.
+     */
+    size_type size() const
+    {
+        return load_content()->f.size();
+    }
+    /// Get the capacity.
+    /**
+     * @return the maximum number of points in the archive.
+     */
+    size_type get_capacity() const
+    {
+        return m_capacity;
+    }
+    /// Get the pruning policy.
+    /**
+     * @return the policy used to discard points when the archive is full.
+     */
+    archive_pruning get_pruning() const
+    {
+        return m_pruning;
+    }
+    /// Clear the archive.
+    /**
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    void clear()
+    {
+        auto new_content = std::make_shared<const content>();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_version;
+        std::atomic_store(&m_content, std::move(new_content));
+    }
+    /// Save to archive.
+    /**
+     * @param ar the output archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the archive's content.
+     */
+    template <typename Archive>
+    void save(Archive &ar) const
+    {
+        const auto c = load_content();
+        ar(m_capacity, static_cast<int>(m_pruning), c->x, c->f);
+    }
+    /// Load from archive.
+    /**
+     * @param ar the input archive.
+     *
+     * @throws std::invalid_argument if the loaded capacity and pruning policy are not valid, or if the
+     * loaded points are inconsistent.
+     * @throws unspecified any exception thrown by the deserialization of the archive's content.
+     */
+    template <typename Archive>
+    void load(Archive &ar)
+    {
+        size_type capacity;
+        int pruning;
+        auto c = std::make_shared<content>();
+        ar(capacity, pruning, c->x, c->f);
+        pareto_archive tmp(capacity, static_cast<archive_pruning>(pruning));
+        if (c->x.size() != c->f.size() || c->f.size() > capacity) {
+            pagmo_throw(std::invalid_argument, "Inconsistent content found while deserializing a Pareto archive");
+        }
+        tmp.m_content = std::move(c);
+        *this = tmp;
+    }
+
+private:
+    std::shared_ptr<const content> load_content() const
+    {
+        return std::atomic_load(&m_content);
+    }
+    // Insert the points (xs[i], fs[i]) and publish the new content. Returns how many
+    // of them are in the archive afterwards.
+    size_type insert_impl(const std::vector<const vector_double *> &xs, const std::vector<const vector_double *> &fs)
+    {
+        // Number of attempts without holding the lock during the computation.
+        const unsigned max_attempts = 3u;
+        for (unsigned attempt = 1u;; ++attempt) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // NOTE: the current content may be being read, work on a copy.
+            auto new_content = std::make_shared<content>(*load_content());
+            const auto version = m_version;
+            if (attempt < max_attempts) {
+                lock.unlock();
+            }
+            std::vector<char> mine;
+            merge(*new_content, mine, xs, fs);
+            prune(*new_content, mine);
+            if (!lock.owns_lock()) {
+                lock.lock();
+                if (m_version != version) {
+                    // Another insertion was published in the meantime.
+                    continue;
+                }
+            }
+            ++m_version;
+            std::atomic_store(&m_content, std::shared_ptr<const content>(std::move(new_content)));
+            return static_cast<size_type>(std::count(mine.begin(), mine.end(), 1));
+        }
+    }
+    // Add the points (xs[i], fs[i]) to c, removing the dominated ones. mine flags the points
+    // of c coming from this insertion.
+    static void merge(content &c, std::vector<char> &mine, const std::vector<const vector_double *> &xs,
+                      const std::vector<const vector_double *> &fs)
+    {
+        auto &X = c.x;
+        auto &F = c.f;
+        mine.assign(F.size(), 0);
+        for (decltype(fs.size()) i = 0; i < fs.size(); ++i) {
+            const auto &x = *xs[i];
+            const auto &f = *fs[i];
+            check_point(x, f, X, F);
+            if (std::any_of(F.begin(), F.end(),
+                            [&f](const vector_double &g) { return g == f || pareto_dominance(g, f); })) {
+                continue;
+            }
+            // Remove the points dominated by the new one.
+            size_type k = 0;
+            for (size_type j = 0; j < F.size(); ++j) {
+                if (!pareto_dominance(f, F[j])) {
+                    if (k != j) {
+                        X[k] = std::move(X[j]);
+                        F[k] = std::move(F[j]);
+                        mine[k] = mine[j];
+                    }
+                    ++k;
+                }
+            }
+            X.resize(k);
+            F.resize(k);
+            mine.resize(k);
+            X.push_back(x);
+            F.push_back(f);
+            mine.push_back(1);
+        }
+    }
+    static void check_point(const vector_double &x, const vector_double &f, const std::vector<vector_double> &X,
+                            const std::vector<vector_double> &F)
+    {
+        if (f.empty()) {
+            pagmo_throw(std::invalid_argument, "Cannot insert a point with no objectives into a Pareto archive");
+        }
+        if (std::any_of(f.begin(), f.end(), [](double v) { return std::isnan(v); })) {
+            pagmo_throw(std::invalid_argument, "Cannot insert a point with NaN objectives into a Pareto archive");
+        }
+        if (!F.empty() && (f.size() != F[0].size() || x.size() != X[0].size())) {
+            pagmo_throw(std::invalid_argument, "Cannot insert a point with " + std::to_string(x.size())
+                                                   + " decision variables and " + std::to_string(f.size())
+                                                   + " objectives into a Pareto archive containing points with "
+                                                   + std::to_string(X[0].size()) + " decision variables and "
+                                                   + std::to_string(F[0].size()) + " objectives");
+        }
+    }
+    // Discard points from c, according to the pruning policy, until the capacity is respected.
+    // NOTE: this does something only when there are at least 2 mutually non-dominated
+    // points in c, which implies that there are at least 2 objectives.
+    void prune(content &c, std::vector<char> &mine) const
+    {
+        const auto &F = c.f;
+        if (F.size() <= m_capacity) {
+            return;
+        }
+        std::vector<char> keep(F.size(), 1);
+        if (m_pruning == archive_pruning::crowding_distance) {
+            // The crowding distances change after each discarded point.
+            std::vector<size_type> idx(F.size());
+            std::iota(idx.begin(), idx.end(), size_type(0));
+            auto cur = F;
+            while (cur.size() > m_capacity) {
+                const auto cd = crowding_distance(cur);
+                const auto i = std::min_element(cd.begin(), cd.end()) - cd.begin();
+                keep[idx[static_cast<size_type>(i)]] = 0;
+                cur.erase(cur.begin() + i);
+                idx.erase(idx.begin() + i);
+            }
+        } else {
+            const auto ref = hv_refpoint(F);
+            if (ref.size() <= 3u) {
+                // The handles are the indices in F.
+                hv_contributions hvc(ref);
+                for (const auto &f : F) {
+                    hvc.insert(f);
+                }
+                while (hvc.size() > m_capacity) {
+                    const auto id = hvc.least_contributor();
+                    hvc.erase(id);
+                    keep[id] = 0;
+                }
+            } else {
+                std::vector<size_type> idx(F.size());
+                std::iota(idx.begin(), idx.end(), size_type(0));
+                auto cur = F;
+                while (cur.size() > m_capacity) {
+                    const auto i = static_cast<std::ptrdiff_t>(hypervolume(cur, false).least_contributor(ref));
+                    keep[idx[static_cast<size_type>(i)]] = 0;
+                    cur.erase(cur.begin() + i);
+                    idx.erase(idx.begin() + i);
+                }
+            }
+        }
+        // Remove the discarded points, preserving the order of the other ones.
+        size_type k = 0;
+        for (size_type j = 0; j < F.size(); ++j) {
+            if (keep[j]) {
+                if (k != j) {
+                    c.x[k] = std::move(c.x[j]);
+                    c.f[k] = std::move(c.f[j]);
+                    mine[k] = mine[j];
+                }
+                ++k;
+            }
+        }
+        c.x.resize(k);
+        c.f.resize(k);
+        mine.resize(k);
+    }
+    // The reference point for the hypervolume contributions of the points in F (see
+    // archive_pruning::hv_contribution).
+    static vector_double hv_refpoint(const std::vector<vector_double> &F)
+    {
+        auto ref = F[0], ideal = F[0];
+        for (const auto &f : F) {
+            for (decltype(f.size()) j = 0; j < f.size(); ++j) {
+                ref[j] = std::max(ref[j], f[j]);
+                ideal[j] = std::min(ideal[j], f[j]);
+            }
+        }
+        for (decltype(ref.size()) j = 0; j < ref.size(); ++j) {
+            const auto extent = ref[j] - ideal[j];
+            ref[j] += extent > 0. ? extent / 10. : 1.;
+        }
+        return ref;
+    }
+    // Data members.
+    size_type m_capacity;
+    archive_pruning m_pruning;
+    // NOTE: m_content is read and written via std::atomic_load()/std::atomic_store(),
+    // and written only while holding m_mutex. m_version, protected by m_mutex, is
+    // incremented each time m_content is replaced.
+    std::mutex m_mutex;
+    unsigned long long m_version;
+    std::shared_ptr<const content> m_content;
+};
+}
+
+#endif
@@ -1885,6 +1885,40 @@ public:
         return m_hevals;
     }
 
+    /// Increment the number of fitness evaluations.
+    /**
+     * This method is meant to be used by algorithms that evaluate copies of a problem (e.g., in
+     * parallel) and then want to account for those evaluations in the original problem.
+     *
+     * @param n the amount by which the fitness evaluation counter will be increased.
+     */
+    void increment_fevals(unsigned long long n) const
+    {
+        m_fevals += n;
+    }
+
+    /// Increment the number of gradient evaluations.
+    /**
+     * @param n the amount by which the gradient evaluation counter will be increased.
+     *
+     * @see problem::increment_fevals().
+     */
+    void increment_gevals(unsigned long long n) const
+    {
+        m_gevals += n;
+    }
+
+    /// Increment the number of hessians evaluations.
+    /**
+     * @param n the amount by which the hessians evaluation counter will be increased.
+     *
+     * @see problem::increment_fevals().
+     */
+    void increment_hevals(unsigned long long n) const
+    {
+        m_hevals += n;
+    }
+
     /// Set the seed for the stochastic variables.
     /**
      * Sets the seed to be used in the fitness function to instantiate
@@ -0,0 +1,425 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PROBLEM_FD_GRADIENT_HPP
+#define PAGMO_PROBLEM_FD_GRADIENT_HPP
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pagmo/bfe.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/gradients_and_hessians.hpp>
+
+namespace pagmo
+{
+
+/// The finite-difference gradient meta-problem.
+/**
+ * This meta-problem equips an input problem with a gradient estimated numerically by central
+ * differences, so that gradient-based solvers (e.g., pagmo::nlopt or pagmo::ipopt) can be used on black-box
+ * problems which do not implement one. pagmo::fd_gradient objects are user-defined problems that can be used in
+ * the definition of a pagmo::problem.
+ *
+ * The gradient sparsity of the inner problem (which is dense if the inner problem does not provide one) is
+ * exploited to minimise the number of fitness evaluations: its columns are grouped, upon construction, via
+ * pagmo::column_colouring(), and all the columns in a group are perturbed together (see
+ * pagmo::estimate_gradient_sparse()). Each call to fd_gradient::gradient() thus costs \f$2n_c\f$ fitness
+ * evaluations of the inner problem, where \f$n_c\f$ is the number of groups. The perturbed decision vectors are
+ * evaluated as a single batch by a pagmo::bfe. By default the batch is evaluated serially: a multithreaded
+ * pagmo::bfe can be passed upon construction to evaluate it in parallel, provided that the inner problem
+ * offers at least the pagmo::thread_safety::basic guarantee.
+ *
+ * The fitness evaluations made to estimate the gradient are accounted for in the inner problem.
+ */
+class fd_gradient
+{
+    // Enabler for the ctor from UDP or problem. In this case we also allow construction from type problem.
+    template <typename T>
+    using ctor_enabler = enable_if_t<std::is_constructible<problem, T &&>::value, int>;
+
+public:
+    /// Default constructor.
+    /**
+     * The default constructor will initialize a pagmo::null_problem with a finite-difference gradient.
+     */
+    fd_gradient() : fd_gradient(null_problem{})
+    {
+    }
+
+    /// Constructor from problem.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    This constructor is enabled only if ``T`` can be used to construct a :cpp:class:`pagmo::problem`.
+     *
+     * \endverbatim
+     *
+     * Wraps a user-defined problem so that its gradient will be estimated by finite differences.
+     *
+     * @param p a pagmo::problem or a user-defined problem (UDP).
+     * @param dx the relative perturbation: each component \f$x_j\f$ of the decision vector will be varied by
+     * \f$\max(|x_j|,1) * \f$ \p dx.
+     * @param b the batch fitness evaluator used to evaluate the perturbed decision vectors (serial by default).
+     *
+     * @throws std::invalid_argument if \p dx is not positive and finite.
+     * @throws unspecified any exception thrown by the pagmo::problem constructor, by
+     * pagmo::problem::gradient_sparsity() or by pagmo::column_colouring().
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit fd_gradient(T &&p, double dx = 1e-8, const bfe &b = bfe{1u})
+        : m_problem(std::forward<T>(p)), m_dx(dx), m_bfe(b)
+    {
+        if (!std::isfinite(dx) || dx <= 0.) {
+            pagmo_throw(std::invalid_argument, "The perturbation of a finite-difference gradient must be positive and "
+                                               "finite, but a value of "
+                                                   + std::to_string(dx) + " was provided instead");
+        }
+        m_sparsity = m_problem.gradient_sparsity();
+        m_colours = column_colouring(m_sparsity, m_problem.get_nx());
+        m_n_colours = detail::n_colours(m_colours);
+    }
+
+    /// Fitness.
+    /**
+     * The fitness computation is forwarded to the inner problem.
+     *
+     * @param x the decision vector.
+     *
+     * @return the fitness of \p x.
+     *
+     * @throws unspecified any exception thrown by problem::fitness().
+     */
+    vector_double fitness(const vector_double &x) const
+    {
+        return m_problem.fitness(x);
+    }
+
+    /// Box-bounds.
+    /**
+     * @return the box-bounds of the inner problem.
+     *
+     * @throws unspecified any exception thrown by problem::get_bounds().
+     */
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return m_problem.get_bounds();
+    }
+
+    /// Number of objectives.
+    /**
+     * @return the number of objectives of the inner problem.
+     */
+    vector_double::size_type get_nobj() const
+    {
+        return m_problem.get_nobj();
+    }
+
+    /// Equality constraint dimension.
+    /**
+     * @return the number of equality constraints of the inner problem.
+     */
+    vector_double::size_type get_nec() const
+    {
+        return m_problem.get_nec();
+    }
+
+    /// Inequality constraint dimension.
+    /**
+     * @return the number of inequality constraints of the inner problem.
+     */
+    vector_double::size_type get_nic() const
+    {
+        return m_problem.get_nic();
+    }
+
+    /// Integer dimension
+    /**
+     * @return the integer dimension of the inner problem.
+     */
+    vector_double::size_type get_nix() const
+    {
+        return m_problem.get_nix();
+    }
+
+    /// Gradient.
+    /**
+     * The gradient is estimated by central differences, evaluating the \f$2n_c\f$ perturbed decision vectors
+     * with the batch fitness evaluator (see the class documentation).
+     *
+     * @param x the decision vector.
+     *
+     * @return the gradient of the fitness function at \p x, in the order given by fd_gradient::gradient_sparsity().
+     *
+     * @throws unspecified any exception thrown by pagmo::bfe::eval().
+     */
+    vector_double gradient(const vector_double &x) const
+    {
+        vector_double dvs, h, fvs;
+        detail::fd_perturbed_points(x, m_colours, m_n_colours, m_dx, dvs, h);
+        m_bfe.eval(m_problem, dvs, fvs);
+        return detail::fd_sparse_gradient(fvs, m_problem.get_nf(), m_sparsity, m_colours, h);
+    }
+
+    /// Checks if the inner problem has gradient sparisty implemented.
+    /**
+     * The <tt>has_gradient_sparsity()</tt> computation is forwarded to the inner problem.
+     *
+     * @return a flag signalling the availability of the gradient sparisty in the inner problem.
+     */
+    bool has_gradient_sparsity() const
+    {
+        return m_problem.has_gradient_sparsity();
+    }
+
+    /// Gradient sparsity.
+    /**
+     * @return the gradient sparsity of the inner problem, as determined upon construction.
+     */
+    sparsity_pattern gradient_sparsity() const
+    {
+        return m_sparsity;
+    }
+
+    /// Checks if the inner problem has hessians.
+    /**
+     * The <tt>has_hessians()</tt> computation is forwarded to the inner problem.
+     *
+     * @return a flag signalling the availability of the hessians in the inner problem.
+     */
+    bool has_hessians() const
+    {
+        return m_problem.has_hessians();
+    }
+
+    /// Hessians.
+    /**
+     * The <tt>hessians()</tt> computation is forwarded to the inner problem.
+     *
+     * @param x the decision vector.
+     *
+     * @return the hessians of the fitness function computed at \p x.
+     *
+     * @throws unspecified any exception thrown by problem::hessians().
+     */
+    std::vector<vector_double> hessians(const vector_double &x) const
+    {
+        return m_problem.hessians(x);
+    }
+
+    /// Checks if the inner problem has hessians sparisty implemented.
+    /**
+     * The <tt>has_hessians_sparsity()</tt> computation is forwarded to the inner problem.
+     *
+     * @return a flag signalling the availability of the hessians sparisty in the inner problem.
+     */
+    bool has_hessians_sparsity() const
+    {
+        return m_problem.has_hessians_sparsity();
+    }
+
+    /// Hessians sparsity.
+    /**
+     * The <tt>hessians_sparsity()</tt> computation is forwarded to the inner problem.
+     *
+     * @return the hessians sparsity of the inner problem.
+     */
+    std::vector<sparsity_pattern> hessians_sparsity() const
+    {
+        return m_problem.hessians_sparsity();
+    }
+
+    /// Calls <tt>has_set_seed()</tt> of the inner problem.
+    /**
+     * Calls the method <tt>has_set_seed()</tt> of the inner problem.
+     *
+     * @return a flag signalling wether the inner problem is stochastic.
+     */
+    bool has_set_seed() const
+    {
+        return m_problem.has_set_seed();
+    }
+
+    /// Calls <tt>set_seed()</tt> of the inner problem.
+    /**
+     * Calls the method <tt>set_seed()</tt> of the inner problem.
+     *
+     * @param seed seed to be set.
+     *
+     * @throws unspecified any exception thrown by the method <tt>set_seed()</tt> of the inner problem.
+     */
+    void set_seed(unsigned seed)
+    {
+        return m_problem.set_seed(seed);
+    }
+
+    /// Problem name
+    /**
+     * This method will add <tt>[finite-difference gradient]</tt> to the name provided by the inner problem.
+     *
+     * @return a string containing the problem name.
+     *
+     * @throws unspecified any exception thrown by <tt>problem::get_name()</tt> or memory errors in standard classes.
+     */
+    std::string get_name() const
+    {
+        return m_problem.get_name() + " [finite-difference gradient]";
+    }
+
+    /// Extra info
+    /**
+     * This method will append the perturbation, the number of column groups and the batch evaluator to the
+     * extra info provided by the inner problem.
+     *
+     * @return a string containing extra info on the problem.
+     *
+     * @throws unspecified any exception thrown by problem::get_extra_info(), the public interface of
+     * \p std::ostringstream or memory errors in standard classes.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream oss;
+        stream(oss, "\n\tFinite-difference perturbation: ", m_dx);
+        stream(oss, "\n\tColumn groups: ", m_n_colours);
+        stream(oss, "\n\tFitness evaluation: ", m_bfe.get_name());
+        return m_problem.get_extra_info() + oss.str();
+    }
+
+    /// Get the perturbation.
+    /**
+     * @return the relative perturbation used in the finite differences.
+     */
+    double get_dx() const
+    {
+        return m_dx;
+    }
+
+    /// Get the number of column groups.
+    /**
+     * @return the number of groups of columns perturbed together, so that each gradient estimation
+     * costs twice this number of fitness evaluations.
+     */
+    vector_double::size_type get_n_colours() const
+    {
+        return m_n_colours;
+    }
+
+    /// Get the batch fitness evaluator.
+    /**
+     * @return a const reference to the batch fitness evaluator.
+     */
+    const bfe &get_bfe() const
+    {
+        return m_bfe;
+    }
+
+    /// Problem's thread safety level.
+    /**
+     * The thread safety of a meta-problem is defined by the thread safety of the inner pagmo::problem.
+     *
+     * @return the thread safety level of the inner pagmo::problem.
+     */
+    thread_safety get_thread_safety() const
+    {
+        return m_problem.get_thread_safety();
+    }
+
+    /// Getter for the inner problem.
+    /**
+     * Returns a const reference to the inner pagmo::problem.
+     *
+     * @return a const reference to the inner pagmo::problem.
+     */
+    const problem &get_inner_problem() const
+    {
+        return m_problem;
+    }
+
+    /// Getter for the inner problem.
+    /**
+     * Returns a reference to the inner pagmo::problem.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    The ability to extract a non const reference is provided only in order to allow to call
+     *    non-const methods on the internal :cpp:class:`pagmo::problem` instance. Assigning a new
+     *    :cpp:class:`pagmo::problem` via this reference is undefined behaviour.
+     *
+     * \endverbatim
+     *
+     * @return a reference to the inner pagmo::problem.
+     */
+    problem &get_inner_problem()
+    {
+        return m_problem;
+    }
+
+    /// Object serialization
+    /**
+     * This method will save/load \p this into/from the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the inner problem and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_problem, m_dx, m_bfe, m_sparsity, m_colours, m_n_colours);
+    }
+
+private:
+    /// Inner problem
+    problem m_problem;
+    /// Relative perturbation
+    double m_dx;
+    /// Batch evaluator of the perturbed points
+    bfe m_bfe;
+    /// Gradient sparsity and column colouring
+    sparsity_pattern m_sparsity;
+    std::vector<vector_double::size_type> m_colours;
+    vector_double::size_type m_n_colours;
+};
+}
+
+PAGMO_REGISTER_PROBLEM(pagmo::fd_gradient)
+
+#endif
@@ -35,14 +35,19 @@ see https://www.gnu.org/licenses/. */
  * This header contains utilities useful in general for PaGMO purposes
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/detail/kd_tree.hpp>
+#include <pagmo/detail/parallel_for.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/rng.hpp>
@@ -224,8 +229,15 @@ inline double binomial_coefficient(vector_double::size_type n, vector_double::si
 /// K-Nearest Neighbours
 /**
  * Computes the indexes of the k nearest neighbours (euclidean distance) to each of the input points.
- * The algorithm complexity (naive implementation) is \f$ O(MN^2)\f$ where \f$N\f$ is the number of
- * points and \f$M\f$ their dimensionality
+ * Neighbours at the same distance are sorted by index and each point is excluded from its own list
+ * of neighbours.
+ *
+ * When the dimensionality \f$M\f$ is low compared to the number of points \f$N\f$ (and all the coordinates are
+ * finite) the queries are answered using a kd-tree, with a complexity of \f$ O(N \log N)\f$ for its construction
+ * and roughly \f$ O(k \log N)\f$ per point. Otherwise a brute force search is performed, whose complexity is
+ * \f$ O(MN^2)\f$ but which selects the k neighbours of each point with a partial sort and only needs \f$ O(N)\f$
+ * memory per thread. The tree construction and the queries are split among \p n_threads threads: the result
+ * does not depend on the number of threads used.
  *
  * Example:
  * @code{.unparsed}
@@ -234,14 +246,17 @@ inline double binomial_coefficient(vector_double::size_type n, vector_double::si
  *
  * @param points the \f$N\f$ points having dimension \f$M\f$
  * @param k number of neighbours to detect
+ * @param n_threads number of threads to be used (0 selects the number of hardware threads). Small inputs
+ * are always processed in the calling thread.
  * @return An <tt>std::vector<std::vector<population::size_type> > </tt> containing the indexes of the k nearest
  * neighbours sorted by distance
  * @throws std::invalid_argument If the points do not all have the same dimension.
+ * @throws unspecified any exception thrown by the creation of threads.
  */
-inline std::vector<std::vector<vector_double::size_type>> kNN(const std::vector<vector_double> &points,
-                                                              std::vector<vector_double>::size_type k)
+inline std::vector<std::vector<vector_double::size_type>>
+kNN(const std::vector<vector_double> &points, std::vector<vector_double>::size_type k, unsigned n_threads = 1u)
 {
-    std::vector<std::vector<vector_double::size_type>> neigh_idxs;
+    using size_type = vector_double::size_type;
     auto N = points.size();
     if (N == 0u) {
         return {};
@@ -250,33 +265,55 @@ inline std::vector<std::vector<vector_double::size_type>> kNN(const std::vector<
     if (!std::all_of(points.begin(), points.end(), [M](const vector_double &p) { return p.size() == M; })) {
         pagmo_throw(std::invalid_argument, "All points must have the same dimensionality for k-NN to be invoked");
     }
-    // loop through the points
-    for (decltype(N) i = 0u; i < N; ++i) {
-        // We compute all the distances to all other points including the self
-        vector_double distances;
-        for (decltype(N) j = 0u; j < N; ++j) {
-            double dist = 0.;
-            for (decltype(M) l = 0u; l < M; ++l) {
-                dist += (points[i][l] - points[j][l]) * (points[i][l] - points[j][l]);
+    k = std::min(k, N - 1u);
+    std::vector<std::vector<size_type>> neigh_idxs(N);
+    // Threads are not worth it on small inputs.
+    n_threads = N < 256u ? 1u : detail::parallel_n_threads(n_threads, N);
+    // A kd-tree pays off only when there are many more points than corners of the M-dimensional box
+    // (and it needs finite coordinates to prune correctly).
+    const bool use_tree = M > 0u && M <= 20u && N >= (size_type(16u) << M)
+                          && std::all_of(points.begin(), points.end(), [](const vector_double &p) {
+                                 return std::all_of(p.begin(), p.end(), [](double x) { return std::isfinite(x); });
+                             });
+    if (use_tree) {
+        const detail::kd_tree tree(points, n_threads);
+        detail::parallel_for(N, n_threads, [&tree, &neigh_idxs, k](std::size_t b, std::size_t e, unsigned) {
+            std::vector<detail::kd_tree::candidate> heap;
+            heap.reserve(k);
+            for (auto i = b; i < e; ++i) {
+                tree.query(i, k, neigh_idxs[i], heap);
+            }
+        });
+    } else {
+        // Brute force: squared distances are ordered as in detail::less_than_f (NaNs last), ties broken by index.
+        detail::parallel_for(N, n_threads, [&points, &neigh_idxs, k, N, M](std::size_t b, std::size_t e, unsigned) {
+            vector_double distances(N);
+            std::vector<size_type> idxs;
+            idxs.reserve(N);
+            auto comp = [&distances](size_type idx1, size_type idx2) {
+                if (detail::less_than_f(distances[idx1], distances[idx2])) {
+                    return true;
+                }
+                if (detail::less_than_f(distances[idx2], distances[idx1])) {
+                    return false;
+                }
+                return idx1 < idx2;
+            };
+            for (auto i = b; i < e; ++i) {
+                idxs.clear();
+                for (decltype(N) j = 0u; j < N; ++j) {
+                    if (j != i) {
+                        distances[j] = detail::knn_distance2(points[i].data(), points[j].data(), M);
+                        idxs.push_back(j);
+                    }
+                }
+                // Only the first k indexes need to be sorted.
+                const auto kth = idxs.begin() + static_cast<std::ptrdiff_t>(k);
+                std::nth_element(idxs.begin(), kth, idxs.end(), comp);
+                std::sort(idxs.begin(), kth, comp);
+                neigh_idxs[i].assign(idxs.begin(), kth);
             }
-            distances.push_back(std::sqrt(dist));
-        }
-        // We sort the indexes with respect to the distance
-        std::vector<vector_double::size_type> idxs(N);
-        std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
-        std::sort(idxs.begin(), idxs.end(), [&distances](vector_double::size_type idx1, vector_double::size_type idx2) {
-            return detail::less_than_f(distances[idx1], distances[idx2]);
         });
-        // We remove the first element containg the self-distance (0)
-        idxs.erase(std::remove(idxs.begin(), idxs.end(), i), idxs.end());
-        neigh_idxs.push_back(idxs);
-    }
-    // We trim to k the lists if needed
-    if (k < N - 1u) {
-        for (decltype(neigh_idxs.size()) i = 0u; i < neigh_idxs.size(); ++i) {
-            neigh_idxs[i].erase(neigh_idxs[i].begin() + static_cast<int>(k),
-                                neigh_idxs[i].end()); // TODO: remove the static_cast
-        }
     }
     return neigh_idxs;
 }
@@ -312,11 +349,11 @@ inline void force_bounds_reflection(vector_double &x, const vector_double &lb, c
     }
 }
 // modifies a chromosome so that it will be in the bounds. Elements that are off are set on the bounds
-inline void force_bounds_stick(vector_double &x, const vector_double &lb, const vector_double &ub)
+// (this overload works on a chromosome stored in a contiguous buffer, its size being the size of the bounds)
+inline void force_bounds_stick(double *x, const vector_double &lb, const vector_double &ub)
 {
-    assert(x.size() == lb.size());
-    assert(x.size() == ub.size());
-    for (decltype(x.size()) j = 0u; j < x.size(); ++j) {
+    assert(lb.size() == ub.size());
+    for (decltype(lb.size()) j = 0u; j < lb.size(); ++j) {
         if (x[j] < lb[j]) {
             x[j] = lb[j];
         }
@@ -325,6 +362,13 @@ inline void force_bounds_stick(vector_double &x, const vector_double &lb, const
         }
     }
 }
+// modifies a chromosome so that it will be in the bounds. Elements that are off are set on the bounds
+inline void force_bounds_stick(vector_double &x, const vector_double &lb, const vector_double &ub)
+{
+    assert(x.size() == lb.size());
+    assert(x.size() == ub.size());
+    force_bounds_stick(x.data(), lb, ub);
+}
 } // namespace detail
 
 } // namespace pagmo
@@ -37,7 +37,10 @@ see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <numeric>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <pagmo/exceptions.hpp>
@@ -248,6 +251,171 @@ vector_double estimate_gradient_h(Func f, const vector_double &x, double dx = 1e
     }
     return gradient;
 }
+
+/// Column colouring of a sparsity pattern
+/**
+ * Partitions the columns of a sparsity pattern (i.e., the components of the decision vector) into groups
+ * of structurally orthogonal columns, that is columns that do not have non-zero elements in the same row.
+ * All the columns in a group can then be perturbed at the same time when estimating a sparse gradient by finite
+ * differences, as done by the method of Curtis, Powell and Reid (CPR). The groups (colours) are determined by
+ * a greedy sequential colouring, visiting the columns in order of decreasing number of non-zero elements
+ * (ties being broken by the column index).
+ *
+ * For a dense pattern each column gets its own colour, while, e.g., for a diagonal pattern all the columns
+ * share the same colour.
+ *
+ * @param sp the sparsity pattern (see pagmo::problem::gradient_sparsity()).
+ * @param nx the number of columns (i.e., the dimension of the decision vector).
+ *
+ * @return a vector of size \p nx containing the colour, in the \f$\left[0, n_c\right)\f$ range, of each column.
+ *
+ * @throws std::invalid_argument if \p sp contains column indices not smaller than \p nx.
+ */
+inline std::vector<vector_double::size_type> column_colouring(const sparsity_pattern &sp, vector_double::size_type nx)
+{
+    using size_type = vector_double::size_type;
+    size_type n_rows = 0u;
+    for (const auto &nz : sp) {
+        if (nz.second >= nx) {
+            pagmo_throw(std::invalid_argument, "Invalid sparsity pattern: the column index " + std::to_string(nz.second)
+                                                   + " is not smaller than the number of columns ("
+                                                   + std::to_string(nx) + ")");
+        }
+        n_rows = std::max(n_rows, nz.first + 1u);
+    }
+    // Adjacency lists of rows and columns.
+    std::vector<std::vector<size_type>> rows(n_rows), cols(nx);
+    for (const auto &nz : sp) {
+        rows[nz.first].push_back(nz.second);
+        cols[nz.second].push_back(nz.first);
+    }
+    // Largest-first ordering.
+    std::vector<size_type> order(nx);
+    std::iota(order.begin(), order.end(), size_type(0u));
+    std::stable_sort(order.begin(), order.end(),
+                     [&cols](size_type a, size_type b) { return cols[a].size() > cols[b].size(); });
+    // NOTE: nx is used as a marker for uncoloured columns. forbidden[c] == j signals that the colour c
+    // is already taken by a neighbour of the column j.
+    std::vector<size_type> retval(nx, nx), forbidden(nx, nx);
+    for (auto j : order) {
+        for (auto i : cols[j]) {
+            for (auto k : rows[i]) {
+                if (retval[k] != nx) {
+                    forbidden[retval[k]] = j;
+                }
+            }
+        }
+        size_type c = 0u;
+        while (forbidden[c] == j) {
+            ++c;
+        }
+        retval[j] = c;
+    }
+    return retval;
+}
+
+namespace detail
+{
+
+// Builds, into dvs, the 2 n_c decision vectors needed for the central difference estimation of a sparse gradient
+// given the column colouring colours: the vectors 2c and 2c + 1 are x perturbed forward and backward along
+// all the columns of colour c. The perturbation of each column is stored in h.
+inline void fd_perturbed_points(const vector_double &x, const std::vector<vector_double::size_type> &colours,
+                                vector_double::size_type n_colours, double dx, vector_double &dvs, vector_double &h)
+{
+    const auto nx = x.size();
+    dvs.resize(2u * n_colours * nx);
+    h.resize(nx);
+    for (decltype(2u * n_colours) k = 0u; k < 2u * n_colours; ++k) {
+        std::copy(x.begin(), x.end(), dvs.begin() + static_cast<std::ptrdiff_t>(k * nx));
+    }
+    for (decltype(x.size()) j = 0u; j < nx; ++j) {
+        h[j] = std::max(std::abs(x[j]), 1.0) * dx;
+        dvs[2u * colours[j] * nx + j] = x[j] + h[j];
+        dvs[(2u * colours[j] + 1u) * nx + j] = x[j] - h[j];
+    }
+}
+
+// Assembles the sparse gradient (in the order of sp) from the fitness vectors fvs of the points built by
+// fd_perturbed_points().
+inline vector_double fd_sparse_gradient(const vector_double &fvs, vector_double::size_type nf,
+                                        const sparsity_pattern &sp,
+                                        const std::vector<vector_double::size_type> &colours, const vector_double &h)
+{
+    vector_double retval(sp.size());
+    for (decltype(sp.size()) k = 0u; k < sp.size(); ++k) {
+        const auto i = sp[k].first, j = sp[k].second;
+        if (i >= nf) {
+            pagmo_throw(std::invalid_argument, "Invalid sparsity pattern: the row index " + std::to_string(i)
+                                                   + " is not smaller than the fitness dimension ("
+                                                   + std::to_string(nf) + ")");
+        }
+        const auto f_r = fvs[2u * colours[j] * nf + i], f_l = fvs[(2u * colours[j] + 1u) * nf + i];
+        retval[k] = (f_r - f_l) / 2. / h[j];
+    }
+    return retval;
+}
+
+inline vector_double::size_type n_colours(const std::vector<vector_double::size_type> &colours)
+{
+    return colours.empty() ? 0u : *std::max_element(colours.begin(), colours.end()) + 1u;
+}
+}
+
+/// Numerical computation of a sparse gradient
+/**
+ * A numerical estimation of the sparse gradient of same callable function is made numerically, exploiting the
+ * knowledge of its sparsity pattern \p sp.
+ *
+ * The callable function \p f must have the prototype:
+ *
+ * @code{.unparsed}
+ * vector_double f(const vector_double &)
+ * @endcode
+ *
+ * otherwise compiler errors will be generated. The gradient returned will be sparse and contain the
+ * derivatives \f$\frac{df_i}{dx_j}\f$ for each pair \f$(i, j)\f$ in \p sp, in the same order (i.e., in the
+ * format requested by pagmo::problem::gradient() for a problem whose gradient sparsity is \p sp).
+ *
+ * The numerical approximation of each derivative is made by central difference as in estimate_gradient(),
+ * but the columns of the pattern are grouped via column_colouring(), and all the columns in a group are varied
+ * together. The overall cost, in terms of calls to \p f, will thus be \f$2n_c\f$ where \f$n_c\f$ is the number of
+ * groups, which, for a dense pattern, is the size of \p x, so that estimate_gradient() is recovered exactly.
+ *
+ * @param f instance of the callable object.
+ * @param x decision vector to compute the gradient at.
+ * @param sp the sparsity pattern of \p f.
+ * @param dx To detect the numerical derivative each component of the input decision vector \p x will be varied by
+ * \f$\max(|x_i|,1) * \f$ \p dx.
+ * @return the sparse gradient of \p f approximated around \p x.
+ *
+ * @throw std::invalid_argument if \p f returns vectors of different sizes when perturbing \p x, or if \p sp
+ * is not compatible with the sizes of \p x and of the vectors returned by \p f.
+ */
+template <typename Func>
+vector_double estimate_gradient_sparse(Func f, const vector_double &x, const sparsity_pattern &sp, double dx = 1e-8)
+{
+    const auto colours = column_colouring(sp, x.size());
+    const auto n_c = detail::n_colours(colours);
+    vector_double dvs, h, fvs;
+    detail::fd_perturbed_points(x, colours, n_c, dx, dvs, h);
+    vector_double xk(x.size());
+    vector_double::size_type nf = 0u;
+    for (decltype(2u * n_c) k = 0u; k < 2u * n_c; ++k) {
+        std::copy(dvs.begin() + static_cast<std::ptrdiff_t>(k * x.size()),
+                  dvs.begin() + static_cast<std::ptrdiff_t>((k + 1u) * x.size()), xk.begin());
+        const vector_double fk = f(xk);
+        if (k == 0u) {
+            nf = fk.size();
+            fvs.resize(2u * n_c * nf);
+        } else if (fk.size() != nf) {
+            pagmo_throw(std::invalid_argument, "Change in the size of the returned vector detected around the "
+                                               "reference point. Cannot compute a gradient");
+        }
+        std::copy(fk.begin(), fk.end(), fvs.begin() + static_cast<std::ptrdiff_t>(k * nf));
+    }
+    return detail::fd_sparse_gradient(fvs, nf, sp, colours, h);
+}
 }
 // namespace pagmo
 
@@ -0,0 +1,340 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_UTIL_HV_MC_APPROX_H
+#define PAGMO_UTIL_HV_MC_APPROX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pagmo/detail/parallel_for.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/rng.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hv_algos/hv_algorithm.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+
+namespace pagmo
+{
+
+/// Parallel Monte Carlo approximation of the hypervolume
+/**
+ * This class approximates the hypervolume with the Karp-Luby estimator for the volume of a union of boxes, on
+ * which the Bringmann-Friedrich scheme (pagmo::bf_fpras) is also based. A box (i.e., the region between a point
+ * and the reference point) is chosen with probability proportional to its volume, a point \f$ x \f$ is sampled
+ * uniformly in it, and the number \f$ c(x) \f$ of boxes containing \f$ x \f$ is counted: the average of
+ * \f$ 1 / c(x) \f$, multiplied by the sum of the volumes of the boxes, is an unbiased estimate of the hypervolume.
+ * Unlike the uniform sampling of the bounding box, the relative variance of this estimator is bounded by the
+ * number of points, regardless of the number of objectives, which makes it suitable for many-objective fronts
+ * for which exact methods are not feasible.
+ *
+ * The implementation differs from pagmo::bf_fpras in the following respects:
+ * - each sample is tested against all the points at once, using a transposed (i.e., objective-major) contiguous
+ *   copy of the points, so that the inner loops run over contiguous memory and can be vectorised by the compiler;
+ * - the samples are drawn in blocks, each with its own random engine seeded from the random engine of the
+ *   algorithm, and the blocks are processed in parallel. The estimate depends only on the seed, not on the number
+ *   of threads;
+ * - the sampling is anytime: at the end of each round of blocks, the estimate is returned as soon as the
+ *   half-width of its confidence interval at level \f$ 1 - \delta \f$ (based on the central limit theorem)
+ *   is not greater than \f$ \epsilon \f$ times the estimate, or the maximum number of samples is reached.
+ *
+ * The number of samples and the half-width of the confidence interval of the last estimate can be retrieved
+ * via mc_approx::get_last_n_samples() and mc_approx::get_last_half_width().
+ */
+class mc_approx : public hv_algorithm
+{
+public:
+    /// Constructor
+    /**
+    * Constructs an instance of the algorithm
+    *
+    * @param eps requested relative half-width of the confidence interval
+    * @param delta the confidence level of the interval is 1 - delta
+    * @param seed seeding for the pseudo-random number generator
+    * @param n_threads number of threads used for sampling (0 means as many as the hardware supports)
+    * @param max_samples maximum number of samples (checked at the end of each round of blocks)
+    *
+    * @throws std::invalid_argument if \p eps or \p delta are not in the (0, 1] range, or if \p max_samples is zero
+    */
+    mc_approx(double eps = 1e-2, double delta = 1e-2, unsigned seed = pagmo::random_device::next(),
+              unsigned n_threads = 0u, unsigned long long max_samples = 100000000ull)
+        : m_eps(eps), m_delta(delta), m_n_threads(n_threads), m_max_samples(max_samples), m_e(seed),
+          m_last_n_samples(0u), m_last_half_width(0.)
+    {
+        if (!(eps > 0 && eps <= 1)) {
+            pagmo_throw(std::invalid_argument, "Epsilon needs to be a probability greater then zero");
+        }
+        if (!(delta > 0 && delta <= 1)) {
+            pagmo_throw(std::invalid_argument, "Delta needs to be a probability greater than zero");
+        }
+        if (!max_samples) {
+            pagmo_throw(std::invalid_argument, "The maximum number of samples must be greater than zero");
+        }
+    }
+
+    /// Verify before compute
+    /**
+    * Verifies whether given algorithm suits the requested data.
+    *
+    * @param points vector of points containing the d dimensional points for which we compute the hypervolume
+    * @param r_point reference point for the vector of points
+    *
+    * @throws value_error when trying to compute the hypervolume for the non-maximal reference point
+    */
+    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const
+    {
+        hv_algorithm::assert_minimisation(points, r_point);
+    }
+
+    /// Compute method
+    /**
+    * Compute the hypervolume using Monte Carlo sampling.
+    *
+    * @param points vector of fitness_vectors for which the hypervolume is computed
+    * @param r_point distinguished "reference point".
+    *
+    * @return approximated hypervolume
+    *
+    * @throws unspecified any exception thrown by threading primitives.
+    */
+    double compute(std::vector<vector_double> &points, const vector_double &r_point) const
+    {
+        m_last_n_samples = 0u;
+        m_last_half_width = 0.;
+        const auto n = points.size();
+        const auto dim = r_point.size();
+
+        // Partial sums of the volumes of the boxes.
+        vector_double sums(n);
+        double V = 0.;
+        for (decltype(points.size()) i = 0u; i < n; ++i) {
+            V = (sums[i] = V + hv_algorithm::volume_between(points[i], r_point));
+        }
+        if (V == 0.) {
+            return 0.;
+        }
+
+        // Transposed copy of the points: the j-th coordinate of the i-th point is in pts[j * n + i].
+        vector_double pts(n * dim);
+        for (decltype(points.size()) i = 0u; i < n; ++i) {
+            for (decltype(r_point.size()) j = 0u; j < dim; ++j) {
+                pts[j * n + i] = points[i][j];
+            }
+        }
+
+        const auto n_threads = detail::parallel_n_threads(m_n_threads, s_round_size);
+        const auto z = normal_quantile(m_delta);
+        // Per-block seeds and partial sums of 1 / c(x) and of its square.
+        std::vector<unsigned> seeds(s_round_size);
+        vector_double b_sum(s_round_size), b_sum2(s_round_size);
+        double sum = 0., sum2 = 0.;
+        unsigned long long n_samples = 0u;
+        while (true) {
+            // NOTE: the seeds are drawn sequentially, so that the estimate does not depend on the number of threads.
+            for (auto &s : seeds) {
+                s = static_cast<unsigned>(m_e());
+            }
+            detail::parallel_for(s_round_size, n_threads, [&](std::size_t begin, std::size_t end, unsigned) {
+                // Per-thread buffers.
+                vector_double x(dim);
+                std::vector<unsigned char> inside(n);
+                for (auto b = begin; b < end; ++b) {
+                    detail::random_engine_type e(seeds[b]);
+                    std::uniform_real_distribution<double> V_dist(0., V), unireal_dist(0., 1.);
+                    double s = 0., s2 = 0.;
+                    for (std::size_t k = 0u; k < s_block_size; ++k) {
+                        // Choose the box with probability proportional to its volume (skipping empty boxes).
+                        const auto i = std::min(
+                            static_cast<decltype(points.size())>(std::upper_bound(sums.begin(), sums.end(), V_dist(e))
+                                                                 - sums.begin()),
+                            n - 1u);
+                        for (decltype(r_point.size()) j = 0u; j < dim; ++j) {
+                            x[j] = points[i][j] + unireal_dist(e) * (r_point[j] - points[i][j]);
+                        }
+                        // Count the boxes containing x, one objective at a time.
+                        std::fill(inside.begin(), inside.end(), static_cast<unsigned char>(1));
+                        for (decltype(r_point.size()) j = 0u; j < dim; ++j) {
+                            const double *col = pts.data() + j * n;
+                            const double xj = x[j];
+                            for (decltype(points.size()) l = 0u; l < n; ++l) {
+                                inside[l] &= static_cast<unsigned char>(col[l] <= xj);
+                            }
+                        }
+                        unsigned long long c = 0u;
+                        for (decltype(points.size()) l = 0u; l < n; ++l) {
+                            c += inside[l];
+                        }
+                        // NOTE: x lies in the i-th box, so c is at least 1.
+                        const double y = 1. / static_cast<double>(std::max(c, 1ull));
+                        s += y;
+                        s2 += y * y;
+                    }
+                    b_sum[b] = s;
+                    b_sum2[b] = s2;
+                }
+            });
+            for (std::size_t b = 0u; b < s_round_size; ++b) {
+                sum += b_sum[b];
+                sum2 += b_sum2[b];
+            }
+            n_samples += s_round_size * s_block_size;
+            const auto N = static_cast<double>(n_samples);
+            const double mean = sum / N;
+            const double var = std::max((sum2 - sum * mean) / (N - 1.), 0.);
+            const double half_width = z * std::sqrt(var / N);
+            if (half_width <= m_eps * mean || n_samples >= m_max_samples) {
+                m_last_n_samples = n_samples;
+                m_last_half_width = half_width * V;
+                return mean * V;
+            }
+        }
+    }
+
+    /// Exclusive method
+    /**
+    * This algorithm does not support this method.
+    * @return Nothing as it throws before
+    */
+    double exclusive(unsigned int, std::vector<vector_double> &, const vector_double &) const
+    {
+        pagmo_throw(std::invalid_argument, "This method is not supported by the mc_approx algorithm");
+    }
+
+    /// Least contributor method
+    /**
+    * This algorithm does not support this method.
+    *
+    * @return Nothing as it throws before
+    */
+    unsigned long long least_contributor(std::vector<vector_double> &, const vector_double &) const
+    {
+        pagmo_throw(std::invalid_argument, "This method is not supported by the mc_approx algorithm");
+    }
+
+    /// Greatest contributor method
+    /**
+    * This algorithm does not support this method.
+    * @return Nothing as it throws before
+    */
+    unsigned long long greatest_contributor(std::vector<vector_double> &, const vector_double &) const
+    {
+        pagmo_throw(std::invalid_argument, "This method is not supported by the mc_approx algorithm");
+    }
+
+    /// Contributions method
+    /**
+    * This algorithm does not support this method.
+    * @return Nothing as it throws before
+    */
+    vector_double contributions(std::vector<vector_double> &, const vector_double &) const
+    {
+        pagmo_throw(std::invalid_argument, "This method is not supported by the mc_approx algorithm");
+    }
+
+    /// Clone method.
+    /**
+     * @return a pointer to a new object cloning this
+     */
+    std::shared_ptr<hv_algorithm> clone() const
+    {
+        return std::shared_ptr<hv_algorithm>(new mc_approx(*this));
+    }
+
+    /// Algorithm name
+    /**
+     * @return The name of this particular algorithm
+     */
+    std::string get_name() const
+    {
+        return "mc_approx algorithm";
+    }
+
+    /// Number of samples of the last estimate
+    /**
+     * @return the number of samples used by the last call to compute() (zero if the hypervolume was trivially null)
+     */
+    unsigned long long get_last_n_samples() const
+    {
+        return m_last_n_samples;
+    }
+
+    /// Half-width of the confidence interval of the last estimate
+    /**
+     * @return the half-width of the confidence interval, at level 1 - delta, of the value returned by the
+     * last call to compute()
+     */
+    double get_last_half_width() const
+    {
+        return m_last_half_width;
+    }
+
+private:
+    // Quantile of the standard normal distribution for a two-sided interval at level 1 - delta,
+    // found by bisection on erfc.
+    static double normal_quantile(double delta)
+    {
+        double lo = 0., hi = 40.;
+        for (auto i = 0; i < 100; ++i) {
+            const double mid = (lo + hi) / 2.;
+            if (std::erfc(mid / std::sqrt(2.)) > delta) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return hi;
+    }
+
+    // Number of samples in a block, and number of blocks in a round.
+    static const std::size_t s_block_size = 1024u;
+    static const std::size_t s_round_size = 32u;
+
+    // requested relative half-width of the confidence interval
+    const double m_eps;
+    // 1 - confidence level of the interval
+    const double m_delta;
+    const unsigned m_n_threads;
+    const unsigned long long m_max_samples;
+
+    mutable detail::random_engine_type m_e;
+    mutable unsigned long long m_last_n_samples;
+    mutable double m_last_half_width;
+};
+}
+
+#endif
@@ -0,0 +1,822 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_UTILS_HV_CONTRIBUTIONS_HPP
+#define PAGMO_UTILS_HV_CONTRIBUTIONS_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pagmo/exceptions.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hv_algos/hv_algorithm.hpp>
+#include <pagmo/utils/hv_algos/hv_hv2d.hpp>
+#include <pagmo/utils/hv_algos/hv_hv3d.hpp>
+#include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Sweep along the third objective computing, for a set of points clipped to the box [b, r], the volume of the box
+// dominated exclusively by each point and the volume of the box not dominated by any point. The points must be
+// added by non-decreasing third coordinate. The projections of the points swept so far which are not weakly
+// dominated by another projection are kept in a two-dimensional staircase: each step stores the projections
+// dominated only by itself (in turn as a non-dominated front, with the area of the region between this front and
+// the step), so that the area of the region dominated exclusively by each step is available in constant time and
+// its volume can be accumulated each time the step changes.
+class hvc3d_sweep
+{
+public:
+    using size_type = std::vector<vector_double>::size_type;
+    hvc3d_sweep(const vector_double &b, const vector_double &r)
+        : m_bx(b[0]), m_by(b[1]), m_rx(r[0]), m_ry(r[1]), m_rz(r[2]), m_box_area((r[0] - b[0]) * (r[1] - b[1])),
+          m_cov(0.), m_uncovered(0.), m_z(b[2]), m_saturated(false)
+    {
+    }
+    // Adds the (clipped) point (x, y, z) with handle id. Returns false if the point is weakly dominated by one of
+    // the points added before.
+    bool add(size_type id, double x, double y, double z)
+    {
+        if (m_saturated) {
+            return false;
+        }
+        m_uncovered += (m_box_area - m_cov) * (z - m_z);
+        m_z = z;
+        auto it = m_front.upper_bound(x);
+        if (it != m_front.begin()) {
+            const auto p = std::prev(it);
+            if (p->second.y <= y) {
+                // A dominated point reduces the exclusive region of the step dominating it, if no other
+                // step dominates it.
+                if (x < x_hi(p) && y < y_hi(p) && !dom_covers(p->second, x, y)) {
+                    flush(p);
+                    dom_insert(p->second, x, y);
+                    // Two points dominating the whole section of the box: the points still to be added
+                    // cannot change the result.
+                    m_saturated = p->first == m_bx && p->second.y == m_by && x == m_bx && y == m_by;
+                }
+                return false;
+            }
+        }
+        // The steps dominated by the new point are in [first, last).
+        const auto first = m_front.lower_bound(x);
+        auto last = first;
+        while (last != m_front.end() && last->second.y >= y) {
+            ++last;
+        }
+        const auto left = first == m_front.begin() ? m_front.end() : std::prev(first);
+        if (left != m_front.end()) {
+            flush(left);
+            m_cov -= cov_area(left);
+        }
+        if (last != m_front.end()) {
+            flush(last);
+        }
+        step s{id, y, z, 0., {}, 0.};
+        for (auto fit = first; fit != last; ++fit) {
+            flush(fit);
+            m_cov -= cov_area(fit);
+            output(fit->second);
+            // The dominated steps are mutually non-dominated, and dominated only by the new point.
+            dom_insert(s, fit->first, fit->second.y);
+        }
+        m_front.erase(first, last);
+        const auto new_it = m_front.emplace_hint(last, x, std::move(s));
+        m_cov += cov_area(new_it);
+        // The projections dominated by the new point are no longer dominated only by its neighbours.
+        if (left != m_front.end()) {
+            auto &d = left->second.dom;
+            while (!d.empty() && std::prev(d.end())->first >= x) {
+                dom_erase(left->second, std::prev(d.end()));
+            }
+            m_cov += cov_area(left);
+        }
+        if (last != m_front.end()) {
+            auto &d = last->second.dom;
+            while (!d.empty() && d.begin()->second >= y) {
+                dom_erase(last->second, d.begin());
+            }
+        }
+        return true;
+    }
+    // Completes the sweep, returning the points with a non-null exclusive volume in the box, with their volumes.
+    std::vector<std::pair<size_type, double>> finish()
+    {
+        m_uncovered += (m_box_area - m_cov) * (m_rz - m_z);
+        m_z = m_rz;
+        for (auto it = m_front.begin(); it != m_front.end(); ++it) {
+            flush(it);
+            output(it->second);
+        }
+        m_front.clear();
+        return std::move(m_vols);
+    }
+    // The volume of the box not dominated by the points (complete after finish()).
+    double uncovered() const
+    {
+        return m_uncovered;
+    }
+
+private:
+    struct step {
+        size_type id;
+        double y;
+        // Third coordinate up to which the volume has been accumulated.
+        double z_last;
+        double vol;
+        // The projections dominated only by this step, and the area between them and the step.
+        std::map<double, double> dom;
+        double dom_area;
+    };
+    using front_t = std::map<double, step>;
+    // The region dominated by the step at it, bounded by its neighbours.
+    double x_hi(front_t::iterator it) const
+    {
+        const auto next = std::next(it);
+        return next == m_front.end() ? m_rx : next->first;
+    }
+    double y_hi(front_t::iterator it) const
+    {
+        return it == m_front.begin() ? m_ry : std::prev(it)->second.y;
+    }
+    // Area dominated by the projection of the step at it, not dominated by the steps preceding it.
+    double cov_area(front_t::iterator it) const
+    {
+        return (x_hi(it) - it->first) * (m_ry - it->second.y);
+    }
+    // Area dominated exclusively by the step at it.
+    double excl_area(front_t::iterator it) const
+    {
+        const auto &s = it->second;
+        const double x_max = x_hi(it), y_max = y_hi(it);
+        if (s.dom.empty()) {
+            return (x_max - it->first) * (y_max - s.y);
+        }
+        const auto last = std::prev(s.dom.end());
+        return (s.dom.begin()->first - it->first) * (y_max - s.y) + s.dom_area
+               + (x_max - last->first) * (last->second - s.y);
+    }
+    void flush(front_t::iterator it)
+    {
+        auto &s = it->second;
+        s.vol += excl_area(it) * (m_z - s.z_last);
+        s.z_last = m_z;
+    }
+    void output(const step &s)
+    {
+        if (s.vol > 0.) {
+            m_vols.emplace_back(s.id, s.vol);
+        }
+    }
+    // Area between the consecutive projections at a and n, dominated only by s.
+    static double dom_term(const step &s, std::map<double, double>::iterator a, std::map<double, double>::iterator n)
+    {
+        return (n->first - a->first) * (a->second - s.y);
+    }
+    static bool dom_covers(const step &s, double x, double y)
+    {
+        const auto it = s.dom.upper_bound(x);
+        return it != s.dom.begin() && std::prev(it)->second <= y;
+    }
+    // Inserts in the front of s a projection not weakly dominated by it.
+    static void dom_insert(step &s, double x, double y)
+    {
+        auto &d = s.dom;
+        auto it = d.lower_bound(x);
+        while (it != d.end() && it->second >= y) {
+            it = dom_erase(s, it);
+        }
+        const auto new_it = d.emplace_hint(it, x, y);
+        if (new_it != d.begin()) {
+            const auto prev = std::prev(new_it);
+            if (it != d.end()) {
+                s.dom_area -= dom_term(s, prev, it);
+            }
+            s.dom_area += dom_term(s, prev, new_it);
+        }
+        if (it != d.end()) {
+            s.dom_area += dom_term(s, new_it, it);
+        }
+    }
+    static std::map<double, double>::iterator dom_erase(step &s, std::map<double, double>::iterator it)
+    {
+        auto &d = s.dom;
+        const auto next = std::next(it);
+        if (it != d.begin()) {
+            const auto prev = std::prev(it);
+            s.dom_area -= dom_term(s, prev, it);
+            if (next != d.end()) {
+                s.dom_area += dom_term(s, prev, next);
+            }
+        }
+        if (next != d.end()) {
+            s.dom_area -= dom_term(s, it, next);
+        }
+        return d.erase(it);
+    }
+
+    const double m_bx, m_by, m_rx, m_ry, m_rz, m_box_area;
+    front_t m_front;
+    // Area of the box dominated by the steps, and volume of the box not dominated up to m_z.
+    double m_cov, m_uncovered;
+    double m_z;
+    bool m_saturated;
+    std::vector<std::pair<size_type, double>> m_vols;
+};
+}
+
+/// Hypervolume contributions under insertions and removals
+/**
+ * This class maintains a set of points, together with the exclusive hypervolume contribution of each of them with
+ * respect to a fixed reference point, under the insertion and the removal of single points. The contributions are
+ * updated incrementally after each change. It is meant for
+ * steady-state selection schemes (e.g., SMS-EMOA-like) or bounded archives, in which one point at a time is added
+ * or removed and the least (or greatest) contributor is queried after each change: hypervolume::least_contributor()
+ * would recompute all the contributions from scratch each time.
+ *
+ * Each inserted point is identified by a handle (returned by hv_contributions::insert()), which stays valid until
+ * the point is removed. Handles of removed points may be reused by later insertions.
+ *
+ * Two and three objectives are supported:
+ * - in two dimensions the non-dominated points are kept sorted, and only the contributions of the points adjacent
+ *   to an inserted or removed point are updated. Insertions and removals cost \f$O(\log N)\f$, plus a cost
+ *   linear in the number of dominated points lying in the regions dominated exclusively by the updated points
+ *   (which reduce their contributions, or become non-dominated when a point is removed). Queries for the least
+ *   and greatest contributors are \f$O(\log N)\f$.
+ * - in three dimensions the points are kept sorted by third objective, the dominated ones separately from the
+ *   non-dominated ones. An insertion or a removal sweeps once all the points, clipped to the box between the
+ *   inserted or removed point and the reference point: the volume each point dominates exclusively in this box is
+ *   the variation of its contribution, and the volume not dominated by any other point is the contribution of the
+ *   inserted point. Insertions and removals cost \f$O(N)\f$, plus a logarithmic factor in the size of the
+ *   (usually small) front of the clipped points. Queries for the least and greatest contributors are
+ *   \f$O(\log N)\f$.
+ *
+ * Dominated points (including duplicates) have a null exclusive contribution.
+ */
+class hv_contributions
+{
+public:
+    /// Handle type.
+    using size_type = std::vector<vector_double>::size_type;
+    /// Constructor.
+    /**
+     * @param r_point the reference point.
+     *
+     * @throws std::invalid_argument if the dimension of \p r_point is not 2 or 3, or if \p r_point contains NaNs.
+     */
+    explicit hv_contributions(const vector_double &r_point) : m_r(r_point), m_size(0u)
+    {
+        if (m_r.size() != 2u && m_r.size() != 3u) {
+            pagmo_throw(std::invalid_argument, "Incremental hypervolume contributions are available only in 2 and 3 "
+                                               "dimensions, but a reference point of dimension "
+                                                   + std::to_string(m_r.size()) + " was provided");
+        }
+        if (std::any_of(m_r.begin(), m_r.end(), [](double x) { return x != x; })) {
+            pagmo_throw(std::invalid_argument, "The reference point contains NaNs");
+        }
+    }
+    /// Insert a point.
+    /**
+     * @param p the point to be inserted.
+     *
+     * @return the handle of the inserted point.
+     *
+     * @throws std::invalid_argument if the dimension of \p p differs from the dimension of the reference point,
+     * or if \p p is not dominated by the reference point (as required by pagmo::hypervolume).
+     */
+    size_type insert(const vector_double &p)
+    {
+        check_point(p);
+        size_type id;
+        if (m_free.empty()) {
+            id = m_points.size();
+            m_points.push_back(p);
+            m_state.push_back(st_free);
+            m_contrib.push_back(0.);
+        } else {
+            id = m_free.back();
+            m_free.pop_back();
+            m_points[id] = p;
+        }
+        ++m_size;
+        if (m_r.size() == 3u) {
+            insert_3d(id);
+            return id;
+        }
+        const double x = p[0], y = p[1];
+        // Look for a point in the front weakly dominating p: the candidate is the point with the largest
+        // first objective not greater than x.
+        auto it = m_front.upper_bound(x);
+        if (it != m_front.begin()) {
+            const auto prev = std::prev(it);
+            const auto &f = m_points[prev->second];
+            if (f[1] <= y) {
+                // A dominated point has no exclusive contribution, but it can reduce the contribution
+                // of the point dominating it.
+                m_state[id] = st_pool;
+                m_contrib[id] = 0.;
+                m_pool.emplace(x, id);
+                m_queue.emplace(0., id);
+                refresh_dominator(x, y);
+                return id;
+            }
+        }
+        // p is non-dominated: the points of the front it dominates move to the pool.
+        it = m_front.lower_bound(x);
+        while (it != m_front.end() && m_points[it->second][1] >= y) {
+            const auto f = it->second;
+            set_contrib(f, 0.);
+            m_state[f] = st_pool;
+            m_pool.emplace(m_points[f][0], f);
+            it = m_front.erase(it);
+        }
+        it = m_front.emplace_hint(it, x, id);
+        m_state[id] = st_front;
+        m_contrib[id] = 0.;
+        m_queue.emplace(0., id);
+        refresh_around(it);
+        return id;
+    }
+    /// Remove a point.
+    /**
+     * @param id the handle of the point to be removed.
+     *
+     * @throws std::invalid_argument if \p id is not the handle of a point in the set.
+     */
+    void erase(size_type id)
+    {
+        check_id(id);
+        --m_size;
+        if (m_r.size() == 3u) {
+            erase_3d(id);
+            return;
+        }
+        const double x = m_points[id][0], y = m_points[id][1];
+        m_queue.erase(std::make_pair(m_contrib[id], id));
+        if (m_state[id] == st_pool) {
+            m_pool.erase(std::make_pair(x, id));
+            release(id);
+            refresh_dominator(x, y);
+            return;
+        }
+        // The point is in the front: the region it dominated exclusively, bounded by its neighbours,
+        // may uncover some of the points in the pool.
+        auto it = m_front.find(x);
+        const auto right = std::next(it);
+        const double x_hi = right == m_front.end() ? m_r[0] : m_points[right->second][0];
+        const double y_hi = it == m_front.begin() ? m_r[1] : m_points[std::prev(it)->second][1];
+        m_front.erase(it);
+        release(id);
+        std::vector<size_type> cand;
+        for (auto pit = m_pool.lower_bound(std::make_pair(x, size_type(0u))); pit != m_pool.end() && pit->first < x_hi;
+             ++pit) {
+            if (m_points[pit->second][1] < y_hi) {
+                cand.push_back(pit->second);
+            }
+        }
+        std::sort(cand.begin(), cand.end(), [this](size_type a, size_type b) {
+            return std::tie(m_points[a][0], m_points[a][1], a) < std::tie(m_points[b][0], m_points[b][1], b);
+        });
+        // The non-dominated candidates are promoted to the front.
+        double best_y = y_hi;
+        for (auto s : cand) {
+            const auto &ps = m_points[s];
+            if (ps[1] < best_y) {
+                m_pool.erase(std::make_pair(ps[0], s));
+                m_front.emplace(ps[0], s);
+                m_state[s] = st_front;
+                best_y = ps[1];
+            }
+        }
+        // Update the contributions between the neighbours of the removed point.
+        auto first = m_front.upper_bound(x);
+        if (first != m_front.begin()) {
+            --first;
+        }
+        for (auto fit = first; fit != m_front.end(); ++fit) {
+            refresh(fit);
+            if (fit->first >= x_hi) {
+                break;
+            }
+        }
+    }
+    /// Number of points.
+    /**
+     * @return the number of points in the set.
+     */
+    size_type size() const
+    {
+        return m_size;
+    }
+    /// Check a handle.
+    /**
+     * @param id a handle.
+     *
+     * @return \p true if \p id is the handle of a point in the set, \p false otherwise.
+     */
+    bool contains(size_type id) const
+    {
+        return id < m_state.size() && m_state[id] != st_free;
+    }
+    /// Get a point.
+    /**
+     * @param id the handle of the point.
+     *
+     * @return a const reference to the point.
+     *
+     * @throws std::invalid_argument if \p id is not the handle of a point in the set.
+     */
+    const vector_double &get_point(size_type id) const
+    {
+        check_id(id);
+        return m_points[id];
+    }
+    /// Get the reference point.
+    /**
+     * @return a const reference to the reference point.
+     */
+    const vector_double &get_refpoint() const
+    {
+        return m_r;
+    }
+    /// Exclusive contribution.
+    /**
+     * @param id the handle of the point.
+     *
+     * @return the exclusive contribution to the hypervolume of the point.
+     *
+     * @throws std::invalid_argument if \p id is not the handle of a point in the set.
+     */
+    double contribution(size_type id) const
+    {
+        check_id(id);
+        return m_contrib[id];
+    }
+    /// Least contributor.
+    /**
+     * @return the handle of the point contributing the least volume (the smallest handle in case of ties).
+     *
+     * @throws std::invalid_argument if the set is empty.
+     */
+    size_type least_contributor() const
+    {
+        check_not_empty();
+        return m_queue.begin()->second;
+    }
+    /// Greatest contributor.
+    /**
+     * @return the handle of the point contributing the most volume (the smallest handle in case of ties).
+     *
+     * @throws std::invalid_argument if the set is empty.
+     */
+    size_type greatest_contributor() const
+    {
+        check_not_empty();
+        return m_queue.lower_bound(std::make_pair(m_queue.rbegin()->first, size_type(0u)))->second;
+    }
+    /// Hypervolume.
+    /**
+     * @return the hypervolume of the set of points.
+     *
+     * @throws unspecified any exception thrown by hv3d::compute().
+     */
+    double compute() const
+    {
+        if (m_r.size() == 2u) {
+            double retval = 0.;
+            for (auto it = m_front.begin(); it != m_front.end(); ++it) {
+                const auto next = std::next(it);
+                const double x_next = next == m_front.end() ? m_r[0] : m_points[next->second][0];
+                retval += (x_next - it->first) * (m_r[1] - m_points[it->second][1]);
+            }
+            return retval;
+        }
+        std::vector<vector_double> points;
+        for (const auto &k : m_zfront) {
+            points.push_back(m_points[std::get<3>(k)]);
+        }
+        return points.empty() ? 0. : hv3d(false).compute(points, m_r);
+    }
+
+private:
+    enum : char { st_free, st_front, st_pool };
+    using zkey = std::tuple<double, double, double, size_type>;
+    void check_point(const vector_double &p) const
+    {
+        if (p.size() != m_r.size()) {
+            pagmo_throw(std::invalid_argument, "The dimension of the point (" + std::to_string(p.size())
+                                                   + ") differs from the dimension of the reference point ("
+                                                   + std::to_string(m_r.size()) + ")");
+        }
+        bool all_equal = true, outside = false;
+        for (decltype(p.size()) i = 0u; i < p.size(); ++i) {
+            all_equal = all_equal && p[i] == m_r[i];
+            outside = outside || !(p[i] <= m_r[i]);
+        }
+        if (all_equal || outside) {
+            pagmo_throw(std::invalid_argument,
+                        "Reference point is invalid: the point is outside the reference point boundary, or "
+                        "is equal to the reference point");
+        }
+    }
+    void check_id(size_type id) const
+    {
+        if (!contains(id)) {
+            pagmo_throw(std::invalid_argument, "The handle " + std::to_string(id) + " does not refer to any point");
+        }
+    }
+    void check_not_empty() const
+    {
+        if (!m_size) {
+            pagmo_throw(std::invalid_argument, "Cannot determine a contributor in an empty set of points");
+        }
+    }
+    void release(size_type id)
+    {
+        m_state[id] = st_free;
+        m_free.push_back(id);
+    }
+    void set_contrib(size_type id, double c)
+    {
+        m_queue.erase(std::make_pair(m_contrib[id], id));
+        m_contrib[id] = c;
+        m_queue.emplace(c, id);
+    }
+    // Recomputes the contribution of the point of the front at it. In two dimensions, it is the
+    // rectangle bounded by the point and by its neighbours, minus the area dominated by the points
+    // of the pool falling in the rectangle (i.e., the points dominated only by this point).
+    void refresh(std::map<double, size_type>::iterator it)
+    {
+        const auto id = it->second;
+        const auto next = std::next(it);
+        const double x_next = next == m_front.end() ? m_r[0] : m_points[next->second][0];
+        const double y_prev = it == m_front.begin() ? m_r[1] : m_points[std::prev(it)->second][1];
+        const double y = m_points[id][1];
+        double retval = (x_next - it->first) * (y_prev - y);
+        // Sweep of the pool points in the rectangle, by increasing first objective.
+        double y_min = y_prev;
+        for (auto pit = m_pool.lower_bound(std::make_pair(it->first, size_type(0u)));
+             pit != m_pool.end() && pit->first < x_next && retval > 0.; ++pit) {
+            const double yp = m_points[pit->second][1];
+            if (yp < y_min) {
+                retval -= (x_next - pit->first) * (y_min - yp);
+                y_min = yp;
+            }
+        }
+        set_contrib(id, std::max(retval, 0.));
+    }
+    // Refreshes the point of the front dominating the point (x, y) of the pool, if the latter
+    // falls in its rectangle.
+    void refresh_dominator(double x, double y)
+    {
+        auto it = m_front.upper_bound(x);
+        if (it == m_front.begin()) {
+            return;
+        }
+        --it;
+        const double y_prev = it == m_front.begin() ? m_r[1] : m_points[std::prev(it)->second][1];
+        if (m_points[it->second][1] <= y && y < y_prev) {
+            refresh(it);
+        }
+    }
+    void refresh_around(std::map<double, size_type>::iterator it)
+    {
+        if (it != m_front.begin()) {
+            refresh(std::prev(it));
+        }
+        refresh(it);
+        if (std::next(it) != m_front.end()) {
+            refresh(std::next(it));
+        }
+    }
+    // Three dimensions: the key of a point in m_zfront and m_zpool. The points are sorted lexicographically by
+    // (z, y, x), so that a point weakly dominating another one is swept first (the earliest of duplicate points
+    // being the non-dominated one).
+    zkey make_zkey(size_type id) const
+    {
+        const auto &p = m_points[id];
+        return zkey(p[2], p[1], p[0], id);
+    }
+    // Sweeps the points but the one with handle excluded, clipped to the box [b, r], in ascending order.
+    // f is called with the key of each point and the result of the sweep for it.
+    template <typename F>
+    std::vector<std::pair<size_type, double>> sweep(detail::hvc3d_sweep &sw, const vector_double &b, size_type excluded,
+                                                    F f) const
+    {
+        auto fit = m_zfront.begin();
+        auto pit = m_zpool.begin();
+        auto next = [this, &fit, &pit]() -> const zkey & {
+            return (pit == m_zpool.end() || (fit != m_zfront.end() && *fit < *pit)) ? *fit++ : *pit++;
+        };
+        auto below = [this, &fit, &pit, &b]() {
+            return (fit != m_zfront.end() && std::get<0>(*fit) <= b[2])
+                   || (pit != m_zpool.end() && std::get<0>(*pit) <= b[2]);
+        };
+        // The points below the box are clipped to its bottom face, where their order does not affect the
+        // volumes: they are swept by (x, y), so that no front is built only to be dominated by later points.
+        // A point weakly dominated by two other points does not change the result, and the points
+        // dominating the most are found among the best two on each of the two lower edges of the face.
+        using cpoint = std::tuple<double, double, const zkey *>;
+        auto before = [](const cpoint &p1, const cpoint &p2) {
+            return std::tie(std::get<0>(p1), std::get<1>(p1), *std::get<2>(p1))
+                   < std::tie(std::get<0>(p2), std::get<1>(p2), *std::get<2>(p2));
+        };
+        auto clip = [&b](const zkey &k) {
+            return cpoint(std::max(std::get<2>(k), b[0]), std::max(std::get<1>(k), b[1]), &k);
+        };
+        const auto fit0 = fit;
+        const auto pit0 = pit;
+        // The best two points on the edge x = b_x ranked by (y, x), and on the edge y = b_y ranked by (x, y).
+        cpoint edges[4];
+        std::fill(edges, edges + 4, cpoint(0., 0., nullptr));
+        auto rank = [&before](cpoint *best, const cpoint &p) {
+            if (!std::get<2>(best[0]) || before(p, best[0])) {
+                best[1] = best[0];
+                best[0] = p;
+            } else if (!std::get<2>(best[1]) || before(p, best[1])) {
+                best[1] = p;
+            }
+        };
+        while (below()) {
+            const auto &k = next();
+            if (std::get<3>(k) != excluded) {
+                const auto p = clip(k);
+                if (std::get<0>(p) == b[0]) {
+                    rank(edges, cpoint(std::get<1>(p), std::get<0>(p), &k));
+                }
+                if (std::get<1>(p) == b[1]) {
+                    rank(edges + 2, p);
+                }
+            }
+        }
+        std::vector<cpoint> cand;
+        for (auto i = 0; i < 4; ++i) {
+            if (i < 2) {
+                std::swap(std::get<0>(edges[i]), std::get<1>(edges[i]));
+            }
+            const auto k = std::get<2>(edges[i]);
+            if (k && std::none_of(cand.begin(), cand.end(), [k](const cpoint &c) { return std::get<2>(c) == k; })) {
+                cand.push_back(edges[i]);
+            }
+        }
+        fit = fit0;
+        pit = pit0;
+        std::vector<cpoint> bottom;
+        while (below()) {
+            const auto &k = next();
+            if (std::get<3>(k) == excluded) {
+                continue;
+            }
+            const auto p = clip(k);
+            auto n_dom = 0;
+            bool preceded = false;
+            for (const auto &c : cand) {
+                if (std::get<2>(c) != &k && std::get<0>(c) <= std::get<0>(p) && std::get<1>(c) <= std::get<1>(p)) {
+                    ++n_dom;
+                    preceded = preceded || before(c, p);
+                }
+            }
+            // The point is dominated by a point swept before it.
+            if (n_dom >= 2 && preceded) {
+                f(k, false);
+            } else {
+                bottom.push_back(p);
+            }
+        }
+        std::sort(bottom.begin(), bottom.end(), before);
+        for (const auto &p : bottom) {
+            const auto &k = *std::get<2>(p);
+            f(k, sw.add(std::get<3>(k), std::get<0>(p), std::get<1>(p), b[2]));
+        }
+        while (fit != m_zfront.end() || pit != m_zpool.end()) {
+            const auto &k = next();
+            const auto id = std::get<3>(k);
+            if (id != excluded) {
+                f(k, sw.add(id, std::max(std::get<2>(k), b[0]), std::max(std::get<1>(k), b[1]), std::get<0>(k)));
+            }
+        }
+        return sw.finish();
+    }
+    void move_to_pool(size_type id)
+    {
+        m_zfront.erase(make_zkey(id));
+        m_zpool.insert(make_zkey(id));
+        m_state[id] = st_pool;
+        set_contrib(id, 0.);
+    }
+    // The inserted point takes from the other points the volume they dominate exclusively in the box between it
+    // and the reference point, and contributes the volume of the box they do not dominate.
+    void insert_3d(size_type id)
+    {
+        const auto &q = m_points[id];
+        detail::hvc3d_sweep sw(q, m_r);
+        bool dominated = false;
+        std::vector<size_type> demoted;
+        const auto vols = sweep(sw, q, m_points.size(), [this, &q, &dominated, &demoted](const zkey &k, bool) {
+            const double x = std::get<2>(k), y = std::get<1>(k), z = std::get<0>(k);
+            dominated = dominated || (x <= q[0] && y <= q[1] && z <= q[2]);
+            if (q[0] <= x && q[1] <= y && q[2] <= z && m_state[std::get<3>(k)] == st_front) {
+                demoted.push_back(std::get<3>(k));
+            }
+        });
+        for (const auto &v : vols) {
+            set_contrib(v.first, std::max(m_contrib[v.first] - v.second, 0.));
+        }
+        if (dominated) {
+            m_state[id] = st_pool;
+            m_contrib[id] = 0.;
+            m_zpool.insert(make_zkey(id));
+        } else {
+            for (auto s : demoted) {
+                move_to_pool(s);
+            }
+            m_state[id] = st_front;
+            m_contrib[id] = std::max(sw.uncovered(), 0.);
+            m_zfront.insert(make_zkey(id));
+        }
+        m_queue.emplace(m_contrib[id], id);
+    }
+    // The other points gain the volume they dominate exclusively, once the removed point is excluded, in the box
+    // between the removed point and the reference point.
+    void erase_3d(size_type id)
+    {
+        const auto &e = m_points[id];
+        const bool in_front = m_state[id] == st_front;
+        detail::hvc3d_sweep sw(e, m_r);
+        std::vector<size_type> promoted;
+        const auto vols = sweep(sw, e, id, [this, &e, in_front, &promoted](const zkey &k, bool non_dominated) {
+            if (in_front && non_dominated && e[0] <= std::get<2>(k) && e[1] <= std::get<1>(k)
+                && e[2] <= std::get<0>(k) && m_state[std::get<3>(k)] == st_pool) {
+                promoted.push_back(std::get<3>(k));
+            }
+        });
+        m_queue.erase(std::make_pair(m_contrib[id], id));
+        (in_front ? m_zfront : m_zpool).erase(make_zkey(id));
+        release(id);
+        for (const auto &v : vols) {
+            set_contrib(v.first, m_contrib[v.first] + v.second);
+        }
+        for (auto s : promoted) {
+            m_zpool.erase(make_zkey(s));
+            m_zfront.insert(make_zkey(s));
+            m_state[s] = st_front;
+        }
+    }
+
+    vector_double m_r;
+    // Storage of the points, indexed by handle.
+    std::vector<vector_double> m_points;
+    std::vector<char> m_state;
+    vector_double m_contrib;
+    // Handles available for reuse.
+    std::vector<size_type> m_free;
+    size_type m_size;
+    // All the points sorted by contribution and handle.
+    std::set<std::pair<double, size_type>> m_queue;
+    // Two dimensions: the non-dominated points sorted by first objective, and the dominated ones
+    // sorted by first objective and handle.
+    std::map<double, size_type> m_front;
+    std::set<std::pair<double, size_type>> m_pool;
+    // Three dimensions: the non-dominated and the dominated points, sorted by (z, y, x) and handle.
+    std::set<zkey> m_zfront;
+    std::set<zkey> m_zpool;
+};
+}
+
+#endif
@@ -38,6 +38,8 @@ see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
+#include <cstddef>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
@@ -272,6 +274,158 @@ inline fnds_return_type fast_non_dominated_sorting(const std::vector<vector_doub
                            std::move(non_dom_rank));
 }
 
+/// Workspace for the multi-objective utilities
+/**
+ * This structure holds the buffers used by the overloads of pagmo::fast_non_dominated_sorting(),
+ * pagmo::crowding_distance() and pagmo::select_best_N_mo() taking a workspace argument. When the same workspace
+ * is reused across calls (e.g., across the generations of an algorithm), the buffers keep their capacity, and no
+ * heap allocation takes place once they have grown to the size of the population.
+ *
+ * After a call to pagmo::fast_non_dominated_sorting(), the non dominated fronts are stored contiguously in
+ * mo_workspace::fronts, the \f$i\f$-th front being the span
+ * <tt>[fronts.begin() + front_begin[i], fronts.begin() + front_begin[i + 1])</tt>.
+ */
+struct mo_workspace {
+    /// Number of non dominated fronts.
+    /**
+     * @return the number of non dominated fronts computed by the last call to pagmo::fast_non_dominated_sorting().
+     */
+    std::vector<vector_double::size_type>::size_type n_fronts() const
+    {
+        return front_begin.empty() ? 0u : front_begin.size() - 1u;
+    }
+    /// The indexes of the individuals, grouped by non dominated front.
+    std::vector<vector_double::size_type> fronts;
+    /// The offsets of the fronts in mo_workspace::fronts (plus a final offset equal to its size).
+    std::vector<std::vector<vector_double::size_type>::size_type> front_begin;
+    /// The domination list (see pagmo::fast_non_dominated_sorting()).
+    std::vector<std::vector<vector_double::size_type>> dom_list;
+    /// The domination count (see pagmo::fast_non_dominated_sorting()).
+    std::vector<vector_double::size_type> dom_count;
+    /// The non domination rank (see pagmo::fast_non_dominated_sorting()).
+    std::vector<vector_double::size_type> non_dom_rank;
+    /// Scratch buffer.
+    std::vector<vector_double::size_type> tmp;
+    /// Scratch buffer for the crowding distances.
+    vector_double crowding;
+};
+
+/// Fast non dominated sorting (workspace version)
+/**
+ * This overload computes the same quantities as pagmo::fast_non_dominated_sorting(const
+ * std::vector<vector_double> &), in the same order, storing them in \p ws (see pagmo::mo_workspace) instead of
+ * returning them.
+ *
+ * @param points An std::vector containing the objectives of different individuals.
+ * @param ws the workspace.
+ *
+ * @throws std::invalid_argument If the size of \p points is not at least 2
+ */
+inline void fast_non_dominated_sorting(const std::vector<vector_double> &points, mo_workspace &ws)
+{
+    auto N = points.size();
+    if (N < 2u) {
+        pagmo_throw(std::invalid_argument, "At least two points are needed for fast_non_dominated_sorting: "
+                                               + std::to_string(N) + " detected.");
+    }
+    ws.fronts.clear();
+    ws.front_begin.assign(1u, 0u);
+    // NOTE: resize() keeps the capacity of the domination lists already present.
+    ws.dom_list.resize(N);
+    ws.dom_count.resize(N);
+    ws.non_dom_rank.resize(N);
+    for (decltype(N) i = 0u; i < N; ++i) {
+        ws.dom_list[i].clear();
+        ws.dom_count[i] = 0u;
+        for (decltype(N) j = 0u; j < N; ++j) {
+            if (i == j) {
+                continue;
+            }
+            if (pareto_dominance(points[i], points[j])) {
+                ws.dom_list[i].push_back(j);
+            } else if (pareto_dominance(points[j], points[i])) {
+                ++ws.dom_count[i];
+            }
+        }
+        if (ws.dom_count[i] == 0u) {
+            ws.non_dom_rank[i] = 0u;
+            ws.fronts.push_back(i);
+        }
+    }
+    // The domination counts are decremented in a copy, as we want to output their value at this point.
+    ws.tmp.assign(ws.dom_count.begin(), ws.dom_count.end());
+    decltype(ws.fronts.size()) begin = 0u, end = ws.fronts.size();
+    vector_double::size_type front_counter(0u);
+    while (begin != end) {
+        ws.front_begin.push_back(end);
+        for (auto p = begin; p < end; ++p) {
+            for (auto q : ws.dom_list[ws.fronts[p]]) {
+                if (--ws.tmp[q] == 0u) {
+                    ws.non_dom_rank[q] = front_counter + 1u;
+                    ws.fronts.push_back(q);
+                }
+            }
+        }
+        ++front_counter;
+        begin = end;
+        end = ws.fronts.size();
+    }
+}
+
+/// Crowding distance (index span version)
+/**
+ * This overload computes the crowding distance of the points <tt>points[*it]</tt>, \p it ranging in
+ * <tt>[first, last)</tt>, without copying them: the crowding distance of <tt>points[*it]</tt> is written in
+ * <tt>retval[*it]</tt>. The buffer \p tmp is used as scratch space, so that no heap allocation takes place if its
+ * capacity suffices. The result is identical to the one of pagmo::crowding_distance(const
+ * std::vector<vector_double> &) called on a copy of the selected points.
+ *
+ * @param points the objective vectors.
+ * @param first beginning of the span of indexes into \p points forming a non dominated front.
+ * @param last end of the span of indexes.
+ * @param retval output vector, indexed as \p points (it must have at least the size of \p points).
+ * @param tmp scratch buffer.
+ *
+ * @throws std::invalid_argument If the span does not contain at least two indexes
+ * @throws std::invalid_argument If the selected points do not all have at least two objectives
+ * @throws std::invalid_argument If the selected points do not all have the same dimensionality
+ */
+inline void crowding_distance(const std::vector<vector_double> &points,
+                              std::vector<vector_double::size_type>::const_iterator first,
+                              std::vector<vector_double::size_type>::const_iterator last, vector_double &retval,
+                              std::vector<vector_double::size_type> &tmp)
+{
+    auto N = static_cast<vector_double::size_type>(std::distance(first, last));
+    if (N < 2u) {
+        pagmo_throw(std::invalid_argument,
+                    "A non dominated front must contain at least two points: " + std::to_string(N) + " detected.");
+    }
+    auto M = points[*first].size();
+    if (M < 2u) {
+        pagmo_throw(std::invalid_argument, "Points in the non dominated front must contain at least two objectives: "
+                                               + std::to_string(M) + " detected.");
+    }
+    if (!std::all_of(first, last, [M, &points](vector_double::size_type idx) { return points[idx].size() == M; })) {
+        pagmo_throw(std::invalid_argument, "A non dominated front must contain points of uniform dimensionality. Some "
+                                           "different sizes were instead detected.");
+    }
+    tmp.assign(first, last);
+    for (auto idx : tmp) {
+        retval[idx] = 0.;
+    }
+    for (decltype(M) i = 0u; i < M; ++i) {
+        std::sort(tmp.begin(), tmp.end(), [i, &points](vector_double::size_type idx1, vector_double::size_type idx2) {
+            return detail::less_than_f(points[idx1][i], points[idx2][i]);
+        });
+        retval[tmp[0]] = std::numeric_limits<double>::infinity();
+        retval[tmp[N - 1u]] = std::numeric_limits<double>::infinity();
+        double df = points[tmp[N - 1u]][i] - points[tmp[0]][i];
+        for (decltype(N - 2u) j = 1u; j < N - 1u; ++j) {
+            retval[tmp[j]] += (points[tmp[j + 1u]][i] - points[tmp[j - 1u]][i]) / df;
+        }
+    }
+}
+
 /// Crowding distance
 /**
  * An implementation of the crowding distance. Complexity is \f$ O(MNlog(N))\f$ where \f$M\f$ is the number of
@@ -295,39 +449,10 @@ inline fnds_return_type fast_non_dominated_sorting(const std::vector<vector_doub
  */
 inline vector_double crowding_distance(const std::vector<vector_double> &non_dom_front)
 {
-    auto N = non_dom_front.size();
-    // We make sure to have two points at least
-    if (N < 2u) {
-        pagmo_throw(std::invalid_argument,
-                    "A non dominated front must contain at least two points: " + std::to_string(N) + " detected.");
-    }
-    auto M = non_dom_front[0].size();
-    // We make sure the first point of the input non dominated front contains at least two objectives
-    if (M < 2u) {
-        pagmo_throw(std::invalid_argument, "Points in the non dominated front must contain at least two objectives: "
-                                               + std::to_string(M) + " detected.");
-    }
-    // We make sure all points contain the same number of objectives
-    if (!std::all_of(non_dom_front.begin(), non_dom_front.end(),
-                     [M](const vector_double &item) { return item.size() == M; })) {
-        pagmo_throw(std::invalid_argument, "A non dominated front must contain points of uniform dimensionality. Some "
-                                           "different sizes were instead detected.");
-    }
-    std::vector<vector_double::size_type> indexes(N);
+    std::vector<vector_double::size_type> indexes(non_dom_front.size()), tmp;
     std::iota(indexes.begin(), indexes.end(), vector_double::size_type(0u));
-    vector_double retval(N, 0.);
-    for (decltype(M) i = 0u; i < M; ++i) {
-        std::sort(indexes.begin(), indexes.end(),
-                  [i, &non_dom_front](vector_double::size_type idx1, vector_double::size_type idx2) {
-                      return detail::less_than_f(non_dom_front[idx1][i], non_dom_front[idx2][i]);
-                  });
-        retval[indexes[0]] = std::numeric_limits<double>::infinity();
-        retval[indexes[N - 1u]] = std::numeric_limits<double>::infinity();
-        double df = non_dom_front[indexes[N - 1u]][i] - non_dom_front[indexes[0]][i];
-        for (decltype(N - 2u) j = 1u; j < N - 1u; ++j) {
-            retval[indexes[j]] += (non_dom_front[indexes[j + 1u]][i] - non_dom_front[indexes[j - 1u]][i]) / df;
-        }
-    }
+    vector_double retval(non_dom_front.size());
+    crowding_distance(non_dom_front, indexes.begin(), indexes.end(), retval, tmp);
     return retval;
 }
 
@@ -374,19 +499,13 @@ inline std::vector<vector_double::size_type> sort_population_mo(const std::vecto
     // Run fast-non-dominated sorting and compute the crowding distance for all input objectives vectors
     auto tuple = fast_non_dominated_sorting(input_f);
     vector_double crowding(input_f.size());
+    std::vector<vector_double::size_type> tmp;
     for (const auto &front : std::get<0>(tuple)) {
         if (front.size() == 1u) {
             crowding[front[0]] = 0u; // corner case of a non dominated front containing one individual. Crowding
                                      // distance is not defined nor it will be used
         } else {
-            std::vector<vector_double> non_dom_fits(front.size());
-            for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
-                non_dom_fits[i] = input_f[front[i]];
-            }
-            vector_double tmp(crowding_distance(non_dom_fits));
-            for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
-                crowding[front[i]] = tmp[i];
-            }
+            crowding_distance(input_f, front.begin(), front.end(), crowding, tmp);
         }
     }
     // Sort the indexes
@@ -401,6 +520,82 @@ inline std::vector<vector_double::size_type> sort_population_mo(const std::vecto
     return retval;
 }
 
+/// Selects the best N individuals in multi-objective optimization (workspace version)
+/**
+ * This overload selects the same individuals as pagmo::select_best_N_mo(const std::vector<vector_double> &,
+ * vector_double::size_type), writing them into \p retval and using \p ws (see pagmo::mo_workspace) for all the
+ * intermediate quantities: if \p ws and \p retval are reused across calls, no heap allocation takes place once
+ * their capacity suffices. The crowding distance is computed only for the last front included in the best N, and
+ * its individuals are only partially sorted.
+ *
+ * @param input_f Input objectives vectors. Example {{0.25,0.25},{-1,1},{2,-2}};
+ * @param N Number of best individuals to return
+ * @param ws the workspace.
+ * @param retval output vector, which will contain the indexes of the best N objective vectors. Example {2,1}
+ *
+ * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting and pagmo::crowding_distance
+ */
+inline void select_best_N_mo(const std::vector<vector_double> &input_f, vector_double::size_type N, mo_workspace &ws,
+                             std::vector<vector_double::size_type> &retval)
+{
+    if (N < 1u) {
+        pagmo_throw(std::invalid_argument,
+                    "The best: " + std::to_string(N) + " individuals were requested, while 1 is the minimum");
+    }
+    retval.clear();
+    if (input_f.size() == 0u) { // corner case
+        return;
+    }
+    if (input_f.size() == 1u) { // corner case
+        retval.push_back(0u);
+        return;
+    }
+    if (N >= input_f.size()) { // corner case
+        retval.resize(input_f.size());
+        std::iota(retval.begin(), retval.end(), vector_double::size_type(0u));
+        return;
+    }
+    // Run fast-non-dominated sorting
+    fast_non_dominated_sorting(input_f, ws);
+    // Insert all non dominated fronts if not more than N
+    decltype(ws.n_fronts()) front_id(0u);
+    for (; front_id < ws.n_fronts(); ++front_id) {
+        const auto b = ws.fronts.begin() + static_cast<std::ptrdiff_t>(ws.front_begin[front_id]),
+                   e = ws.fronts.begin() + static_cast<std::ptrdiff_t>(ws.front_begin[front_id + 1u]);
+        if (retval.size() + static_cast<vector_double::size_type>(e - b) <= N) {
+            retval.insert(retval.end(), b, e);
+            if (retval.size() == N) {
+                return;
+            }
+        } else {
+            break;
+        }
+    }
+    const auto b = ws.fronts.begin() + static_cast<std::ptrdiff_t>(ws.front_begin[front_id]),
+               e = ws.fronts.begin() + static_cast<std::ptrdiff_t>(ws.front_begin[front_id + 1u]);
+    // Run crowding distance for the front
+    ws.crowding.resize(input_f.size());
+    crowding_distance(input_f, b, e, ws.crowding, ws.tmp);
+    // Only the individuals with the largest crowding distances are needed: partial sort of the positions
+    // in the front, in descending order of crowding distance. Ties are broken by position, so that the
+    // selected individuals are the same as with a full (stable) sort.
+    ws.tmp.resize(static_cast<vector_double::size_type>(e - b));
+    std::iota(ws.tmp.begin(), ws.tmp.end(), vector_double::size_type(0u));
+    const auto remaining = static_cast<std::ptrdiff_t>(N - retval.size());
+    std::partial_sort(ws.tmp.begin(), ws.tmp.begin() + remaining, ws.tmp.end(),
+                      [&ws, b](vector_double::size_type p1, vector_double::size_type p2) {
+                          const auto cd1 = ws.crowding[b[static_cast<std::ptrdiff_t>(p1)]],
+                                     cd2 = ws.crowding[b[static_cast<std::ptrdiff_t>(p2)]];
+                          if (detail::greater_than_f(cd1, cd2)) {
+                              return true;
+                          }
+                          return !detail::greater_than_f(cd2, cd1) && p1 < p2;
+                      });
+    for (auto it = ws.tmp.begin(); it != ws.tmp.begin() + remaining; ++it) {
+        retval.push_back(b[static_cast<std::ptrdiff_t>(*it)]);
+    }
+}
+
 /// Selects the best N individuals in multi-objective optimization
 /**
  * Selects the best N individuals out of a population, (intended here as an
@@ -430,56 +625,9 @@ inline std::vector<vector_double::size_type> sort_population_mo(const std::vecto
 inline std::vector<vector_double::size_type> select_best_N_mo(const std::vector<vector_double> &input_f,
                                                               vector_double::size_type N)
 {
-    if (N < 1u) {
-        pagmo_throw(std::invalid_argument,
-                    "The best: " + std::to_string(N) + " individuals were requested, while 1 is the minimum");
-    }
-    if (input_f.size() == 0u) { // corner case
-        return {};
-    }
-    if (input_f.size() == 1u) { // corner case
-        return {0u};
-    }
-    if (N >= input_f.size()) { // corner case
-        std::vector<vector_double::size_type> retval(input_f.size());
-        std::iota(retval.begin(), retval.end(), vector_double::size_type(0u));
-        return retval;
-    }
+    mo_workspace ws;
     std::vector<vector_double::size_type> retval;
-    std::vector<vector_double::size_type>::size_type front_id(0u);
-    // Run fast-non-dominated sorting
-    auto tuple = fast_non_dominated_sorting(input_f);
-    // Insert all non dominated fronts if not more than N
-    for (const auto &front : std::get<0>(tuple)) {
-        if (retval.size() + front.size() <= N) {
-            for (auto i : front) {
-                retval.push_back(i);
-            }
-            if (retval.size() == N) {
-                return retval;
-            }
-            ++front_id;
-        } else {
-            break;
-        }
-    }
-    auto front = std::get<0>(tuple)[front_id];
-    std::vector<vector_double> non_dom_fits(front.size());
-    // Run crowding distance for the front
-    for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
-        non_dom_fits[i] = input_f[front[i]];
-    }
-    vector_double cds(crowding_distance(non_dom_fits));
-    // We now have front and crowding distance, we sort the front w.r.t. the crowding
-    std::vector<vector_double::size_type> idxs(front.size());
-    std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
-    std::sort(idxs.begin(), idxs.end(), [&cds](vector_double::size_type idx1, vector_double::size_type idx2) {
-        return detail::greater_than_f(cds[idx1], cds[idx2]);
-    }); // Descending order1
-    auto remaining = N - retval.size();
-    for (decltype(remaining) i = 0u; i < remaining; ++i) {
-        retval.push_back(front[idxs[i]]);
-    }
+    select_best_N_mo(input_f, N, ws, retval);
     return retval;
 }
 
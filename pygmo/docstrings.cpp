@@ -3962,8 +3962,9 @@ Launch evolution.
 
 This method will evolve the island’s :class:`~pygmo.population` using the island’s :class:`~pygmo.algorithm`.
 The evolution happens asynchronously: a call to :func:`~pygmo.island.evolve()` will create an evolution task that
-will be pushed to a queue, and then return immediately. The tasks in the queue are consumed by a separate thread of execution
-managed by the :class:`~pygmo.island` object. Each task will invoke the ``run_evolve()`` method of the UDI *n*
+will be pushed to a queue, and then return. The queue can hold up to 256 pending tasks: if it is full, this method will block
+(with the GIL released) until the island's thread has started one of the queued tasks. The tasks in the queue are consumed by a
+separate thread of execution managed by the :class:`~pygmo.island` object. Each task will invoke the ``run_evolve()`` method of the UDI *n*
 times consecutively to perform the actual evolution. The island's population will be updated at the end of each ``run_evolve()``
 invocation. Exceptions raised inside the tasks are stored within the island object, and can be re-raised by calling
 :func:`~pygmo.island.wait_check()`.
@@ -4212,7 +4213,7 @@ Evolve archipelago.
 This method will call :func:`pygmo.island.evolve()` on all the islands of the archipelago.
 The input parameter *n* will be passed to the invocations of :func:`pygmo.island.evolve()` for each island.
 The :attr:`~pygmo.archipelago.status` attribute can be used to query the status of the asynchronous operations in the
-archipelago.
+archipelago. Like :func:`pygmo.island.evolve()`, this method will block if the queue of pending tasks of an island is full.
 
 Args:
      n (``int``): the parameter that will be passed to :func:`pygmo.island.evolve()`
@@ -40,17 +40,23 @@ see https://www.gnu.org/licenses/. */
 #include <boost/lexical_cast.hpp>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
 #include <pagmo/algorithms/pso.hpp>
 #include <pagmo/archipelago.hpp>
+#include <pagmo/detail/affinity.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/island.hpp>
+#include <pagmo/pareto_archive.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/schwefel.hpp>
@@ -475,3 +481,258 @@ BOOST_AUTO_TEST_CASE(archipelago_throw_on_ctor)
 {
     BOOST_CHECK_THROW((archipelago{100u, de{}, pthrower_00{}, 1u}), std::invalid_argument);
 }
+
+BOOST_AUTO_TEST_CASE(archipelago_submit)
+{
+    using size_type = archipelago::size_type;
+    archipelago archi;
+    size_type idx = 0;
+    BOOST_CHECK(archi.get_n_pending() == 0u);
+    BOOST_CHECK(!archi.try_wait_any(idx));
+    BOOST_CHECK_THROW(archi.wait_any(), std::runtime_error);
+    BOOST_CHECK_THROW(archi.submit(0), std::out_of_range);
+    BOOST_CHECK_THROW(archi.submit_fevals(0, 10u), std::out_of_range);
+    BOOST_CHECK(archi.get_n_pending() == 0u);
+    // Heterogeneous islands, each resubmitted a different number of times.
+    archi.push_back(de{1u}, rosenbrock{}, 20u);
+    archi.push_back(pso{1u}, rosenbrock{10u}, 20u);
+    archi.push_back(de{5u}, schwefel{5u}, 20u);
+    std::vector<unsigned> counts(archi.size()), target{3u, 5u, 7u};
+    for (size_type i = 0; i < archi.size(); ++i) {
+        archi.submit(i, 2u);
+    }
+    BOOST_CHECK(archi.get_n_pending() == 3u);
+    while (archi.get_n_pending()) {
+        const auto i = archi.wait_any();
+        BOOST_CHECK(i < archi.size());
+        if (++counts[i] < target[i]) {
+            archi.submit(i, 2u);
+        }
+    }
+    BOOST_CHECK(counts == target);
+    BOOST_CHECK(!archi.try_wait_any(idx));
+    BOOST_CHECK_THROW(archi.wait_any(), std::runtime_error);
+    // The generations were actually run.
+    BOOST_CHECK_EQUAL(archi[0].get_population().get_problem().get_fevals(), 20u + 3u * 2u * 20u);
+    archi.wait_check();
+    // Budget in fevals.
+    const auto f0 = archi[0].get_population().get_problem().get_fevals();
+    archi.submit_fevals(0, 100u);
+    BOOST_CHECK_EQUAL(archi.wait_any(), 0u);
+    BOOST_CHECK_EQUAL(archi[0].get_population().get_problem().get_fevals() - f0, 100u);
+    archi.submit_fevals(0, 101u);
+    archi.wait();
+    BOOST_CHECK(archi.try_wait_any(idx));
+    BOOST_CHECK_EQUAL(idx, 0u);
+    BOOST_CHECK_EQUAL(archi[0].get_population().get_problem().get_fevals() - f0, 220u);
+    // A zero budget does not evolve.
+    archi.submit_fevals(1, 0u);
+    archi.submit(2, 0u);
+    std::vector<size_type> done{archi.wait_any(), archi.wait_any()};
+    std::sort(done.begin(), done.end());
+    BOOST_CHECK((done == std::vector<size_type>{1u, 2u}));
+    // Errors are stored in the island, the completion is signalled anyway.
+    archi.push_back(de{10u}, population{rosenbrock{}, 3u});
+    archi.submit(3);
+    BOOST_CHECK_EQUAL(archi.wait_any(), 3u);
+    BOOST_CHECK_THROW(archi[3].wait_check(), std::invalid_argument);
+    BOOST_CHECK(archi[3].status() == evolve_status::idle);
+    // Completions are transferred by moves, and not by copies.
+    archi.submit(0);
+    archi.submit(1);
+    archipelago archi2(std::move(archi));
+    BOOST_CHECK(archi.get_n_pending() == 0u);
+    BOOST_CHECK(archi2.get_n_pending() == 2u);
+    archipelago archi3(archi2);
+    BOOST_CHECK(archi3.get_n_pending() == 0u);
+    archi3 = std::move(archi2);
+    BOOST_CHECK(archi2.get_n_pending() == 0u);
+    BOOST_CHECK(archi3.get_n_pending() == 2u);
+    done = std::vector<size_type>{archi3.wait_any(), archi3.wait_any()};
+    std::sort(done.begin(), done.end());
+    BOOST_CHECK((done == std::vector<size_type>{0u, 1u}));
+    // The moved-from archipelago is still usable.
+    archi2.push_back(de{1u}, rosenbrock{}, 20u);
+    archi2.submit(0);
+    BOOST_CHECK_EQUAL(archi2.wait_any(), 0u);
+    // Moving does not allocate a new completion queue for the moved-from archipelago,
+    // which behaves as if its queue was empty.
+    idx = 42u;
+    BOOST_CHECK(!archi.try_wait_any(idx));
+    BOOST_CHECK_EQUAL(idx, 42u);
+    BOOST_CHECK_THROW(archi.wait_any(), std::runtime_error);
+    archi = std::move(archi3);
+    BOOST_CHECK(archi3.get_n_pending() == 0u);
+    BOOST_CHECK_THROW(archi3.wait_any(), std::runtime_error);
+    archi3.push_back(de{1u}, rosenbrock{}, 20u);
+    archi3.submit(0);
+    BOOST_CHECK_EQUAL(archi3.wait_any(), 0u);
+    archi.submit(1);
+    BOOST_CHECK_EQUAL(archi.wait_any(), 1u);
+}
+
+// An algorithm that runs until the island asks it to stop.
+struct algo_stop {
+    population evolve(const population &pop) const
+    {
+        while (!evolve_stop_requested()) {
+            std::this_thread::yield();
+        }
+        return pop;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(archipelago_cancel)
+{
+    archipelago archi{4u, algo_stop{}, rosenbrock{}, 10u};
+    archi.evolve(100u);
+    archi.cancel();
+    archi.wait_check();
+    BOOST_CHECK(archi.status() == evolve_status::idle);
+    archi.submit(0, 100u);
+    archi.submit_fevals(1, 100u);
+    archi.cancel();
+    std::vector<archipelago::size_type> done{archi.wait_any(), archi.wait_any()};
+    std::sort(done.begin(), done.end());
+    BOOST_CHECK((done == std::vector<archipelago::size_type>{0u, 1u}));
+    archi.wait_check();
+    archi.evolve(1u, evolve_limits{.01});
+    archi.wait_check();
+    // Limits apply to each island separately.
+    archi = archipelago{4u, de{1u}, rosenbrock{}, 10u};
+    archi.evolve(100u, evolve_limits{std::numeric_limits<double>::infinity(), 50u});
+    archi.wait_check();
+    for (const auto &isl : archi) {
+        BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 60u);
+    }
+    // The destructor cancels the ongoing evolutions.
+    {
+        archipelago archi2{4u, algo_stop{}, rosenbrock{}, 10u};
+        archi2.evolve(1000u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_snapshots)
+{
+    archipelago archi{5u, de{1u}, rosenbrock{}, 10u};
+    archi.evolve(2u);
+    archi.wait_check();
+    const auto snaps = archi.get_snapshots();
+    BOOST_CHECK_EQUAL(snaps.size(), 5u);
+    const auto ch_f = archi.get_champions_f();
+    const auto ch_x = archi.get_champions_x();
+    for (archipelago::size_type i = 0; i < archi.size(); ++i) {
+        BOOST_CHECK_EQUAL(snaps[i]->n_evolve, 2u);
+        BOOST_CHECK_EQUAL(snaps[i]->fevals, 30u);
+        BOOST_CHECK(snaps[i]->status == evolve_status::idle);
+        BOOST_CHECK(ch_f[i] == archi[i].get_population().champion_f());
+        BOOST_CHECK(ch_x[i] == archi[i].get_population().champion_x());
+        BOOST_CHECK(ch_f[i] == snaps[i]->champion_f);
+    }
+    // Multi-objective: the champions are not defined.
+    archi = archipelago{2u, de{}, zdt{}, 10u};
+    BOOST_CHECK_EQUAL(archi.get_snapshots().size(), 2u);
+    BOOST_CHECK_THROW(archi.get_champions_f(), std::invalid_argument);
+    BOOST_CHECK_THROW(archi.get_champions_x(), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_placement)
+{
+    archipelago archi{5u, de{1u}, rosenbrock{}, 10u};
+    archi.evolve(2u);
+    archi.set_placement(placement_policy::core);
+    auto pls = archi.get_placements();
+    BOOST_CHECK_EQUAL(pls.size(), 5u);
+#if defined(__linux__)
+    const auto topo = detail::numa_topology();
+    std::vector<unsigned> all_cpus;
+    for (const auto &nc : topo) {
+        all_cpus.insert(all_cpus.end(), nc.cpus.begin(), nc.cpus.end());
+    }
+    for (const auto &pl : pls) {
+        BOOST_CHECK_EQUAL(pl.cpus.size(), 1u);
+        BOOST_CHECK(pl.numa_node >= 0);
+        BOOST_CHECK(std::find(all_cpus.begin(), all_cpus.end(), pl.cpus[0]) != all_cpus.end());
+    }
+    if (all_cpus.size() >= 5u) {
+        // Each island has its own CPU.
+        for (decltype(pls.size()) i = 1; i < pls.size(); ++i) {
+            BOOST_CHECK(pls[i].cpus != pls[0].cpus);
+        }
+    }
+    archi.set_placement(placement_policy::numa);
+    pls = archi.get_placements();
+    for (decltype(pls.size()) i = 0; i < pls.size(); ++i) {
+        BOOST_CHECK(pls[i].cpus == topo[i % topo.size()].cpus);
+        BOOST_CHECK_EQUAL(pls[i].numa_node, topo[i % topo.size()].node);
+    }
+#endif
+    archi.set_placement(placement_policy::none);
+    for (const auto &pl : archi.get_placements()) {
+        BOOST_CHECK(pl.cpus.empty());
+        BOOST_CHECK_EQUAL(pl.numa_node, -1);
+    }
+    BOOST_CHECK_THROW(archi.set_placement(static_cast<placement_policy>(42)), std::invalid_argument);
+    // The evolutions queued before the placements went through.
+    archi.wait_check();
+    for (const auto &isl : archi) {
+        BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 30u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_pareto_archive)
+{
+    archipelago archi{3u, nsga2{5u}, zdt{1u, 10u}, 20u};
+    BOOST_CHECK(!archi.get_pareto_archive());
+    archi.set_pareto_archive(pareto_archive{15u});
+    // The islands added later share the archive.
+    archi.push_back(nsga2{5u}, zdt{1u, 10u}, 20u);
+    const auto ar = archi.get_pareto_archive();
+    BOOST_CHECK(ar);
+    BOOST_CHECK_EQUAL(ar->size(), 0u);
+    BOOST_CHECK_EQUAL(ar->get_capacity(), 15u);
+    archi.evolve(3u);
+    // Read the archive while the archipelago is evolving.
+    while (archi.status() == evolve_status::busy) {
+        BOOST_CHECK(ar->size() <= 15u);
+    }
+    archi.wait_check();
+    BOOST_CHECK(ar->size() > 0u && ar->size() <= 15u);
+    // The archived points are mutually non-dominated.
+    const auto f = ar->get_f();
+    for (const auto &f1 : f) {
+        for (const auto &f2 : f) {
+            BOOST_CHECK(!pareto_dominance(f1, f2));
+        }
+    }
+    // The archive is deep-copied with the archipelago.
+    auto archi2(archi);
+    BOOST_CHECK(archi2.get_pareto_archive() != ar);
+    BOOST_CHECK(archi2.get_pareto_archive()->get_xf() == ar->get_xf());
+    archi2.evolve();
+    archi2.wait_check();
+    BOOST_CHECK(archi.get_pareto_archive()->get_f() == f);
+    // Serialization.
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(archi);
+    }
+    archipelago archi3;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(archi3);
+    }
+    BOOST_CHECK_EQUAL(archi3.size(), 4u);
+    BOOST_CHECK(archi3.get_pareto_archive()->get_xf() == ar->get_xf());
+    // Once unset, the islands stop feeding the archive.
+    archi.unset_pareto_archive();
+    BOOST_CHECK(!archi.get_pareto_archive());
+    archi.evolve();
+    archi.wait_check();
+    BOOST_CHECK(ar->get_f() == f);
+    // Islands with different numbers of objectives cannot share an archive.
+    archi3.push_back(de{1u}, rosenbrock{}, 10u);
+    archi3.evolve();
+    BOOST_CHECK_THROW(archi3.wait_check(), std::invalid_argument);
+}
@@ -38,6 +38,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/bee_colony.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/ackley.hpp>
@@ -134,6 +135,36 @@ BOOST_AUTO_TEST_CASE(bee_colony_setters_getters_test)
     BOOST_CHECK_NO_THROW(user_algo.get_log());
 }
 
+BOOST_AUTO_TEST_CASE(bee_colony_batch_mode_test)
+{
+    problem prob{rosenbrock{10u}};
+    for (auto limit : {1u, 5u, 20u}) {
+        population pop1{prob, 20u, 23u};
+        bee_colony user_algo1{30u, limit, 23u};
+        user_algo1.set_verbosity(1u);
+        user_algo1.set_batch_mode(true);
+        BOOST_CHECK(user_algo1.get_batch_mode());
+        pop1 = user_algo1.evolve(pop1);
+        BOOST_CHECK(user_algo1.get_log().size() > 0u);
+
+        population pop2{prob, 20u, 23u};
+        bee_colony user_algo2{30u, limit, 23u};
+        user_algo2.set_verbosity(1u);
+        user_algo2.set_batch_mode(true);
+        user_algo2.set_bfe(bfe{3u});
+        BOOST_CHECK_EQUAL(user_algo2.get_bfe().get_n_threads(), 3u);
+        pop2 = user_algo2.evolve(pop2);
+        BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+        BOOST_CHECK(pop1.get_x() == pop2.get_x());
+        BOOST_CHECK(pop1.get_f() == pop2.get_f());
+        BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), pop2.get_problem().get_fevals());
+        // The fitnesses stored in the population are consistent with the decision vectors.
+        for (decltype(pop1.size()) i = 0u; i < pop1.size(); ++i) {
+            BOOST_CHECK(prob.fitness(pop1.get_x()[i]) == pop1.get_f()[i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(bee_colony_serialization_test)
 {
     // We test the serialization of a pagmo algorithm when constructed with bee_colony
@@ -142,6 +173,8 @@ BOOST_AUTO_TEST_CASE(bee_colony_serialization_test)
     population pop{prob, 10u, 23u};
     algorithm algo{bee_colony{10u, 10u, 23u}};
     algo.set_verbosity(1u); // allows the log to be filled
+    algo.extract<bee_colony>()->set_batch_mode(true);
+    algo.extract<bee_colony>()->set_bfe(bfe{2u});
     pop = algo.evolve(pop);
 
     // Store the string representation of p.
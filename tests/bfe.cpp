@@ -0,0 +1,139 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE bfe_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <pagmo/bfe.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A problem that is not thread safe.
+struct ts_none {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + x[1]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+// A problem throwing on a specific input.
+struct thrower {
+    vector_double fitness(const vector_double &x) const
+    {
+        if (x[0] == 42.) {
+            throw std::runtime_error("42");
+        }
+        return {x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {100.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(bfe_construction_test)
+{
+    BOOST_CHECK_EQUAL(bfe{}.get_n_threads(), 0u);
+    BOOST_CHECK_EQUAL(bfe{4u}.get_n_threads(), 4u);
+    BOOST_CHECK(bfe{}.get_name().find("auto") != std::string::npos);
+    BOOST_CHECK(bfe{4u}.get_name().find("4") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(bfe_eval_test)
+{
+    for (auto n_threads : {0u, 1u, 2u, 3u, 7u, 100u}) {
+        problem p{zdt{1u, 5u}}, p_seq{zdt{1u, 5u}};
+        vector_double dvs;
+        for (auto i = 0u; i < 21u; ++i) {
+            for (auto j = 0u; j < 5u; ++j) {
+                dvs.push_back((i + 1u) * (j + 1u) / 210.);
+            }
+        }
+        const auto fvs = bfe{n_threads}(p, dvs);
+        BOOST_CHECK_EQUAL(fvs.size(), 21u * 2u);
+        for (auto i = 0u; i < 21u; ++i) {
+            const auto f = p_seq.fitness(vector_double(dvs.data() + i * 5u, dvs.data() + (i + 1u) * 5u));
+            BOOST_CHECK((vector_double(fvs.data() + i * 2u, fvs.data() + (i + 1u) * 2u) == f));
+        }
+        // All the evaluations are accounted for in the original problem
+        BOOST_CHECK_EQUAL(p.get_fevals(), 21u);
+        // Evaluation into an existing buffer
+        vector_double fvs2(3u);
+        bfe{n_threads}.eval(p, dvs, fvs2);
+        BOOST_CHECK(fvs2 == fvs);
+        BOOST_CHECK_EQUAL(p.get_fevals(), 42u);
+        // Empty batch
+        BOOST_CHECK(bfe{n_threads}(p, vector_double{}).empty());
+        BOOST_CHECK_EQUAL(p.get_fevals(), 42u);
+    }
+    // Non thread-safe problems are evaluated sequentially
+    problem p{ts_none{}};
+    BOOST_CHECK((bfe{4u}(p, {1., 2., 3., 4.}) == vector_double{3., 7.}));
+    BOOST_CHECK_EQUAL(p.get_fevals(), 2u);
+    // Invalid buffer size
+    BOOST_CHECK_THROW(bfe{4u}(p, {1., 2., 3.}), std::invalid_argument);
+    // Errors in the evaluations are propagated
+    problem p2{thrower{}};
+    BOOST_CHECK_THROW(bfe{4u}(p2, {1., 2., 42., 4.}), std::runtime_error);
+    BOOST_CHECK_THROW(bfe{1u}(p2, {1., 2., 42., 4.}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(bfe_serialization_test)
+{
+    bfe b{5u};
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(b);
+    }
+    b = bfe{};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(b);
+    }
+    BOOST_CHECK_EQUAL(b.get_n_threads(), 5u);
+}
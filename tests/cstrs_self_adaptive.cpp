@@ -33,6 +33,7 @@
 #include <boost/test/floating_point_comparison.hpp>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <string>
 
 #include <pagmo/algorithm.hpp>
@@ -64,7 +65,8 @@ BOOST_AUTO_TEST_CASE(penalized_problem_construction)
     BOOST_CHECK_EQUAL(udp_p.m_f_hat_down.size(), udp.get_nf());
     BOOST_CHECK_EQUAL(udp_p.m_f_hat_up.size(), udp.get_nf());
     BOOST_CHECK_EQUAL(udp_p.m_f_hat_round.size(), udp.get_nf());
-    BOOST_CHECK_EQUAL(udp_p.m_fitness_map.size(), NP);
+    BOOST_CHECK_EQUAL(udp_p.m_cache.size(), NP);
+    BOOST_CHECK(problem{udp_p}.get_thread_safety() == thread_safety::none);
     // We also test get bounds here
     BOOST_CHECK(udp_p.get_bounds() == udp.get_bounds());
     // And the debug stream operator
@@ -94,6 +96,62 @@ BOOST_AUTO_TEST_CASE(penalized_problem_fitness_cache)
     new_pop.set_x(1, vector_double(13, 0.5));
     // We check the cache was hit -> not increasing the fevals
     BOOST_CHECK_EQUAL(udp_p.m_pop_ptr->get_problem().get_fevals(), NP + 1);
+    // After an update only the reference population is in the cache
+    auto udp_ptr = new_pop.get_problem().extract<penalized_udp>();
+    BOOST_CHECK_EQUAL(udp_ptr->m_cache.size(), NP + 1);
+    udp_ptr->update();
+    BOOST_CHECK_EQUAL(udp_ptr->m_cache.size(), NP);
+    new_pop.set_x(1, vector_double(13, 0.5));
+    BOOST_CHECK_EQUAL(udp_p.m_pop_ptr->get_problem().get_fevals(), NP + 2);
+}
+
+BOOST_AUTO_TEST_CASE(fitness_cache_test)
+{
+    detail::fitness_cache cache;
+    BOOST_CHECK(cache.find(vector_double{}) == nullptr);
+    cache.reset(2u, 3u, 100u);
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+    BOOST_CHECK_EQUAL(cache.max_size(), 100u);
+    BOOST_CHECK(cache.find({1., 2.}) == nullptr);
+    // Insertions and lookups, also across the growth of the table
+    for (auto i = 0; i < 100; ++i) {
+        BOOST_CHECK(cache.insert({1. * i, 2.}, {1. * i, 2. * i, 3. * i}));
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 100u);
+    for (auto i = 0; i < 100; ++i) {
+        auto f = cache.find({1. * i, 2.});
+        BOOST_CHECK(f != nullptr);
+        BOOST_CHECK((vector_double(f, f + 3) == vector_double{1. * i, 2. * i, 3. * i}));
+    }
+    BOOST_CHECK(cache.find({1., 3.}) == nullptr);
+    // The cache is full: new entries are rejected, existing ones overwritten
+    BOOST_CHECK(!cache.insert({1., 3.}, {0., 0., 0.}));
+    BOOST_CHECK(cache.find({1., 3.}) == nullptr);
+    BOOST_CHECK(cache.insert({1., 2.}, {4., 5., 6.}));
+    BOOST_CHECK_EQUAL(cache.find({1., 2.})[0], 4.);
+    BOOST_CHECK_EQUAL(cache.size(), 100u);
+    // Clearing invalidates everything
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+    BOOST_CHECK(cache.find({1., 2.}) == nullptr);
+    BOOST_CHECK(cache.insert({1., 3.}, {0., 0., 0.}));
+    BOOST_CHECK(cache.find({1., 3.}) != nullptr);
+    BOOST_CHECK(cache.find({1., 2.}) == nullptr);
+    // Nans are equal to each other, zeroes of different sign too
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    BOOST_CHECK(cache.insert({nan, -0.}, {1., 1., 1.}));
+    BOOST_CHECK(cache.find({-nan, 0.}) != nullptr);
+    BOOST_CHECK_EQUAL(cache.find({-nan, 0.})[0], 1.);
+    BOOST_CHECK(cache.find({nan, 1.}) == nullptr);
+    // A zero-sized cache never stores anything
+    cache.reset(2u, 3u, 0u);
+    BOOST_CHECK(!cache.insert({1., 2.}, {1., 2., 3.}));
+    BOOST_CHECK(cache.find({1., 2.}) == nullptr);
+    // Bound on the number of slots
+    BOOST_CHECK_EQUAL(detail::fitness_cache::n_slots(0u), 16u);
+    BOOST_CHECK_EQUAL(detail::fitness_cache::n_slots(8u), 16u);
+    BOOST_CHECK_EQUAL(detail::fitness_cache::n_slots(9u), 32u);
+    BOOST_CHECK_EQUAL(detail::fitness_cache::n_slots(1000u), 2048u);
 }
 
 BOOST_AUTO_TEST_CASE(cstrs_self_adaptive_construction)
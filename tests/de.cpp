@@ -32,10 +32,13 @@ see https://www.gnu.org/licenses/. */
 #include <boost/lexical_cast.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <string>
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/island.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
@@ -172,3 +175,97 @@ BOOST_AUTO_TEST_CASE(de_serialization_test)
         BOOST_CHECK_CLOSE(std::get<4>(before_log[i]), std::get<4>(after_log[i]), 1e-8);
     }
 }
+
+// A problem whose evaluation fails for some decision vectors.
+struct de_throwing_udp {
+    vector_double fitness(const vector_double &x) const
+    {
+        if (x[0] > .9) {
+            throw std::runtime_error("failed evaluation");
+        }
+        return {x[0] * x[0] + x[1] * x[1]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(de_steady_state_test)
+{
+    de uda{50u, 0.8, 0.9, 2u, 0., 0., 23u};
+    BOOST_CHECK_EQUAL(uda.get_steady_state(), 0u);
+    BOOST_CHECK(uda.get_extra_info().find("Steady-state") == std::string::npos);
+    uda.set_steady_state(4u);
+    BOOST_CHECK_EQUAL(uda.get_steady_state(), 4u);
+    BOOST_CHECK(uda.get_extra_info().find("Steady-state evaluations: 4") != std::string::npos);
+
+    // The fevals budget is the same as in the generational mode, for any number of in-flight evaluations.
+    for (auto n : {1u, 3u, 4u, 20u, 50u}) {
+        population pop{rosenbrock{5u}, 20u, 42u};
+        const auto f0 = pop.champion_f()[0];
+        const auto fevals0 = pop.get_problem().get_fevals();
+        uda.set_steady_state(n);
+        uda.set_verbosity(10u);
+        pop = uda.evolve(pop);
+        BOOST_CHECK_EQUAL(pop.get_problem().get_fevals() - fevals0, 50u * 20u);
+        BOOST_CHECK(pop.champion_f()[0] < f0);
+        // One log line every 10 generations.
+        BOOST_CHECK_EQUAL(uda.get_log().size(), 5u);
+        BOOST_CHECK_EQUAL(std::get<1>(uda.get_log().back()), 41u * 20u);
+        // The population is consistent with the fitness values.
+        for (decltype(pop.size()) i = 0u; i < pop.size(); ++i) {
+            BOOST_CHECK(pop.get_f()[i] == pop.get_problem().fitness(pop.get_x()[i]));
+        }
+    }
+
+    // The stopping criteria are checked every population size evaluations.
+    {
+        population pop{rosenbrock{2u}, 10u, 42u};
+        de uda2{1000u, 0.8, 0.9, 2u, 1e-3, 1e-3, 23u};
+        uda2.set_steady_state(4u);
+        const auto fevals0 = pop.get_problem().get_fevals();
+        pop = uda2.evolve(pop);
+        const auto fevals = pop.get_problem().get_fevals() - fevals0;
+        BOOST_CHECK(fevals < 1000u * 10u);
+    }
+
+    // Errors in the evaluations are propagated.
+    {
+        population pop{de_throwing_udp{}};
+        for (auto i = 0u; i < 10u; ++i) {
+            pop.push_back({.1 * i / 2., .5});
+        }
+        uda.set_steady_state(4u);
+        BOOST_CHECK_THROW(uda.evolve(pop), std::runtime_error);
+    }
+
+    // The fevals budget of an island is enforced in the steady-state mode.
+    {
+        uda.set_steady_state(3u);
+        de uda2{1000u, 0.8, 0.9, 2u, 0., 0., 23u};
+        uda2.set_steady_state(3u);
+        island isl{uda2, rosenbrock{5u}, 20u, 42u};
+        isl.evolve(1u, evolve_limits{std::numeric_limits<double>::infinity(), 105u});
+        isl.wait_check();
+        const auto fevals = isl.get_population().get_problem().get_fevals() - 20u;
+        BOOST_CHECK(fevals >= 105u);
+        BOOST_CHECK(fevals <= 108u);
+    }
+
+    // Serialization.
+    {
+        algorithm algo{uda};
+        std::stringstream ss;
+        {
+            cereal::JSONOutputArchive oarchive(ss);
+            oarchive(algo);
+        }
+        algo = algorithm{null_algorithm{}};
+        {
+            cereal::JSONInputArchive iarchive(ss);
+            iarchive(algo);
+        }
+        BOOST_CHECK_EQUAL(algo.extract<de>()->get_steady_state(), 3u);
+    }
+}
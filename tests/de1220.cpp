@@ -36,6 +36,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/de1220.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
@@ -139,6 +140,41 @@ BOOST_AUTO_TEST_CASE(setters_getters_test)
     BOOST_CHECK_NO_THROW(user_algo.get_log());
 }
 
+BOOST_AUTO_TEST_CASE(generational_test)
+{
+    problem prob{rosenbrock{10u}};
+    for (auto variant_adptv : {1u, 2u}) {
+        // Sequential mode.
+        population pop1{prob, 20u, 23u};
+        de1220 user_algo1{50u, de1220_statics<void>::allowed_variants, variant_adptv, 1e-6, 1e-6, false, 23u};
+        user_algo1.set_verbosity(1u);
+        pop1 = user_algo1.evolve(pop1);
+        // Generational mode, sequential and parallel evaluation.
+        population pop2{prob, 20u, 23u};
+        de1220 user_algo2{50u, de1220_statics<void>::allowed_variants, variant_adptv, 1e-6, 1e-6, false, 23u};
+        user_algo2.set_verbosity(1u);
+        user_algo2.set_generational(true);
+        BOOST_CHECK(user_algo2.get_generational());
+        pop2 = user_algo2.evolve(pop2);
+        population pop3{prob, 20u, 23u};
+        de1220 user_algo3{50u, de1220_statics<void>::allowed_variants, variant_adptv, 1e-6, 1e-6, false, 23u};
+        user_algo3.set_verbosity(1u);
+        user_algo3.set_generational(true);
+        user_algo3.set_bfe(bfe{3u});
+        BOOST_CHECK_EQUAL(user_algo3.get_bfe().get_n_threads(), 3u);
+        pop3 = user_algo3.evolve(pop3);
+        BOOST_CHECK(user_algo2.get_log() == user_algo3.get_log());
+        BOOST_CHECK(pop2.get_x() == pop3.get_x());
+        BOOST_CHECK(pop2.get_f() == pop3.get_f());
+        BOOST_CHECK_EQUAL(pop2.get_problem().get_fevals(), pop3.get_problem().get_fevals());
+        // With jDE the generational mode does not change the results.
+        if (variant_adptv == 1u) {
+            BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+            BOOST_CHECK(pop1.get_x() == pop2.get_x());
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(serialization_test)
 {
     // Make one evolution
@@ -148,6 +184,8 @@ BOOST_AUTO_TEST_CASE(serialization_test)
     std::iota(mutation_variants.begin(), mutation_variants.end(), 1u);
     algorithm algo(de1220{10000u, mutation_variants, 1, 1e-6, 1e-6, false, 41u});
     algo.set_verbosity(1u);
+    algo.extract<de1220>()->set_generational(true);
+    algo.extract<de1220>()->set_bfe(bfe{2u});
     pop = algo.evolve(pop);
 
     // Store the string representation of p.
@@ -0,0 +1,207 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+#define BOOST_TEST_MODULE fd_gradient_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <pagmo/bfe.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/fd_gradient.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/luksan_vlcek1.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/gradients_and_hessians.hpp>
+
+using namespace pagmo;
+
+// A black-box problem without gradient.
+struct black_box {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] * x[0] + std::sin(x[1]) * x[2], x[0] - x[2], std::exp(x[1])};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1., -1., -1.}, {1., 1., 1.}};
+    }
+    vector_double::size_type get_nic() const
+    {
+        return 2u;
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+// A block-diagonal problem with sparse gradient: f_i = x_{3i}^2 + sin(x_{3i+1}) - x_{3i+2}.
+struct banded {
+    vector_double fitness(const vector_double &x) const
+    {
+        vector_double retval(x.size() / 3u);
+        for (decltype(retval.size()) i = 0u; i < retval.size(); ++i) {
+            retval[i] = x[3u * i] * x[3u * i] + std::sin(x[3u * i + 1u]) - x[3u * i + 2u];
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(48u, -1.), vector_double(48u, 1.)};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 16u;
+    }
+    sparsity_pattern gradient_sparsity() const
+    {
+        sparsity_pattern retval;
+        for (vector_double::size_type i = 0u; i < 16u; ++i) {
+            retval.emplace_back(i, 3u * i);
+            retval.emplace_back(i, 3u * i + 1u);
+            retval.emplace_back(i, 3u * i + 2u);
+        }
+        return retval;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(fd_gradient_construction_test)
+{
+    problem p0{fd_gradient{}};
+    problem p1{fd_gradient{null_problem{}}};
+    BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(p0), boost::lexical_cast<std::string>(p1));
+    BOOST_CHECK(p0.has_gradient());
+    // The perturbed decision vectors are evaluated serially by default.
+    BOOST_CHECK_EQUAL(fd_gradient{}.get_bfe().get_n_threads(), 1u);
+    BOOST_CHECK_THROW((fd_gradient{black_box{}, 0.}), std::invalid_argument);
+    BOOST_CHECK_THROW((fd_gradient{black_box{}, -1e-8}), std::invalid_argument);
+    BOOST_CHECK_THROW((fd_gradient{black_box{}, std::nan("")}), std::invalid_argument);
+    fd_gradient udp{black_box{}, 1e-7, bfe{2u}};
+    BOOST_CHECK_EQUAL(udp.get_dx(), 1e-7);
+    BOOST_CHECK_EQUAL(udp.get_bfe().get_n_threads(), 2u);
+    BOOST_CHECK_EQUAL(udp.get_n_colours(), 3u);
+    problem p{udp};
+    BOOST_CHECK(p.has_gradient());
+    BOOST_CHECK(!p.has_gradient_sparsity());
+    BOOST_CHECK(!p.has_hessians());
+    BOOST_CHECK_EQUAL(p.get_nic(), 2u);
+    BOOST_CHECK(p.get_thread_safety() == thread_safety::none);
+    BOOST_CHECK(p.get_name().find("[finite-difference gradient]") != std::string::npos);
+    BOOST_CHECK(p.get_extra_info().find("Column groups: 3") != std::string::npos);
+    BOOST_CHECK(p.extract<fd_gradient>()->get_inner_problem().extract<black_box>() != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(fd_gradient_dense_test)
+{
+    // On a dense problem, the result is the one of estimate_gradient()
+    problem bb{black_box{}};
+    problem p{fd_gradient{bb}};
+    const vector_double x = {0.1, -0.3, 0.7};
+    BOOST_CHECK(p.gradient(x) == estimate_gradient([&bb](const vector_double &y) { return bb.fitness(y); }, x));
+    BOOST_CHECK(p.fitness(x) == bb.fitness(x));
+    // The evaluations are counted in the inner problem
+    BOOST_CHECK_EQUAL(p.extract<fd_gradient>()->get_inner_problem().get_fevals(), 7u);
+    BOOST_CHECK_EQUAL(p.get_gevals(), 1u);
+    // The inner gradient, if present, is replaced
+    problem r{rosenbrock{5u}};
+    problem pr{fd_gradient{r}};
+    const vector_double xr = {0.1, 0.2, 0.3, 0.4, 0.5};
+    const auto g = r.gradient(xr), g_fd = pr.gradient(xr);
+    BOOST_CHECK(g != g_fd);
+    for (decltype(g.size()) i = 0u; i < g.size(); ++i) {
+        BOOST_CHECK(std::abs(g[i] - g_fd[i]) < 1e-5);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fd_gradient_sparse_test)
+{
+    // The sparsity of the inner problem is exploited
+    problem bp{banded{}};
+    BOOST_CHECK_EQUAL(fd_gradient{bp}.get_n_colours(), 3u);
+    problem pb{fd_gradient{bp}};
+    vector_double y(48u, 0.25);
+    const auto gb = pb.gradient(y);
+    BOOST_CHECK_EQUAL(pb.extract<fd_gradient>()->get_inner_problem().get_fevals(), 6u);
+    for (decltype(gb.size()) k = 0u; k < gb.size(); ++k) {
+        const auto j = pb.gradient_sparsity()[k].second % 3u;
+        BOOST_CHECK(std::abs(gb[k] - (j == 0u ? 0.5 : (j == 1u ? std::cos(0.25) : -1.))) < 1e-6);
+    }
+    // A dense row (here, the objective) makes all the columns interact
+    problem lv{luksan_vlcek1{100u}};
+    fd_gradient udp{lv, 1e-8, bfe{1u}};
+    BOOST_CHECK_EQUAL(udp.get_n_colours(), 100u);
+    problem p{udp};
+    BOOST_CHECK(p.has_gradient_sparsity());
+    BOOST_CHECK(p.gradient_sparsity() == lv.gradient_sparsity());
+    vector_double x(100u);
+    for (decltype(x.size()) i = 0u; i < x.size(); ++i) {
+        x[i] = 0.5 + 0.01 * static_cast<double>(i);
+    }
+    const auto g = lv.gradient(x), g_fd = p.gradient(x);
+    BOOST_CHECK_EQUAL(g.size(), g_fd.size());
+    for (decltype(g.size()) i = 0u; i < g.size(); ++i) {
+        BOOST_CHECK(std::abs(g[i] - g_fd[i]) < 1e-4 * std::max(1., std::abs(g[i])));
+    }
+    BOOST_CHECK_EQUAL(p.extract<fd_gradient>()->get_inner_problem().get_fevals(), 2u * udp.get_n_colours());
+    // The result does not depend on the number of threads
+    for (auto n_threads : {2u, 4u, 0u}) {
+        problem pt{fd_gradient{lv, 1e-8, bfe{n_threads}}};
+        BOOST_CHECK(pt.gradient(x) == g_fd);
+        BOOST_CHECK_EQUAL(pt.extract<fd_gradient>()->get_inner_problem().get_fevals(), 2u * udp.get_n_colours());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fd_gradient_serialization_test)
+{
+    problem p{fd_gradient{hock_schittkowsky_71{}, 1e-6, bfe{3u}}};
+    const vector_double x = {1., 2., 3., 4.};
+    const auto before_g = p.gradient(x);
+    std::stringstream ss;
+    auto before = boost::lexical_cast<std::string>(p);
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(p);
+    }
+    p = problem{null_problem{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(p);
+    }
+    auto after = boost::lexical_cast<std::string>(p);
+    BOOST_CHECK_EQUAL(before, after);
+    BOOST_CHECK_EQUAL(p.extract<fd_gradient>()->get_bfe().get_n_threads(), 3u);
+    BOOST_CHECK(p.gradient(x) == before_g);
+}
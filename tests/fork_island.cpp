@@ -0,0 +1,266 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE fork_island_test
+// NOTE: the test executable is also the worker executable of the fork
+// islands, so we need our own main() (see the bottom of the file).
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/archipelago.hpp>
+#include <pagmo/evolve_limits.hpp>
+#include <pagmo/island.hpp>
+#include <pagmo/islands/fork_island.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A problem which does not provide any thread safety guarantee.
+struct unsafe_prob {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] * x[0] + x[1] * x[1]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1., -1.}, {1., 1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+
+PAGMO_REGISTER_PROBLEM(unsafe_prob)
+
+// An algorithm which kills the worker process.
+struct algo_crash {
+    population evolve(const population &) const
+    {
+        std::_Exit(1);
+    }
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+
+PAGMO_REGISTER_ALGORITHM(algo_crash)
+
+// An algorithm which takes a long time.
+struct algo_slow {
+    population evolve(const population &pop) const
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(30));
+        return pop;
+    }
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+
+PAGMO_REGISTER_ALGORITHM(algo_slow)
+
+BOOST_AUTO_TEST_CASE(fork_island_basic)
+{
+    fork_island::resize_pool(2u);
+    BOOST_CHECK_EQUAL(fork_island::get_pool_size(), 2u);
+    BOOST_CHECK_THROW(fork_island::resize_pool(0u), std::invalid_argument);
+    BOOST_CHECK_EQUAL(fork_island::get_pool_size(), 2u);
+    island isl{fork_island{}, de{10}, rosenbrock{}, 20};
+    BOOST_CHECK(isl.get_name() == "Fork island");
+    BOOST_CHECK(isl.get_extra_info().find("Pool size: 2") != std::string::npos);
+    BOOST_CHECK(isl.get_extra_info().find("Worker executable: " + fork_island::get_worker_executable())
+                != std::string::npos);
+    const auto f0 = isl.get_population().champion_f()[0];
+    isl.evolve();
+    isl.wait_check();
+    // The evolved population is transferred back, fevals included.
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 220u);
+    BOOST_CHECK(isl.get_population().champion_f()[0] <= f0);
+    // Serialization roundtrip.
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(isl);
+    }
+    island isl2;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(isl2);
+    }
+    BOOST_CHECK(isl2.get_name() == "Fork island");
+}
+
+BOOST_AUTO_TEST_CASE(fork_island_unsafe)
+{
+    // The thread island refuses problems which are not thread-safe,
+    // the fork island does not need any guarantee.
+    island tisl{thread_island{}, de{5}, unsafe_prob{}, 10};
+    tisl.evolve();
+    BOOST_CHECK_THROW(tisl.wait_check(), std::invalid_argument);
+    island fisl{fork_island{}, de{5}, unsafe_prob{}, 10};
+    fisl.evolve(3);
+    BOOST_CHECK_NO_THROW(fisl.wait_check());
+    BOOST_CHECK_EQUAL(fisl.get_population().get_problem().get_fevals(), 160u);
+}
+
+BOOST_AUTO_TEST_CASE(fork_island_errors)
+{
+    // Error in the worker process: de needs at least 5 individuals.
+    island isl{fork_island{}, de{}, rosenbrock{}, 3};
+    isl.evolve();
+    BOOST_CHECK_EXCEPTION(isl.wait_check(), std::runtime_error, [](const std::runtime_error &e) {
+        return std::string(e.what()).find("at least 5 individuals") != std::string::npos;
+    });
+    // The worker survived the error and can be reused.
+    isl.set_population(population{rosenbrock{}, 10});
+    isl.evolve();
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+    // Crash of the worker process.
+    const auto n_workers = fork_island::get_worker_pids().size();
+    island isl_crash{fork_island{}, algo_crash{}, rosenbrock{}, 10};
+    isl_crash.evolve();
+    BOOST_CHECK_EXCEPTION(isl_crash.wait_check(), std::runtime_error, [](const std::runtime_error &e) {
+        return std::string(e.what()).find("terminated unexpectedly") != std::string::npos;
+    });
+    // The dead worker was removed from the pool.
+    BOOST_CHECK(fork_island::get_worker_pids().size() < n_workers + 1u);
+    // New workers are spawned as needed.
+    isl.evolve();
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+    // Missing worker executable.
+    const auto exe = fork_island::get_worker_executable();
+    BOOST_CHECK_THROW(fork_island::set_worker_executable(""), std::invalid_argument);
+    fork_island::set_worker_executable("pagmo_fork_island_no_such_worker");
+    BOOST_CHECK(fork_island::get_worker_executable() == "pagmo_fork_island_no_such_worker");
+    isl.evolve();
+    BOOST_CHECK_EXCEPTION(isl.wait_check(), std::runtime_error, [](const std::runtime_error &e) {
+        return std::string(e.what()).find("could not be found") != std::string::npos;
+    });
+    fork_island::set_worker_executable("/pagmo_fork_island_no_such_worker");
+    isl.evolve();
+    BOOST_CHECK_THROW(isl.wait_check(), std::runtime_error);
+    fork_island::set_worker_executable(exe);
+    isl.evolve();
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+}
+
+BOOST_AUTO_TEST_CASE(fork_island_stop)
+{
+    // The timeout interrupts the evolution: the worker is killed,
+    // and the population is not modified.
+    island isl{fork_island{}, algo_slow{}, rosenbrock{}, 10};
+    const auto start = std::chrono::steady_clock::now();
+    isl.evolve(1, evolve_limits{.5});
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+    BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(20));
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 10u);
+    // The pool is still usable.
+    isl.set_algorithm(algorithm{de{2}});
+    isl.evolve();
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 30u);
+}
+
+BOOST_AUTO_TEST_CASE(fork_island_worker_main)
+{
+    const char *args0[] = {"foo"};
+    BOOST_CHECK(!fork_island::worker_main(1, args0));
+    const char *args1[] = {"foo", "bar"};
+    BOOST_CHECK(!fork_island::worker_main(2, args1));
+    const char *args2[] = {"foo", "fd://"};
+    BOOST_CHECK(!fork_island::worker_main(2, args2));
+    const char *args3[] = {"foo", "fd://1a"};
+    BOOST_CHECK(!fork_island::worker_main(2, args3));
+}
+
+BOOST_AUTO_TEST_CASE(fork_island_pool)
+{
+    fork_island::shutdown_pool();
+    fork_island::resize_pool(1u);
+    BOOST_CHECK(fork_island::get_worker_pids().empty());
+    island isl{fork_island{}, de{2}, rosenbrock{}, 10};
+    isl.evolve();
+    isl.wait_check();
+    const auto pids = fork_island::get_worker_pids();
+    BOOST_CHECK_EQUAL(pids.size(), 1u);
+    // The same worker is reused.
+    isl.evolve(5);
+    isl.wait_check();
+    BOOST_CHECK(fork_island::get_worker_pids() == pids);
+    // Shutdown and restart.
+    fork_island::shutdown_pool();
+    BOOST_CHECK(fork_island::get_worker_pids().empty());
+    isl.evolve();
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(fork_island::get_worker_pids().size(), 1u);
+    BOOST_CHECK(fork_island::get_worker_pids() != pids);
+    // Shrinking the pool.
+    fork_island::resize_pool(4u);
+    archipelago archi{4u, fork_island{}, de{5}, rosenbrock{}, 10};
+    archi.evolve(2);
+    archi.wait_check();
+    BOOST_CHECK(fork_island::get_worker_pids().size() <= 4u);
+    fork_island::resize_pool(1u);
+    BOOST_CHECK(fork_island::get_worker_pids().size() <= 1u);
+    for (const auto &isl2 : archi) {
+        BOOST_CHECK_EQUAL(isl2.get_population().get_problem().get_fevals(), 110u);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (fork_island::worker_main(argc, argv)) {
+        return 0;
+    }
+    fork_island::set_worker_executable(argv[0]);
+    return boost::unit_test::unit_test_main(&init_unit_test, argc, argv);
+}
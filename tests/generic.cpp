@@ -29,9 +29,13 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE generic_utilities_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <random>
 #include <stdexcept>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <pagmo/io.hpp>
 #include <pagmo/rng.hpp>
@@ -197,9 +201,78 @@ BOOST_AUTO_TEST_CASE(kNN_test)
             = {{1u, 2u, 3u}, {0u, 2u, 3u}, {1u, 3u, 0u}, {2u, 4u, 1u}, {3u, 2u, 1u}};
         BOOST_CHECK(kNN(points, 3u) == res);
     }
+    // Ties are broken by index, k larger than the number of neighbours, NaNs are the farthest
+    {
+        std::vector<vector_double> points = {{0, 0}, {1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+        std::vector<std::vector<vector_double::size_type>> res
+            = {{1u, 2u, 3u, 4u}, {0u, 2u, 4u, 3u}, {0u, 1u, 3u, 4u}, {0u, 2u, 4u, 1u}, {0u, 1u, 3u, 2u}};
+        BOOST_CHECK(kNN(points, 10u) == res);
+        points[2][1] = std::numeric_limits<double>::quiet_NaN();
+        BOOST_CHECK((kNN(points, 4u)[0] == std::vector<vector_double::size_type>{1u, 3u, 4u, 2u}));
+    }
+    // k = 0
+    {
+        std::vector<vector_double> points = {{1, 1}, {2, 2}};
+        std::vector<std::vector<vector_double::size_type>> res = {{}, {}};
+        BOOST_CHECK(kNN(points, 0u) == res);
+    }
     // throws
     {
         std::vector<vector_double> points = {{1, 1}, {2, 2}, {2, 3, 4}};
         BOOST_CHECK_THROW(kNN(points, 3u), std::invalid_argument);
     }
 }
+
+BOOST_AUTO_TEST_CASE(kNN_large_test)
+{
+    // Reference implementation: full sort on (distance, index).
+    auto naive = [](const std::vector<vector_double> &points, vector_double::size_type k) {
+        std::vector<std::vector<vector_double::size_type>> retval;
+        for (decltype(points.size()) i = 0u; i < points.size(); ++i) {
+            std::vector<std::pair<double, vector_double::size_type>> d;
+            for (decltype(points.size()) j = 0u; j < points.size(); ++j) {
+                if (j != i) {
+                    double dist = 0.;
+                    for (decltype(points[i].size()) l = 0u; l < points[i].size(); ++l) {
+                        dist += (points[i][l] - points[j][l]) * (points[i][l] - points[j][l]);
+                    }
+                    d.emplace_back(dist, j);
+                }
+            }
+            std::sort(d.begin(), d.end());
+            retval.emplace_back();
+            for (decltype(d.size()) j = 0u; j < std::min(k, d.size()); ++j) {
+                retval.back().push_back(d[j].second);
+            }
+        }
+        return retval;
+    };
+    detail::random_engine_type r_engine(32u);
+    std::uniform_real_distribution<double> drng(0., 1.);
+    // Random points in low dimension (kd-tree) and in higher dimension (brute force).
+    for (auto M : {1u, 2u, 3u, 8u}) {
+        std::vector<vector_double> points(1500u, vector_double(M));
+        for (auto &p : points) {
+            for (auto &x : p) {
+                x = drng(r_engine);
+            }
+        }
+        auto res = naive(points, 10u);
+        BOOST_CHECK(kNN(points, 10u) == res);
+        BOOST_CHECK(kNN(points, 10u, 4u) == res);
+        BOOST_CHECK(kNN(points, 10u, 0u) == res);
+    }
+    // A grid, with many ties and duplicated points.
+    {
+        std::vector<vector_double> points;
+        for (auto i = 0; i < 20; ++i) {
+            for (auto j = 0; j < 20; ++j) {
+                points.push_back({i / 19., j / 19., 0.});
+                points.push_back({i / 19., j / 19., 0.});
+            }
+        }
+        auto res = naive(points, 12u);
+        BOOST_CHECK(kNN(points, 12u) == res);
+        BOOST_CHECK(kNN(points, 12u, 3u) == res);
+    }
+}
@@ -29,8 +29,12 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE generic_utilities_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <random>
 #include <stdexcept>
+#include <vector>
 
 #include <pagmo/io.hpp>
 #include <pagmo/rng.hpp>
@@ -149,4 +153,124 @@ BOOST_AUTO_TEST_CASE(estimate_gradient_test)
     for (unsigned i = 0u; i < res.size(); ++i) {
         BOOST_CHECK_CLOSE(gh[i], res[i], 1e-11);
     }
-}
\ No newline at end of file
+}
+// A banded problem: f_i = x_i^2 + sin(x_{i+1}) - x_{i+2}.
+struct banded_problem {
+    vector_double fitness(const vector_double &dv) const
+    {
+        vector_double retval(dv.size() - 2u);
+        for (decltype(retval.size()) i = 0u; i < retval.size(); ++i) {
+            retval[i] = dv[i] * dv[i] + std::sin(dv[i + 1u]) - dv[i + 2u];
+        }
+        return retval;
+    }
+    static sparsity_pattern sparsity(vector_double::size_type n)
+    {
+        sparsity_pattern retval;
+        for (decltype(n) i = 0u; i < n - 2u; ++i) {
+            retval.emplace_back(i, i);
+            retval.emplace_back(i, i + 1u);
+            retval.emplace_back(i, i + 2u);
+        }
+        return retval;
+    }
+};
+
+// Checks that no two columns with the same colour have a non-zero in the same row.
+static bool valid_colouring(const sparsity_pattern &sp, const std::vector<vector_double::size_type> &colours)
+{
+    for (const auto &a : sp) {
+        for (const auto &b : sp) {
+            if (a.first == b.first && a.second != b.second && colours[a.second] == colours[b.second]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(column_colouring_test)
+{
+    // Empty cases
+    BOOST_CHECK(column_colouring({}, 0u).empty());
+    BOOST_CHECK((column_colouring({}, 3u) == std::vector<vector_double::size_type>{0u, 0u, 0u}));
+    // Diagonal: a single colour
+    BOOST_CHECK((column_colouring({{0u, 0u}, {1u, 1u}, {2u, 2u}}, 3u)
+                 == std::vector<vector_double::size_type>{0u, 0u, 0u}));
+    // Dense: one colour per column, in order
+    sparsity_pattern dense;
+    for (vector_double::size_type i = 0u; i < 3u; ++i) {
+        for (vector_double::size_type j = 0u; j < 5u; ++j) {
+            dense.emplace_back(i, j);
+        }
+    }
+    BOOST_CHECK((column_colouring(dense, 5u) == std::vector<vector_double::size_type>{0u, 1u, 2u, 3u, 4u}));
+    // Banded: as many colours as the bandwidth
+    const auto sp = banded_problem::sparsity(100u);
+    const auto colours = column_colouring(sp, 100u);
+    BOOST_CHECK_EQUAL(colours.size(), 100u);
+    BOOST_CHECK(valid_colouring(sp, colours));
+    BOOST_CHECK_EQUAL(*std::max_element(colours.begin(), colours.end()), 2u);
+    // Random patterns
+    detail::random_engine_type r_engine(32u);
+    std::uniform_int_distribution<vector_double::size_type> dist(0u, 29u);
+    for (auto k = 0; k < 20; ++k) {
+        sparsity_pattern rsp;
+        for (auto n = 0; n < 40; ++n) {
+            rsp.emplace_back(dist(r_engine), dist(r_engine));
+        }
+        BOOST_CHECK(valid_colouring(rsp, column_colouring(rsp, 30u)));
+    }
+    // Invalid column index
+    BOOST_CHECK_THROW(column_colouring({{0u, 3u}}, 3u), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(estimate_gradient_sparse_test)
+{
+    dummy_problem udp{};
+    dummy_problem_malformed udp2{};
+    const vector_double x = {0.1, 0.2, 0.3, 0.4};
+    // With a dense pattern, estimate_gradient() is recovered exactly
+    sparsity_pattern dense;
+    for (vector_double::size_type i = 0u; i < 3u; ++i) {
+        for (vector_double::size_type j = 0u; j < 4u; ++j) {
+            dense.emplace_back(i, j);
+        }
+    }
+    auto f = [udp](const vector_double &y) { return udp.fitness(y); };
+    BOOST_CHECK(estimate_gradient_sparse(f, x, dense, 1e-8) == estimate_gradient(f, x, 1e-8));
+    // With the real pattern, the non-zero elements are the same
+    const sparsity_pattern sp = {{0, 0}, {0, 1}, {0, 2}, {0, 3}, {1, 1}, {1, 2}, {1, 3}, {2, 2}};
+    const auto g_dense = estimate_gradient(f, x, 1e-8);
+    const auto g_sparse = estimate_gradient_sparse(f, x, sp, 1e-8);
+    BOOST_CHECK_EQUAL(g_sparse.size(), sp.size());
+    for (decltype(sp.size()) k = 0u; k < sp.size(); ++k) {
+        BOOST_CHECK_EQUAL(g_sparse[k], g_dense[sp[k].first * 4u + sp[k].second]);
+    }
+    // Banded problem: 6 calls instead of 200
+    banded_problem bp{};
+    unsigned n_calls = 0u;
+    vector_double y(100u);
+    for (decltype(y.size()) j = 0u; j < y.size(); ++j) {
+        y[j] = 0.01 * static_cast<double>(j);
+    }
+    const auto bsp = banded_problem::sparsity(100u);
+    auto g_band = estimate_gradient_sparse(
+        [bp, &n_calls](const vector_double &z) {
+            ++n_calls;
+            return bp.fitness(z);
+        },
+        y, bsp, 1e-8);
+    BOOST_CHECK_EQUAL(n_calls, 6u);
+    BOOST_CHECK_EQUAL(g_band.size(), bsp.size());
+    for (decltype(bsp.size()) k = 0u; k < bsp.size(); ++k) {
+        const auto i = bsp[k].first, j = bsp[k].second;
+        const double exact = j == i ? 2. * y[i] : (j == i + 1u ? std::cos(y[j]) : -1.);
+        BOOST_CHECK(std::abs(g_band[k] - exact) < 1e-6);
+    }
+    // Errors
+    BOOST_CHECK_THROW(estimate_gradient_sparse([udp2](const vector_double &z) { return udp2.fitness(z); }, x, sp),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(estimate_gradient_sparse(f, x, {{3u, 0u}}), std::invalid_argument);
+    BOOST_CHECK_THROW(estimate_gradient_sparse(f, x, {{0u, 4u}}), std::invalid_argument);
+}
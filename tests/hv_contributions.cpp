@@ -0,0 +1,279 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE hv_contributions_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hv_algos/hv_hv2d.hpp>
+#include <pagmo/utils/hv_algos/hv_hv3d.hpp>
+#include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hv_contributions.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+
+using namespace pagmo;
+
+using size_type = hv_contributions::size_type;
+
+// Exclusive contribution of the i-th point, computed from its definition.
+static double exclusive(std::vector<vector_double> points, const vector_double &r, decltype(points.size()) i)
+{
+    hvwfg algo;
+    const auto all = hypervolume(points, true).compute(r, algo);
+    points.erase(points.begin() + static_cast<std::vector<vector_double>::difference_type>(i));
+    return points.empty() ? all : all - hypervolume(points, true).compute(r, algo);
+}
+
+// Compares the incremental contributions with the ones computed from scratch.
+static void check_against_hypervolume(const hv_contributions &hvc, const std::vector<size_type> &ids)
+{
+    BOOST_CHECK_EQUAL(hvc.size(), ids.size());
+    if (ids.empty()) {
+        BOOST_CHECK_EQUAL(hvc.compute(), 0.);
+        BOOST_CHECK_THROW(hvc.least_contributor(), std::invalid_argument);
+        return;
+    }
+    std::vector<vector_double> points;
+    for (auto id : ids) {
+        points.push_back(hvc.get_point(id));
+    }
+    hypervolume hv(points, true);
+    vector_double c;
+    for (decltype(points.size()) i = 0u; i < points.size(); ++i) {
+        c.push_back(exclusive(points, hvc.get_refpoint(), i));
+    }
+    double c_min = c[0], c_max = c[0];
+    for (decltype(ids.size()) i = 0u; i < ids.size(); ++i) {
+        BOOST_CHECK_EQUAL(hvc.contribution(ids[i]), c[i]);
+        c_min = std::min(c_min, c[i]);
+        c_max = std::max(c_max, c[i]);
+    }
+    BOOST_CHECK_EQUAL(hvc.contribution(hvc.least_contributor()), c_min);
+    BOOST_CHECK_EQUAL(hvc.contribution(hvc.greatest_contributor()), c_max);
+    hvwfg algo;
+    BOOST_CHECK_EQUAL(hvc.compute(), hv.compute(hvc.get_refpoint(), algo));
+}
+
+static void random_sequence(unsigned dim, unsigned seed)
+{
+    std::mt19937 r_engine(seed);
+    // Integer coordinates on a small grid, so that there are plenty of duplicates and
+    // dominated points and the comparisons can be exact.
+    std::uniform_int_distribution<int> coord(0, 9);
+    hv_contributions hvc(vector_double(dim, 10.));
+    std::vector<size_type> ids;
+    for (auto i = 0; i < 300; ++i) {
+        if (ids.empty() || (ids.size() < 40u && r_engine() % 3u)) {
+            vector_double p(dim);
+            for (auto &x : p) {
+                x = coord(r_engine);
+            }
+            ids.push_back(hvc.insert(p));
+            BOOST_CHECK(hvc.get_point(ids.back()) == p);
+        } else {
+            const auto k = r_engine() % ids.size();
+            hvc.erase(ids[k]);
+            BOOST_CHECK(!hvc.contains(ids[k]));
+            ids.erase(ids.begin() + static_cast<std::vector<size_type>::difference_type>(k));
+        }
+        check_against_hypervolume(hvc, ids);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hv_contributions_construction_test)
+{
+    BOOST_CHECK_NO_THROW((hv_contributions{vector_double{1., 1.}}));
+    BOOST_CHECK_NO_THROW((hv_contributions{vector_double{1., 1., 1.}}));
+    BOOST_CHECK_THROW((hv_contributions{vector_double{1.}}), std::invalid_argument);
+    BOOST_CHECK_THROW((hv_contributions{vector_double{1., 1., 1., 1.}}), std::invalid_argument);
+    BOOST_CHECK_THROW((hv_contributions{vector_double{1., std::numeric_limits<double>::quiet_NaN()}}),
+                      std::invalid_argument);
+    hv_contributions hvc(vector_double{4., 4.});
+    BOOST_CHECK_EQUAL(hvc.size(), 0u);
+    BOOST_CHECK_EQUAL(hvc.compute(), 0.);
+    BOOST_CHECK_THROW(hvc.least_contributor(), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.greatest_contributor(), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.insert({1., 1., 1.}), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.insert({5., 1.}), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.insert({4., 4.}), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.insert({std::numeric_limits<double>::quiet_NaN(), 1.}), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.erase(0u), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.contribution(0u), std::invalid_argument);
+    BOOST_CHECK_THROW(hvc.get_point(0u), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(hv_contributions_2d_test)
+{
+    hv_contributions hvc(vector_double{4., 4.});
+    const auto a = hvc.insert({1., 3.});
+    const auto b = hvc.insert({2., 2.});
+    const auto c = hvc.insert({3., 1.});
+    BOOST_CHECK_EQUAL(hvc.compute(), 6.);
+    BOOST_CHECK_EQUAL(hvc.contribution(a), 1.);
+    BOOST_CHECK_EQUAL(hvc.contribution(b), 1.);
+    BOOST_CHECK_EQUAL(hvc.contribution(c), 1.);
+    BOOST_CHECK_EQUAL(hvc.least_contributor(), a);
+    BOOST_CHECK_EQUAL(hvc.greatest_contributor(), a);
+    // A duplicate cancels the contribution of b.
+    const auto d = hvc.insert({2., 2.});
+    BOOST_CHECK_EQUAL(hvc.contribution(b), 0.);
+    BOOST_CHECK_EQUAL(hvc.contribution(d), 0.);
+    BOOST_CHECK_EQUAL(hvc.least_contributor(), b);
+    hvc.erase(b);
+    BOOST_CHECK_EQUAL(hvc.contribution(d), 1.);
+    // Handles are reused.
+    BOOST_CHECK_EQUAL(hvc.insert({1., 1.}), b);
+    BOOST_CHECK_EQUAL(hvc.compute(), 9.);
+    BOOST_CHECK_EQUAL(hvc.contribution(b), 3.);
+    BOOST_CHECK_EQUAL(hvc.contribution(a), 0.);
+    BOOST_CHECK_EQUAL(hvc.greatest_contributor(), b);
+    // Removing the dominating point uncovers the other ones.
+    hvc.erase(b);
+    BOOST_CHECK_EQUAL(hvc.compute(), 6.);
+    check_against_hypervolume(hvc, {a, c, d});
+    for (auto seed = 0u; seed < 10u; ++seed) {
+        random_sequence(2u, seed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hv_contributions_3d_test)
+{
+    hv_contributions hvc(vector_double{2., 2., 2.});
+    const auto a = hvc.insert({1., 1., 1.});
+    BOOST_CHECK_EQUAL(hvc.compute(), 1.);
+    BOOST_CHECK_EQUAL(hvc.contribution(a), 1.);
+    const auto b = hvc.insert({0., 0., 0.});
+    BOOST_CHECK_EQUAL(hvc.compute(), 8.);
+    BOOST_CHECK_EQUAL(hvc.contribution(a), 0.);
+    BOOST_CHECK_EQUAL(hvc.greatest_contributor(), b);
+    hvc.erase(b);
+    BOOST_CHECK_EQUAL(hvc.least_contributor(), a);
+    BOOST_CHECK_EQUAL(hvc.contribution(a), 1.);
+    for (auto seed = 0u; seed < 10u; ++seed) {
+        random_sequence(3u, seed);
+    }
+}
+
+// Steady-state reduction of a front, as in SMS-EMOA: the least contributor is removed one at a time.
+BOOST_AUTO_TEST_CASE(hv_contributions_reduction_test)
+{
+    std::mt19937 r_engine(42u);
+    std::uniform_real_distribution<double> coord(0., 1.);
+    for (unsigned dim = 2u; dim <= 3u; ++dim) {
+        const vector_double r(dim, 1.1);
+        hv_contributions hvc(r);
+        std::vector<vector_double> points;
+        for (auto i = 0; i < 50; ++i) {
+            vector_double p(dim);
+            for (auto &x : p) {
+                x = coord(r_engine);
+            }
+            points.push_back(p);
+            BOOST_CHECK_EQUAL(hvc.insert(p), static_cast<size_type>(i));
+        }
+        std::vector<size_type> ids(points.size());
+        std::iota(ids.begin(), ids.end(), size_type(0u));
+        while (ids.size() > 1u) {
+            std::vector<vector_double> cur;
+            for (auto id : ids) {
+                cur.push_back(points[id]);
+            }
+            vector_double c;
+            for (decltype(cur.size()) i = 0u; i < cur.size(); ++i) {
+                c.push_back(exclusive(cur, r, i));
+            }
+            BOOST_CHECK_SMALL(hvc.contribution(hvc.least_contributor()) - *std::min_element(c.begin(), c.end()),
+                              1E-12);
+            hvwfg algo;
+            BOOST_CHECK_CLOSE(hvc.compute(), hypervolume(cur, true).compute(r, algo), 1E-8);
+            const auto lc = hvc.least_contributor();
+            hvc.erase(lc);
+            ids.erase(std::find(ids.begin(), ids.end(), lc));
+        }
+    }
+}
+
+// Steady-state selection on a large three-dimensional front: each insertion and removal updates all the
+// contributions with a linear sweep.
+BOOST_AUTO_TEST_CASE(hv_contributions_3d_large_test)
+{
+    std::mt19937 r_engine(42u);
+    std::normal_distribution<double> nd(0., 1.);
+    // Points on the unit sphere in the positive orthant are mutually non-dominated.
+    auto sphere_point = [&r_engine, &nd]() {
+        vector_double p(3u);
+        double norm = 0.;
+        for (auto &x : p) {
+            x = std::abs(nd(r_engine));
+            norm += x * x;
+        }
+        for (auto &x : p) {
+            x /= std::sqrt(norm);
+        }
+        return p;
+    };
+    const vector_double r(3u, 1.1);
+    hv_contributions hvc(r);
+    for (auto i = 0; i < 10000; ++i) {
+        hvc.insert(sphere_point());
+    }
+    const unsigned n_steps = 20u;
+    std::chrono::duration<double> elapsed(0.);
+    for (unsigned i = 0u; i < n_steps; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        hvc.insert(sphere_point());
+        const auto lc = hvc.least_contributor();
+        const auto c_lc = hvc.contribution(lc);
+        elapsed += std::chrono::steady_clock::now() - start;
+        // Check against a recomputation of all the contributions.
+        std::vector<vector_double> points;
+        for (size_type id = 0u; points.size() < hvc.size(); ++id) {
+            if (hvc.contains(id)) {
+                points.push_back(hvc.get_point(id));
+            }
+        }
+        const auto c = hv3d().contributions(points, r);
+        // The incremental updates accumulate rounding errors relative to the volumes added and subtracted
+        // over time, which are much larger than the least contribution.
+        BOOST_CHECK_SMALL(c_lc - *std::min_element(c.begin(), c.end()), 1E-15);
+        hvc.erase(lc);
+        BOOST_CHECK_EQUAL(hvc.size(), 10000u);
+    }
+    BOOST_TEST_MESSAGE("3D insertion/query/removal step on 10000 points: " << elapsed.count() / n_steps << " s");
+    // Generous bound (a few milliseconds are expected in release builds), catching a quadratic behaviour.
+    BOOST_CHECK(elapsed.count() / n_steps < 1.);
+}
@@ -28,6 +28,8 @@ see https://www.gnu.org/licenses/. */
 
 #define BOOST_TEST_MODULE hypervolume_utilities_test
 #include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <random>
 #include <stdexcept>
 #include <tuple>
 
@@ -48,6 +50,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/utils/hv_algos/hv_hv2d.hpp>
 #include <pagmo/utils/hv_algos/hv_hv3d.hpp>
 #include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hv_algos/hv_mc_approx.hpp>
 #include <pagmo/utils/hypervolume.hpp>
 
 using namespace pagmo;
@@ -592,6 +595,72 @@ BOOST_AUTO_TEST_CASE(hypervolume_approximation_test)
     BOOST_CHECK_THROW(bf_fpras(epsilon, -2.0, seed), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(hypervolume_mc_approx_test)
+{
+    // As for bf_fpras, the seed is fixed in order to derandomize the test.
+    double epsilon = 1e-2;
+    double delta = 1e-2;
+    unsigned seed = 42u;
+
+    mc_approx hv_mc(epsilon, delta, seed);
+    BOOST_CHECK_EQUAL(hv_mc.get_name(), "mc_approx algorithm");
+    BOOST_CHECK_EQUAL(hv_mc.get_last_n_samples(), 0u);
+
+    hypervolume hv({{2.3, 4.5}, {3.4, 3.4}, {6.0, 1.2}});
+    double correct = 17.91;
+    auto res = hv.compute({7.0, 7.0}, hv_mc);
+    BOOST_CHECK(std::abs(res - correct) <= correct * epsilon);
+    // The requested confidence interval was reached.
+    BOOST_CHECK(hv_mc.get_last_n_samples() > 0u);
+    BOOST_CHECK(hv_mc.get_last_half_width() <= res * epsilon);
+
+    hv = hypervolume({{2.3, 4.5, 3.2, 1.9, 6.0}, {3.4, 3.4, 3.4, 2.1, 5.8}, {6.0, 1.2, 3.6, 3.0, 6.0}});
+    correct = 373.21228;
+    res = hv.compute({7.0, 7.0, 7.0, 7.0, 7.0}, hv_mc);
+    BOOST_CHECK(std::abs(res - correct) <= correct * epsilon);
+
+    // Many objectives, with dominated points and duplicates.
+    std::vector<vector_double> points;
+    detail::random_engine_type r_engine(seed);
+    std::uniform_real_distribution<double> dist(0., 1.);
+    for (auto i = 0; i < 30; ++i) {
+        vector_double p(10);
+        for (auto &x : p) {
+            x = dist(r_engine);
+        }
+        points.push_back(p);
+    }
+    points.push_back(points[0]);
+    hv = hypervolume(points);
+    const vector_double r_point(10, 1.1);
+    correct = hv.compute(r_point, *hvwfg().clone());
+    res = hv.compute(r_point, hv_mc);
+    BOOST_CHECK(std::abs(res - correct) <= correct * epsilon);
+
+    // The estimate does not depend on the number of threads.
+    mc_approx hv_mc1(epsilon, delta, seed, 1u), hv_mc4(epsilon, delta, seed, 4u);
+    BOOST_CHECK_EQUAL(hv.compute(r_point, hv_mc1), hv.compute(r_point, hv_mc4));
+    BOOST_CHECK_EQUAL(hv_mc1.get_last_n_samples(), hv_mc4.get_last_n_samples());
+
+    // Maximum number of samples.
+    mc_approx hv_mc_max(1e-6, delta, seed, 0u, 1u);
+    hv.compute(r_point, hv_mc_max);
+    BOOST_CHECK_EQUAL(hv_mc_max.get_last_n_samples(), 32u * 1024u);
+    BOOST_CHECK(hv_mc_max.get_last_half_width() > 0.);
+
+    BOOST_CHECK_THROW(hv.exclusive(0u, r_point, hv_mc), std::invalid_argument);
+    BOOST_CHECK_THROW(hv.contributions(r_point, hv_mc), std::invalid_argument);
+
+    // A single box is computed exactly.
+    hv = hypervolume({{1., 1., 1., 1.}});
+    BOOST_CHECK_CLOSE(hv.compute({2., 3., 2., 2.}, hv_mc), 2., 1e-12);
+    BOOST_CHECK_EQUAL(hv_mc.get_last_half_width(), 0.);
+
+    BOOST_CHECK_THROW(mc_approx(1.1, delta, seed), std::invalid_argument);
+    BOOST_CHECK_THROW(mc_approx(epsilon, -2.0, seed), std::invalid_argument);
+    BOOST_CHECK_THROW(mc_approx(epsilon, delta, seed, 0u, 0u), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(hypervolume_contributor_approximation_test)
 {
     hypervolume hv;
@@ -167,6 +167,37 @@ BOOST_AUTO_TEST_CASE(ipopt_nlp_test)
     BOOST_CHECK(std::abs(h[9] - (0. + lambda[0] * 2)) < 1E-8);
 }
 
+// The fitness and the gradient are computed once per point, even if requested by several callbacks.
+BOOST_AUTO_TEST_CASE(ipopt_nlp_cache_test)
+{
+    using ipopt_nlp = detail::ipopt_nlp;
+    using Index = ipopt_nlp::Index;
+    problem prob(hock_schittkowsky_71{});
+    ipopt_nlp nlp(prob, {1.1, 1.2, 1.3, 1.4}, 0u);
+    const vector_double x{2.1, 2.2, 2.3, 2.4}, y{2.5, 2.2, 2.3, 2.4};
+    double objval;
+    vector_double grad_f(4), g(2), jac_g(8);
+    std::vector<Index> iRow(8), jCol(8);
+    nlp.eval_f(4, x.data(), true, objval);
+    nlp.eval_g(4, x.data(), false, 2, g.data());
+    nlp.eval_grad_f(4, x.data(), false, grad_f.data());
+    nlp.eval_jac_g(4, x.data(), false, 2, 8, iRow.data(), jCol.data(), jac_g.data());
+    BOOST_CHECK_EQUAL(prob.get_fevals(), 1u);
+    BOOST_CHECK_EQUAL(prob.get_gevals(), 1u);
+    BOOST_CHECK_EQUAL(objval, prob.fitness(x)[0]);
+    BOOST_CHECK((g == vector_double{prob.fitness(x)[1], prob.fitness(x)[2]}));
+    const auto grad = prob.gradient(x);
+    BOOST_CHECK((jac_g == vector_double(grad.begin() + 4, grad.end())));
+    // A new point invalidates the cache.
+    nlp.eval_g(4, y.data(), true, 2, g.data());
+    BOOST_CHECK((g == vector_double{prob.fitness(y)[1], prob.fitness(y)[2]}));
+    // The cache is invalidated also if Ipopt does not flag a point as new.
+    nlp.eval_f(4, x.data(), false, objval);
+    BOOST_CHECK_EQUAL(objval, prob.fitness(x)[0]);
+    nlp.eval_f(4, x.data(), true, objval);
+    BOOST_CHECK_EQUAL(objval, prob.fitness(x)[0]);
+}
+
 BOOST_AUTO_TEST_CASE(ipopt_evolve_test_00)
 {
     ipopt ip;
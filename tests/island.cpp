@@ -31,7 +31,10 @@ see https://www.gnu.org/licenses/. */
 
 #include <atomic>
 #include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <cmath>
 #include <initializer_list>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -41,10 +44,15 @@ see https://www.gnu.org/licenses/. */
 #include <vector>
 
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/pso.hpp>
+#include <pagmo/detail/affinity.hpp>
+#include <pagmo/detail/parallel_for.hpp>
+#include <pagmo/evolve_limits.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/island.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
 #include <pagmo/serialization.hpp>
 #include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
@@ -401,3 +409,268 @@ BOOST_AUTO_TEST_CASE(island_evolve_status)
     stream(ss, evolve_status::idle_error);
     BOOST_CHECK_EQUAL(ss.str(), "idle - **error occurred**");
 }
+
+static std::atomic<unsigned> n_stop_runs = ATOMIC_VAR_INIT(0u);
+
+// An algorithm that runs until the island asks it to stop.
+struct algo_stop {
+    population evolve(const population &pop) const
+    {
+        ++n_stop_runs;
+        while (!evolve_stop_requested()) {
+            std::this_thread::yield();
+        }
+        return pop;
+    }
+};
+
+// As above, but polling from multiple threads.
+struct algo_stop_mt {
+    population evolve(const population &pop) const
+    {
+        ++n_stop_runs;
+        detail::parallel_for(4u, 4u, [](std::size_t, std::size_t, unsigned) {
+            while (!evolve_stop_requested()) {
+                std::this_thread::yield();
+            }
+        });
+        return pop;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(island_evolve_limits)
+{
+    evolve_limits lim;
+    BOOST_CHECK(std::isinf(lim.get_max_seconds()));
+    BOOST_CHECK_EQUAL(lim.get_max_fevals(), std::numeric_limits<unsigned long long>::max());
+    lim = evolve_limits{1.5, 10u};
+    BOOST_CHECK_EQUAL(lim.get_max_seconds(), 1.5);
+    BOOST_CHECK_EQUAL(lim.get_max_fevals(), 10u);
+    BOOST_CHECK_NO_THROW(evolve_limits{0.});
+    BOOST_CHECK_THROW(evolve_limits{-1.}, std::invalid_argument);
+    BOOST_CHECK_THROW(evolve_limits{std::numeric_limits<double>::quiet_NaN()}, std::invalid_argument);
+    // Outside an island, there is never a request to stop.
+    BOOST_CHECK(!evolve_stop_requested());
+    BOOST_CHECK(!evolve_stop_requested(problem{rosenbrock{}}));
+    // Budget of fevals, checked between the run_evolve() calls.
+    island isl{de{1u}, rosenbrock{}, 20u};
+    isl.evolve(1000u, evolve_limits{std::numeric_limits<double>::infinity(), 100u});
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 120u);
+    // Budget of fevals, checked between generations.
+    isl = island{de{1000u}, rosenbrock{}, 20u};
+    isl.evolve(1u, evolve_limits{std::numeric_limits<double>::infinity(), 100u});
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 120u);
+    isl = island{pso{1000u}, rosenbrock{}, 20u};
+    isl.evolve(1u, evolve_limits{std::numeric_limits<double>::infinity(), 100u});
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 120u);
+    // No limits.
+    isl = island{de{1u}, rosenbrock{}, 20u};
+    isl.evolve(3u, evolve_limits{});
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 80u);
+    // Timeout.
+    isl = island{algo_stop{}, rosenbrock{}, 20u};
+    n_stop_runs.store(0u);
+    auto start = std::chrono::steady_clock::now();
+    isl.evolve(1000u, evolve_limits{.05});
+    isl.wait_check();
+    BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+    BOOST_CHECK(n_stop_runs.load() <= 1u);
+    // A zero timeout prevents the evolution from starting.
+    n_stop_runs.store(0u);
+    isl.evolve(1000u, evolve_limits{0.});
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(n_stop_runs.load(), 0u);
+    // Huge timeouts are fine.
+    isl = island{de{1u}, rosenbrock{}, 20u};
+    isl.evolve(1u, evolve_limits{std::numeric_limits<double>::max()});
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 40u);
+}
+
+BOOST_AUTO_TEST_CASE(island_cancel)
+{
+    island isl{algo_stop{}, rosenbrock{}, 20u};
+    n_stop_runs.store(0u);
+    isl.evolve(1000u);
+    isl.evolve(1000u);
+    isl.cancel();
+    isl.wait_check();
+    BOOST_CHECK(isl.status() == evolve_status::idle);
+    BOOST_CHECK(n_stop_runs.load() <= 1u);
+    // Evolutions launched after the cancellation are not affected.
+    isl = island{de{1u}, rosenbrock{}, 20u};
+    isl.cancel();
+    isl.evolve(2u);
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 60u);
+    // The cancellation is propagated to the threads spawned by the evolution.
+    isl = island{algo_stop_mt{}, rosenbrock{}, 20u};
+    isl.evolve();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    isl.cancel();
+    isl.wait_check();
+    // Cancel from another thread.
+    isl.evolve();
+    std::thread t([&isl]() { isl.cancel(); });
+    t.join();
+    isl.wait_check();
+    // The destructor cancels the ongoing evolutions (otherwise this would not terminate).
+    {
+        island isl2{algo_stop{}, rosenbrock{}, 20u};
+        isl2.evolve(1000u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(island_snapshot_test)
+{
+    island isl{de{1u}, rosenbrock{}, 20u};
+    auto s = isl.get_snapshot();
+    BOOST_CHECK_EQUAL(s->version, 0u);
+    BOOST_CHECK(s->champion_x == isl.get_population().champion_x());
+    BOOST_CHECK(s->champion_f == isl.get_population().champion_f());
+    BOOST_CHECK_EQUAL(s->fevals, 20u);
+    BOOST_CHECK_EQUAL(s->n_evolve, 0u);
+    BOOST_CHECK(s->status == evolve_status::idle);
+    isl.evolve(3u);
+    isl.wait_check();
+    auto s2 = isl.get_snapshot();
+    BOOST_CHECK(s2->version > s->version);
+    BOOST_CHECK(s2->champion_x == isl.get_population().champion_x());
+    BOOST_CHECK(s2->champion_f == isl.get_population().champion_f());
+    BOOST_CHECK_EQUAL(s2->fevals, 80u);
+    BOOST_CHECK_EQUAL(s2->n_evolve, 3u);
+    BOOST_CHECK(s2->status == evolve_status::idle);
+    // Old snapshots are not modified.
+    BOOST_CHECK_EQUAL(s->version, 0u);
+    BOOST_CHECK_EQUAL(s->n_evolve, 0u);
+    // set_population() publishes a new snapshot.
+    population pop{rosenbrock{}, 5u};
+    isl.set_population(pop);
+    s = isl.get_snapshot();
+    BOOST_CHECK(s->version > s2->version);
+    BOOST_CHECK(s->champion_f == pop.champion_f());
+    BOOST_CHECK_EQUAL(s->fevals, 5u);
+    BOOST_CHECK_EQUAL(s->n_evolve, 3u);
+    // Copies start afresh, the serialization restores the population-dependent members.
+    island isl2(isl);
+    BOOST_CHECK_EQUAL(isl2.get_snapshot()->n_evolve, 0u);
+    BOOST_CHECK(isl2.get_snapshot()->champion_f == pop.champion_f());
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(isl);
+    }
+    island isl3{de{}, rosenbrock{}, 10u};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(isl3);
+    }
+    BOOST_CHECK(isl3.get_snapshot()->champion_f == pop.champion_f());
+    BOOST_CHECK_EQUAL(isl3.get_snapshot()->fevals, 5u);
+    // Errors.
+    isl = island{de{}, population{rosenbrock{}, 3u}};
+    isl.evolve();
+    isl.wait();
+    BOOST_CHECK(isl.get_snapshot()->status == evolve_status::idle_error);
+    BOOST_CHECK_EQUAL(isl.get_snapshot()->n_evolve, 0u);
+    BOOST_CHECK_THROW(isl.wait_check(), std::invalid_argument);
+    BOOST_CHECK(isl.get_snapshot()->status == evolve_status::idle);
+    // Busy status.
+    isl = island{algo_stop{}, rosenbrock{}, 20u};
+    isl.evolve();
+    BOOST_CHECK(isl.get_snapshot()->status == evolve_status::busy);
+    isl.cancel();
+    isl.wait_check();
+    BOOST_CHECK(isl.get_snapshot()->status == evolve_status::idle);
+    BOOST_CHECK(isl.get_snapshot()->n_evolve <= 1u);
+    // Multi-objective problems: no champion.
+    isl = island{de{}, population{zdt{}, 5u}};
+    BOOST_CHECK(isl.get_snapshot()->champion_x.empty());
+    BOOST_CHECK(isl.get_snapshot()->champion_f.empty());
+    BOOST_CHECK_EQUAL(isl.get_snapshot()->fevals, 5u);
+    // Concurrent readers see increasing versions.
+    isl = island{de{1u}, rosenbrock{}, 20u};
+    isl.evolve(200u);
+    unsigned long long last_version = 0, last_n_evolve = 0;
+    bool monotonic = true;
+    while (isl.status() == evolve_status::busy) {
+        const auto cur = isl.get_snapshot();
+        monotonic = monotonic && cur->version >= last_version && cur->n_evolve >= last_n_evolve;
+        last_version = cur->version;
+        last_n_evolve = cur->n_evolve;
+    }
+    isl.wait_check();
+    BOOST_CHECK(monotonic);
+    BOOST_CHECK_EQUAL(isl.get_snapshot()->n_evolve, 200u);
+    // Concurrent calls to set_population() leave a snapshot consistent with the population.
+    for (auto k = 0; k < 10; ++k) {
+        std::vector<std::thread> threads;
+        for (auto i = 0u; i < 4u; ++i) {
+            threads.emplace_back([&isl, i]() {
+                for (auto j = 0u; j < 20u; ++j) {
+                    isl.set_population(population{rosenbrock{}, 5u + i, i * 100u + j});
+                }
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+        const auto cur_pop = isl.get_population();
+        BOOST_CHECK(isl.get_snapshot()->champion_f == cur_pop.champion_f());
+        BOOST_CHECK_EQUAL(isl.get_snapshot()->fevals, cur_pop.get_problem().get_fevals());
+    }
+}
+
+// The CPUs the thread running algo_affinity::evolve() can run on.
+std::vector<unsigned> evolve_cpus;
+
+struct algo_affinity {
+    population evolve(const population &pop) const
+    {
+        evolve_cpus = detail::get_thread_affinity();
+        return pop;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(island_placement_test)
+{
+    BOOST_CHECK((detail::parse_cpu_list("8,0-3, 10-11\n") == std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}));
+    BOOST_CHECK(detail::parse_cpu_list("").empty());
+    island isl{algo_affinity{}, rosenbrock{}, 10u};
+    BOOST_CHECK(isl.get_placement().cpus.empty());
+    BOOST_CHECK_EQUAL(isl.get_placement().numa_node, -1);
+#if defined(__linux__)
+    BOOST_CHECK_THROW(isl.set_placement({std::numeric_limits<unsigned>::max()}), std::invalid_argument);
+    const auto topo = detail::numa_topology();
+    BOOST_REQUIRE(!topo.empty());
+    const auto cpu = topo.back().cpus.back();
+    const auto pop0 = isl.get_population();
+    isl.evolve();
+    isl.set_placement({cpu});
+    BOOST_CHECK(isl.get_placement().cpus == std::vector<unsigned>{cpu});
+    BOOST_CHECK_EQUAL(isl.get_placement().numa_node, topo.back().node);
+    // The population was not altered by the relocation.
+    BOOST_CHECK(isl.get_population().get_x() == pop0.get_x());
+    BOOST_CHECK(isl.get_population().get_f() == pop0.get_f());
+    isl.evolve();
+    isl.wait_check();
+    BOOST_CHECK(evolve_cpus == std::vector<unsigned>{cpu});
+    // The copies of the island are not pinned.
+    island isl2(isl);
+    BOOST_CHECK(isl2.get_placement().cpus.empty());
+    // Unpinning.
+    isl.set_placement({});
+    BOOST_CHECK(isl.get_placement().cpus.empty());
+    BOOST_CHECK_EQUAL(isl.get_placement().numa_node, -1);
+    isl.evolve();
+    isl.wait_check();
+    BOOST_CHECK(evolve_cpus == detail::process_cpus<>::get());
+#else
+    isl.set_placement({0});
+    BOOST_CHECK(isl.get_placement().cpus.empty());
+#endif
+}
@@ -47,6 +47,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/serialization.hpp>
 #include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
+#include <pagmo/utils/constrained.hpp>
 
 using namespace pagmo;
 
@@ -124,6 +125,37 @@ BOOST_AUTO_TEST_CASE(mbh_evolve_test)
                 == (pop.get_x()[0]));
 }
 
+BOOST_AUTO_TEST_CASE(mbh_trials_test)
+{
+    // Multiple trials: the evolution is deterministic if the seed is controlled
+    problem prob{hock_schittkowsky_71{}};
+    prob.set_c_tol({1e-3, 1e-3});
+    population pop1{prob, 5u, 23u};
+    population pop2{prob, 5u, 23u};
+    mbh user_algo1{compass_search{100u, 0.1, 0.001, 0.7}, 5u, 0.1, 23u};
+    user_algo1.set_n_trials(4u);
+    user_algo1.set_verbosity(1u);
+    BOOST_CHECK_EQUAL(user_algo1.get_n_trials(), 4u);
+    pop1 = user_algo1.evolve(pop1);
+    BOOST_CHECK(user_algo1.get_log().size() > 0u);
+    mbh user_algo2{compass_search{100u, 0.1, 0.001, 0.7}, 5u, 0.1, 23u};
+    user_algo2.set_n_trials(4u);
+    user_algo2.set_verbosity(1u);
+    pop2 = user_algo2.evolve(pop2);
+    BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+    BOOST_CHECK(pop1.get_x() == pop2.get_x());
+    BOOST_CHECK(pop1.get_f() == pop2.get_f());
+    // The evaluations made by all the trials are accounted for
+    BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), pop2.get_problem().get_fevals());
+    BOOST_CHECK_EQUAL(std::get<0>(user_algo1.get_log().back()) + 5u, pop1.get_problem().get_fevals());
+    // The result is never worse than the starting point
+    population pop3{prob, 5u, 23u};
+    BOOST_CHECK(!compare_fc(pop3.get_f()[pop3.best_idx()], pop1.get_f()[pop1.best_idx()], 2u, prob.get_c_tol()));
+    // Invalid number of trials
+    BOOST_CHECK_THROW(user_algo1.set_n_trials(0u), std::invalid_argument);
+    BOOST_CHECK(user_algo1.get_extra_info().find("Trials: 4") != std::string::npos);
+}
+
 BOOST_AUTO_TEST_CASE(mbh_setters_getters_test)
 {
     mbh user_algo{compass_search{100u, 0.1, 0.001, 0.7}, 5u, {1e-3, 1e-2}, 23u};
@@ -148,6 +180,7 @@ BOOST_AUTO_TEST_CASE(mbh_serialization_test)
     population pop{prob, 10u, 23u};
     algorithm algo{mbh{compass_search{100u, 0.1, 0.001, 0.7}, 5u, 1e-3, 23u}};
     algo.set_verbosity(1u);
+    algo.extract<mbh>()->set_n_trials(2u);
     pop = algo.evolve(pop);
 
     // Store the string representation of p.
@@ -168,6 +201,7 @@ BOOST_AUTO_TEST_CASE(mbh_serialization_test)
     auto after_text = boost::lexical_cast<std::string>(algo);
     auto after_log = algo.extract<mbh>()->get_log();
     BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK_EQUAL(algo.extract<mbh>()->get_n_trials(), 2u);
     // BOOST_CHECK(before_log == after_log); // This fails because of floating point problems when using JSON and cereal
     // so we implement a close check
     BOOST_CHECK(before_log.size() > 0u);
@@ -36,11 +36,15 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/moead.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/zdt.hpp>
+#include <pagmo/rng.hpp>
 #include <pagmo/serialization.hpp>
 #include <pagmo/types.hpp>
+#include <pagmo/utils/generic.hpp>
+#include <pagmo/utils/multi_objective.hpp>
 
 using namespace pagmo;
 
@@ -184,6 +188,84 @@ BOOST_AUTO_TEST_CASE(moead_evolve_test)
     BOOST_CHECK(std::get<3>(user_algo1.get_log()[0]).size() == 6u);
 }
 
+BOOST_AUTO_TEST_CASE(moead_batch_test)
+{
+    problem prob{zdt{1u, 30u}};
+    // A batch size of 1 is the default, sequential, algorithm
+    population pop1{prob, 40u, 23u};
+    population pop2{prob, 40u, 23u};
+    moead user_algo1{10u, "grid", "tchebycheff", 20u, 1., 0.5, 20., 0.9, 2u, true, 23u};
+    user_algo1.set_verbosity(1u);
+    pop1 = user_algo1.evolve(pop1);
+    moead user_algo2{10u, "grid", "tchebycheff", 20u, 1., 0.5, 20., 0.9, 2u, true, 23u};
+    user_algo2.set_verbosity(1u);
+    user_algo2.set_batch_size(1u);
+    user_algo2.set_bfe(bfe{3u});
+    pop2 = user_algo2.evolve(pop2);
+    BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+    BOOST_CHECK(pop1.get_x() == pop2.get_x());
+    // Synchronous mode: deterministic and independent of the number of threads
+    for (auto bs : {7u, 40u, 100u}) {
+        population pop3{prob, 40u, 23u};
+        population pop4{prob, 40u, 23u};
+        moead user_algo3{10u, "grid", "tchebycheff", 20u, 1., 0.5, 20., 0.9, 2u, true, 23u};
+        user_algo3.set_verbosity(1u);
+        user_algo3.set_batch_size(bs);
+        BOOST_CHECK_EQUAL(user_algo3.get_batch_size(), bs);
+        pop3 = user_algo3.evolve(pop3);
+        BOOST_CHECK(user_algo3.get_log().size() > 0u);
+        moead user_algo4{10u, "grid", "tchebycheff", 20u, 1., 0.5, 20., 0.9, 2u, true, 23u};
+        user_algo4.set_verbosity(1u);
+        user_algo4.set_batch_size(bs);
+        user_algo4.set_bfe(bfe{4u});
+        BOOST_CHECK_EQUAL(user_algo4.get_bfe().get_n_threads(), 4u);
+        // The neighbourhoods do not depend on the number of threads used to compute them.
+        user_algo4.set_knn_threads(3u);
+        BOOST_CHECK_EQUAL(user_algo4.get_knn_threads(), 3u);
+        pop4 = user_algo4.evolve(pop4);
+        BOOST_CHECK(user_algo3.get_log() == user_algo4.get_log());
+        BOOST_CHECK(pop3.get_x() == pop4.get_x());
+        BOOST_CHECK(pop3.get_f() == pop4.get_f());
+        BOOST_CHECK_EQUAL(pop3.get_problem().get_fevals(), 40u + 40u * 10u);
+        BOOST_CHECK_EQUAL(pop4.get_problem().get_fevals(), 40u + 40u * 10u);
+    }
+    BOOST_CHECK_THROW(user_algo1.set_batch_size(0u), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(moead_knn_threads_test)
+{
+    // Populations of at least 256 individuals trigger the parallel computation of the neighbourhoods.
+    const population::size_type NP = 300u;
+    for (auto wg : {"grid", "low discrepancy", "random"}) {
+        // The neighbourhoods of the weights moead generates do not depend on the number of threads.
+        detail::random_engine_type e1(23u), e2(23u);
+        const auto w1 = decomposition_weights(2u, NP, wg, e1);
+        const auto w2 = decomposition_weights(2u, NP, wg, e2);
+        BOOST_CHECK(w1 == w2);
+        const auto neigh = kNN(w1, 20u, 1u);
+        for (auto n_threads : {2u, 4u, 0u}) {
+            BOOST_CHECK(kNN(w2, 20u, n_threads) == neigh);
+        }
+        // Neither does the evolved population.
+        problem prob{zdt{1u, 30u}};
+        population pop1{prob, NP, 23u};
+        moead user_algo1{5u, wg, "tchebycheff", 20u, 1., 0.5, 20., 0.9, 2u, true, 23u};
+        user_algo1.set_verbosity(1u);
+        pop1 = user_algo1.evolve(pop1);
+        for (auto n_threads : {2u, 4u, 0u}) {
+            population pop2{prob, NP, 23u};
+            moead user_algo2{5u, wg, "tchebycheff", 20u, 1., 0.5, 20., 0.9, 2u, true, 23u};
+            user_algo2.set_verbosity(1u);
+            user_algo2.set_knn_threads(n_threads);
+            BOOST_CHECK_EQUAL(user_algo2.get_knn_threads(), n_threads);
+            pop2 = user_algo2.evolve(pop2);
+            BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+            BOOST_CHECK(pop1.get_x() == pop2.get_x());
+            BOOST_CHECK(pop1.get_f() == pop2.get_f());
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(moead_setters_getters_test)
 {
     moead user_algo{10u, "grid", "tchebycheff", 20u, 1., 0.5, 20., 0.9, 2u, true, 23u};
@@ -203,6 +285,8 @@ BOOST_AUTO_TEST_CASE(moead_serialization_test)
     population pop{prob, 40u, 23u};
     algorithm algo{moead{10u, "grid", "tchebycheff", 10u, 0.9, 0.5, 20., 0.9, 2u, true, 23u}};
     algo.set_verbosity(1u);
+    algo.extract<moead>()->set_batch_size(8u);
+    algo.extract<moead>()->set_knn_threads(2u);
     pop = algo.evolve(pop);
 
     // Store the string representation of p.
@@ -223,6 +307,8 @@ BOOST_AUTO_TEST_CASE(moead_serialization_test)
     auto after_text = boost::lexical_cast<std::string>(algo);
     auto after_log = algo.extract<moead>()->get_log();
     BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK_EQUAL(algo.extract<moead>()->get_batch_size(), 8u);
+    BOOST_CHECK_EQUAL(algo.extract<moead>()->get_knn_threads(), 2u);
     // BOOST_CHECK(before_log == after_log); // This fails because of floating point problems when using JSON and cereal
     // so we implement a close check
     BOOST_CHECK(before_log.size() > 0u);
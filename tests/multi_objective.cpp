@@ -29,11 +29,15 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE mo_utilities_test
 
 #include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <numeric>
+#include <random>
 #include <stdexcept>
 #include <tuple>
 
 #include <pagmo/io.hpp>
+#include <pagmo/rng.hpp>
 #include <pagmo/types.hpp>
 #include <pagmo/utils/multi_objective.hpp>
 
@@ -259,6 +263,99 @@ BOOST_AUTO_TEST_CASE(select_best_N_mo_test)
     BOOST_CHECK_THROW(select_best_N_mo(example, 0u), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(mo_workspace_test)
+{
+    detail::random_engine_type r_engine(32u);
+    // NOTE: the objectives are continuous, as the crowding distance is not defined (NaN) on fronts
+    // which are degenerate in some objective.
+    std::uniform_real_distribution<double> dist(0., 1.);
+    mo_workspace ws;
+    std::vector<vector_double::size_type> best;
+    for (auto n_obj = 2u; n_obj <= 4u; ++n_obj) {
+        for (auto trial = 0u; trial < 20u; ++trial) {
+            std::vector<vector_double> example(40u, vector_double(n_obj));
+            for (auto &f : example) {
+                for (auto &x : f) {
+                    x = dist(r_engine);
+                }
+            }
+            // The non dominated sorting matches the original one.
+            auto fnds = fast_non_dominated_sorting(example);
+            fast_non_dominated_sorting(example, ws);
+            BOOST_CHECK_EQUAL(ws.n_fronts(), std::get<0>(fnds).size());
+            for (decltype(ws.n_fronts()) f = 0u; f < ws.n_fronts(); ++f) {
+                BOOST_CHECK(std::equal(std::get<0>(fnds)[f].begin(), std::get<0>(fnds)[f].end(),
+                                       ws.fronts.begin() + static_cast<std::ptrdiff_t>(ws.front_begin[f])));
+                BOOST_CHECK_EQUAL(ws.front_begin[f + 1u] - ws.front_begin[f], std::get<0>(fnds)[f].size());
+            }
+            BOOST_CHECK(ws.dom_list == std::get<1>(fnds));
+            BOOST_CHECK(ws.dom_count == std::get<2>(fnds));
+            BOOST_CHECK(ws.non_dom_rank == std::get<3>(fnds));
+            // The crowding distances computed on index spans match the ones computed on copies of the fronts.
+            vector_double cd(example.size());
+            for (const auto &front : std::get<0>(fnds)) {
+                if (front.size() < 2u) {
+                    continue;
+                }
+                std::vector<vector_double> copy;
+                for (auto idx : front) {
+                    copy.push_back(example[idx]);
+                }
+                const auto cd_copy = crowding_distance(copy);
+                crowding_distance(example, front.begin(), front.end(), cd, ws.tmp);
+                for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
+                    BOOST_CHECK_EQUAL(cd[front[i]], cd_copy[i]);
+                }
+            }
+            // The best N are the first N of sort_population_mo, up to the order of the individuals with equal
+            // rank and crowding distance.
+            const auto sorted = sort_population_mo(example);
+            for (const auto &front : std::get<0>(fnds)) {
+                if (front.size() == 1u) {
+                    cd[front[0]] = 0.;
+                }
+            }
+            auto keys = [&fnds, &cd](std::vector<vector_double::size_type>::const_iterator b,
+                                     std::vector<vector_double::size_type>::const_iterator e) {
+                std::vector<std::pair<vector_double::size_type, double>> retval;
+                for (; b != e; ++b) {
+                    retval.emplace_back(std::get<3>(fnds)[*b], cd[*b]);
+                }
+                std::sort(retval.begin(), retval.end());
+                return retval;
+            };
+            for (auto N : {1u, 5u, 17u, 39u}) {
+                select_best_N_mo(example, N, ws, best);
+                BOOST_CHECK_EQUAL(best.size(), N);
+                BOOST_CHECK(keys(best.begin(), best.end()) == keys(sorted.begin(), sorted.begin() + N));
+                const auto ref = select_best_N_mo(example, N);
+                BOOST_CHECK(keys(best.begin(), best.end()) == keys(ref.begin(), ref.end()));
+            }
+            select_best_N_mo(example, 45u, ws, best);
+            BOOST_CHECK_EQUAL(best.size(), example.size());
+        }
+    }
+    // After the first calls, the buffers do not need to grow anymore.
+    std::vector<vector_double> example(40u, vector_double(3u));
+    for (auto &f : example) {
+        for (auto &x : f) {
+            x = dist(r_engine);
+        }
+    }
+    select_best_N_mo(example, 20u, ws, best);
+    const auto p_fronts = ws.fronts.data(), p_best = best.data(), p_tmp = ws.tmp.data();
+    select_best_N_mo(example, 20u, ws, best);
+    BOOST_CHECK(p_fronts == ws.fronts.data());
+    BOOST_CHECK(p_best == best.data());
+    BOOST_CHECK(p_tmp == ws.tmp.data());
+    // Throws.
+    std::vector<vector_double::size_type> span{0u};
+    vector_double cd(example.size());
+    BOOST_CHECK_THROW(crowding_distance(example, span.begin(), span.end(), cd, ws.tmp), std::invalid_argument);
+    BOOST_CHECK_THROW(fast_non_dominated_sorting(std::vector<vector_double>{{1., 2.}}, ws), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_mo(example, 0u, ws, best), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(ideal_test)
 {
     std::vector<vector_double> example;
@@ -0,0 +1,229 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+#define BOOST_TEST_MODULE multi_start_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <iostream>
+#include <string>
+#include <tuple>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/algorithms/multi_start.hpp>
+#include <pagmo/algorithms/simulated_annealing.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/constrained.hpp>
+
+using namespace pagmo;
+
+BOOST_AUTO_TEST_CASE(multi_start_construction_test)
+{
+    multi_start user_algo{};
+    BOOST_CHECK_EQUAL(user_algo.get_n_starts(), 1u);
+    BOOST_CHECK_EQUAL(user_algo.get_verbosity(), 0u);
+    BOOST_CHECK(user_algo.get_inner_algorithm().extract<compass_search>() != nullptr);
+    BOOST_CHECK_NO_THROW((multi_start{compass_search{}, 4u, 23u}));
+    BOOST_CHECK_NO_THROW((multi_start{algorithm{compass_search{}}, 4u}));
+    BOOST_CHECK_THROW((multi_start{compass_search{}, 0u, 23u}), std::invalid_argument);
+    multi_start user_algo2{compass_search{}, 4u, 23u};
+    BOOST_CHECK_EQUAL(user_algo2.get_seed(), 23u);
+    user_algo2.set_seed(32u);
+    BOOST_CHECK_EQUAL(user_algo2.get_seed(), 32u);
+    user_algo2.set_n_starts(7u);
+    BOOST_CHECK_EQUAL(user_algo2.get_n_starts(), 7u);
+    BOOST_CHECK_THROW(user_algo2.set_n_starts(0u), std::invalid_argument);
+    user_algo2.set_verbosity(2u);
+    BOOST_CHECK_EQUAL(user_algo2.get_verbosity(), 2u);
+    BOOST_CHECK(user_algo2.get_name().find("Multi-start") != std::string::npos);
+    BOOST_CHECK(user_algo2.get_extra_info().find("Starts: 7") != std::string::npos);
+    BOOST_CHECK(user_algo2.get_extra_info().find("Inner algorithm extra info") != std::string::npos);
+    BOOST_CHECK(user_algo2.get_log().empty());
+}
+
+BOOST_AUTO_TEST_CASE(multi_start_evolve_test)
+{
+    problem prob{rosenbrock{5u}};
+    population pop0{prob, 20u, 23u};
+    population pop{pop0};
+    multi_start user_algo{compass_search{500u, 0.1, 1e-6, 0.5}, 4u, 23u};
+    user_algo.set_verbosity(1u);
+    pop = user_algo.evolve(pop);
+    const auto &log = user_algo.get_log();
+    BOOST_CHECK_EQUAL(log.size(), 4u);
+    // The best 4 individuals have been refined, the others are untouched
+    auto ranked = sort_population_con(pop0.get_f(), 0u);
+    unsigned long long fevals = 0u;
+    for (decltype(log.size()) s = 0u; s < log.size(); ++s) {
+        BOOST_CHECK_EQUAL(std::get<0>(log[s]), s);
+        BOOST_CHECK_EQUAL(std::get<1>(log[s]), ranked[s]);
+        BOOST_CHECK_EQUAL(std::get<2>(log[s]), pop0.get_f()[ranked[s]][0]);
+        BOOST_CHECK_EQUAL(std::get<3>(log[s]), pop.get_f()[ranked[s]][0]);
+        BOOST_CHECK(pop.get_f()[ranked[s]][0] < pop0.get_f()[ranked[s]][0]);
+        fevals += std::get<4>(log[s]);
+    }
+    for (decltype(ranked.size()) s = 4u; s < ranked.size(); ++s) {
+        BOOST_CHECK(pop.get_x()[ranked[s]] == pop0.get_x()[ranked[s]]);
+        BOOST_CHECK(pop.get_f()[ranked[s]] == pop0.get_f()[ranked[s]]);
+    }
+    // The evaluations made by all the starts are accounted for
+    BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), 20u + fevals);
+    // The IDs are preserved
+    BOOST_CHECK(pop.get_ID() == pop0.get_ID());
+    // More starts than individuals: everything is refined
+    population small{prob, 3u, 23u};
+    user_algo.set_n_starts(10u);
+    small = user_algo.evolve(small);
+    BOOST_CHECK_EQUAL(user_algo.get_log().size(), 3u);
+    // Empty population
+    population empty{prob, 0u, 23u};
+    BOOST_CHECK_EQUAL(user_algo.evolve(empty).size(), 0u);
+    BOOST_CHECK(user_algo.get_log().empty());
+    // Constrained problem: the refined individuals are never worse
+    problem con_prob{hock_schittkowsky_71{}};
+    con_prob.set_c_tol({1e-3, 1e-3});
+    population con_pop0{con_prob, 10u, 23u};
+    multi_start con_algo{compass_search{100u, 0.1, 0.001, 0.7}, 10u, 23u};
+    auto con_pop = con_algo.evolve(con_pop0);
+    for (decltype(con_pop.size()) i = 0u; i < con_pop.size(); ++i) {
+        BOOST_CHECK(!compare_fc(con_pop0.get_f()[i], con_pop.get_f()[i], con_prob.get_nec(), con_prob.get_c_tol()));
+    }
+    // Unsupported problems
+    BOOST_CHECK_THROW(user_algo.evolve(population{zdt{1u, 30u}, 5u, 23u}), std::invalid_argument);
+    BOOST_CHECK_THROW(user_algo.evolve(population{inventory{}, 5u, 23u}), std::invalid_argument);
+}
+
+// A rosenbrock that does not allow concurrent evaluations.
+struct serial_rosenbrock : rosenbrock {
+    serial_rosenbrock() : rosenbrock(5u) {}
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(multi_start_determinism_test)
+{
+    // For a given seed the outcome does not depend on the number of threads
+    population pop1{rosenbrock{5u}, 30u, 42u};
+    population pop2{serial_rosenbrock{}, 30u, 42u};
+    BOOST_CHECK(pop1.get_x() == pop2.get_x());
+    // The inner algorithm is stochastic, so that the reseeding of its copies matters
+    multi_start user_algo1{simulated_annealing{10., .1, 5u, 5u, 5u, 1.}, 8u, 23u};
+    multi_start user_algo2{simulated_annealing{10., .1, 5u, 5u, 5u, 1.}, 8u, 23u};
+    user_algo1.set_verbosity(1u);
+    user_algo2.set_verbosity(1u);
+    pop1 = user_algo1.evolve(pop1);
+    pop2 = user_algo2.evolve(pop2);
+    BOOST_CHECK(pop1.get_x() == pop2.get_x());
+    BOOST_CHECK(pop1.get_f() == pop2.get_f());
+    BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+    BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), pop2.get_problem().get_fevals());
+    // The starts do not all share the same seed
+    pop1 = population{rosenbrock{5u}, 2u, 42u};
+    pop1.set_x(1u, pop1.get_x()[0]);
+    pop1 = user_algo1.evolve(pop1);
+    BOOST_CHECK(pop1.get_x()[0] != pop1.get_x()[1]);
+}
+
+BOOST_AUTO_TEST_CASE(multi_start_serialization_test)
+{
+    // Make one evolution
+    problem prob{hock_schittkowsky_71{}};
+    population pop{prob, 10u, 23u};
+    algorithm algo{multi_start{compass_search{100u, 0.1, 0.001, 0.7}, 3u, 23u}};
+    algo.set_verbosity(1u);
+    pop = algo.evolve(pop);
+
+    // Store the string representation of p.
+    std::stringstream ss;
+    auto before_text = boost::lexical_cast<std::string>(algo);
+    auto before_log = algo.extract<multi_start>()->get_log();
+    // Now serialize, deserialize and compare the result.
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(algo);
+    }
+    // Change the content of p before deserializing.
+    algo = algorithm{null_algorithm{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(algo);
+    }
+    auto after_text = boost::lexical_cast<std::string>(algo);
+    auto after_log = algo.extract<multi_start>()->get_log();
+    BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK_EQUAL(algo.extract<multi_start>()->get_n_starts(), 3u);
+    BOOST_CHECK_EQUAL(before_log.size(), 3u);
+    BOOST_CHECK_EQUAL(after_log.size(), 3u);
+    for (auto i = 0u; i < before_log.size(); ++i) {
+        BOOST_CHECK_EQUAL(std::get<0>(before_log[i]), std::get<0>(after_log[i]));
+        BOOST_CHECK_EQUAL(std::get<1>(before_log[i]), std::get<1>(after_log[i]));
+        BOOST_CHECK_CLOSE(std::get<2>(before_log[i]), std::get<2>(after_log[i]), 1e-8);
+        BOOST_CHECK_CLOSE(std::get<3>(before_log[i]), std::get<3>(after_log[i]), 1e-8);
+        BOOST_CHECK_EQUAL(std::get<4>(before_log[i]), std::get<4>(after_log[i]));
+    }
+}
+
+struct ts1 {
+    population evolve(population pop) const
+    {
+        return pop;
+    }
+};
+
+struct ts2 {
+    population evolve(population pop) const
+    {
+        return pop;
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(multi_start_threading_test)
+{
+    BOOST_CHECK((algorithm{multi_start{ts1{}, 5u, 23u}}.get_thread_safety() == thread_safety::basic));
+    BOOST_CHECK((algorithm{multi_start{ts2{}, 5u, 23u}}.get_thread_safety() == thread_safety::none));
+    // A non thread-safe inner algorithm is still usable (sequentially)
+    population pop{rosenbrock{5u}, 10u, 23u};
+    auto pop2 = multi_start{ts2{}, 5u, 23u}.evolve(pop);
+    BOOST_CHECK(pop2.get_x() == pop.get_x());
+}
@@ -388,3 +388,43 @@ BOOST_AUTO_TEST_CASE(nlopt_loc_opt)
     algo.evolve(pop);
     BOOST_CHECK(algo.extract<nlopt>()->get_last_opt_result() >= 0);
 }
+
+BOOST_AUTO_TEST_CASE(nlopt_eval_cache)
+{
+    // The objective function and the constraints are computed from a single fitness/gradient
+    // evaluation per point. mma is not tested here as it does not support the equality constraint of hs71.
+    for (auto str : {"slsqp", "cobyla"}) {
+        nlopt n{str};
+        BOOST_CHECK_EQUAL(n.get_last_saved_fevals(), 0u);
+        BOOST_CHECK_EQUAL(n.get_last_saved_gevals(), 0u);
+        n.set_maxeval(100);
+        algorithm algo{n};
+        auto pop = population{hs71{}, 1, 42u};
+        pop = algo.evolve(pop);
+        const auto &nl = *algo.extract<nlopt>();
+        BOOST_CHECK(nl.get_last_saved_fevals() > 0u);
+        if (std::string(str) != "cobyla") {
+            BOOST_CHECK(nl.get_last_saved_gevals() > 0u);
+        } else {
+            BOOST_CHECK_EQUAL(nl.get_last_saved_gevals(), 0u);
+        }
+        // The stored fitness is consistent with the decision vector.
+        BOOST_CHECK(pop.get_f()[0] == hs71{}.fitness(pop.get_x()[0]));
+        // The counters are copied and serialized.
+        auto n2(nl);
+        BOOST_CHECK_EQUAL(n2.get_last_saved_fevals(), nl.get_last_saved_fevals());
+        BOOST_CHECK_EQUAL(n2.get_last_saved_gevals(), nl.get_last_saved_gevals());
+        std::stringstream ss;
+        {
+            cereal::JSONOutputArchive oarchive(ss);
+            oarchive(algo);
+        }
+        algorithm algo2{null_algorithm{}};
+        {
+            cereal::JSONInputArchive iarchive(ss);
+            iarchive(algo2);
+        }
+        BOOST_CHECK_EQUAL(algo2.extract<nlopt>()->get_last_saved_fevals(), nl.get_last_saved_fevals());
+        BOOST_CHECK_EQUAL(algo2.extract<nlopt>()->get_last_saved_gevals(), nl.get_last_saved_gevals());
+    }
+}
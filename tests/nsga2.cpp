@@ -37,6 +37,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/nsga2.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/problems/dtlz.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
@@ -110,6 +111,17 @@ BOOST_AUTO_TEST_CASE(nsga2_evolve_test)
 
     BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
 
+    // The outcome does not depend on the batch fitness evaluator
+    population pop5{udp, 52u, 23u};
+    user_algo2.set_seed(32u);
+    user_algo2.set_bfe(bfe{3u});
+    BOOST_CHECK_EQUAL(user_algo2.get_bfe().get_n_threads(), 3u);
+    pop5 = user_algo2.evolve(pop5);
+    BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+    BOOST_CHECK(pop1.get_x() == pop5.get_x());
+    BOOST_CHECK(pop1.get_f() == pop5.get_f());
+    BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), pop5.get_problem().get_fevals());
+
     // We evolve for many-objectives and trigger the output with the ellipses
     udp = dtlz{1u, 12u, 7u};
     population pop4{udp, 52u, 23u};
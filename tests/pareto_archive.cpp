@@ -0,0 +1,303 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE pareto_archive_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pagmo/pareto_archive.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+using namespace pagmo;
+
+// Check that the points in the archive are mutually non-dominated.
+static bool non_dominated(const pareto_archive &a)
+{
+    const auto f = a.get_f();
+    for (decltype(f.size()) i = 0; i < f.size(); ++i) {
+        for (decltype(f.size()) j = 0; j < f.size(); ++j) {
+            if (i != j && (f[i] == f[j] || pareto_dominance(f[i], f[j]))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(pareto_archive_construction)
+{
+    pareto_archive a;
+    BOOST_CHECK_EQUAL(a.size(), 0u);
+    BOOST_CHECK_EQUAL(a.get_capacity(), 100u);
+    BOOST_CHECK(a.get_pruning() == archive_pruning::crowding_distance);
+    pareto_archive b{10u, archive_pruning::hv_contribution};
+    BOOST_CHECK_EQUAL(b.get_capacity(), 10u);
+    BOOST_CHECK(b.get_pruning() == archive_pruning::hv_contribution);
+    BOOST_CHECK_THROW(pareto_archive{0u}, std::invalid_argument);
+    BOOST_CHECK_THROW((pareto_archive{10u, static_cast<archive_pruning>(42)}), std::invalid_argument);
+    // Copy and move.
+    b.insert({1.}, {1., 2.});
+    auto c(b);
+    BOOST_CHECK_EQUAL(c.size(), 1u);
+    BOOST_CHECK(c.get_pruning() == archive_pruning::hv_contribution);
+    c.insert({2.}, {2., 1.});
+    BOOST_CHECK_EQUAL(b.size(), 1u);
+    auto d(std::move(c));
+    BOOST_CHECK_EQUAL(d.size(), 2u);
+    a = d;
+    BOOST_CHECK_EQUAL(a.size(), 2u);
+    BOOST_CHECK_EQUAL(a.get_capacity(), 10u);
+    a = pareto_archive{};
+    BOOST_CHECK_EQUAL(a.size(), 0u);
+    BOOST_CHECK_EQUAL(a.get_capacity(), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(pareto_archive_insert)
+{
+    pareto_archive a{3u};
+    BOOST_CHECK(a.insert({0.}, {2., 2.}));
+    // Dominated and duplicate points are rejected.
+    BOOST_CHECK(!a.insert({1.}, {3., 2.}));
+    BOOST_CHECK(!a.insert({2.}, {2., 2.}));
+    BOOST_CHECK_EQUAL(a.size(), 1u);
+    // Non-dominated points are added.
+    BOOST_CHECK(a.insert({3.}, {1., 3.}));
+    BOOST_CHECK(a.insert({4.}, {3., 1.}));
+    BOOST_CHECK_EQUAL(a.size(), 3u);
+    // A dominating point removes the points it dominates.
+    BOOST_CHECK(a.insert({5.}, {1.5, 1.5}));
+    BOOST_CHECK_EQUAL(a.size(), 3u);
+    BOOST_CHECK((a.get_xf() == std::make_pair(std::vector<vector_double>{{3.}, {4.}, {5.}},
+                                               std::vector<vector_double>{{1., 3.}, {3., 1.}, {1.5, 1.5}})));
+    BOOST_CHECK(a.get_x() == a.get_xf().first);
+    BOOST_CHECK(a.get_f() == a.get_xf().second);
+    // Invalid points.
+    BOOST_CHECK_THROW(a.insert({1.}, {}), std::invalid_argument);
+    BOOST_CHECK_THROW(a.insert({1.}, {1., std::numeric_limits<double>::quiet_NaN()}), std::invalid_argument);
+    BOOST_CHECK_THROW(a.insert({1.}, {1., 2., 3.}), std::invalid_argument);
+    BOOST_CHECK_THROW(a.insert({1., 2.}, {0., 0.}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(a.size(), 3u);
+    a.clear();
+    BOOST_CHECK_EQUAL(a.size(), 0u);
+    BOOST_CHECK(a.insert({1., 2.}, {0., 0., 0.}));
+    // Single objective: the archive keeps the best point.
+    pareto_archive b;
+    BOOST_CHECK(b.insert({1.}, {3.}));
+    BOOST_CHECK(!b.insert({2.}, {4.}));
+    BOOST_CHECK(b.insert({3.}, {1.}));
+    BOOST_CHECK(b.get_x() == std::vector<vector_double>{{3.}});
+}
+
+BOOST_AUTO_TEST_CASE(pareto_archive_pruning)
+{
+    // Points on the front f2 = 1 - f1: the extremes are never discarded by the crowding
+    // distance, the most crowded point is discarded first.
+    pareto_archive a{3u};
+    a.insert({0.}, {0., 1.});
+    a.insert({1.}, {1., 0.});
+    a.insert({2.}, {.1, .9});
+    BOOST_CHECK(a.insert({3.}, {.5, .5}));
+    BOOST_CHECK(a.get_x() == (std::vector<vector_double>{{0.}, {1.}, {3.}}));
+    BOOST_CHECK(!a.insert({4.}, {.45, .55}));
+    BOOST_CHECK(a.get_x() == (std::vector<vector_double>{{0.}, {1.}, {3.}}));
+    // Hypervolume contributions.
+    pareto_archive b{2u, archive_pruning::hv_contribution};
+    b.insert({0.}, {0., 1.});
+    b.insert({1.}, {1., 0.});
+    // The knee point contributes more than the extremes.
+    BOOST_CHECK(b.insert({2.}, {.2, .2}));
+    BOOST_CHECK_EQUAL(b.size(), 2u);
+    BOOST_CHECK(non_dominated(b));
+    BOOST_CHECK(b.get_f()[1] == (vector_double{.2, .2}));
+}
+
+// Hypervolume pruning, compared with the least contributors computed by pagmo::hypervolume.
+BOOST_AUTO_TEST_CASE(pareto_archive_hv_pruning)
+{
+    std::mt19937 r_engine(42u);
+    std::normal_distribution<double> nd(0., 1.);
+    for (unsigned nobj = 2u; nobj <= 4u; ++nobj) {
+        pareto_archive a{10u, archive_pruning::hv_contribution};
+        std::vector<vector_double> expected;
+        for (unsigned i = 0; i < 40u; ++i) {
+            // Points on the unit sphere in the positive orthant are mutually non-dominated.
+            vector_double f(nobj);
+            double norm = 0.;
+            for (auto &v : f) {
+                v = std::abs(nd(r_engine));
+                norm += v * v;
+            }
+            for (auto &v : f) {
+                v /= std::sqrt(norm);
+            }
+            a.insert({static_cast<double>(i)}, f);
+            expected.push_back(f);
+            if (expected.size() > 10u) {
+                auto ref = expected[0], ideal = expected[0];
+                for (const auto &g : expected) {
+                    for (decltype(g.size()) j = 0; j < g.size(); ++j) {
+                        ref[j] = std::max(ref[j], g[j]);
+                        ideal[j] = std::min(ideal[j], g[j]);
+                    }
+                }
+                for (decltype(ref.size()) j = 0; j < ref.size(); ++j) {
+                    ref[j] += (ref[j] - ideal[j]) / 10.;
+                }
+                const auto lc = hypervolume(expected, false).least_contributor(ref);
+                expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(lc));
+            }
+            BOOST_CHECK(a.get_f() == expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pareto_archive_population)
+{
+    population pop{zdt{1u, 10u}, 50u, 42u};
+    for (auto pruning : {archive_pruning::crowding_distance, archive_pruning::hv_contribution}) {
+        pareto_archive a{10u, pruning};
+        const auto n = a.insert(pop);
+        BOOST_CHECK_EQUAL(n, a.size());
+        BOOST_CHECK(a.size() > 0u && a.size() <= 10u);
+        BOOST_CHECK(non_dominated(a));
+        // The archived points come from the population.
+        const auto xf = a.get_xf();
+        for (decltype(xf.first.size()) i = 0; i < xf.first.size(); ++i) {
+            bool found = false;
+            for (decltype(pop.size()) j = 0; j < pop.size(); ++j) {
+                found = found || (pop.get_x()[j] == xf.first[i] && pop.get_f()[j] == xf.second[i]);
+            }
+            BOOST_CHECK(found);
+        }
+        // Reinserting the same population is a no-op.
+        BOOST_CHECK_EQUAL(a.insert(pop), 0u);
+        BOOST_CHECK(a.get_xf() == xf);
+    }
+    // Constrained problem: only the feasible individuals are inserted,
+    // and only the objectives are stored.
+    problem prob{hock_schittkowsky_71{}};
+    prob.set_c_tol(20.);
+    population cpop{prob};
+    cpop.push_back({1., 5., 5., 1.});
+    cpop.push_back({1., 1., 1., 1.});
+    pareto_archive b;
+    BOOST_CHECK_EQUAL(b.insert(cpop), 1u);
+    BOOST_CHECK((b.get_x() == std::vector<vector_double>{{1., 5., 5., 1.}}));
+    BOOST_CHECK_EQUAL(b.get_f()[0].size(), 1u);
+}
+
+// Concurrent insertions, with a reader observing the archive.
+static void concurrent_inserts(archive_pruning pruning)
+{
+    pareto_archive a{20u, pruning};
+    std::atomic<bool> done(false);
+    std::vector<std::thread> writers;
+    for (unsigned i = 0; i < 4u; ++i) {
+        writers.emplace_back([&a, i]() {
+            for (unsigned j = 0; j < 20u; ++j) {
+                a.insert(population{zdt{1u, 5u}, 10u, i * 100u + j});
+            }
+        });
+    }
+    // NOTE: Boost.Test assertions are not thread-safe, record the failures.
+    std::atomic<bool> failed(false);
+    std::thread reader([&a, &done, &failed]() {
+        while (!done.load()) {
+            const auto xf = a.get_xf();
+            if (xf.first.size() != xf.second.size() || xf.first.size() > 20u) {
+                failed.store(true);
+            }
+        }
+    });
+    for (auto &t : writers) {
+        t.join();
+    }
+    done.store(true);
+    reader.join();
+    BOOST_CHECK(!failed.load());
+    BOOST_CHECK(a.size() > 0u && a.size() <= 20u);
+    BOOST_CHECK(non_dominated(a));
+}
+
+BOOST_AUTO_TEST_CASE(pareto_archive_concurrency)
+{
+    for (auto pruning : {archive_pruning::crowding_distance, archive_pruning::hv_contribution}) {
+        concurrent_inserts(pruning);
+    }
+    // No insertion is lost: the points on the front f2 = 1 - f1 are mutually non-dominated.
+    pareto_archive a{400u};
+    std::vector<std::thread> writers;
+    for (unsigned i = 0; i < 4u; ++i) {
+        writers.emplace_back([&a, i]() {
+            for (unsigned j = 0; j < 100u; ++j) {
+                const auto v = (i * 100u + j) / 400.;
+                a.insert({v}, {v, 1. - v});
+            }
+        });
+    }
+    for (auto &t : writers) {
+        t.join();
+    }
+    BOOST_CHECK_EQUAL(a.size(), 400u);
+}
+
+BOOST_AUTO_TEST_CASE(pareto_archive_serialization)
+{
+    pareto_archive a{10u, archive_pruning::hv_contribution};
+    a.insert(population{zdt{1u, 10u}, 20u, 1u});
+    const auto xf = a.get_xf();
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(a);
+    }
+    pareto_archive b;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(b);
+    }
+    BOOST_CHECK_EQUAL(b.get_capacity(), 10u);
+    BOOST_CHECK(b.get_pruning() == archive_pruning::hv_contribution);
+    BOOST_CHECK(b.get_xf() == xf);
+}
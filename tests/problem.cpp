@@ -703,6 +703,12 @@ BOOST_AUTO_TEST_CASE(problem_getters_test)
     BOOST_CHECK(p2.get_fevals() == N);
     BOOST_CHECK(p2.get_gevals() == N);
     BOOST_CHECK(p2.get_hevals() == N);
+    p2.increment_fevals(3u);
+    p2.increment_gevals(4u);
+    p2.increment_hevals(5u);
+    BOOST_CHECK(p2.get_fevals() == N + 3u);
+    BOOST_CHECK(p2.get_gevals() == N + 4u);
+    BOOST_CHECK(p2.get_hevals() == N + 5u);
 
     // User implemented
     BOOST_CHECK(p1.get_name() == "A base toy problem");
@@ -36,6 +36,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/pso_gen.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
@@ -236,6 +237,32 @@ struct my_sto_prob {
         }
     }
 }
+ BOOST_AUTO_TEST_CASE(bfe_test)
+{
+    // The evolution does not depend on the number of threads used to evaluate the swarm
+    for (unsigned int variant = 1u; variant <= 6u; ++variant) {
+        for (unsigned int neighb_type = 1u; neighb_type <= 4u; ++neighb_type) {
+            for (const problem &prob : {problem{rosenbrock{10u}}, problem{my_sto_prob{10u}}}) {
+                population pop1{prob, 20u, 23u};
+                pso_gen user_algo1{10u, 0.79, 2., 2., 0.1, variant, neighb_type, 4u, false, 23u};
+                user_algo1.set_verbosity(1u);
+                pop1 = user_algo1.evolve(pop1);
+
+                population pop2{prob, 20u, 23u};
+                pso_gen user_algo2{10u, 0.79, 2., 2., 0.1, variant, neighb_type, 4u, false, 23u};
+                user_algo2.set_verbosity(1u);
+                user_algo2.set_bfe(bfe{3u});
+                BOOST_CHECK_EQUAL(user_algo2.get_bfe().get_n_threads(), 3u);
+                pop2 = user_algo2.evolve(pop2);
+                BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+                BOOST_CHECK(pop1.get_x() == pop2.get_x());
+                BOOST_CHECK(pop1.get_f() == pop2.get_f());
+                BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), pop2.get_problem().get_fevals());
+            }
+        }
+    }
+}
+
  BOOST_AUTO_TEST_CASE(setters_getters_test)
 {
     pso_gen user_algo{5000u, 0.79, 2., 2., 0.1, 5u, 2u, 4u, false, 23u};
@@ -256,6 +283,7 @@ struct my_sto_prob {
     population pop{prob, 5u, 23u};
     algorithm algo{pso_gen{500u, 0.79, 2., 2., 0.1, 5u, 2u, 4u, false, 23u}};
     algo.set_verbosity(23u);
+    algo.extract<pso_gen>()->set_bfe(bfe{2u});
     pop = algo.evolve(pop);
 
     // Store the string representation of p.
@@ -288,3 +316,57 @@ struct my_sto_prob {
         BOOST_CHECK_CLOSE(std::get<5>(before_log[i]), std::get<5>(after_log[i]), 1e-8);
     }
 }
+
+BOOST_AUTO_TEST_CASE(steady_state_test)
+{
+    pso_gen uda{20u, 0.79, 2., 2., 0.1, 5u, 2u, 4u, false, 23u};
+    BOOST_CHECK_EQUAL(uda.get_steady_state(), 0u);
+    uda.set_steady_state(3u);
+    BOOST_CHECK_EQUAL(uda.get_steady_state(), 3u);
+    BOOST_CHECK(uda.get_extra_info().find("Steady-state evaluations: 3") != std::string::npos);
+    // The fevals budget is the same as in the generational mode.
+    for (unsigned int variant = 1u; variant <= 6u; ++variant) {
+        for (unsigned int neighb_type = 1u; neighb_type <= 4u; ++neighb_type) {
+            for (auto n : {1u, 4u, 30u}) {
+                population pop{rosenbrock{10u}, 20u, 23u};
+                const auto f0 = pop.champion_f()[0];
+                pso_gen user_algo{20u, 0.79, 2., 2., 0.1, variant, neighb_type, 4u, false, 23u};
+                user_algo.set_steady_state(n);
+                user_algo.set_verbosity(5u);
+                pop = user_algo.evolve(pop);
+                BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), 20u + 20u * 20u);
+                BOOST_CHECK(pop.champion_f()[0] <= f0);
+                BOOST_CHECK_EQUAL(user_algo.get_log().size(), 4u);
+                for (decltype(pop.size()) i = 0u; i < pop.size(); ++i) {
+                    BOOST_CHECK(pop.get_f()[i] == pop.get_problem().fitness(pop.get_x()[i]));
+                }
+            }
+        }
+    }
+    // With a single evaluation at a time the evolution is reproducible.
+    {
+        population pop1{rosenbrock{10u}, 20u, 23u}, pop2{rosenbrock{10u}, 20u, 23u};
+        pso_gen user_algo1{20u, 0.79, 2., 2., 0.1, 5u, 4u, 4u, false, 23u};
+        user_algo1.set_steady_state(1u);
+        auto user_algo2 = user_algo1;
+        pop1 = user_algo1.evolve(pop1);
+        pop2 = user_algo2.evolve(pop2);
+        BOOST_CHECK(pop1.get_x() == pop2.get_x());
+    }
+    // Stochastic problems are not supported in the steady-state mode.
+    population pop{my_sto_prob{10u}, 20u, 23u};
+    BOOST_CHECK_THROW(uda.evolve(pop), std::invalid_argument);
+    // Serialization.
+    algorithm algo{uda};
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(algo);
+    }
+    algo = algorithm{null_algorithm{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(algo);
+    }
+    BOOST_CHECK_EQUAL(algo.extract<pso_gen>()->get_steady_state(), 3u);
+}
@@ -36,6 +36,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/sade.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
@@ -132,6 +133,41 @@ BOOST_AUTO_TEST_CASE(setters_getters_test)
     BOOST_CHECK_NO_THROW(user_algo.get_log());
 }
 
+BOOST_AUTO_TEST_CASE(generational_test)
+{
+    problem prob{rosenbrock{10u}};
+    for (auto variant_adptv : {1u, 2u}) {
+        // Sequential mode.
+        population pop1{prob, 20u, 23u};
+        sade user_algo1{50u, 2u, variant_adptv, 1e-6, 1e-6, false, 23u};
+        user_algo1.set_verbosity(1u);
+        pop1 = user_algo1.evolve(pop1);
+        // Generational mode, sequential and parallel evaluation.
+        population pop2{prob, 20u, 23u};
+        sade user_algo2{50u, 2u, variant_adptv, 1e-6, 1e-6, false, 23u};
+        user_algo2.set_verbosity(1u);
+        user_algo2.set_generational(true);
+        BOOST_CHECK(user_algo2.get_generational());
+        pop2 = user_algo2.evolve(pop2);
+        population pop3{prob, 20u, 23u};
+        sade user_algo3{50u, 2u, variant_adptv, 1e-6, 1e-6, false, 23u};
+        user_algo3.set_verbosity(1u);
+        user_algo3.set_generational(true);
+        user_algo3.set_bfe(bfe{3u});
+        BOOST_CHECK_EQUAL(user_algo3.get_bfe().get_n_threads(), 3u);
+        pop3 = user_algo3.evolve(pop3);
+        BOOST_CHECK(user_algo2.get_log() == user_algo3.get_log());
+        BOOST_CHECK(pop2.get_x() == pop3.get_x());
+        BOOST_CHECK(pop2.get_f() == pop3.get_f());
+        BOOST_CHECK_EQUAL(pop2.get_problem().get_fevals(), pop3.get_problem().get_fevals());
+        // With jDE the generational mode does not change the results.
+        if (variant_adptv == 1u) {
+            BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+            BOOST_CHECK(pop1.get_x() == pop2.get_x());
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(serialization_test)
 {
     // Make one evolution
@@ -139,6 +175,8 @@ BOOST_AUTO_TEST_CASE(serialization_test)
     population pop{prob, 15u, 23u};
     algorithm algo{sade{10000000u, 2, 1, 1e-3, 1e-3, false, 23u}};
     algo.set_verbosity(1u);
+    algo.extract<sade>()->set_generational(true);
+    algo.extract<sade>()->set_bfe(bfe{2u});
     pop = algo.evolve(pop);
 
     // Store the string representation of p.
@@ -29,6 +29,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE sga_problem_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -36,6 +37,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/sea.hpp>
 #include <pagmo/algorithms/sga.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
@@ -172,6 +174,37 @@ BOOST_AUTO_TEST_CASE(sga_evolve_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(sga_bfe_test)
+{
+    // The evolution does not depend on the batch fitness evaluator
+    std::vector<sga> udas = {
+        sga{10u, .90, 1., 0.1, 1., 2u, "exponential", "gaussian", "tournament", 32u},
+        sga{10u, .90, 1., 0.1, 1., 2u, "sbx", "polynomial", "truncated", 32u},
+    };
+    for (sga &uda : udas) {
+        for (auto prob : {problem{schwefel{20u}}, problem{inventory{25u, 5u, 1432u}}}) {
+            population pop1{prob, 20u, 23u};
+            uda.set_seed(32u);
+            uda.set_verbosity(1u);
+            pop1 = uda.evolve(pop1);
+            auto log1 = uda.get_log();
+
+            population pop2{prob, 20u, 23u};
+            uda.set_seed(32u);
+            uda.set_bfe(bfe{3u});
+            BOOST_CHECK_EQUAL(uda.get_bfe().get_n_threads(), 3u);
+            pop2 = uda.evolve(pop2);
+            auto log2 = uda.get_log();
+            uda.set_bfe(bfe{1u});
+
+            BOOST_CHECK(log1 == log2);
+            BOOST_CHECK(pop1.get_x() == pop2.get_x());
+            BOOST_CHECK(pop1.get_f() == pop2.get_f());
+            BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), pop2.get_problem().get_fevals());
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(sga_serialization_test)
 {
     // Make one evolution
@@ -179,6 +212,7 @@ BOOST_AUTO_TEST_CASE(sga_serialization_test)
     population pop{prob, 20u, 23u};
     algorithm algo{sga{10u}};
     algo.set_verbosity(1u);
+    algo.extract<sga>()->set_bfe(bfe{2u});
     pop = algo.evolve(pop);
 
     // Store the string representation of p.
@@ -209,3 +243,63 @@ BOOST_AUTO_TEST_CASE(sga_serialization_test)
         BOOST_CHECK_CLOSE(std::get<3>(before_log[i]), std::get<3>(after_log[i]), 1e-8);
     }
 }
+
+BOOST_AUTO_TEST_CASE(sga_steady_state_test)
+{
+    sga uda{40u, .9, 1., .1, 1., 2u, "exponential", "polynomial", "tournament", 23u};
+    BOOST_CHECK_EQUAL(uda.get_steady_state(), 0u);
+    BOOST_CHECK(uda.get_extra_info().find("Steady-state") == std::string::npos);
+    uda.set_steady_state(4u);
+    BOOST_CHECK_EQUAL(uda.get_steady_state(), 4u);
+    BOOST_CHECK(uda.get_extra_info().find("Steady-state evaluations: 4") != std::string::npos);
+    // The fevals budget is the same as in the generational mode.
+    for (auto n : {1u, 4u, 30u}) {
+        for (std::string cx : {"exponential", "sbx"}) {
+            for (std::string sel : {"tournament", "truncated"}) {
+                population pop{rosenbrock{5u}, 20u, 42u};
+                const auto f0 = pop.champion_f()[0];
+                const auto fevals0 = pop.get_problem().get_fevals();
+                sga uda2{40u, .9, 1., .1, 1., 2u, cx, "polynomial", sel, 23u};
+                uda2.set_steady_state(n);
+                uda2.set_verbosity(10u);
+                pop = uda2.evolve(pop);
+                BOOST_CHECK_EQUAL(pop.get_problem().get_fevals() - fevals0, 40u * 20u);
+                BOOST_CHECK(pop.champion_f()[0] < f0);
+                BOOST_CHECK_EQUAL(uda2.get_log().size(), 4u);
+                for (decltype(pop.size()) i = 0u; i < pop.size(); ++i) {
+                    BOOST_CHECK(pop.get_f()[i] == pop.get_problem().fitness(pop.get_x()[i]));
+                }
+            }
+        }
+    }
+    // Integer variables.
+    {
+        population pop{minlp_rastrigin{3u, 3u}, 20u, 42u};
+        pop = uda.evolve(pop);
+        for (const auto &x : pop.get_x()) {
+            for (auto i = 3u; i < 6u; ++i) {
+                BOOST_CHECK_EQUAL(x[i], std::round(x[i]));
+            }
+        }
+    }
+    // Stochastic problems are not supported in the steady-state mode.
+    {
+        population pop{inventory{4u, 10u, 23u}, 20u, 42u};
+        BOOST_CHECK_THROW(uda.evolve(pop), std::invalid_argument);
+    }
+    // Serialization.
+    {
+        algorithm algo{uda};
+        std::stringstream ss;
+        {
+            cereal::JSONOutputArchive oarchive(ss);
+            oarchive(algo);
+        }
+        algo = algorithm{null_algorithm{}};
+        {
+            cereal::JSONInputArchive iarchive(ss);
+            iarchive(algo);
+        }
+        BOOST_CHECK_EQUAL(algo.extract<sga>()->get_steady_state(), 4u);
+    }
+}
@@ -0,0 +1,286 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE socket_island_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/sga.hpp>
+#include <pagmo/archipelago.hpp>
+#include <pagmo/evolve_limits.hpp>
+#include <pagmo/island.hpp>
+#include <pagmo/islands/socket_island.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A problem which does not provide any thread safety guarantee.
+struct unsafe_prob {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] * x[0] + x[1] * x[1]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1., -1.}, {1., 1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+
+PAGMO_REGISTER_PROBLEM(unsafe_prob)
+
+// Run a socket worker in a separate thread.
+struct worker_runner {
+    explicit worker_runner(const std::string &address) : m_worker(address), m_thread([this]() { m_worker.run(); })
+    {
+    }
+    ~worker_runner()
+    {
+        m_worker.stop();
+        m_thread.join();
+    }
+    socket_worker m_worker;
+    std::thread m_thread;
+};
+
+BOOST_AUTO_TEST_CASE(socket_island_address)
+{
+    BOOST_CHECK(socket_island{}.get_address() == socket_island::default_address());
+    BOOST_CHECK(socket_island{"tcp://localhost:0"}.get_address() == "tcp://localhost:0");
+    BOOST_CHECK(socket_island{"tcp://[::1]:2424"}.get_address() == "tcp://[::1]:2424");
+    BOOST_CHECK(socket_island{"unix:///tmp/foo"}.get_address() == "unix:///tmp/foo");
+    BOOST_CHECK_THROW(socket_island{"localhost:2424"}, std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island{"tcp://localhost"}, std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island{"tcp://:2424"}, std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island{"tcp://localhost:65536"}, std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island{"tcp://localhost:12a"}, std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island{"tcp://[::1:2424"}, std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island{"unix://"}, std::invalid_argument);
+    BOOST_CHECK_EQUAL(socket_island{}.get_connect_timeout(), 10.);
+    BOOST_CHECK_EQUAL(socket_island("tcp://127.0.0.1:1234", 2.5).get_connect_timeout(), 2.5);
+    BOOST_CHECK_THROW(socket_island("tcp://127.0.0.1:1234", 0.), std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island("tcp://127.0.0.1:1234", -1.), std::invalid_argument);
+    BOOST_CHECK_THROW(socket_island("tcp://127.0.0.1:1234", std::nan("")), std::invalid_argument);
+    BOOST_CHECK_THROW(socket_worker{"unix://" + std::string(200, 'a')}, std::invalid_argument);
+    // Serialization.
+    island isl{socket_island{"tcp://127.0.0.1:1234", 2.5}, de{}, rosenbrock{}, 10};
+    BOOST_CHECK(isl.get_name() == "Socket island");
+    BOOST_CHECK(isl.get_extra_info().find("tcp://127.0.0.1:1234") != std::string::npos);
+    BOOST_CHECK(isl.get_extra_info().find("2.5 s") != std::string::npos);
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(isl);
+    }
+    island isl2;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(isl2);
+    }
+    BOOST_CHECK(isl2.get_extra_info().find("tcp://127.0.0.1:1234") != std::string::npos);
+    BOOST_CHECK(isl2.get_extra_info().find("2.5 s") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(socket_island_tcp)
+{
+    worker_runner wr("tcp://127.0.0.1:0");
+    const auto address = wr.m_worker.get_address();
+    BOOST_CHECK(address.find("tcp://127.0.0.1:") == 0u);
+    BOOST_CHECK(address != "tcp://127.0.0.1:0");
+    island isl{socket_island{address}, de{10}, rosenbrock{}, 20};
+    const auto f0 = isl.get_population().champion_f()[0];
+    isl.evolve();
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 220u);
+    BOOST_CHECK(isl.get_population().champion_f()[0] <= f0);
+    // The connection is reused.
+    isl.evolve(5);
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 1220u);
+    BOOST_CHECK_EQUAL(wr.m_worker.get_n_connections(), 1u);
+    // Errors in the worker.
+    island isl_err{socket_island{address}, de{}, rosenbrock{}, 3};
+    isl_err.evolve();
+    BOOST_CHECK_EXCEPTION(isl_err.wait_check(), std::runtime_error, [](const std::runtime_error &e) {
+        return std::string(e.what()).find("at least 5 individuals") != std::string::npos;
+    });
+    // Non thread-safe problems are served as well.
+    island isl_unsafe{socket_island{address}, sga{3}, unsafe_prob{}, 10};
+    isl_unsafe.evolve();
+    BOOST_CHECK_NO_THROW(isl_unsafe.wait_check());
+    BOOST_CHECK_EQUAL(isl_unsafe.get_population().get_problem().get_fevals(), 40u);
+    // Several islands served concurrently.
+    archipelago archi{5u, socket_island{address}, de{5}, rosenbrock{}, 10};
+    archi.evolve(3);
+    archi.wait_check();
+    for (const auto &isl3 : archi) {
+        BOOST_CHECK_EQUAL(isl3.get_population().get_problem().get_fevals(), 160u);
+    }
+    BOOST_CHECK(wr.m_worker.get_n_connections() <= 6u);
+}
+
+BOOST_AUTO_TEST_CASE(socket_island_unix)
+{
+    const std::string address = "unix:///tmp/pagmo_socket_island_test_" + std::to_string(::getpid()) + ".sock";
+    island isl{socket_island{address}, de{2}, rosenbrock{}, 10};
+    {
+        worker_runner wr(address);
+        BOOST_CHECK(wr.m_worker.get_address() == address);
+        // The address is in use.
+        BOOST_CHECK_THROW(socket_worker{address}, std::runtime_error);
+        isl.evolve();
+        isl.wait_check();
+        BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 30u);
+    }
+    // No worker: the stale connection is dropped, and the new connection fails.
+    isl.evolve();
+    BOOST_CHECK_THROW(isl.wait_check(), std::runtime_error);
+    // Restart the worker at the same address.
+    {
+        worker_runner wr(address);
+        isl.evolve();
+        BOOST_CHECK_NO_THROW(isl.wait_check());
+        BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 50u);
+        isl.evolve();
+        isl.wait_check();
+        BOOST_CHECK_EQUAL(wr.m_worker.get_n_connections(), 1u);
+        // Closing the idle connections forces a reconnection.
+        socket_island::close_connections();
+        isl.evolve();
+        isl.wait_check();
+        BOOST_CHECK_EQUAL(wr.m_worker.get_n_connections(), 2u);
+        // Fill the pool with several idle connections.
+        archipelago archi{4u, socket_island{address}, de{1}, rosenbrock{}, 10};
+        archi.evolve();
+        archi.wait_check();
+    }
+    // After a restart all the pooled connections are stale: a single retry is enough.
+    {
+        worker_runner wr(address);
+        isl.evolve();
+        BOOST_CHECK_NO_THROW(isl.wait_check());
+        isl.evolve();
+        BOOST_CHECK_NO_THROW(isl.wait_check());
+        BOOST_CHECK_EQUAL(wr.m_worker.get_n_connections(), 1u);
+    }
+    // A socket file left behind by a crashed worker is replaced.
+    {
+        const auto path = address.substr(7);
+        const auto sa = detail::socket_unix_sockaddr(path);
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        BOOST_CHECK(::bind(fd, reinterpret_cast<const ::sockaddr *>(&sa), sizeof(sa)) == 0);
+        ::close(fd);
+        worker_runner wr(address);
+        isl.evolve();
+        BOOST_CHECK_NO_THROW(isl.wait_check());
+    }
+    // Other files are not removed.
+    {
+        const auto path = address.substr(7);
+        std::ofstream(path) << "foo";
+        BOOST_CHECK_THROW(socket_worker{address}, std::runtime_error);
+        ::unlink(path.c_str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(socket_island_stop)
+{
+    // A worker which listens, but never serves the connections.
+    socket_worker w("tcp://127.0.0.1:0");
+    island isl{socket_island{w.get_address()}, de{10}, rosenbrock{}, 20};
+    // The timeout interrupts the wait for the reply, and the population is not modified.
+    isl.evolve(1, evolve_limits{.5});
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 20u);
+    // Same with cancellation.
+    isl.evolve();
+    isl.cancel();
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+    BOOST_CHECK_EQUAL(isl.get_population().get_problem().get_fevals(), 20u);
+    // The stop predicate is honoured by the I/O functions.
+    int fds[2];
+    BOOST_CHECK(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    char tag;
+    std::string payload;
+    BOOST_CHECK(!detail::socket_recv_msg(fds[1], tag, payload, []() { return true; }));
+    BOOST_CHECK(!detail::socket_send_msg(fds[0], 1, "hello", []() { return true; }));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(socket_msg_size_limit)
+{
+    int fds[2];
+    BOOST_CHECK(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    // A header announcing a payload larger than the limit.
+    char header[9] = {0, 0, 0, 0, 0, 0, 0, 0, 1};
+    BOOST_CHECK(::write(fds[0], header, sizeof(header)) == static_cast<::ssize_t>(sizeof(header)));
+    char tag;
+    std::string payload;
+    BOOST_CHECK_THROW(detail::socket_recv_msg(fds[1], tag, payload), std::runtime_error);
+    BOOST_CHECK(payload.empty());
+    detail::socket_send_msg(fds[0], 1, "hello");
+    BOOST_CHECK(detail::socket_recv_msg(fds[1], tag, payload));
+    BOOST_CHECK_EQUAL(tag, 1);
+    BOOST_CHECK(payload == "hello");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(socket_worker_stop)
+{
+    // Stopping before running makes run() return immediately.
+    socket_worker w("tcp://127.0.0.1:0");
+    w.stop();
+    w.run();
+    BOOST_CHECK_EQUAL(w.get_n_connections(), 0u);
+}
@@ -0,0 +1,210 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE task_queue_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/task_queue.hpp>
+
+using namespace pagmo;
+using namespace pagmo::detail;
+
+BOOST_AUTO_TEST_CASE(small_task_test)
+{
+    small_task t0;
+    BOOST_CHECK(!t0);
+    BOOST_CHECK(!t0.is_inline());
+    // Small callables are stored inline.
+    int n = 0;
+    small_task t1([&n]() { ++n; });
+    BOOST_CHECK(t1);
+    BOOST_CHECK(t1.is_inline());
+    t1();
+    BOOST_CHECK_EQUAL(n, 1);
+    // Large callables on the heap.
+    std::array<double, 32> arr{};
+    arr[31] = 2.;
+    double res = 0.;
+    small_task t2([arr, &res]() { res = arr[31]; });
+    BOOST_CHECK(t2);
+    BOOST_CHECK(!t2.is_inline());
+    t2();
+    BOOST_CHECK_EQUAL(res, 2.);
+    // Move operations.
+    auto sp = std::make_shared<int>(3);
+    small_task t3([sp, &n]() { n += *sp; });
+    BOOST_CHECK_EQUAL(sp.use_count(), 2);
+    small_task t4(std::move(t3));
+    BOOST_CHECK(!t3);
+    BOOST_CHECK(t4);
+    BOOST_CHECK_EQUAL(sp.use_count(), 2);
+    t4();
+    BOOST_CHECK_EQUAL(n, 4);
+    t4 = std::move(t2);
+    BOOST_CHECK_EQUAL(sp.use_count(), 1);
+    BOOST_CHECK(!t4.is_inline());
+    res = 0.;
+    t4();
+    BOOST_CHECK_EQUAL(res, 2.);
+    t4.reset();
+    BOOST_CHECK(!t4);
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_order_test)
+{
+    task_queue tq(4u);
+    BOOST_CHECK_EQUAL(tq.capacity(), 4u);
+    BOOST_CHECK_EQUAL(task_queue(0u).capacity(), 1u);
+    // Waiting on the ticket zero returns immediately.
+    tq.wait(0u);
+    BOOST_CHECK(tq.done(0u));
+    // The tasks are executed in FIFO order, also if the producer
+    // has to wait for the consumer to make room.
+    std::vector<int> v;
+    task_queue::ticket t = 0;
+    for (int i = 0; i < 100; ++i) {
+        const auto new_t = tq.enqueue([&v, i]() { v.push_back(i); });
+        BOOST_CHECK_EQUAL(new_t, t + 1u);
+        t = new_t;
+    }
+    tq.wait(t);
+    BOOST_CHECK(tq.done(t));
+    BOOST_CHECK_EQUAL(v.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        BOOST_CHECK_EQUAL(v[static_cast<decltype(v.size())>(i)], i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_bounded_test)
+{
+    task_queue tq(2u);
+    std::mutex m;
+    std::unique_lock<std::mutex> lock(m);
+    // Block the consumer.
+    std::atomic<bool> started(false);
+    tq.enqueue([&m, &started]() {
+        started.store(true);
+        std::lock_guard<std::mutex> l(m);
+    });
+    std::atomic<int> counter(0);
+    // Wait for the blocking task to be picked up, so that the two slots are free.
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+    // The hook is not invoked if there is room in the queue.
+    std::atomic<int> n_blocks(0);
+    const auto on_block = [&n_blocks]() {
+        ++n_blocks;
+        return 0;
+    };
+    tq.enqueue([&counter]() { ++counter; }, on_block);
+    tq.enqueue([&counter]() { ++counter; });
+    BOOST_CHECK_EQUAL(n_blocks.load(), 0);
+    // The queue is full: the next enqueue invokes the hook and blocks until the consumer makes room.
+    std::atomic<bool> enqueued(false);
+    task_queue::ticket t = 0;
+    std::thread producer([&]() {
+        t = tq.enqueue([&counter]() { ++counter; }, on_block);
+        enqueued.store(true);
+    });
+    while (!n_blocks.load()) {
+        std::this_thread::yield();
+    }
+    BOOST_CHECK(!enqueued.load());
+    BOOST_CHECK(!tq.done(1u));
+    lock.unlock();
+    producer.join();
+    BOOST_CHECK(enqueued.load());
+    BOOST_CHECK_EQUAL(n_blocks.load(), 1);
+    BOOST_CHECK_EQUAL(t, 4u);
+    tq.wait(t);
+    BOOST_CHECK_EQUAL(counter.load(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_batch_test)
+{
+    task_queue tq(8u);
+    std::vector<int> v;
+    std::vector<std::function<void()>> tasks;
+    // An empty batch returns the last ticket.
+    BOOST_CHECK_EQUAL(tq.enqueue_batch(tasks.begin(), tasks.end()), 0u);
+    for (int i = 0; i < 50; ++i) {
+        tasks.emplace_back([&v, i]() { v.push_back(i); });
+    }
+    // Batches larger than the capacity are enqueued in chunks.
+    auto t = tq.enqueue_batch(tasks.begin(), tasks.end());
+    BOOST_CHECK_EQUAL(t, 50u);
+    t = tq.enqueue_batch(tasks.begin(), tasks.begin() + 3);
+    BOOST_CHECK_EQUAL(t, 53u);
+    BOOST_CHECK_EQUAL(tq.enqueue_batch(tasks.begin(), tasks.begin()), 53u);
+    tq.wait(t);
+    BOOST_CHECK_EQUAL(v.size(), 53u);
+    for (decltype(v.size()) i = 0; i < v.size(); ++i) {
+        BOOST_CHECK_EQUAL(v[i], static_cast<int>(i % 50u));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_stop_test)
+{
+    std::atomic<int> counter(0);
+    {
+        task_queue tq;
+        for (int i = 0; i < 10; ++i) {
+            tq.enqueue([&counter]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++counter;
+            });
+        }
+        // The tasks queued before stopping are consumed.
+        tq.stop();
+        BOOST_CHECK_EQUAL(counter.load(), 10);
+        tq.stop();
+        BOOST_CHECK_THROW(tq.enqueue([]() {}), std::runtime_error);
+        std::vector<std::function<void()>> tasks(1u, []() {});
+        BOOST_CHECK_THROW(tq.enqueue_batch(tasks.begin(), tasks.end()), std::runtime_error);
+    }
+    // Destruction with tasks in flight.
+    {
+        task_queue tq(3u);
+        for (int i = 0; i < 10; ++i) {
+            tq.enqueue([&counter]() { ++counter; });
+        }
+    }
+    BOOST_CHECK_EQUAL(counter.load(), 20);
+}
@@ -0,0 +1,82 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+// Worker daemon for pagmo::socket_island. It can evolve all the algorithms
+// and problems implemented in pagmo.
+//
+// Usage: pagmo_socket_worker [address]
+//
+// The address is either "tcp://host:port" or "unix://path", and it defaults
+// to pagmo::socket_island::default_address(). The executable is also the default
+// worker of pagmo::fork_island, which starts it with an "fd://N" argument.
+
+#include <atomic>
+#include <csignal>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include <pagmo/pagmo.hpp>
+
+namespace
+{
+
+std::atomic<pagmo::socket_worker *> worker_ptr(nullptr);
+
+extern "C" void stop_handler(int)
+{
+    if (auto w = worker_ptr.load()) {
+        w->stop();
+    }
+}
+}
+
+int main(int argc, char **argv)
+{
+    if (pagmo::fork_island::worker_main(argc, argv)) {
+        return 0;
+    }
+    if (argc > 2 || (argc == 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))) {
+        std::cout << "Usage: " << argv[0] << " [address]\n\nThe address is either 'tcp://host:port' or "
+                  << "'unix://path' (default: '" << pagmo::socket_island::default_address() << "').\n";
+        return argc == 2 ? 0 : 1;
+    }
+    try {
+        pagmo::socket_worker w(argc == 2 ? argv[1] : pagmo::socket_island::default_address());
+        worker_ptr.store(&w);
+        std::signal(SIGINT, stop_handler);
+        std::signal(SIGTERM, stop_handler);
+        std::cout << "Listening on " << w.get_address() << std::endl;
+        w.run();
+        worker_ptr.store(nullptr);
+    } catch (const std::exception &e) {
+        worker_ptr.store(nullptr);
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}